@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/vst3sdk-populate"
+  "CMakeFiles/vst3sdk-populate-complete"
+  "vst3sdk-populate-prefix/src/vst3sdk-populate-stamp/vst3sdk-populate-build"
+  "vst3sdk-populate-prefix/src/vst3sdk-populate-stamp/vst3sdk-populate-configure"
+  "vst3sdk-populate-prefix/src/vst3sdk-populate-stamp/vst3sdk-populate-download"
+  "vst3sdk-populate-prefix/src/vst3sdk-populate-stamp/vst3sdk-populate-install"
+  "vst3sdk-populate-prefix/src/vst3sdk-populate-stamp/vst3sdk-populate-mkdir"
+  "vst3sdk-populate-prefix/src/vst3sdk-populate-stamp/vst3sdk-populate-patch"
+  "vst3sdk-populate-prefix/src/vst3sdk-populate-stamp/vst3sdk-populate-test"
+  "vst3sdk-populate-prefix/src/vst3sdk-populate-stamp/vst3sdk-populate-update"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/vst3sdk-populate.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+cmake_minimum_required(VERSION 3.5)
+
+file(MAKE_DIRECTORY
+  "/root/repo/build/.vst3_validator/build/_deps/vst3sdk-src"
+  "/root/repo/build/.vst3_validator/build/_deps/vst3sdk-build"
+  "/root/repo/build/.vst3_validator/build/_deps/vst3sdk-subbuild/vst3sdk-populate-prefix"
+  "/root/repo/build/.vst3_validator/build/_deps/vst3sdk-subbuild/vst3sdk-populate-prefix/tmp"
+  "/root/repo/build/.vst3_validator/build/_deps/vst3sdk-subbuild/vst3sdk-populate-prefix/src/vst3sdk-populate-stamp"
+  "/root/repo/build/.vst3_validator/build/_deps/vst3sdk-subbuild/vst3sdk-populate-prefix/src"
+  "/root/repo/build/.vst3_validator/build/_deps/vst3sdk-subbuild/vst3sdk-populate-prefix/src/vst3sdk-populate-stamp"
+)
+
+set(configSubDirs )
+foreach(subDir IN LISTS configSubDirs)
+    file(MAKE_DIRECTORY "/root/repo/build/.vst3_validator/build/_deps/vst3sdk-subbuild/vst3sdk-populate-prefix/src/vst3sdk-populate-stamp/${subDir}")
+endforeach()
+if(cfgdir)
+  file(MAKE_DIRECTORY "/root/repo/build/.vst3_validator/build/_deps/vst3sdk-subbuild/vst3sdk-populate-prefix/src/vst3sdk-populate-stamp${cfgdir}") # cfgdir has leading slash
+endif()
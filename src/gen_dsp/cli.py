@@ -4,12 +4,13 @@ Command-line interface for gen_dsp.
 Usage:
     gen-dsp <source> -p <platform> [--no-build] [--dry-run]
     gen-dsp compile <file>
+    gen-dsp cost <file> [options]
     gen-dsp validate <file>
     gen-dsp dot <file>
     gen-dsp sim <file> [options]
-    gen-dsp build [project-path] [-p <platform>]
-    gen-dsp detect <export-path> [--json]
-    gen-dsp patch <target-path> [--dry-run]
+    gen-dsp build [project-path] [-p <platform>] [--pgo] [--lto]
+    gen-dsp detect <export-path> [--json] [--cost]
+    gen-dsp patch <target-path> [--dry-run] [--perf-patches [NAME ...]]
     gen-dsp chain <export-dir> --graph <chain.json> -n NAME [-p circle]
     gen-dsp list
     gen-dsp cache
@@ -26,9 +27,10 @@ from gen_dsp import __version__
 
 from gen_dsp.core.parser import GenExportParser
 from gen_dsp.core.project import ProjectGenerator, ProjectConfig
-from gen_dsp.core.patcher import Patcher
+from gen_dsp.core.patcher import PERF_PATCHES, Patcher
 from gen_dsp.core.builder import Builder
-from gen_dsp.errors import GenExtError
+from gen_dsp.core.cost import add_cost_options, export_cost, render_cost
+from gen_dsp.errors import GenExtError, PatchError
 from gen_dsp.platforms import list_platforms, get_platform
 from gen_dsp.platforms.base import Platform
 
@@ -39,6 +41,7 @@ SUBCOMMANDS = {
     "validate",
     "dot",
     "sim",
+    "cost",
     "build",
     "detect",
     "patch",
@@ -67,9 +70,12 @@ Default command (auto-detects source type):
   -n, --name NAME           Plugin name (default: inferred from source)
   -o, --output DIR          Output directory (default: <name>_<platform>)
   --no-build                Skip building after project creation
+  --pgo                     Profile-guided build (synthetic training run)
+  --lto                     Link-time optimisation across wrapper/kernel
   --dry-run                 Show what would be done without creating files
   --buffers NAME [NAME ...]
   --no-patch                Skip platform patches
+  --perf-patches [NAME ...] Opt-in export performance patches (all or named)
   --no-shared-cache         Disable shared OS cache for FetchContent downloads
   --cache-dir DIR           Explicit FetchContent cache directory
   --board BOARD             Board variant (daisy, circle)
@@ -87,8 +93,9 @@ Subcommands:
   validate <file>           Validate a graph file
   dot <file>                Generate DOT visualization
   sim <file>                Simulate graph (WAV in/out)
+  cost <file>               Estimate graph memory and CPU cost
   build [dir]               Build an existing project
-  detect <dir>              Analyze a gen~ export
+  detect <dir>              Analyze a gen~ export (--cost: memory/CPU)
   patch <dir>               Apply platform-specific patches
   chain <dir>               Multi-plugin chain mode (Circle)
   list                      List available platforms
@@ -146,6 +153,14 @@ def _make_default_parser() -> argparse.ArgumentParser:
         action="store_true",
         help="Don't apply platform patches (exp2f fix)",
     )
+    parser.add_argument(
+        "--perf-patches",
+        nargs="*",
+        default=None,
+        metavar="NAME",
+        help="Apply opt-in performance patches to the gen~ export. "
+        f"No names = apply all; available: {', '.join(PERF_PATCHES)}",
+    )
     parser.add_argument(
         "--no-shared-cache",
         action="store_true",
@@ -202,6 +217,16 @@ def _make_default_parser() -> argparse.ArgumentParser:
         help="Remap signal inputs to parameters. "
         "No names = remap all; with names = remap only those inputs.",
     )
+    parser.add_argument(
+        "--pgo",
+        action="store_true",
+        help="Profile-guided build: train on a synthetic workload, then rebuild",
+    )
+    parser.add_argument(
+        "--lto",
+        action="store_true",
+        help="Link-time optimisation: inline wrapper calls across translation units",
+    )
     parser.add_argument(
         "--dry-run",
         action="store_true",
@@ -240,6 +265,17 @@ def _make_subcommand_parser() -> argparse.ArgumentParser:
     build_parser.add_argument(
         "-v", "--verbose", action="store_true", help="Show build output"
     )
+    build_parser.add_argument(
+        "--pgo",
+        action="store_true",
+        help="Profile-guided build: train on a synthetic workload, then rebuild",
+    )
+    build_parser.add_argument(
+        "--lto",
+        action="store_true",
+        help="Link-time optimisation: inline wrapper calls across translation units "
+        "(use with --clean when switching an existing Make build)",
+    )
 
     # detect command
     detect_parser = subparsers.add_parser("detect", help="Analyze a gen~ export")
@@ -249,6 +285,12 @@ def _make_subcommand_parser() -> argparse.ArgumentParser:
     detect_parser.add_argument(
         "--json", action="store_true", help="Output in JSON format"
     )
+    detect_parser.add_argument(
+        "--cost",
+        action="store_true",
+        help="Estimate memory footprint and per-sample CPU cost",
+    )
+    add_cost_options(detect_parser, default_sample_rate=48000.0)
 
     # patch command
     patch_parser = subparsers.add_parser(
@@ -260,6 +302,14 @@ def _make_subcommand_parser() -> argparse.ArgumentParser:
     patch_parser.add_argument(
         "--dry-run", action="store_true", help="Show what would be done"
     )
+    patch_parser.add_argument(
+        "--perf-patches",
+        nargs="*",
+        default=None,
+        metavar="NAME",
+        help="Apply opt-in performance patches instead of platform patches. "
+        f"No names = apply all; available: {', '.join(PERF_PATCHES)}",
+    )
 
     # list command
     subparsers.add_parser("list", help="List available target platforms")
@@ -325,19 +375,21 @@ def _make_subcommand_parser() -> argparse.ArgumentParser:
         "--dry-run", action="store_true", help="Show what would be done"
     )
 
-    # graph subcommands (compile, validate, dot, sim)
+    # graph subcommands (compile, validate, dot, sim, cost)
     try:
         from gen_dsp.graph.cli import (
             add_compile_parser,
             add_validate_parser,
             add_dot_parser,
             add_sim_parser,
+            add_cost_parser,
         )
 
         add_compile_parser(subparsers)
         add_validate_parser(subparsers)
         add_dot_parser(subparsers)
         add_sim_parser(subparsers)
+        add_cost_parser(subparsers)
     except ImportError:
         pass
 
@@ -349,6 +401,12 @@ def _make_subcommand_parser() -> argparse.ArgumentParser:
 # ---------------------------------------------------------------------------
 
 
+def _build_mode_suffix(args: argparse.Namespace) -> str:
+    """' (PGO, LTO)'-style note for dry-run output."""
+    modes = [name for name, on in (("PGO", args.pgo), ("LTO", args.lto)) if on]
+    return f" ({', '.join(modes)})" if modes else ""
+
+
 def _cmd_default(argv: list[str]) -> int:
     """Handle the default command: <source> -p <platform> [flags]."""
     parser = _make_default_parser()
@@ -448,7 +506,7 @@ def _cmd_default_graph(args: argparse.Namespace, graph_path: Path) -> int:
         print(f"  Outputs: {len(graph.outputs)}")
         print(f"  Parameters: {len(graph.params)}")
         if not args.no_build:
-            print("  Would build after creating")
+            print(f"  Would build after creating{_build_mode_suffix(args)}")
         return 0
 
     # Generate project
@@ -468,7 +526,9 @@ def _cmd_default_graph(args: argparse.Namespace, graph_path: Path) -> int:
     if not args.no_build:
         try:
             builder = Builder(project_dir)
-            result = builder.build(target_platform=args.platform)
+            result = builder.build(
+                target_platform=args.platform, pgo=args.pgo, lto=args.lto
+            )
             if result.success:
                 print("Build successful!")
                 if result.output_file:
@@ -555,6 +615,7 @@ def _cmd_default_export(args: argparse.Namespace, export_path: Path) -> int:
         midi_freq_unit=args.midi_freq_unit,
         num_voices=args.voices,
         inputs_as_params=args.inputs_as_params,
+        perf_patches=args.perf_patches,
     )
 
     # Validate
@@ -584,8 +645,11 @@ def _cmd_default_export(args: argparse.Namespace, export_path: Path) -> int:
         print(f"  Buffers: {buffers if buffers else '(none)'}")
         if export_info.has_exp2f_issue and not args.no_patch:
             print("  Would apply exp2f -> exp2 patch")
+        if args.perf_patches is not None:
+            names = args.perf_patches or list(PERF_PATCHES)
+            print(f"  Would apply performance patches: {', '.join(names)}")
         if not args.no_build:
-            print("  Would build after creating")
+            print(f"  Would build after creating{_build_mode_suffix(args)}")
         return 0
 
     # Generate project
@@ -605,7 +669,9 @@ def _cmd_default_export(args: argparse.Namespace, export_path: Path) -> int:
     if not args.no_build:
         try:
             builder = Builder(project_dir)
-            result = builder.build(target_platform=args.platform)
+            result = builder.build(
+                target_platform=args.platform, pgo=args.pgo, lto=args.lto
+            )
             if result.success:
                 print("Build successful!")
                 if result.output_file:
@@ -643,6 +709,8 @@ def cmd_build(args: argparse.Namespace) -> int:
             target_platform=args.platform,
             clean=args.clean,
             verbose=args.verbose,
+            pgo=args.pgo,
+            lto=args.lto,
         )
 
         if result.success:
@@ -675,6 +743,22 @@ def cmd_detect(args: argparse.Namespace) -> int:
         print(f"Error: {e}", file=sys.stderr)
         return 1
 
+    if args.cost:
+        try:
+            report = export_cost(info, args.sample_rate, args.block_size)
+        except GenExtError as e:
+            print(f"Error: {e}", file=sys.stderr)
+            return 1
+        text, failures, warnings = render_cost(
+            report, args.target, args.json, args.max_memory, args.max_cpu
+        )
+        print(text)
+        for warning in warnings:
+            print(f"Warning: {warning}", file=sys.stderr)
+        for failure in failures:
+            print(f"Budget exceeded: {failure}", file=sys.stderr)
+        return 1 if failures else 0
+
     if args.json:
         data = {
             "name": info.name,
@@ -711,6 +795,23 @@ def cmd_patch(args: argparse.Namespace) -> int:
 
     patcher = Patcher(target_path)
 
+    if args.perf_patches is not None:
+        try:
+            results = patcher.apply_perf_patches(
+                args.perf_patches or None, dry_run=args.dry_run
+            )
+        except PatchError as e:
+            print(f"Error: {e}", file=sys.stderr)
+            return 1
+        if not results:
+            print("No gen~ export sources found.")
+            return 0
+        for result in results:
+            status = "Applied" if result.applied else "Skipped"
+            print(f"{status}: {result.patch_name} ({result.file_path.name})")
+            print(f"  {result.message}")
+        return 0
+
     if args.dry_run:
         needed = patcher.check_patches_needed()
         if not any(needed.values()):
@@ -920,12 +1021,19 @@ def _dispatch_subcommand(argv: list[str]) -> int:
 
     # Add graph subcommand handlers if available
     try:
-        from gen_dsp.graph.cli import cmd_compile, cmd_validate, cmd_dot, cmd_simulate
+        from gen_dsp.graph.cli import (
+            cmd_compile,
+            cmd_cost,
+            cmd_validate,
+            cmd_dot,
+            cmd_simulate,
+        )
 
         handlers["compile"] = cmd_compile
         handlers["validate"] = cmd_validate
         handlers["dot"] = cmd_dot
         handlers["sim"] = cmd_simulate
+        handlers["cost"] = cmd_cost
     except ImportError:
         pass
 
@@ -5,6 +5,7 @@ Uses the platform registry to dynamically select the appropriate
 build system for each platform.
 """
 
+import os
 import re
 from dataclasses import dataclass
 from pathlib import Path
@@ -50,6 +51,8 @@ class Builder:
         target_platform: str = "pd",
         clean: bool = False,
         verbose: bool = False,
+        pgo: bool = False,
+        lto: bool = False,
     ) -> BuildResult:
         """
         Build the project for the specified platform.
@@ -58,6 +61,10 @@ class Builder:
             target_platform: Platform name (e.g., 'pd', 'max').
             clean: If True, clean before building.
             verbose: If True, print build output in real-time.
+            pgo: If True, do a profile-guided build (see core/pgo.py).
+            lto: If True, build with link-time optimisation by setting
+                GEN_DSP_LTO=1 for the build tools, which the generated
+                CMake/Make files honour.
 
         Returns:
             BuildResult with build status and output file path.
@@ -73,7 +80,29 @@ class Builder:
         except ValueError as e:
             raise BuildError(str(e)) from e
 
-        return platform_impl.build(self.project_dir, clean=clean, verbose=verbose)
+        if lto and not platform_impl.supports_lto:
+            raise BuildError(
+                f"--lto is not supported for platform '{platform_impl.name}'"
+            )
+
+        saved_lto = os.environ.get("GEN_DSP_LTO")
+        if lto:
+            os.environ["GEN_DSP_LTO"] = "1"
+        try:
+            if pgo:
+                from gen_dsp.core.pgo import PgoBuilder
+
+                return PgoBuilder(platform_impl, self.project_dir).build(
+                    clean=clean, verbose=verbose
+                )
+
+            return platform_impl.build(self.project_dir, clean=clean, verbose=verbose)
+        finally:
+            if lto:
+                if saved_lto is None:
+                    del os.environ["GEN_DSP_LTO"]
+                else:
+                    os.environ["GEN_DSP_LTO"] = saved_lto
 
     def clean(self, target_platform: str = "pd") -> None:
         """
@@ -28,3 +28,11 @@ def get_cache_dir() -> Path:
         base = Path(xdg) if xdg else Path.home() / ".cache"
 
     return base / "gen-dsp" / "fetchcontent"
+
+
+def get_pgo_cache_dir() -> Path:
+    """Return the directory holding trained PGO profiles, keyed per export.
+
+    Sibling of the FetchContent cache (``.../gen-dsp/pgo/``).
+    """
+    return get_cache_dir().parent / "pgo"
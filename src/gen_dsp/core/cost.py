@@ -0,0 +1,610 @@
+"""
+Static cost and memory footprint estimates.
+
+Answers "how much RAM, and roughly how many cycles per sample?" before
+anything is built: for gen~ exports from the ``Delay``/``Data``
+allocations, State members and per-sample loop that ``GenExportParser``
+reads out of the exported ``.cpp`` (``ExportInfo.state``), and for
+dsp-graphs by walking the node list (see ``gen_dsp.graph.cost``). Both
+produce a ``CostReport``.
+
+Operation counts are grouped into a few classes with different costs
+(plain arithmetic, division, libm calls, memory accesses); each
+``TargetProfile`` weights them with rough cycle counts for one CPU. The
+numbers are estimates for budgeting and comparison, not measurements.
+"""
+
+import argparse
+import ast
+import json
+import math
+import re
+from dataclasses import dataclass, field
+from typing import Any
+
+from gen_dsp.core.parser import ExportInfo
+from gen_dsp.errors import ParseError
+
+# ---------------------------------------------------------------------------
+# Operation counts and target profiles
+# ---------------------------------------------------------------------------
+
+
+@dataclass
+class OpCounts:
+    """Operations per sample, by cost class."""
+
+    add: float = 0.0  # add/sub, compares, selects, min/max, abs
+    mul: float = 0.0
+    div: float = 0.0  # div, mod, sqrt
+    math: float = 0.0  # libm calls: sin, exp, pow, tanh, ...
+    mem: float = 0.0  # delay/buffer/table loads and stores
+
+    def __add__(self, other: "OpCounts") -> "OpCounts":
+        return OpCounts(
+            self.add + other.add,
+            self.mul + other.mul,
+            self.div + other.div,
+            self.math + other.math,
+            self.mem + other.mem,
+        )
+
+    def scaled(self, k: float) -> "OpCounts":
+        return OpCounts(
+            self.add * k, self.mul * k, self.div * k, self.math * k, self.mem * k
+        )
+
+    @property
+    def flops(self) -> float:
+        """Floating-point operations per sample (memory accesses excluded)."""
+        return self.add + self.mul + self.div + self.math
+
+    def to_dict(self) -> dict[str, float]:
+        return {
+            "add": round(self.add, 2),
+            "mul": round(self.mul, 2),
+            "div": round(self.div, 2),
+            "math": round(self.math, 2),
+            "mem": round(self.mem, 2),
+            "flops": round(self.flops, 2),
+        }
+
+
+@dataclass(frozen=True)
+class TargetProfile:
+    """Rough per-class cycle costs and memory capacity of one target CPU."""
+
+    name: str
+    description: str
+    clock_hz: float
+    weights: OpCounts
+    memory_bytes: int | None = None  # None = not a constraint worth reporting
+
+    def cycles_per_sample(self, ops: OpCounts) -> float:
+        w = self.weights
+        return (
+            ops.add * w.add
+            + ops.mul * w.mul
+            + ops.div * w.div
+            + ops.math * w.math
+            + ops.mem * w.mem
+        )
+
+    def cpu_percent(self, ops: OpCounts, sample_rate: float) -> float:
+        """Estimated load on one core at *sample_rate*, in percent."""
+        return 100.0 * self.cycles_per_sample(ops) * sample_rate / self.clock_hz
+
+
+TARGETS: dict[str, TargetProfile] = {
+    "desktop": TargetProfile(
+        "desktop",
+        "x86-64 / Apple silicon core, 3 GHz",
+        3.0e9,
+        OpCounts(add=1, mul=1, div=4, math=20, mem=1),
+    ),
+    "circle": TargetProfile(
+        "circle",
+        "Raspberry Pi 3 (Cortex-A53), 1.2 GHz",
+        1.2e9,
+        OpCounts(add=1, mul=1, div=10, math=40, mem=2),
+    ),
+    "daisy": TargetProfile(
+        "daisy",
+        "Daisy Seed (Cortex-M7), 480 MHz",
+        480e6,
+        OpCounts(add=1, mul=1, div=14, math=60, mem=3),
+        # genlib_daisy.h: SRAM pool + SDRAM pool
+        memory_bytes=450 * 1024 + 64 * 1024 * 1024,
+    ),
+}
+
+
+# ---------------------------------------------------------------------------
+# Report
+# ---------------------------------------------------------------------------
+
+
+@dataclass
+class MemoryItem:
+    """One allocation outside the state struct."""
+
+    name: str
+    kind: str  # "delay", "data" or "buffer"
+    bytes: int | None  # None = sized by the host at runtime
+
+
+@dataclass
+class CostReport:
+    """Static memory and per-sample cost estimate for one export or graph."""
+
+    name: str
+    sample_rate: float
+    block_size: int
+    state_bytes: int
+    items: list[MemoryItem] = field(default_factory=list)
+    ops: OpCounts = field(default_factory=OpCounts)
+    notes: list[str] = field(default_factory=list)
+
+    @property
+    def delay_bytes(self) -> int:
+        return sum(i.bytes or 0 for i in self.items if i.kind == "delay")
+
+    @property
+    def buffer_bytes(self) -> int:
+        return sum(i.bytes or 0 for i in self.items if i.kind != "delay")
+
+    @property
+    def total_bytes(self) -> int:
+        return self.state_bytes + self.delay_bytes + self.buffer_bytes
+
+    def to_dict(self, targets: list[str]) -> dict[str, Any]:
+        return {
+            "name": self.name,
+            "sample_rate": self.sample_rate,
+            "block_size": self.block_size,
+            "memory": {
+                "state_bytes": self.state_bytes,
+                "delay_bytes": self.delay_bytes,
+                "buffer_bytes": self.buffer_bytes,
+                "total_bytes": self.total_bytes,
+                "items": [
+                    {"name": i.name, "kind": i.kind, "bytes": i.bytes}
+                    for i in self.items
+                ],
+            },
+            "ops_per_sample": self.ops.to_dict(),
+            "targets": {
+                t: {
+                    "cycles_per_sample": round(
+                        TARGETS[t].cycles_per_sample(self.ops), 1
+                    ),
+                    "cpu_percent": round(
+                        TARGETS[t].cpu_percent(self.ops, self.sample_rate), 3
+                    ),
+                }
+                for t in targets
+            },
+            "notes": list(self.notes),
+        }
+
+    def format(self, targets: list[str]) -> str:
+        lines = [f"Cost estimate: {self.name}"]
+        lines.append(
+            f"  Assumes: {self.sample_rate:g} Hz, block size {self.block_size}"
+        )
+        lines.append("  Memory:")
+        lines.append(f"    State:   {format_size(self.state_bytes)}")
+        lines.append(f"    Delays:  {format_size(self.delay_bytes)}")
+        lines.append(f"    Buffers: {format_size(self.buffer_bytes)}")
+        for item in self.items:
+            size = format_size(item.bytes) if item.bytes is not None else "host-sized"
+            lines.append(f"      {item.kind:<6} {item.name}: {size}")
+        lines.append(f"    Total:   {format_size(self.total_bytes)}")
+        ops = self.ops
+        lines.append(
+            f"  Per sample: {ops.flops:.1f} flops "
+            f"(add {ops.add:.1f}, mul {ops.mul:.1f}, div {ops.div:.1f}, "
+            f"math {ops.math:.1f}), {ops.mem:.1f} memory accesses"
+        )
+        lines.append("  Targets:")
+        for t in targets:
+            prof = TARGETS[t]
+            line = (
+                f"    {t:<8} ~{prof.cycles_per_sample(ops):.0f} cycles/sample, "
+                f"{prof.cpu_percent(ops, self.sample_rate):.2f}% CPU "
+                f"({prof.description})"
+            )
+            if prof.memory_bytes is not None and self.total_bytes > prof.memory_bytes:
+                line += " -- exceeds target memory"
+            lines.append(line)
+        for note in self.notes:
+            lines.append(f"  Note: {note}")
+        return "\n".join(lines)
+
+
+def format_size(n: int) -> str:
+    """Human-readable byte count (``1536`` -> ``"1.5 KB"``)."""
+    if n < 1024:
+        return f"{n} B"
+    if n < 1024 * 1024:
+        return f"{n / 1024:.1f} KB"
+    return f"{n / (1024 * 1024):.1f} MB"
+
+
+_SIZE_RE = re.compile(r"^\s*(\d+(?:\.\d+)?)\s*([kKmMgG]?)[bB]?\s*$")
+
+
+def parse_size(text: str) -> int:
+    """Parse a byte budget such as ``4096``, ``64K``, ``1.5MB``.
+
+    Raises:
+        ValueError: If *text* is not a size.
+    """
+    m = _SIZE_RE.match(text)
+    if not m:
+        raise ValueError(f"invalid size: {text!r} (e.g. 4096, 64K, 2M)")
+    scale = {"": 1, "k": 1024, "m": 1024**2, "g": 1024**3}[m.group(2).lower()]
+    return int(float(m.group(1)) * scale)
+
+
+def check_budget(
+    report: CostReport,
+    targets: list[str],
+    max_memory: int | None = None,
+    max_cpu: float | None = None,
+) -> list[str]:
+    """Return one message per exceeded budget (empty when within budget).
+
+    Only the budgets given are checked. *max_cpu* is a percentage of one
+    core and is checked on every target in *targets*. Target memory
+    capacity is not a budget; see ``check_capacity``.
+    """
+    failures: list[str] = []
+    total = report.total_bytes
+    if max_memory is not None and total > max_memory:
+        failures.append(
+            f"memory {format_size(total)} exceeds budget {format_size(max_memory)}"
+        )
+    if max_cpu is not None:
+        for t in targets:
+            load = TARGETS[t].cpu_percent(report.ops, report.sample_rate)
+            if load > max_cpu:
+                failures.append(f"{t}: CPU {load:.2f}% exceeds budget {max_cpu:g}%")
+    return failures
+
+
+def check_capacity(report: CostReport, targets: list[str]) -> list[str]:
+    """Return one warning per target whose known memory the total exceeds."""
+    total = report.total_bytes
+    warnings: list[str] = []
+    for t in targets:
+        cap = TARGETS[t].memory_bytes
+        if cap is not None and total > cap:
+            warnings.append(
+                f"{t}: memory {format_size(total)} exceeds {format_size(cap)} available"
+            )
+    return warnings
+
+
+# ---------------------------------------------------------------------------
+# gen~ export analysis
+# ---------------------------------------------------------------------------
+
+# sizeof() of genlib types on LP64 with GENLIB_USE_FLOAT32 (as every gen-dsp
+# backend compiles them), measured against the bundled genlib_ops.h.
+_GENLIB_TYPE_BYTES: dict[str, int] = {
+    "t_sample": 4,
+    "t_param": 4,
+    "float": 4,
+    "int": 4,
+    "bool": 1,
+    "long": 8,
+    "double": 8,
+    "CommonState": 64,
+    "Delta": 4,
+    "Change": 4,
+    "Rate": 28,
+    "DCBlock": 8,
+    "Noise": 16,
+    "Phasor": 4,
+    "PlusEquals": 4,
+    "MulEquals": 4,
+    "Sah": 8,
+    "Train": 8,
+    "Delay": 56,
+    "Data": 48,
+    "DataLocal": 40,
+    "Buffer": 816,
+    "SineData": 40,
+    "SineCycle": 12,
+}
+_UNKNOWN_TYPE_BYTES = 8
+_SAMPLE_BYTES = 4
+
+# Per-call cost of genlib/libm helpers seen in exported code
+_MATH_CALLS = {
+    "sin", "cos", "tan", "asin", "acos", "atan", "atan2", "sinh", "cosh",
+    "tanh", "asinh", "acosh", "atanh", "exp", "exp2", "log", "log2", "log10",
+    "pow", "safepow", "safelog", "safelog2", "safelog10", "hypot", "mtof",
+    "ftom", "dbtoa", "atodb", "t60", "t60time", "safeasin", "safeacos",
+}  # fmt: skip
+_DIV_CALLS = {"safediv", "safemod", "fmod", "sqrt", "safesqrt", "wrap", "scale"}
+_CHEAP_CALLS: dict[str, OpCounts] = {
+    "fixdenorm": OpCounts(add=2),
+    "fixnan": OpCounts(add=1),
+    "floor": OpCounts(add=1),
+    "ceil": OpCounts(add=1),
+    "trunc": OpCounts(add=1),
+    "fabs": OpCounts(add=1),
+    "clamp": OpCounts(add=2),
+    "minimum": OpCounts(add=1),
+    "maximum": OpCounts(add=1),
+    "fold": OpCounts(add=4, div=1),
+    "mix": OpCounts(add=2, mul=1),
+    "linear_interp": OpCounts(add=2, mul=1),
+    "cosine_interp": OpCounts(add=3, mul=2, math=1),
+    "cubic_interp": OpCounts(add=10, mul=8),
+    "spline_interp": OpCounts(add=10, mul=10),
+    "fastpow": OpCounts(add=4, mul=4),
+    "fastsin": OpCounts(add=4, mul=5),
+    "fastcos": OpCounts(add=4, mul=5),
+    "fasttan": OpCounts(add=4, mul=6),
+    "fastexp": OpCounts(add=4, mul=4),
+}
+_METHOD_CALLS: dict[str, OpCounts] = {
+    "read_step": OpCounts(add=1, mem=1),
+    "read_linear": OpCounts(add=4, mul=1, mem=2),
+    "read_cosine": OpCounts(add=5, mul=2, math=1, mem=2),
+    "read_cubic": OpCounts(add=12, mul=8, mem=4),
+    "read_spline": OpCounts(add=12, mul=10, mem=4),
+    "read": OpCounts(add=1, mem=1),
+    "write": OpCounts(add=1, mem=1),
+    "blend": OpCounts(add=3, mul=2, mem=2),
+    "step": OpCounts(add=2),
+    "poke": OpCounts(add=2, mem=1),
+    "peek": OpCounts(add=2, mem=1),
+    "operator()": OpCounts(add=2),
+}
+_NOT_CALLS = {
+    "if", "while", "for", "switch", "return", "sizeof", "int", "long",
+    "float", "double", "bool", "t_sample", "t_param",
+}  # fmt: skip
+
+_CAST_RE = re.compile(r"\(\s*(?:int|long|t_sample|t_param|double|float|bool)\s*\)")
+_NUMBER_RE = re.compile(r"(?<![\w.])(?:\d+\.?\d*|\.\d+)(?:[eE][+-]?\d+)?[fFlL]?")
+_STRING_RE = re.compile(r"\"(?:\\.|[^\"\\])*\"")
+_COMMENT_RE = re.compile(r"//[^\n]*|/\*.*?\*/", re.DOTALL)
+_PTR_DECL_RE = re.compile(
+    r"\b(?:t_sample|t_param|double|float|int|long|bool)\s*\*+\s*(?=\w)"
+)
+_CALL_RE = re.compile(r"(\.)?\b([A-Za-z_]\w*)\s*\(")
+_BINARY_OP_RE = re.compile(r"(?<=[\w)\]])\s*(\*|/|%|\+(?!\+)|-(?![-=>]))(?!=)")
+_COMPARE_RE = re.compile(
+    r"<=|>=|==|!=|&&|\|\||\?|(?<![<\-])<(?![<=])|(?<![>\-])>(?![>=])"
+)
+
+
+def _next_pow2(n: int) -> int:
+    return 1 << (max(n, 2) - 1).bit_length()
+
+
+def _eval_size(expr: str, sample_rate: float, block_size: int) -> int | None:
+    """Evaluate an allocation size such as ``((int)48000)`` or ``samplerate``.
+
+    Only arithmetic on literals, ``samplerate``, ``vectorsize`` and a few
+    genlib helpers is understood; anything else returns None.
+    """
+    names: dict[str, float] = {"samplerate": sample_rate, "vectorsize": block_size}
+    funcs: dict[str, Any] = {
+        "mstosamps": lambda ms: ms * sample_rate / 1000.0,
+        "floor": math.floor,
+        "ceil": math.ceil,
+        "int": int,
+        "max": max,
+        "min": min,
+    }
+
+    def ev(node: ast.AST) -> float:
+        if isinstance(node, ast.Expression):
+            return ev(node.body)
+        if isinstance(node, ast.Constant) and isinstance(node.value, (int, float)):
+            return float(node.value)
+        if isinstance(node, ast.Name) and node.id in names:
+            return names[node.id]
+        if isinstance(node, ast.UnaryOp) and isinstance(node.op, ast.USub):
+            return -ev(node.operand)
+        if isinstance(node, ast.BinOp):
+            a, b = ev(node.left), ev(node.right)
+            if isinstance(node.op, ast.Add):
+                return a + b
+            if isinstance(node.op, ast.Sub):
+                return a - b
+            if isinstance(node.op, ast.Mult):
+                return a * b
+            if isinstance(node.op, ast.Div) and b:
+                return a / b
+        if (
+            isinstance(node, ast.Call)
+            and isinstance(node.func, ast.Name)
+            and node.func.id in funcs
+        ):
+            return float(funcs[node.func.id](*(ev(a) for a in node.args)))
+        raise ValueError(ast.dump(node))
+
+    try:
+        return int(ev(ast.parse(_CAST_RE.sub("", expr).strip(), mode="eval")))
+    except (SyntaxError, ValueError, TypeError):
+        return None
+
+
+def count_code_ops(code: str) -> OpCounts:
+    """Estimate the operations executed by one pass over a C++ code fragment."""
+    code = _COMMENT_RE.sub(" ", code)
+    code = _STRING_RE.sub('""', code)
+    code = _CAST_RE.sub(" ", code)
+    code = _NUMBER_RE.sub("0", code)
+    ops = OpCounts()
+
+    for m in _CALL_RE.finditer(code):
+        is_method, fn = m.group(1) is not None, m.group(2)
+        if is_method:
+            ops += _METHOD_CALLS.get(fn, OpCounts(add=1))
+        elif fn in _NOT_CALLS:
+            continue
+        elif fn in _MATH_CALLS:
+            ops.math += 1
+        elif fn in _DIV_CALLS:
+            ops.div += 1
+        else:
+            ops += _CHEAP_CALLS.get(fn, OpCounts(add=1))
+
+    # Drop declarations and pointer bumps so only value arithmetic remains
+    code = _PTR_DECL_RE.sub(" ", code)
+    code = re.sub(r"\(\*\(\w+\+\+\)\)", "x", code)
+    for m in _BINARY_OP_RE.finditer(code):
+        op = m.group(1)
+        if op == "*":
+            ops.mul += 1
+        elif op in ("/", "%"):
+            ops.div += 1
+        else:
+            ops.add += 1
+    ops.add += len(_COMPARE_RE.findall(code))
+    return ops
+
+
+def export_cost(
+    info: ExportInfo, sample_rate: float = 48000.0, block_size: int = 64
+) -> CostReport:
+    """Estimate memory and per-sample cost of a parsed gen~ export.
+
+    Delay lines are sized as genlib allocates them (rounded up to a power
+    of two); ``Data`` members by their ``reset()`` dimensions. Buffers
+    (see ``ExportInfo.buffers``) are supplied by the host and listed as
+    host-sized. Code before the per-sample loop is amortised over
+    *block_size*.
+
+    Raises:
+        ParseError: If the export has no ``State`` struct.
+    """
+    if info.cpp_path is None:
+        raise ParseError(f"No .cpp file found for export '{info.name}'")
+    state = info.state
+    if state is None:
+        raise ParseError(f"No State struct found in {info.cpp_path.name}")
+
+    report = CostReport(info.name, sample_rate, block_size, state_bytes=0)
+
+    member_types: dict[str, str] = {}
+    unknown: set[str] = set()
+    for ctype, name in state.members:
+        member_types[name] = ctype
+        if ctype not in _GENLIB_TYPE_BYTES:
+            unknown.add(ctype)
+        report.state_bytes += _GENLIB_TYPE_BYTES.get(ctype, _UNKNOWN_TYPE_BYTES)
+    for ctype in sorted(unknown):
+        report.notes.append(
+            f"unknown member type '{ctype}' counted as {_UNKNOWN_TYPE_BYTES} bytes"
+        )
+
+    # Heap allocations made in reset()
+    for member, label, args in state.allocations:
+        ctype = member_types.get(member, "")
+        dims = [_eval_size(a, sample_rate, block_size) for a in args]
+        if None in dims or not dims:
+            report.items.append(MemoryItem(label, "data", None))
+            report.notes.append(f"size of '{label}' not statically known")
+            continue
+        if ctype == "Delay":
+            size = _next_pow2(int(dims[0] or 0)) * _SAMPLE_BYTES
+            report.items.append(MemoryItem(label, "delay", size))
+        else:
+            elems = 1
+            for d in dims:
+                elems *= max(int(d or 0), 1)
+            kind = "buffer" if label in info.buffers else "data"
+            report.items.append(MemoryItem(label, kind, elems * _SAMPLE_BYTES))
+
+    # SineData tables are allocated by their constructors (16384 samples)
+    for name, ctype in member_types.items():
+        if ctype == "SineData":
+            report.items.append(MemoryItem(name, "data", (1 << 14) * _SAMPLE_BYTES))
+
+    allocated = {i.name for i in report.items}
+    for buf in info.buffers:
+        if buf not in allocated:
+            report.items.append(MemoryItem(buf, "buffer", None))
+
+    # Per-sample cost: the main loop, plus block-rate setup amortised
+    loop_body = state.perform_loop
+    if loop_body is None:
+        report.notes.append("per-sample loop not found; operation counts omitted")
+        return report
+    report.ops = count_code_ops(loop_body)
+    report.ops += count_code_ops(state.perform_setup).scaled(1.0 / max(block_size, 1))
+    if re.search(r"\b(for|while)\s*\(", loop_body):
+        report.notes.append(
+            "per-sample loop contains inner loops; each is counted once"
+        )
+    return report
+
+
+def render_cost(
+    report: CostReport,
+    targets: list[str] | None = None,
+    as_json: bool = False,
+    max_memory: int | None = None,
+    max_cpu: float | None = None,
+) -> tuple[str, list[str], list[str]]:
+    """Render *report* for the CLI and check it against the budgets.
+
+    Returns ``(text, failures, warnings)``: *failures* from the budgets
+    given, *warnings* from target memory capacity. *targets* defaults to
+    every profile.
+    """
+    targets = targets or list(TARGETS)
+    failures = check_budget(report, targets, max_memory, max_cpu)
+    warnings = check_capacity(report, targets)
+    if as_json:
+        data = report.to_dict(targets)
+        data["budget_failures"] = failures
+        data["capacity_warnings"] = warnings
+        return json.dumps(data, indent=2), failures, warnings
+    return report.format(targets), failures, warnings
+
+
+def add_cost_options(
+    parser: argparse.ArgumentParser, default_sample_rate: float | None
+) -> None:
+    """Add the target, rate and budget options shared by the cost commands."""
+    parser.add_argument(
+        "--target",
+        action="append",
+        choices=list(TARGETS),
+        help="Report this target only (repeatable; default: all)",
+    )
+    parser.add_argument(
+        "--sample-rate",
+        type=float,
+        default=default_sample_rate,
+        help="Sample rate for sizes and CPU load"
+        + (f" (default: {default_sample_rate:g})" if default_sample_rate else ""),
+    )
+    parser.add_argument(
+        "--block-size",
+        type=int,
+        default=64,
+        help="Block size for amortised per-block work (default: 64)",
+    )
+    parser.add_argument(
+        "--max-memory",
+        type=parse_size,
+        metavar="SIZE",
+        help="Fail if total memory exceeds SIZE (e.g. 64K, 2M)",
+    )
+    parser.add_argument(
+        "--max-cpu",
+        type=float,
+        metavar="PERCENT",
+        help="Fail if estimated CPU load exceeds PERCENT on any reported target",
+    )
@@ -5,6 +5,7 @@ Analyzes gen~ exports to detect:
 - Export name (from .cpp/.h filenames)
 - Buffer names (via regex patterns)
 - I/O counts (from gen_kernel_numins/numouts)
+- State struct layout (members, allocations, per-sample loop)
 - Platform-specific issues (exp2f)
 """
 
@@ -16,6 +17,23 @@ from typing import Optional
 from gen_dsp.errors import ParseError
 
 
+@dataclass
+class StateLayout:
+    """Layout of the export's ``State`` struct, as read by cost estimates."""
+
+    # (type, name) of each member declared before the first method
+    members: list[tuple[str, str]] = field(default_factory=list)
+
+    # (member, label, size expressions) of each member.reset("label", ...) call
+    allocations: list[tuple[str, str, list[str]]] = field(default_factory=list)
+
+    # perform() body before the per-sample loop (block-rate setup)
+    perform_setup: str = ""
+
+    # Body of the per-sample while ((__n--)) loop; None when not found
+    perform_loop: str | None = None
+
+
 @dataclass
 class ExportInfo:
     """Information extracted from a gen~ export."""
@@ -53,6 +71,9 @@ class ExportInfo:
     # Signal input names (from gen_kernel_innames[], e.g. ["carrier", "c/m ratio"])
     input_names: list[str] = field(default_factory=list)
 
+    # State struct layout (None when the export has no State struct)
+    state: StateLayout | None = None
+
 
 class GenExportParser:
     """Parser for gen~ exported code directories."""
@@ -102,6 +123,15 @@ class GenExportParser:
     # Prefixes for genlib-internal members (not user buffers)
     INTERNAL_MEMBER_PREFIXES = ("m_delay", "__m_")
 
+    # Patterns for the State struct: typedef struct State { ... } State;
+    STATE_PATTERN = re.compile(
+        r"typedef\s+struct\s+State\s*\{(.*?)\}\s*State\s*;", re.DOTALL
+    )
+    STATE_MEMBER_PATTERN = re.compile(
+        r"^\s*(\w+)\s+(\w+(?:\s*,\s*\w+)*)\s*;", re.MULTILINE
+    )
+    STATE_RESET_PATTERN = re.compile(r"\b(\w+)\.reset\(\s*\"([^\"]*)\"\s*,(.*?)\)\s*;")
+
     def __init__(self, export_path: str | Path):
         """
         Initialize parser with path to gen~ export directory.
@@ -152,6 +182,9 @@ class GenExportParser:
         # Detect buffers
         info.buffers = self._detect_buffers(cpp_content)
 
+        # State struct layout
+        info.state = self._extract_state(cpp_content)
+
         # Check for exp2f issue in genlib_ops.h
         info.genlib_ops_path, info.has_exp2f_issue = self._check_exp2f_issue()
 
@@ -284,6 +317,41 @@ class GenExportParser:
 
         return sorted(candidates)
 
+    def _extract_state(self, content: str) -> StateLayout | None:
+        """
+        Extract the State struct layout.
+
+        Members are the declarations before the first ``inline`` method;
+        allocations are the ``member.reset("label", dims...)`` calls; the
+        per-sample loop is the ``while ((__n--))`` block inside perform().
+
+        Returns:
+            StateLayout, or None if there is no State struct.
+        """
+        match = self.STATE_PATTERN.search(content)
+        if not match:
+            return None
+        body = match.group(1)
+        layout = StateLayout()
+
+        members_text = body.split("inline", 1)[0]
+        for mm in self.STATE_MEMBER_PATTERN.finditer(members_text):
+            for name in mm.group(2).split(","):
+                layout.members.append((mm.group(1), name.strip()))
+
+        for rm in self.STATE_RESET_PATTERN.finditer(body):
+            layout.allocations.append(
+                (rm.group(1), rm.group(2), _split_args(rm.group(3)))
+            )
+
+        perform_at = body.find("inline int perform(")
+        perform = _extract_block(body, perform_at) if perform_at >= 0 else ""
+        loop_at = perform.find("while ((__n--))")
+        if loop_at >= 0:
+            layout.perform_setup = perform[:loop_at]
+            layout.perform_loop = _extract_block(perform, loop_at)
+        return layout
+
     def _check_exp2f_issue(self) -> tuple[Optional[Path], bool]:
         """
         Check for exp2f issue in genlib_ops.h.
@@ -320,3 +388,39 @@ class GenExportParser:
                 invalid.append(name)
 
         return invalid
+
+
+def _split_args(text: str) -> list[str]:
+    """Split a C argument list at top-level commas."""
+    args: list[str] = []
+    depth = 0
+    cur = ""
+    for ch in text:
+        if ch == "(":
+            depth += 1
+        elif ch == ")":
+            depth -= 1
+        if ch == "," and depth == 0:
+            args.append(cur.strip())
+            cur = ""
+        else:
+            cur += ch
+    if cur.strip():
+        args.append(cur.strip())
+    return args
+
+
+def _extract_block(text: str, start: int) -> str:
+    """Return the brace-delimited block whose ``{`` is at or after *start*."""
+    open_at = text.find("{", start)
+    if open_at < 0:
+        return ""
+    depth = 0
+    for i in range(open_at, len(text)):
+        if text[i] == "{":
+            depth += 1
+        elif text[i] == "}":
+            depth -= 1
+            if depth == 0:
+                return text[open_at + 1 : i]
+    return text[open_at + 1 :]
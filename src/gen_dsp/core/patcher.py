@@ -3,14 +3,315 @@ Platform-specific patches for gen~ exports.
 
 Handles issues like:
 - exp2f -> exp2 for macOS compatibility
+
+Also provides an opt-in performance patch set (see PERF_PATCHES) that
+rewrites call sites inside the exported perform() routine into cheaper
+equivalents where the semantics allow, and gives genlib's allocator a
+huge-page, prefaulted path for large delay and data memory.
 """
 
+import math
 import re
 from pathlib import Path
-from typing import Optional
+from typing import TYPE_CHECKING, Optional
 
 from gen_dsp.errors import PatchError
 
+if TYPE_CHECKING:
+    from collections.abc import Callable
+
+# Opt-in performance patches, in the order they are applied
+PERF_PATCHES: dict[str, str] = {
+    "ftz_denormals": "flush denormals in hardware instead of per-sample fixdenorm()",
+    "safediv_nonzero": "plain division when the divisor is a nonzero literal or samplerate",
+    "safepow_literal": "exp() for constant positive bases, x*x for squares",
+    "float_literals": "evaluate double literals at t_sample precision",
+    "large_pages": "huge-page backed, prefaulted memory for large delays and data",
+}
+
+# Patches applied to gen_dsp/genlib.cpp rather than to perform()
+_GENLIB_PATCHES = ("large_pages",)
+
+PERF_PATCH_MARKER = "// gen-dsp perf patch: "
+
+_PERFORM_PATTERN = re.compile(r"\binline\s+int\s+perform\s*\(")
+_NUMBER_PATTERN = re.compile(r"-?(?:\d+\.?\d*|\.\d+)(?:[eE][-+]?\d+)?")
+_CAST_PATTERN = re.compile(r"\(\s*(?:t_sample|t_param|double|float|int)\s*\)")
+_IDENTIFIER_PATTERN = re.compile(r"[A-Za-z_]\w*")
+
+# Unsuffixed floating literals, skipping comments and strings (group 1)
+_FLOAT_LITERAL_PATTERN = re.compile(
+    r'(//[^\n]*|/\*.*?\*/|"(?:\\.|[^"\\])*")'
+    r"|(?<![\w.])((?:\d+\.\d*|\.\d+)(?:[eE][-+]?\d+)?|\d+[eE][-+]?\d+)(?![\w.])",
+    re.DOTALL,
+)
+_CAST_BEFORE_PATTERN = re.compile(
+    r"\(\s*(?:t_sample|t_param|double|float)\s*\)\s*-?\s*$"
+)
+
+# Hardware flush-to-zero for the duration of perform(). Injected into the
+# export's namespace, so it relies on compiler builtins rather than
+# <xmmintrin.h> (the export is #included inside the wrapper's namespace).
+# Where no FTZ control is available fixdenorm() is kept.
+_FTZ_SCOPE = """\
+#ifndef GEN_DSP_HAVE_FTZ
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__SSE__) \\
+	|| defined(__aarch64__) || (defined(__arm__) && defined(__VFP_FP__) && !defined(__SOFTFP__)))
+#define GEN_DSP_HAVE_FTZ 1
+#else
+#define GEN_DSP_HAVE_FTZ 0
+#endif
+#endif
+
+// Flushes denormals to zero (and denormal inputs, where supported) while
+// perform() runs, replacing per-sample fixdenorm() on feedback paths
+#if GEN_DSP_HAVE_FTZ
+#define GEN_DSP_FIXDENORM(x) (x)
+struct GenDspFtzScope {
+#if defined(__SSE__)
+	unsigned int saved;
+	GenDspFtzScope() : saved(__builtin_ia32_stmxcsr()) { __builtin_ia32_ldmxcsr(saved | 0x8040u); }
+	~GenDspFtzScope() { __builtin_ia32_ldmxcsr(saved); }
+#elif defined(__aarch64__)
+	unsigned long long saved;
+	GenDspFtzScope() {
+		__asm__ __volatile__("mrs %0, fpcr" : "=r"(saved));
+		__asm__ __volatile__("msr fpcr, %0" : : "r"(saved | (1ull << 24)));
+	}
+	~GenDspFtzScope() { __asm__ __volatile__("msr fpcr, %0" : : "r"(saved)); }
+#else
+	unsigned int saved;
+	GenDspFtzScope() {
+		__asm__ __volatile__("vmrs %0, fpscr" : "=r"(saved));
+		__asm__ __volatile__("vmsr fpscr, %0" : : "r"(saved | (1u << 24)));
+	}
+	~GenDspFtzScope() { __asm__ __volatile__("vmsr fpscr, %0" : : "r"(saved)); }
+#endif
+};
+#else
+#define GEN_DSP_FIXDENORM(x) fixdenorm(x)
+struct GenDspFtzScope {};
+#endif
+
+"""
+
+
+# Large-allocation path for genlib.cpp's sysmem_newptr(). genlib.cpp is
+# compiled as its own translation unit, so system headers are fine here.
+_LARGE_ALLOC = """\
+#ifndef GEN_DSP_LARGE_ALLOC
+#	if defined(__linux__) && !defined(GEN_NO_STDLIB)
+#		define GEN_DSP_LARGE_ALLOC 1
+#	else
+#		define GEN_DSP_LARGE_ALLOC 0
+#	endif
+#endif
+
+#if GEN_DSP_LARGE_ALLOC
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Allocations of at least GEN_DSP_LARGE_ALLOC_MIN bytes (big [delay] and
+// [data] memory) are aligned to 2 MB so transparent huge pages can back
+// them, and every page is faulted in here -- in create()/reset(), on the
+// host's setup thread -- instead of on the audio thread's first pass.
+#ifndef GEN_DSP_LARGE_ALLOC_MIN
+#	define GEN_DSP_LARGE_ALLOC_MIN (2 * 1024 * 1024)
+#endif
+#define GEN_DSP_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+static t_ptr gen_dsp_large_alloc(t_ptr_size size)
+{
+	void *p = 0;
+	if (posix_memalign(&p, GEN_DSP_HUGE_PAGE_SIZE, size) != 0)
+		return (t_ptr)malloc(size);
+
+	long page = sysconf(_SC_PAGESIZE);
+	if (page <= 0)
+		page = 4096;
+#ifdef MADV_HUGEPAGE
+	// A hint only: ignored when THP is disabled system-wide
+	madvise(p, (size + page - 1) & ~(t_ptr_size)(page - 1), MADV_HUGEPAGE);
+#endif
+	for (t_ptr_size i = 0; i < size; i += (t_ptr_size)page)
+		((volatile char *)p)[i] = 0;
+	return (t_ptr)p;
+}
+#endif
+
+"""
+
+_SYSMEM_NEWPTR = "t_ptr sysmem_newptr(t_ptr_size size)"
+_SYSMEM_NEWPTRCLEAR = "t_ptr sysmem_newptrclear(t_ptr_size size)"
+_MALLOC_SIZE = "(t_ptr)malloc(size)"
+
+
+def _matching_close(text: str, open_idx: int) -> int:
+    """Index of the bracket closing ``text[open_idx]``, or -1."""
+    opener = text[open_idx]
+    closer = {"(": ")", "{": "}", "[": "]"}[opener]
+    depth = 0
+    for i in range(open_idx, len(text)):
+        c = text[i]
+        if c == opener:
+            depth += 1
+        elif c == closer:
+            depth -= 1
+            if depth == 0:
+                return i
+    return -1
+
+
+def _split_args(text: str) -> list[str]:
+    """Split a call's argument text at top-level commas."""
+    args = []
+    depth = 0
+    start = 0
+    for i, c in enumerate(text):
+        if c in "([{":
+            depth += 1
+        elif c in ")]}":
+            depth -= 1
+        elif c == "," and depth == 0:
+            args.append(text[start:i])
+            start = i + 1
+    args.append(text[start:])
+    return [a.strip() for a in args]
+
+
+def _literal_value(expr: str) -> float | None:
+    """Numeric value of a (possibly parenthesised or cast) literal."""
+    expr = expr.strip()
+    while True:
+        if expr.startswith("(") and _matching_close(expr, 0) == len(expr) - 1:
+            expr = expr[1:-1].strip()
+            continue
+        cast = _CAST_PATTERN.match(expr)
+        if cast:
+            expr = expr[cast.end() :].strip()
+            continue
+        break
+    if not _NUMBER_PATTERN.fullmatch(expr):
+        return None
+    return float(expr)
+
+
+def _rewrite_calls(
+    text: str, name: str, rewrite: "Callable[[list[str]], str | None]"
+) -> tuple[str, int]:
+    """
+    Rewrite every ``name(...)`` call in text, innermost arguments first.
+
+    ``rewrite`` receives the (already rewritten) arguments and returns the
+    replacement expression, or None to keep the call.
+    """
+    pattern = re.compile(rf"\b{name}\s*\(")
+    out = []
+    count = 0
+    pos = 0
+    while True:
+        match = pattern.search(text, pos)
+        if not match:
+            break
+        open_idx = match.end() - 1
+        close_idx = _matching_close(text, open_idx)
+        if close_idx < 0:
+            break
+        args = []
+        for arg in _split_args(text[open_idx + 1 : close_idx]):
+            new_arg, n = _rewrite_calls(arg, name, rewrite)
+            args.append(new_arg)
+            count += n
+        replacement = rewrite(args)
+        out.append(text[pos : match.start()])
+        if replacement is not None:
+            out.append(replacement)
+            count += 1
+        else:
+            out.append(f"{name}({', '.join(args)})")
+        pos = close_idx + 1
+    out.append(text[pos:])
+    return "".join(out), count
+
+
+def _rewrite_safediv(args: list[str]) -> str | None:
+    if len(args) != 2:
+        return None
+    num, denom = args
+    value = _literal_value(denom)
+    if denom != "samplerate" and not value:
+        return None
+    return f"((t_sample)({num}) / (t_sample)({denom}))"
+
+
+def _rewrite_safepow(args: list[str]) -> str | None:
+    if len(args) != 2:
+        return None
+    base, exponent = args
+    value = _literal_value(base)
+    if value is not None and value > 0 and value != 1:
+        return f"fixnan(exp((t_sample)({exponent}) * (t_sample){math.log(value)!r}))"
+    if _IDENTIFIER_PATTERN.fullmatch(base) and _literal_value(exponent) == 2:
+        return f"fixnan({base} * {base})"
+    return None
+
+
+def _rewrite_large_alloc(text: str) -> tuple[str, int]:
+    """Route large sysmem_newptr()/sysmem_newptrclear() calls to the huge-page path."""
+    start = text.find(_SYSMEM_NEWPTR)
+    clear = text.find(_SYSMEM_NEWPTRCLEAR)
+    if start < 0 or clear < start:
+        return text, 0
+
+    def body_span(at: int) -> tuple[int, int]:
+        body_open = text.find("{", at)
+        return body_open + 1, _matching_close(text, body_open)
+
+    new_open, new_close = body_span(start)
+    clear_open, clear_close = body_span(clear)
+    new_body = text[new_open:new_close]
+    clear_body = text[clear_open:clear_close]
+    if f"return {_MALLOC_SIZE};" not in new_body or _MALLOC_SIZE not in clear_body:
+        return text, 0
+
+    new_body = new_body.replace(
+        f"\treturn {_MALLOC_SIZE};",
+        "#if GEN_DSP_LARGE_ALLOC\n"
+        "\tif (size >= GEN_DSP_LARGE_ALLOC_MIN)\n"
+        "\t\treturn gen_dsp_large_alloc(size);\n"
+        "#endif\n"
+        f"\treturn {_MALLOC_SIZE};",
+        1,
+    )
+    # sysmem_newptrclear() calls malloc() itself; send it through the same path
+    clear_body = clear_body.replace(_MALLOC_SIZE, "sysmem_newptr(size)", 1)
+    return (
+        text[:start]
+        + _LARGE_ALLOC
+        + text[start:new_open]
+        + new_body
+        + text[new_close:clear_open]
+        + clear_body
+        + text[clear_close:]
+    ), 1
+
+
+def _rewrite_float_literals(text: str) -> tuple[str, int]:
+    count = 0
+
+    def replace(match: "re.Match[str]") -> str:
+        nonlocal count
+        if match.group(1) is not None:
+            return match.group(0)
+        if _CAST_BEFORE_PATTERN.search(
+            text[max(0, match.start() - 16) : match.start()]
+        ):
+            return match.group(0)
+        count += 1
+        return f"((t_sample){match.group(2)})"
+
+    return _FLOAT_LITERAL_PATTERN.sub(replace, text), count
+
 
 class PatchResult:
     """Result of applying a patch."""
@@ -136,6 +437,174 @@ class Patcher:
         except OSError as e:
             raise PatchError(f"Failed to write patched file: {e}") from e
 
+    def find_export_sources(self) -> list[Path]:
+        """
+        Find the exported gen~ kernel sources (gen_exported.cpp etc.).
+
+        Returns:
+            Sorted list of .cpp files next to the gen_dsp/ genlib directory.
+        """
+        for base in (self.target_path, self.target_path / "gen"):
+            if (base / "gen_dsp").is_dir():
+                return sorted(base.glob("*.cpp"))
+        return []
+
+    def find_genlib_source(self) -> Path | None:
+        """Find the export's genlib.cpp (the allocator the genlib patches target)."""
+        for base in (self.target_path, self.target_path / "gen"):
+            path = base / "gen_dsp" / "genlib.cpp"
+            if path.is_file():
+                return path
+        return None
+
+    def apply_perf_patches(
+        self, names: list[str] | None = None, dry_run: bool = False
+    ) -> list[PatchResult]:
+        """
+        Apply opt-in performance patches to the exported kernel sources.
+
+        Only the body of the State::perform() routine is rewritten, except
+        for large_pages, which patches the allocator in gen_dsp/genlib.cpp.
+        Each patch leaves a marker comment in the file, so applying it
+        twice is a no-op.
+
+        Args:
+            names: Patches to apply (see PERF_PATCHES); None applies all.
+            dry_run: If True, don't modify files, just report what would be done.
+
+        Returns:
+            List of PatchResult objects, one per patch and source file.
+
+        Raises:
+            PatchError: If a patch name is unknown or a file cannot be written.
+        """
+        if names is None:
+            names = list(PERF_PATCHES)
+        unknown = [name for name in names if name not in PERF_PATCHES]
+        if unknown:
+            raise PatchError(
+                f"Unknown performance patch(es): {', '.join(unknown)}. "
+                f"Available: {', '.join(PERF_PATCHES)}"
+            )
+        # Apply in canonical order regardless of how they were requested
+        selected = [name for name in PERF_PATCHES if name in names]
+
+        perform_patches = [name for name in selected if name not in _GENLIB_PATCHES]
+        genlib_patches = [name for name in selected if name in _GENLIB_PATCHES]
+
+        targets = [(path, perform_patches) for path in self.find_export_sources()]
+        genlib = self.find_genlib_source()
+        if genlib is not None and genlib_patches:
+            targets.append((genlib, genlib_patches))
+
+        results = []
+        for path, patches in targets:
+            content = path.read_text(encoding="utf-8")
+            new_content = content
+            for name in patches:
+                new_content, result = self._apply_perf_patch(
+                    path, name, new_content, dry_run
+                )
+                results.append(result)
+
+            if not dry_run and new_content != content:
+                try:
+                    path.write_text(new_content, encoding="utf-8")
+                except OSError as e:
+                    raise PatchError(f"Failed to write patched file: {e}") from e
+
+        return results
+
+    def _apply_perf_patch(
+        self, path: Path, name: str, content: str, dry_run: bool
+    ) -> tuple[str, PatchResult]:
+        """Apply one performance patch to content; returns (new_content, result)."""
+        marker = f"{PERF_PATCH_MARKER}{name}\n"
+        if marker in content:
+            return content, PatchResult(
+                file_path=path,
+                patch_name=name,
+                applied=False,
+                message="Already applied",
+            )
+
+        if name in _GENLIB_PATCHES:
+            new_content, count = _rewrite_large_alloc(content)
+            if not count:
+                return content, PatchResult(
+                    file_path=path,
+                    patch_name=name,
+                    applied=False,
+                    message="No sysmem_newptr() allocator found",
+                )
+            return self._perf_patch_result(path, name, content, new_content, 1, dry_run)
+
+        match = _PERFORM_PATTERN.search(content)
+        body_open = content.find("{", match.end()) if match else -1
+        body_close = _matching_close(content, body_open) if body_open >= 0 else -1
+        if body_close < 0:
+            return content, PatchResult(
+                file_path=path,
+                patch_name=name,
+                applied=False,
+                message="No perform() routine found",
+            )
+
+        body = content[body_open + 1 : body_close]
+        prelude = content[: body_open + 1]
+        if name == "ftz_denormals":
+            body, count = _rewrite_calls(
+                body, "fixdenorm", lambda args: f"GEN_DSP_FIXDENORM({args[0]})"
+            )
+            state = prelude.rfind("typedef struct State")
+            if count and state >= 0:
+                body = "\n\t\tGenDspFtzScope gen_dsp_ftz_scope;" + body
+                prelude = prelude[:state] + _FTZ_SCOPE + prelude[state:]
+            else:
+                count = 0
+        elif name == "safediv_nonzero":
+            body, count = _rewrite_calls(body, "safediv", _rewrite_safediv)
+        elif name == "safepow_literal":
+            body, count = _rewrite_calls(body, "safepow", _rewrite_safepow)
+        else:
+            body, count = _rewrite_float_literals(body)
+
+        if not count:
+            return content, PatchResult(
+                file_path=path,
+                patch_name=name,
+                applied=False,
+                message="No matching call sites",
+            )
+
+        new_content = prelude + body + content[body_close:]
+        return self._perf_patch_result(path, name, content, new_content, count, dry_run)
+
+    @staticmethod
+    def _perf_patch_result(
+        path: Path,
+        name: str,
+        content: str,
+        new_content: str,
+        count: int,
+        dry_run: bool,
+    ) -> tuple[str, PatchResult]:
+        """Add the patch marker after any existing ones and build the result."""
+        markers_end = 0
+        while new_content.startswith(PERF_PATCH_MARKER, markers_end):
+            markers_end = new_content.index("\n", markers_end) + 1
+        marker = f"{PERF_PATCH_MARKER}{name}\n"
+        new_content = new_content[:markers_end] + marker + new_content[markers_end:]
+        message = f"Rewrote {count} site(s): {PERF_PATCHES[name]}"
+        return new_content, PatchResult(
+            file_path=path,
+            patch_name=name,
+            applied=not dry_run,
+            message=f"Would rewrite {count} site(s) (dry run)" if dry_run else message,
+            original_content=content,
+            new_content=new_content,
+        )
+
     def check_patches_needed(self) -> dict[str, bool]:
         """
         Check which patches are needed without applying them.
@@ -0,0 +1,336 @@
+"""
+Profile-guided optimisation builds (``gen-dsp build --pgo``).
+
+A PGO build runs in three steps against the project's own build system:
+
+1. **generate** -- build ``gen_dsp_pgo_train``, the shared training driver
+   linked against an instrumented copy of the kernel objects (the
+   project's ``_ext_<platform>.cpp`` with the gen~ export compiled in,
+   plus genlib).
+2. **train** -- run it offline over a fixed, seeded workload (noise, a
+   sine sweep, impulses and silence, with every parameter swept and
+   randomly jumped); Clang ``.profraw`` files are merged into
+   ``default.profdata`` with ``llvm-profdata``.
+3. **use** -- rebuild the plugin with the profile.
+
+Profiles are cached per export under ``<cache>/gen-dsp/pgo/<key>/``. The
+key hashes the exported sources, the platform, the training workload and
+the compiler, so rebuilding an unchanged export skips steps 1 and 2.
+GCC names its profile files after absolute object paths, so for GCC the
+project directory is part of the key as well.
+
+CMake projects switch phases with ``-DGEN_DSP_PGO=generate|use`` (see
+``gen_dsp_pgo.cmake``); Make projects take ``PGO_FLAGS`` and a
+``pgo-train`` target.
+"""
+
+import hashlib
+import os
+import shutil
+import subprocess
+from dataclasses import dataclass
+from pathlib import Path
+from typing import TYPE_CHECKING
+
+from gen_dsp.core.builder import BuildResult
+from gen_dsp.core.cache import get_pgo_cache_dir
+from gen_dsp.errors import BuildError
+
+if TYPE_CHECKING:
+    from gen_dsp.platforms.base import Platform
+
+TRAINER_SOURCE = "gen_dsp_pgo_train.cpp"
+TRAINER_NAME = "gen_dsp_pgo_train"
+
+# Bump when the training driver or the flags change meaning, so stale
+# cached profiles are not reused
+PGO_CACHE_VERSION = 1
+
+
+@dataclass(frozen=True)
+class PgoWorkload:
+    """Training schedule passed to gen_dsp_pgo_train."""
+
+    blocks: int = 4000
+    block_size: int = 64
+    sample_rate: float = 48000.0
+    seed: int = 1
+
+    def args(self) -> list[str]:
+        return [
+            "--blocks",
+            str(self.blocks),
+            "--block-size",
+            str(self.block_size),
+            "--sr",
+            str(self.sample_rate),
+            "--seed",
+            str(self.seed),
+        ]
+
+
+def _compiler_version(compiler: str) -> str:
+    """First line of ``<compiler> --version`` (empty if it cannot run)."""
+    try:
+        result = subprocess.run(
+            [compiler, "--version"],
+            capture_output=True,
+            text=True,
+            timeout=30,
+            check=False,
+        )
+    except (OSError, subprocess.TimeoutExpired):
+        return ""
+    lines = result.stdout.strip().splitlines()
+    return lines[0] if lines else ""
+
+
+def _cxx() -> str:
+    return os.environ.get("CXX", "c++")
+
+
+def is_clang(compiler_version: str) -> bool:
+    return "clang" in compiler_version.lower()
+
+
+def make_pgo_flags(phase: str, profile_dir: Path, clang: bool) -> str:
+    """``PGO_FLAGS`` for Make projects; mirrors gen_dsp_pgo.cmake."""
+    if phase == "generate":
+        return f"-fprofile-generate={profile_dir}"
+    if clang:
+        return (
+            f"-fprofile-use={profile_dir / 'default.profdata'} "
+            "-Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date"
+        )
+    return f"-fprofile-use={profile_dir} -fprofile-correction -Wno-missing-profile"
+
+
+def profile_cache_key(
+    project_dir: Path,
+    platform_name: str,
+    workload: PgoWorkload,
+    compiler_version: str,
+) -> str:
+    """Hash of everything the trained profile depends on."""
+    h = hashlib.sha256()
+    h.update(f"v{PGO_CACHE_VERSION}\0{platform_name}\0{workload}\0".encode())
+    h.update(compiler_version.encode())
+    if not is_clang(compiler_version):
+        h.update(str(project_dir.resolve()).encode())
+    sources = sorted((project_dir / "gen").rglob("*.[ch]*"))
+    sources += sorted(project_dir.glob("_ext*.cpp"))
+    sources.append(project_dir / TRAINER_SOURCE)
+    for path in sources:
+        if path.is_file():
+            h.update(path.relative_to(project_dir).as_posix().encode())
+            h.update(path.read_bytes())
+    return h.hexdigest()[:16]
+
+
+def _find_llvm_profdata() -> list[str] | None:
+    tool = shutil.which("llvm-profdata")
+    if tool:
+        return [tool]
+    if shutil.which("xcrun"):
+        return ["xcrun", "llvm-profdata"]
+    for version in range(30, 9, -1):
+        tool = shutil.which(f"llvm-profdata-{version}")
+        if tool:
+            return [tool]
+    return None
+
+
+class PgoBuilder:
+    """Run the generate / train / use cycle for one project."""
+
+    def __init__(
+        self,
+        platform_impl: "Platform",
+        project_dir: Path,
+        workload: PgoWorkload | None = None,
+        use_cache: bool = True,
+    ):
+        if not platform_impl.supports_pgo:
+            raise BuildError(
+                f"--pgo is not supported for platform '{platform_impl.name}'"
+            )
+        if not (project_dir / TRAINER_SOURCE).exists():
+            raise BuildError(
+                f"{TRAINER_SOURCE} not found in {project_dir}; "
+                "regenerate the project to enable --pgo"
+            )
+        self.platform = platform_impl
+        self.project_dir = project_dir
+        self.workload = workload or PgoWorkload()
+        self.use_cache = use_cache
+        self.cmake = (project_dir / "CMakeLists.txt").exists()
+        self.build_dir = project_dir / "build"
+        self.profile_dir = self.build_dir / "pgo"
+        self.compiler_version = _compiler_version(_cxx())
+        self.log: list[str] = []
+
+    def build(self, clean: bool = False, verbose: bool = False) -> BuildResult:
+        """Build with a trained (or cached) profile."""
+        if clean:
+            self.platform.clean(self.project_dir)
+
+        key = profile_cache_key(
+            self.project_dir, self.platform.name, self.workload, self.compiler_version
+        )
+        cached = get_pgo_cache_dir() / key
+
+        if self.use_cache and cached.is_dir():
+            self._restore(cached)
+            self.log.append(f"Using cached profile {key}\n")
+        else:
+            failed = self._train(verbose)
+            if failed is not None:
+                return failed
+            if self.use_cache:
+                self._store(cached)
+
+        return self._final_build(verbose)
+
+    # -- phases ---------------------------------------------------------------
+
+    def _train(self, verbose: bool) -> BuildResult | None:
+        """Build and run the instrumented trainer; None on success."""
+        if self.profile_dir.exists():
+            shutil.rmtree(self.profile_dir)
+        self.profile_dir.mkdir(parents=True)
+
+        if self.cmake:
+            result = self._cmake_configure("generate", verbose)
+            if result.returncode != 0:
+                return self._failed(result)
+            result = self._run(
+                ["cmake", "--build", ".", "--target", TRAINER_NAME],
+                self.build_dir,
+                verbose,
+            )
+            trainer = self.build_dir / TRAINER_NAME
+        else:
+            self._remove_objects()
+            result = self._run(
+                ["make", self._make_flags("generate"), "pgo-train"],
+                self.project_dir,
+                verbose,
+            )
+            trainer = self.project_dir / TRAINER_NAME
+        if result.returncode != 0:
+            return self._failed(result)
+
+        if not trainer.exists() and trainer.with_suffix(".exe").exists():
+            trainer = trainer.with_suffix(".exe")
+        result = self._run(
+            [str(trainer), *self.workload.args()], self.build_dir, verbose
+        )
+        if result.returncode != 0:
+            return self._failed(result)
+
+        raw = sorted(self.profile_dir.rglob("*.profraw"))
+        if raw:
+            profdata = _find_llvm_profdata()
+            if profdata is None:
+                raise BuildError(
+                    "llvm-profdata not found; needed to merge Clang profiles"
+                )
+            result = self._run(
+                [
+                    *profdata,
+                    "merge",
+                    "-o",
+                    str(self.profile_dir / "default.profdata"),
+                    *map(str, raw),
+                ],
+                self.project_dir,
+                verbose,
+            )
+            if result.returncode != 0:
+                return self._failed(result)
+            for path in raw:
+                path.unlink()
+        elif not any(self.profile_dir.rglob("*.gcda")):
+            raise BuildError(
+                f"training run wrote no profile data to {self.profile_dir}"
+            )
+        return None
+
+    def _final_build(self, verbose: bool) -> BuildResult:
+        if self.cmake:
+            result = self._cmake_configure("use", verbose)
+            if result.returncode == 0:
+                result = self._run(["cmake", "--build", "."], self.build_dir, verbose)
+        else:
+            self._remove_objects()
+            result = self._run(
+                ["make", self._make_flags("use"), "all"], self.project_dir, verbose
+            )
+
+        return BuildResult(
+            success=result.returncode == 0,
+            platform=self.platform.name,
+            output_file=self.platform.find_output(self.project_dir),
+            stdout="".join(self.log),
+            stderr=result.stderr,
+            return_code=result.returncode,
+        )
+
+    # -- helpers --------------------------------------------------------------
+
+    def _cmake_configure(
+        self, phase: str, verbose: bool
+    ) -> subprocess.CompletedProcess[str]:
+        self.build_dir.mkdir(exist_ok=True)
+        return self._run(
+            [
+                "cmake",
+                "..",
+                "-DCMAKE_BUILD_TYPE=Release",
+                f"-DGEN_DSP_PGO={phase}",
+                f"-DGEN_DSP_PGO_DIR={self.profile_dir.resolve()}",
+            ],
+            self.build_dir,
+            verbose,
+        )
+
+    def _make_flags(self, phase: str) -> str:
+        flags = make_pgo_flags(
+            phase, self.profile_dir.resolve(), is_clang(self.compiler_version)
+        )
+        return f"PGO_FLAGS={flags}"
+
+    def _remove_objects(self) -> None:
+        """Force a Make rebuild with new flags (profile files are kept)."""
+        for obj in self.project_dir.rglob("*.o"):
+            if "pd-lib-builder" not in obj.parts:
+                obj.unlink()
+
+    def _restore(self, cached: Path) -> None:
+        if self.profile_dir.exists():
+            shutil.rmtree(self.profile_dir)
+        shutil.copytree(cached, self.profile_dir)
+
+    def _store(self, cached: Path) -> None:
+        if cached.exists():
+            shutil.rmtree(cached)
+        cached.parent.mkdir(parents=True, exist_ok=True)
+        shutil.copytree(self.profile_dir, cached)
+
+    def _run(
+        self, cmd: list[str], cwd: Path, verbose: bool
+    ) -> subprocess.CompletedProcess[str]:
+        cwd.mkdir(parents=True, exist_ok=True)
+        result = self.platform.run_command(cmd, cwd, verbose=verbose)
+        self.log.append(result.stdout)
+        return result
+
+    def _failed(self, result: subprocess.CompletedProcess[str]) -> BuildResult:
+        return BuildResult(
+            success=False,
+            platform=self.platform.name,
+            output_file=None,
+            stdout="".join(self.log),
+            stderr=result.stderr,
+            return_code=result.returncode,
+        )
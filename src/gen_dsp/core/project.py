@@ -39,6 +39,10 @@ class ProjectConfig:
     # Whether to apply patches automatically
     apply_patches: bool = True
 
+    # Opt-in performance patches for the gen~ export (see core.patcher).
+    # None = don't apply, [] = apply all, ["name", ...] = apply named subset
+    perf_patches: Optional[list[str]] = None
+
     # Output directory (if None, use current directory)
     output_dir: Optional[Path] = None
 
@@ -103,6 +107,17 @@ class ProjectConfig:
             if not re.match(r"^[a-zA-Z_][a-zA-Z0-9_]*$", buf_name):
                 errors.append(f"Buffer name '{buf_name}' is not a valid C identifier.")
 
+        # Validate performance patch names
+        if self.perf_patches:
+            from gen_dsp.core.patcher import PERF_PATCHES
+
+            for patch_name in self.perf_patches:
+                if patch_name not in PERF_PATCHES:
+                    errors.append(
+                        f"Unknown performance patch '{patch_name}'. "
+                        f"Valid patches: {', '.join(PERF_PATCHES)}"
+                    )
+
         # Validate Daisy board name
         if self.board is not None and self.platform == "daisy":
             from gen_dsp.platforms.daisy import DAISY_BOARDS
@@ -273,6 +288,11 @@ class ProjectGenerator:
             patcher = Patcher(output_dir)
             patcher.apply_exp2f_fix()
 
+        if self.config.perf_patches is not None:
+            from gen_dsp.core.patcher import Patcher
+
+            Patcher(output_dir).apply_perf_patches(self.config.perf_patches or None)
+
         return output_dir
 
     def _generate_from_graph(self, output_dir: Path) -> Path:
@@ -332,6 +352,7 @@ class ProjectGenerator:
         from gen_dsp.platforms import get_platform
 
         get_platform(platform).copy_voice_alloc_header(output_dir, self.config)
+        get_platform(platform).copy_simd_header(output_dir)
 
         # 6. Copy platform-specific buffer header if exists
         import gen_dsp.templates as templates
@@ -51,15 +51,20 @@ try:
         DelayWrite,
         Delta,
         Elapsed,
+        FDN,
+        FIR,
         Fold,
         GateOut,
         GateRoute,
+        Granulator,
         Graph,
         History,
         Latch,
         Lookup,
         Mix,
+        MovingAverage,
         MulAccum,
+        MultiTapRead,
         NamedConstant,
         Node,
         Noise,
@@ -71,6 +76,7 @@ try:
         PulseOsc,
         RateDiv,
         Ref,
+        Resample,
         SampleHold,
         SampleRate,
         SawOsc,
@@ -85,7 +91,11 @@ try:
         Subgraph,
         TriOsc,
         UnaryOp,
+        Undersample,
         Wave,
+        WavetableOsc,
+        WindowMax,
+        WindowMin,
         Wrap,
     )
     from gen_dsp.graph.optimize import (
@@ -94,11 +104,12 @@ try:
         constant_fold,
         eliminate_cse,
         eliminate_dead_nodes,
+        infer_ranges,
         optimize_graph,
         promote_control_rate,
     )
     from gen_dsp.graph.subgraph import expand_subgraphs
-    from gen_dsp.graph.toposort import toposort
+    from gen_dsp.graph.toposort import max_live, schedule, toposort
     from gen_dsp.graph.validate import GraphValidationError, validate_graph
     from gen_dsp.graph.visualize import graph_to_dot, graph_to_dot_file
     from gen_dsp.graph.serialize import graph_to_gdsp
@@ -151,6 +162,8 @@ __all__ = [
     "DelayWrite",
     "Delta",
     "Elapsed",
+    "FDN",
+    "FIR",
     "Fold",
     "GateOut",
     "GateRoute",
@@ -160,7 +173,9 @@ __all__ = [
     "Latch",
     "Lookup",
     "Mix",
+    "MovingAverage",
     "MulAccum",
+    "MultiTapRead",
     "NamedConstant",
     "Node",
     "Noise",
@@ -172,6 +187,8 @@ __all__ = [
     "PulseOsc",
     "RateDiv",
     "Ref",
+    "Resample",
+    "Granulator",
     "SVF",
     "SampleHold",
     "SampleRate",
@@ -187,7 +204,11 @@ __all__ = [
     "Subgraph",
     "TriOsc",
     "UnaryOp",
+    "Undersample",
     "Wave",
+    "WavetableOsc",
+    "WindowMax",
+    "WindowMin",
     "Wrap",
     "GDSPCompileError",
     "GDSPSyntaxError",
@@ -210,10 +231,13 @@ __all__ = [
     "graph_to_dot",
     "graph_to_dot_file",
     "graph_to_gdsp",
+    "infer_ranges",
+    "max_live",
     "OptimizeResult",
     "OptimizeStats",
     "optimize_graph",
     "promote_control_rate",
+    "schedule",
     "toposort",
     "validate_graph",
 ]
@@ -4,7 +4,7 @@ from __future__ import annotations
 
 from collections import defaultdict
 
-from gen_dsp.graph.models import Graph, History
+from gen_dsp.graph.models import Graph, History, Subgraph
 
 
 def is_feedback_edge(node: object, field_name: str) -> bool:
@@ -22,20 +22,32 @@ def build_forward_deps(graph: Graph) -> dict[str, set[str]]:
     """Build forward dependency map: {node_id: set of node_ids it depends on}.
 
     Excludes feedback edges (History.input) and non-node references
-    (audio inputs, param names).
+    (audio inputs, param names). Unexpanded Subgraph nodes (kept for
+    outlined compilation) contribute their input/param refs, and compound
+    ``{sg}__{output}`` refs resolve to the Subgraph node.
     """
     node_ids = {node.id for node in graph.nodes}
+    compound = {
+        f"{node.id}__{out.id}": node.id
+        for node in graph.nodes
+        if isinstance(node, Subgraph)
+        for out in node.graph.outputs
+    }
     deps: dict[str, set[str]] = defaultdict(set)
     for node in graph.nodes:
         nid = node.id
         for field_name, value in node.__dict__.items():
-            if field_name in ("id", "op"):
+            if field_name in ("id", "op", "output"):
                 continue
-            if isinstance(value, list):
-                for item in value:
-                    if isinstance(item, str) and item in node_ids:
-                        deps[nid].add(item)
-            elif isinstance(value, str) and value in node_ids:
-                if not is_feedback_edge(node, field_name):
+            if isinstance(value, list | dict):
+                items = value.values() if isinstance(value, dict) else value
+                for item in items:
+                    if isinstance(item, str):
+                        item = compound.get(item, item)
+                        if item in node_ids:
+                            deps[nid].add(item)
+            elif isinstance(value, str):
+                value = compound.get(value, value)
+                if value in node_ids and not is_feedback_edge(node, field_name):
                     deps[nid].add(value)
     return deps
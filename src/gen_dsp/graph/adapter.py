@@ -35,6 +35,7 @@ _PLATFORM_INFO: dict[str, tuple[str, str]] = {
     "standalone": ("STANDALONE_EXT_NAME", "_standalone"),
     "csound": ("CSOUND_EXT_NAME", "_csound"),
     "auv3": ("AUV3_EXT_NAME", "_auv3"),
+    "lib": ("LIB_EXT_NAME", "_lib"),
 }
 
 SUPPORTED_PLATFORMS = set(_PLATFORM_INFO.keys())
@@ -167,6 +168,12 @@ def generate_adapter_cpp(graph: Graph, platform: str) -> str:
     w(f"    {name}_set_param(({struct}*)state, index, (float)value);")
     w("}")
     w("")
+    w(
+        f"void wrapper_set_param_ramp(GenState* state, int index, {st} value, int nsamples) {{"
+    )
+    w(f"    {name}_set_param_ramp(({struct}*)state, index, (float)value, nsamples);")
+    w("}")
+    w("")
     w(f"{st} wrapper_get_param(GenState* state, int index) {{")
     w(f"    return ({st}){name}_get_param(({struct}*)state, index);")
     w("}")
@@ -335,6 +342,7 @@ def generate_graph_build_file(
         "lv2": _cmake_lv2,
         "sc": _cmake_sc,
         "max": _cmake_max,
+        "lib": _cmake_lib,
         "pd": _makefile_pd,
         "chuck": _makefile_chuck,
         "vcvrack": _makefile_vcvrack,
@@ -883,6 +891,96 @@ include(${{CMAKE_CURRENT_SOURCE_DIR}}/max-sdk-base/script/max-posttarget.cmake)
     return path
 
 
+def _cmake_lib(**kwargs: object) -> Path:
+    from gen_dsp.platforms.lib import LIB_API_VERSION, generate_lib_header
+
+    output_dir = kwargs["output_dir"]
+    assert isinstance(output_dir, Path)
+    lib_name = str(kwargs["lib_name"])
+    gen_name = str(kwargs["gen_name"])
+    genext_version = str(kwargs["genext_version"])
+
+    generate_lib_header(output_dir, lib_name, genext_version)
+
+    content = f"""\
+cmake_minimum_required(VERSION 3.19)
+
+# Shared library for {lib_name}
+# Generated by gen-dsp (dsp-graph source)
+
+set(PROJECT_NAME {lib_name})
+project(${{PROJECT_NAME}} VERSION {genext_version} LANGUAGES C CXX)
+
+set(CMAKE_CXX_STANDARD 17)
+set(CMAKE_CXX_STANDARD_REQUIRED ON)
+
+include(GNUInstallDirs)
+
+set(GENDSP_LIB_TARGET gendsp_{lib_name})
+
+add_library(${{GENDSP_LIB_TARGET}} SHARED
+    gen_ext_lib.cpp
+    _ext_lib.cpp
+)
+
+target_include_directories(${{GENDSP_LIB_TARGET}}
+    PRIVATE
+        "${{CMAKE_CURRENT_SOURCE_DIR}}"
+    PUBLIC
+        "$<BUILD_INTERFACE:${{CMAKE_CURRENT_SOURCE_DIR}}/include>"
+        "$<INSTALL_INTERFACE:${{CMAKE_INSTALL_INCLUDEDIR}}>"
+)
+
+target_compile_definitions(${{GENDSP_LIB_TARGET}} PRIVATE
+    GENLIB_USE_FLOAT32
+    GEN_EXT_VERSION="{genext_version}"
+    LIB_EXT_NAME={lib_name}
+    GEN_EXPORTED_NAME={gen_name}
+    GEN_EXPORTED_HEADER="{gen_name}.h"
+    GEN_EXPORTED_CPP="{gen_name}.cpp"
+    GENDSP_LIB_HEADER="gendsp_{lib_name}.h"
+    GENDSP_{lib_name.upper()}_BUILDING
+)
+
+target_compile_options(${{GENDSP_LIB_TARGET}} PRIVATE -Wno-unused-function -Wno-unused-variable)
+
+set_target_properties(${{GENDSP_LIB_TARGET}} PROPERTIES
+    C_VISIBILITY_PRESET hidden
+    CXX_VISIBILITY_PRESET hidden
+    VISIBILITY_INLINES_HIDDEN ON
+    POSITION_INDEPENDENT_CODE ON
+    VERSION {LIB_API_VERSION}.0.0
+    SOVERSION {LIB_API_VERSION}
+    PUBLIC_HEADER "include/gendsp_{lib_name}.h"
+)
+
+if(APPLE)
+    target_link_options(${{GENDSP_LIB_TARGET}} PRIVATE "LINKER:-exported_symbol,_gendsp_*")
+elseif(UNIX)
+    file(WRITE "${{CMAKE_CURRENT_BINARY_DIR}}/gendsp.map" "{{ global: gendsp_*; local: *; }};\\n")
+    target_link_options(${{GENDSP_LIB_TARGET}} PRIVATE
+        "LINKER:--version-script=${{CMAKE_CURRENT_BINARY_DIR}}/gendsp.map")
+endif()
+
+file(RELATIVE_PATH GENDSP_PC_RELPREFIX
+    "${{CMAKE_INSTALL_FULL_LIBDIR}}/pkgconfig" "${{CMAKE_INSTALL_PREFIX}}")
+configure_file(gendsp.pc.in "${{CMAKE_CURRENT_BINARY_DIR}}/${{GENDSP_LIB_TARGET}}.pc" @ONLY)
+
+install(TARGETS ${{GENDSP_LIB_TARGET}}
+    LIBRARY DESTINATION "${{CMAKE_INSTALL_LIBDIR}}"
+    ARCHIVE DESTINATION "${{CMAKE_INSTALL_LIBDIR}}"
+    RUNTIME DESTINATION "${{CMAKE_INSTALL_BINDIR}}"
+    PUBLIC_HEADER DESTINATION "${{CMAKE_INSTALL_INCLUDEDIR}}"
+)
+install(FILES "${{CMAKE_CURRENT_BINARY_DIR}}/${{GENDSP_LIB_TARGET}}.pc"
+    DESTINATION "${{CMAKE_INSTALL_LIBDIR}}/pkgconfig"
+)
+"""
+    path = output_dir / "CMakeLists.txt"
+    path.write_text(content)
+    return path
+
+
 def _makefile_pd(**kwargs: object) -> Path:
     output_dir = kwargs["output_dir"]
     assert isinstance(output_dir, Path)
@@ -1525,6 +1623,12 @@ def _copy_platform_templates(output_dir: Path, platform: str) -> None:
             if src.is_file():
                 shutil.copy2(src, output_dir / fname)
 
+    elif platform == "lib":
+        # pkg-config file template (configured by CMake at build time)
+        src = tmpl_dir / "gendsp.pc.in"
+        if src.is_file():
+            shutil.copy2(src, output_dir / "gendsp.pc.in")
+
     elif platform == "circle":
         # C++ stdlib shims for bare-metal builds (Circle's -nostdinc++ strips them)
         for shim in ("cmath", "cstdlib", "cstdint", "cstring"):
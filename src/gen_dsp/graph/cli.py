@@ -14,7 +14,9 @@ from pathlib import Path
 
 from pydantic import ValidationError
 
+from gen_dsp.core.cost import add_cost_options, render_cost
 from gen_dsp.graph.compile import compile_graph, compile_graph_to_file
+from gen_dsp.graph.cost import graph_cost
 from gen_dsp.graph.models import Graph
 from gen_dsp.graph.optimize import optimize_graph
 from gen_dsp.graph.validate import validate_graph
@@ -163,10 +165,12 @@ def cmd_compile(args: argparse.Namespace) -> int:
         graph = _load_graph(args.file)
         if args.optimize:
             graph, _stats = optimize_graph(graph)
+        check = getattr(args, "check_ranges", False)
+        outline = getattr(args, "outline_subgraphs", False)
         if args.output:
-            compile_graph_to_file(graph, args.output)
+            compile_graph_to_file(graph, args.output, check, outline)
         else:
-            sys.stdout.write(compile_graph(graph))
+            sys.stdout.write(compile_graph(graph, check, outline))
         return 0
     except FileNotFoundError as e:
         print(f"error: {e}", file=sys.stderr)
@@ -379,6 +383,40 @@ def cmd_simulate(args: argparse.Namespace) -> int:
         return 1
 
 
+def cmd_cost(args: argparse.Namespace) -> int:
+    """Report a graph's memory footprint and estimated per-sample cost."""
+    try:
+        graph = _load_graph(args.file)
+        if args.optimize:
+            graph, _stats = optimize_graph(graph)
+        report = graph_cost(graph, args.block_size, args.sample_rate)
+    except FileNotFoundError as e:
+        print(f"error: {e}", file=sys.stderr)
+        return 1
+    except json.JSONDecodeError as e:
+        print(f"error: invalid JSON: {e}", file=sys.stderr)
+        return 1
+    except ValidationError as e:
+        print(f"error: invalid graph: {e}", file=sys.stderr)
+        return 1
+    except ValueError as e:
+        print(f"error: {e}", file=sys.stderr)
+        return 1
+    except _gdsp_errors() as e:
+        print(f"error: {e}", file=sys.stderr)
+        return 1
+
+    text, failures, warnings = render_cost(
+        report, args.target, args.json, args.max_memory, args.max_cpu
+    )
+    print(text)
+    for warning in warnings:
+        print(f"warning: {warning}", file=sys.stderr)
+    for failure in failures:
+        print(f"budget exceeded: {failure}", file=sys.stderr)
+    return 1 if failures else 0
+
+
 def _gdsp_errors() -> tuple[type[Exception], ...]:
     """Return GDSP error types for exception handling."""
     from gen_dsp.graph.dsl import GDSPCompileError, GDSPSyntaxError
@@ -401,6 +439,16 @@ def add_compile_parser(
     p.add_argument("file", help=_FILE_HELP)
     p.add_argument("-o", "--output", help="Output directory")
     p.add_argument("--optimize", action="store_true", help="Apply optimization passes")
+    p.add_argument(
+        "--check-ranges",
+        action="store_true",
+        help="Assert inferred value ranges in the generated code (debug)",
+    )
+    p.add_argument(
+        "--outline-subgraphs",
+        action="store_true",
+        help="Compile repeated subgraphs as shared functions instead of inlining",
+    )
 
 
 def add_validate_parser(
@@ -452,6 +500,21 @@ def add_sim_parser(
     p.add_argument("--optimize", action="store_true", help="Optimize before simulation")
 
 
+def add_cost_parser(
+    subparsers: argparse._SubParsersAction[argparse.ArgumentParser],
+) -> None:
+    """Add the 'cost' subcommand."""
+    p = subparsers.add_parser("cost", help="Estimate memory and CPU cost")
+    _add_cost_arguments(p)
+
+
+def _add_cost_arguments(p: argparse.ArgumentParser) -> None:
+    p.add_argument("file", help=_FILE_HELP)
+    p.add_argument("--optimize", action="store_true", help="Optimize before costing")
+    p.add_argument("--json", action="store_true", help="Output in JSON format")
+    add_cost_options(p, default_sample_rate=None)
+
+
 # ---------------------------------------------------------------------------
 # Standalone entry point (for testing)
 # ---------------------------------------------------------------------------
@@ -461,7 +524,7 @@ def main(argv: list[str] | None = None) -> int:
     """Standalone entry point for dsp-graph CLI (for testing)."""
     parser = argparse.ArgumentParser(
         prog="dsp-graph",
-        description="Compile, validate, visualize, and simulate DSP signal graphs.",
+        description="Compile, validate, visualize, simulate, and cost DSP signal graphs.",
     )
     sub = parser.add_subparsers(dest="command")
 
@@ -472,6 +535,16 @@ def main(argv: list[str] | None = None) -> int:
     p_compile.add_argument(
         "--optimize", action="store_true", help="Apply optimization passes"
     )
+    p_compile.add_argument(
+        "--check-ranges",
+        action="store_true",
+        help="Assert inferred value ranges in the generated code (debug)",
+    )
+    p_compile.add_argument(
+        "--outline-subgraphs",
+        action="store_true",
+        help="Compile repeated subgraphs as shared functions instead of inlining",
+    )
 
     # validate
     p_validate = sub.add_parser("validate", help="Validate graph")
@@ -512,6 +585,10 @@ def main(argv: list[str] | None = None) -> int:
         "--optimize", action="store_true", help="Optimize before simulation"
     )
 
+    # cost
+    p_cost = sub.add_parser("cost", help="Estimate memory and CPU cost")
+    _add_cost_arguments(p_cost)
+
     args = parser.parse_args(argv)
 
     if not args.command:
@@ -526,6 +603,8 @@ def main(argv: list[str] | None = None) -> int:
         return cmd_dot(args)
     elif args.command == "sim":
         return cmd_simulate(args)
+    elif args.command == "cost":
+        return cmd_cost(args)
 
     return 0  # pragma: no cover
 
@@ -5,9 +5,10 @@ from __future__ import annotations
 import math as _math
 import re
 from pathlib import Path
-from typing import Callable
+from typing import Callable, NamedTuple
 
 from gen_dsp.graph.models import (
+    NON_REF_FIELDS,
     SVF,
     ADSR,
     Accum,
@@ -30,15 +31,20 @@ from gen_dsp.graph.models import (
     DelayWrite,
     Delta,
     Elapsed,
+    FDN,
+    FIR,
     Fold,
     GateOut,
     GateRoute,
+    Granulator,
     Graph,
     History,
     Latch,
     Lookup,
     Mix,
+    MovingAverage,
     MulAccum,
+    MultiTapRead,
     NamedConstant,
     Node,
     Noise,
@@ -49,6 +55,7 @@ from gen_dsp.graph.models import (
     Phasor,
     PulseOsc,
     RateDiv,
+    Resample,
     SampleHold,
     SampleRate,
     SawOsc,
@@ -60,14 +67,44 @@ from gen_dsp.graph.models import (
     Smoothstep,
     SmoothParam,
     Splat,
+    Subgraph,
     TriOsc,
     UnaryOp,
+    Undersample,
     Wave,
+    WavetableOsc,
+    WindowMax,
+    WindowMin,
     Wrap,
 )
-from gen_dsp.graph.optimize import _STATEFUL_TYPES
+from gen_dsp.graph.optimize import (
+    _STATEFUL_TYPES,
+    UNBOUNDED,
+    Interval,
+    infer_ranges,
+    is_bounded,
+)
+from gen_dsp.graph._deps import build_forward_deps
 from gen_dsp.graph.subgraph import expand_subgraphs
-from gen_dsp.graph.toposort import toposort
+from gen_dsp.graph.tables import (
+    GRAIN_MAX_LEN,
+    GRAIN_MAX_WAIT,
+    GRAIN_WINDOW,
+    RESAMPLE_PHASES,
+    fdn_offsets,
+    grain_window,
+    mip_buffers,
+    mip_levels,
+    multitap_lanes,
+    multitap_table,
+    resample_kernel,
+    resample_ratios,
+    undersample_filter,
+    undersample_hist_len,
+    undersample_poly,
+    undersample_taps,
+)
+from gen_dsp.graph.toposort import schedule
 from gen_dsp.graph.validate import validate_graph
 
 _Writer = Callable[[str], None]
@@ -156,6 +193,164 @@ def _float_lit(v: float) -> str:
     return s + "f"
 
 
+def _float32_lit(v: float) -> str:
+    """Format a float32 value as the shortest-safe C literal (9 digits)."""
+    s = f"{v:.9g}"
+    if "." not in s and "e" not in s:
+        s += ".0"
+    return s + "f"
+
+
+class _Ranges(NamedTuple):
+    """Inferred value ranges consulted while emitting node code."""
+
+    values: dict[str, Interval]
+    sizes: dict[str, int]  # DelayLine / Buffer id -> fixed length
+    check: bool = False  # emit an assert per bounded node value
+    tables: frozenset[str] = frozenset()  # guard-padded Buffer ids
+    s16: frozenset[str] = frozenset()  # Buffer ids stored as int16
+
+    def of(self, ref: str | float) -> Interval:
+        if isinstance(ref, float):
+            return (ref, ref)
+        return self.values.get(ref, UNBOUNDED)
+
+
+def _within(iv: Interval, lo: float, hi: float) -> bool:
+    """True when *iv* is known to lie inside the closed range [lo, hi]."""
+    return is_bounded(iv) and lo <= iv[0] and iv[1] <= hi
+
+
+def _int_span(iv: Interval) -> tuple[int, int] | None:
+    """Range of ``(int)x`` for x in *iv* (truncation), or None if unknown."""
+    if not is_bounded(iv):
+        return None
+    return (_math.trunc(iv[0]), _math.trunc(iv[1]))
+
+
+# Standard headers every generated file opens with; inlined inner graphs
+# drop them but keep conditional SIMD includes (FIR dot product).
+_STD_INCLUDE = "#include <c"
+
+
+# Samples allocated past the end of a table Buffer. Guard k mirrors
+# sample k % len, so a linear read of i0 and i0 + 1 with i0 in [0, len]
+# (len only when the wrapped phase rounds up to 1.0) never wraps.
+_TABLE_GUARD = 2
+
+
+def _table_buffers(nodes: list[Node]) -> frozenset[str]:
+    """Buffers read as tables by Cycle, Wave, Lookup or Granulator (allocated with guards)."""
+    return frozenset(
+        n.buffer for n in nodes if isinstance(n, (Cycle, Wave, Lookup, Granulator))
+    )
+
+
+def _emit_table_guards(buf: str, size: int, indent: str, w: _Writer) -> None:
+    """Refresh the guard samples of table *buf* (a ``float*`` expression)."""
+    for k in range(_TABLE_GUARD):
+        w(f"{indent}{buf}[{size + k}] = {buf}[{k % size}];")
+
+
+def _emit_table_write_guard(nid: str, buf: str, size: int, w: _Writer) -> None:
+    """After a BufWrite/Splat into table *buf*, mirror the head into its guards."""
+    if size >= _TABLE_GUARD:
+        w(
+            f"            if ({nid}_idx < {_TABLE_GUARD}) {buf}_buf[{buf}_len + {nid}_idx] = {buf}_buf[{nid}_idx];"
+        )
+    else:
+        _emit_table_guards(f"{buf}_buf", size, "            ", w)
+
+
+def _buf_ctype(node: Buffer) -> str:
+    """C element type of a Buffer's storage."""
+    return "int16_t" if node.format == "int16" else "float"
+
+
+def _buf_load(buf: str, idx: str, ranges: _Ranges | None) -> str:
+    """Float expression for sample *idx* of *buf*, unscaled for int16 storage.
+
+    Interpolation is linear in the samples, so int16 reads interpolate the
+    raw integers and apply ``_buf_scaled`` once to the result.
+    """
+    sample = f"{buf}_buf[{idx}]"
+    if ranges is not None and buf in ranges.s16:
+        return f"(float){sample}"
+    return sample
+
+
+def _buf_scaled(buf: str, expr: str, ranges: _Ranges | None) -> str:
+    """Scale *expr* built from ``_buf_load`` values of *buf* to [-1, 1).
+
+    The 1/32768 scale is the inverse of ``{name}_to_s16``; as a power of
+    two it is exact, so scaling after interpolating equals scaling each
+    sample.
+    """
+    if ranges is not None and buf in ranges.s16:
+        return f"({expr}) * (1.0f / 32768.0f)"
+    return expr
+
+
+def _buf_store(name: str, val: str, s16: bool) -> str:
+    """Expression for storing float *val*, saturated when *s16*."""
+    return f"{name}_to_s16({val})" if s16 else val
+
+
+def _emit_s16_store(name: str, w: _Writer) -> None:
+    """Emit the saturating float -> int16 store used by int16 buffers.
+
+    The inverse of the 1/32768 read scale: NaN -> 0, scale by 32768,
+    saturate to [-32768, 32767] and round to nearest, so a value read from
+    an int16 buffer is stored back unchanged.
+    """
+    w(f"static inline int16_t {name}_to_s16(float x) {{")
+    w("    if (!(x == x)) x = 0.0f;")
+    w("    x *= 32768.0f;")
+    w("    x = x < 32767.0f ? x : 32767.0f;")
+    w("    x = x > -32768.0f ? x : -32768.0f;")
+    w("    return (int16_t)lrintf(x);")
+    w("}")
+
+
+def _mip_only_buffers(nodes: list[Node]) -> frozenset[str]:
+    """Mip buffers no node other than WavetableOsc reads in perform.
+
+    Their raw ``_buf``/``_len`` pointers would be unused locals there.
+    """
+    used: set[str] = set()
+    for n in nodes:
+        if isinstance(n, (Buffer, WavetableOsc)):
+            continue
+        for field_name, value in n.__dict__.items():
+            if field_name in NON_REF_FIELDS:
+                continue
+            if isinstance(value, str):
+                used.add(value)
+            elif isinstance(value, list):
+                used.update(v for v in value if isinstance(v, str))
+    return mip_buffers(nodes) - used
+
+
+def _is_pow2(n: int) -> bool:
+    """True when *n* is a positive power of two."""
+    return n > 0 and n & (n - 1) == 0
+
+
+def _emit_phase_advance(nid: str, freq: str, w: _Writer) -> None:
+    """Advance an oscillator phase and wrap it into [0, 1).
+
+    The single subtraction covers 0 <= freq < sr; any other frequency
+    (negative, above the rate, inf or NaN) takes the floorf path, so the
+    phase stays in [0, 1) whatever the frequency and sample rate.
+    """
+    w(f"        {nid}_phase += {freq} / sr;")
+    w(f"        if ({nid}_phase >= 1.0f) {nid}_phase -= 1.0f;")
+    w(f"        if (!({nid}_phase >= 0.0f && {nid}_phase < 1.0f)) {{")
+    w(f"            {nid}_phase -= floorf({nid}_phase);")
+    w(f"            if (!({nid}_phase < 1.0f)) {nid}_phase = 0.0f;")
+    w("        }")
+
+
 def _emit_ref(ref: str | float, input_ids: set[str], param_names: set[str]) -> str:
     """Emit a C expression for a Ref value."""
     if isinstance(ref, float):
@@ -166,16 +361,36 @@ def _emit_ref(ref: str | float, input_ids: set[str], param_names: set[str]) -> s
     return ref
 
 
-def compile_graph(graph: Graph) -> str:
+def compile_graph(
+    graph: Graph, check_ranges: bool = False, outline_subgraphs: bool = False
+) -> str:
     """Compile a DSP graph to standalone C++ source code.
 
+    Value ranges inferred by ``infer_ranges`` let the compiler drop clamps,
+    wraps and index guards that can never trigger. With *check_ranges*,
+    every bounded node value is ``assert``-ed against its inferred range
+    (a debug aid; compile without ``NDEBUG``).
+
+    With *outline_subgraphs*, a Subgraph used often enough to be worth it
+    (see ``_plan_outlining``) is compiled once to its own state struct and
+    perform function, and each instance calls it instead of inlining a
+    copy of the inner nodes. Output is identical to flattening.
+
     Raises ValueError if the graph is invalid or contains IDs that are
     not valid C identifiers.
     """
-    graph = expand_subgraphs(graph)
-    errors = validate_graph(graph)
+    flat = expand_subgraphs(graph)
+    errors = validate_graph(flat)
     if errors:
         raise ValueError("Invalid graph: " + "; ".join(errors))
+    outlined = _plan_outlining(graph) if outline_subgraphs else {}
+    if outlined:
+        nodes = [outlined.get(n.id, n) for n in graph.nodes]
+        graph = expand_subgraphs(
+            graph.model_copy(update={"nodes": nodes}), keep=outlined.keys()
+        )
+    else:
+        graph = flat
 
     # Validate all IDs are valid C identifiers
     all_ids: list[str] = []
@@ -187,10 +402,19 @@ def compile_graph(graph: Graph) -> str:
         if not _C_ID_RE.match(ident):
             raise ValueError(f"ID '{ident}' is not a valid C identifier")
 
-    sorted_nodes = toposort(graph)
+    sorted_nodes = schedule(graph)
     input_ids = {inp.id for inp in graph.inputs}
     param_names = {p.name for p in graph.params}
 
+    sizes = {n.id: n.max_samples for n in sorted_nodes if isinstance(n, DelayLine)}
+    sizes.update({n.id: n.size for n in sorted_nodes if isinstance(n, Buffer)})
+    tables = _table_buffers(sorted_nodes)
+    mips = mip_buffers(sorted_nodes)
+    s16 = frozenset(
+        n.id for n in sorted_nodes if isinstance(n, Buffer) and n.format == "int16"
+    )
+    ranges = _Ranges(infer_ranges(graph), sizes, check_ranges, tables, s16)
+
     name = graph.name
     pascal = _to_pascal(name)
     struct_name = pascal + "State"
@@ -199,21 +423,71 @@ def compile_graph(graph: Graph) -> str:
     w = lines.append
 
     # -- Includes
+    if check_ranges:
+        w("#include <cassert>")
     w("#include <cmath>")
     w("#include <cstdlib>")
     w("#include <cstdint>")
     w("#include <cstring>")
     w("")
 
+    # -- Saturating store for int16 buffers
+    if s16:
+        _emit_s16_store(name, w)
+        w("")
+
+    # -- Segment renderer for block-rate ADSR envelopes
+    if any(isinstance(n, ADSR) for n in sorted_nodes):
+        _emit_adsr_render(name, w)
+        w("")
+
+    # -- Mip pyramid builder for WavetableOsc tables
+    if mips:
+        _emit_mip_builder(name, w)
+        w("")
+
+    # -- Shared dot product for FIR filters and Resample kernels
+    if any(isinstance(n, (FIR, Resample)) for n in sorted_nodes):
+        _emit_fir_dot(name, w)
+        w("")
+    for taps in sorted({n.taps for n in sorted_nodes if isinstance(n, Resample)}):
+        kernel = resample_kernel(taps)
+        _emit_float_table(f"{name}_sinc{taps}", kernel, w, _float32_lit)
+        w("")
+
+    # -- Window table and grain renderer for Granulator nodes
+    if any(isinstance(n, Granulator) for n in sorted_nodes):
+        _emit_float_table(f"{name}_grain_win", grain_window(), w, _float32_lit)
+        w("")
+        _emit_grain_render(name, w)
+        w("")
+
+    # -- Undersampled inner graphs and their anti-alias filter tables
+    for node in sorted_nodes:
+        if isinstance(node, Undersample):
+            _emit_undersample_defs(node, name, w)
+
+    # -- Outlined subgraph functions (one per distinct inner graph)
+    emitted: set[str] = set()
+    for node in sorted_nodes:
+        if isinstance(node, Subgraph) and node.graph.name not in emitted:
+            emitted.add(node.graph.name)
+            _emit_outlined_defs(node, check_ranges, w)
+
     # -- Struct
     w(f"struct {struct_name} {{")
     w("    float sr;")
     # Params
     for p in graph.params:
         w(f"    float p_{p.name};")
+    # Param ramps (set_param_ramp)
+    for p in graph.params:
+        w(f"    float r_{p.name}_inc;")
+        w(f"    float r_{p.name}_target;")
+        w(f"    int r_{p.name}_left;")
     # State fields from nodes
     for node in sorted_nodes:
-        _emit_state_fields(node, w)
+        _emit_state_fields(node, w, name, mips)
     w("};")
     w("")
 
@@ -225,7 +499,7 @@ def compile_graph(graph: Graph) -> str:
     for p in graph.params:
         w(f"    self->p_{p.name} = {_float_lit(p.default)};")
     for node in sorted_nodes:
-        _emit_state_init(node, w)
+        _emit_state_init(node, w, name, tables, mips)
     w("    return self;")
     w("}")
     w("")
@@ -233,18 +507,32 @@ def compile_graph(graph: Graph) -> str:
     # -- destroy()
     w(f"void {name}_destroy({struct_name}* self) {{")
     for node in sorted_nodes:
-        if isinstance(node, (DelayLine, Buffer)):
+        if isinstance(node, (DelayLine, Buffer, FDN, MovingAverage)):
             w(f"    free(self->m_{node.id}_buf);")
+            if node.id in mips:
+                w(f"    free(self->m_{node.id}_mip);")
+        elif isinstance(node, FIR):
+            w(f"    free(self->m_{node.id}_hist);")
+        elif isinstance(node, (WindowMax, WindowMin)):
+            w(f"    free(self->m_{node.id}_val);")
+            w(f"    free(self->m_{node.id}_at);")
+        elif isinstance(node, Undersample):
+            inner = _undersample_inner_name(name, node.id)
+            w(f"    {inner}_destroy(self->m_{node.id}_inner);")
+        elif isinstance(node, Subgraph):
+            w(f"    {node.graph.name}_destroy(self->m_{node.id}_inner);")
     w("    free(self);")
     w("}")
     w("")
 
     # -- reset()
-    _emit_reset(graph, sorted_nodes, name, struct_name, w)
+    _emit_reset(graph, sorted_nodes, name, struct_name, w, tables, mips)
     w("")
 
     # -- perform()
-    _emit_perform(graph, sorted_nodes, input_ids, param_names, name, struct_name, w)
+    _emit_perform(
+        graph, sorted_nodes, input_ids, param_names, name, struct_name, w, ranges=ranges
+    )
     w("")
 
     # -- Introspection
@@ -266,27 +554,38 @@ def compile_graph(graph: Graph) -> str:
     # -- set_param / get_param
     _emit_param_set(graph.params, name, struct_name, w)
     w("")
+    _emit_param_ramp(graph.params, name, struct_name, w)
+    w("")
     _emit_param_get(graph.params, name, struct_name, w)
     w("")
 
     # -- Buffer API
     buffer_nodes = [n for n in sorted_nodes if isinstance(n, Buffer)]
-    _emit_buffer_api(buffer_nodes, name, struct_name, w)
+    _emit_buffer_api(buffer_nodes, name, struct_name, w, tables, mips)
 
     # -- Peek API
     peek_nodes = [n for n in sorted_nodes if isinstance(n, Peek)]
     _emit_peek_api(peek_nodes, name, struct_name, w)
 
+    # -- Envelope idle query
+    adsr_nodes = [n for n in sorted_nodes if isinstance(n, ADSR)]
+    _emit_adsr_idle_api(adsr_nodes, name, struct_name, w)
+
     return "\n".join(lines) + "\n"
 
 
-def compile_graph_to_file(graph: Graph, output_dir: str | Path) -> Path:
+def compile_graph_to_file(
+    graph: Graph,
+    output_dir: str | Path,
+    check_ranges: bool = False,
+    outline_subgraphs: bool = False,
+) -> Path:
     """Compile a DSP graph and write {name}.cpp to output_dir.
 
     Creates the output directory if it doesn't exist.
     Returns the path to the written file.
     """
-    code = compile_graph(graph)
+    code = compile_graph(graph, check_ranges, outline_subgraphs)
     out = Path(output_dir)
     out.mkdir(parents=True, exist_ok=True)
     path = out / f"{graph.name}.cpp"
@@ -299,13 +598,45 @@ def compile_graph_to_file(graph: Graph, output_dir: str | Path) -> Path:
 # ---------------------------------------------------------------------------
 
 
-def _emit_state_fields(node: Node, w: _Writer) -> None:
+def _emit_state_fields(
+    node: Node, w: _Writer, name: str = "", mips: frozenset[str] = frozenset()
+) -> None:
     if isinstance(node, History):
         w(f"    float m_{node.id};")
     elif isinstance(node, DelayLine):
         w(f"    float* m_{node.id}_buf;")
         w(f"    int m_{node.id}_len;")
         w(f"    int m_{node.id}_wr;")
+    elif isinstance(node, FDN):
+        # All lines in one allocation; per-line ring heads and damping state
+        n = len(node.delays)
+        w(f"    float* m_{node.id}_buf;")
+        w(f"    int m_{node.id}_pos[{n}];")
+        w(f"    float m_{node.id}_lp[{n}];")
+    elif isinstance(node, (WindowMax, WindowMin)):
+        # Monotonic deque in a ring: candidate values and their arrival times
+        w(f"    float* m_{node.id}_val;")
+        w(f"    uint32_t* m_{node.id}_at;")
+        w(f"    int m_{node.id}_head;")
+        w(f"    int m_{node.id}_count;")
+        w(f"    uint32_t m_{node.id}_t;")
+    elif isinstance(node, MovingAverage):
+        # Ring of the last `window` terms, running sum and restarted sum
+        w(f"    float* m_{node.id}_buf;")
+        w(f"    int m_{node.id}_pos;")
+        w(f"    float m_{node.id}_sum;")
+        w(f"    float m_{node.id}_fresh;")
+    elif isinstance(node, Granulator):
+        # Live grains fill slots 0..count-1 in onset order
+        cap = node.grains
+        w(f"    float m_{node.id}_gpos[{cap}];")
+        w(f"    float m_{node.id}_ginc[{cap}];")
+        w(f"    uint32_t m_{node.id}_gph[{cap}];")
+        w(f"    uint32_t m_{node.id}_gstep[{cap}];")
+        w(f"    int m_{node.id}_gleft[{cap}];")
+        w(f"    int m_{node.id}_count;")
+        w(f"    float m_{node.id}_wait;")
+        w(f"    uint32_t m_{node.id}_seed;")
     elif isinstance(node, Phasor):
         w(f"    float m_{node.id}_phase;")
     elif isinstance(node, Noise):
@@ -326,6 +657,10 @@ def _emit_state_fields(node: Node, w: _Writer) -> None:
     elif isinstance(node, Allpass):
         w(f"    float m_{node.id}_xprev;")
         w(f"    float m_{node.id}_yprev;")
+    elif isinstance(node, FIR):
+        # Doubled history ring: the last N inputs are always contiguous
+        w(f"    float* m_{node.id}_hist;")
+        w(f"    int m_{node.id}_pos;")
     elif isinstance(node, (SinOsc, TriOsc, SawOsc, PulseOsc)):
         w(f"    float m_{node.id}_phase;")
     elif isinstance(node, (SampleHold, Latch)):
@@ -354,8 +689,29 @@ def _emit_state_fields(node: Node, w: _Writer) -> None:
     elif isinstance(node, Peek):
         w(f"    float m_{node.id}_value;")
     elif isinstance(node, Buffer):
-        w(f"    float* m_{node.id}_buf;")
+        w(f"    {_buf_ctype(node)}* m_{node.id}_buf;")
         w(f"    int m_{node.id}_len;")
+        if node.id in mips:
+            w(f"    float* m_{node.id}_mip;")
+    elif isinstance(node, WavetableOsc):
+        w(f"    float m_{node.id}_phase;")
+        w(f"    float m_{node.id}_f;")
+        w(f"    float m_{node.id}_inc;")
+        w(f"    float m_{node.id}_t;")
+        w(f"    int m_{node.id}_lo;")
+    elif isinstance(node, Subgraph):
+        w(f"    {_to_pascal(node.graph.name)}State* m_{node.id}_inner;")
+    elif isinstance(node, Undersample):
+        taps = undersample_taps(node)
+        hist = undersample_hist_len(node)
+        inner_struct = _to_pascal(_undersample_inner_name(name, node.id)) + "State"
+        w(f"    {inner_struct}* m_{node.id}_inner;")
+        if node.inputs:
+            w(f"    float m_{node.id}_dec[{len(node.inputs) * 2 * taps}];")
+        w(f"    int m_{node.id}_dpos;")
+        w(f"    float m_{node.id}_hist[{2 * hist}];")
+        w(f"    int m_{node.id}_hpos;")
+        w(f"    int m_{node.id}_phase;")
 
 
 # ---------------------------------------------------------------------------
@@ -363,7 +719,13 @@ def _emit_state_fields(node: Node, w: _Writer) -> None:
 # ---------------------------------------------------------------------------
 
 
-def _emit_state_init(node: Node, w: _Writer) -> None:
+def _emit_state_init(
+    node: Node,
+    w: _Writer,
+    name: str = "",
+    tables: frozenset[str] = frozenset(),
+    mips: frozenset[str] = frozenset(),
+) -> None:
     if isinstance(node, History):
         w(f"    self->m_{node.id} = {_float_lit(node.init)};")
     elif isinstance(node, DelayLine):
@@ -372,8 +734,24 @@ def _emit_state_init(node: Node, w: _Writer) -> None:
             f"    self->m_{node.id}_buf = (float*)calloc({node.max_samples}, sizeof(float));"
         )
         w(f"    self->m_{node.id}_wr = 0;")
+    elif isinstance(node, FDN):
+        w(
+            f"    self->m_{node.id}_buf = (float*)calloc({sum(node.delays)}, sizeof(float));"
+        )
+        _emit_fdn_clear(node, w)
+    elif isinstance(node, (WindowMax, WindowMin)):
+        cap = node.max_window
+        w(f"    self->m_{node.id}_val = (float*)calloc({cap}, sizeof(float));")
+        w(f"    self->m_{node.id}_at = (uint32_t*)calloc({cap}, sizeof(uint32_t));")
+        _emit_window_clear(node, w)
+    elif isinstance(node, MovingAverage):
+        w(f"    self->m_{node.id}_buf = (float*)calloc({node.window}, sizeof(float));")
+        _emit_average_clear(node, w)
     elif isinstance(node, Noise):
         w(f"    self->m_{node.id}_seed = 123456789u;")
+    elif isinstance(node, Granulator):
+        # Pool slots are zeroed by calloc; the first onset is at sample 0
+        _emit_grain_clear(node, w)
     elif isinstance(node, (Delta, Change)):
         w(f"    self->m_{node.id}_prev = 0.0f;")
     elif isinstance(node, Biquad):
@@ -390,6 +768,10 @@ def _emit_state_init(node: Node, w: _Writer) -> None:
     elif isinstance(node, Allpass):
         w(f"    self->m_{node.id}_xprev = 0.0f;")
         w(f"    self->m_{node.id}_yprev = 0.0f;")
+    elif isinstance(node, FIR):
+        taps = _fir_taps(node, "self->m_")
+        w(f"    self->m_{node.id}_hist = (float*)calloc(2 * {taps}, sizeof(float));")
+        w(f"    self->m_{node.id}_pos = 0;")
     elif isinstance(node, (SampleHold, Latch)):
         w(f"    self->m_{node.id}_held = 0.0f;")
         w(f"    self->m_{node.id}_ptrig = 0.0f;")
@@ -409,13 +791,39 @@ def _emit_state_init(node: Node, w: _Writer) -> None:
     elif isinstance(node, Peek):
         w(f"    self->m_{node.id}_value = 0.0f;")
     elif isinstance(node, Buffer):
+        guard = _TABLE_GUARD if node.id in tables else 0
         w(f"    self->m_{node.id}_len = {node.size};")
-        w(f"    self->m_{node.id}_buf = (float*)calloc({node.size}, sizeof(float));")
+        ctype = _buf_ctype(node)
+        w(
+            f"    self->m_{node.id}_buf = ({ctype}*)calloc({node.size + guard}, sizeof({ctype}));"
+        )
         if node.fill == "sine":
             w(f"    for (int _k = 0; _k < {node.size}; _k++)")
+            sine = f"sinf(2.0f * 3.14159265f * (float)_k / (float){node.size})"
+            w(
+                f"        self->m_{node.id}_buf[_k] = {_buf_store(name, sine, node.format == 'int16')};"
+            )
+            if guard:
+                _emit_table_guards(f"self->m_{node.id}_buf", node.size, "    ", w)
+        if node.id in mips:
+            levels = mip_levels(node.size)
             w(
-                f"        self->m_{node.id}_buf[_k] = sinf(2.0f * 3.14159265f * (float)_k / (float){node.size});"
+                f"    self->m_{node.id}_mip = (float*)calloc({levels * (node.size + 2)}, sizeof(float));"
             )
+            _emit_mip_build(name, node, "    ", w)
+    elif isinstance(node, WavetableOsc):
+        # freq 0 selects level 0 with no increment, so zero state is consistent
+        w(f"    self->m_{node.id}_phase = 0.0f;")
+        w(f"    self->m_{node.id}_f = 0.0f;")
+        w(f"    self->m_{node.id}_inc = 0.0f;")
+        w(f"    self->m_{node.id}_t = 0.0f;")
+        w(f"    self->m_{node.id}_lo = 0;")
+    elif isinstance(node, Undersample):
+        # Arrays and counters are zeroed by calloc
+        inner = _undersample_inner_name(name, node.id)
+        w(f"    self->m_{node.id}_inner = {inner}_create(sr / {node.factor}.0f);")
+    elif isinstance(node, Subgraph):
+        w(f"    self->m_{node.id}_inner = {node.graph.name}_create(sr);")
 
 
 # ---------------------------------------------------------------------------
@@ -429,18 +837,27 @@ def _emit_reset(
     name: str,
     struct_name: str,
     w: _Writer,
+    tables: frozenset[str] = frozenset(),
+    mips: frozenset[str] = frozenset(),
 ) -> None:
     w(f"void {name}_reset({struct_name}* self) {{")
     # Reset params to defaults
     for p in graph.params:
         w(f"    self->p_{p.name} = {_float_lit(p.default)};")
+        w(f"    self->r_{p.name}_left = 0;")
     # Reset node state
     for node in sorted_nodes:
-        _emit_state_reset(node, w)
+        _emit_state_reset(node, w, name, tables, mips)
     w("}")
 
 
-def _emit_state_reset(node: Node, w: _Writer) -> None:
+def _emit_state_reset(
+    node: Node,
+    w: _Writer,
+    name: str = "",
+    tables: frozenset[str] = frozenset(),
+    mips: frozenset[str] = frozenset(),
+) -> None:
     if isinstance(node, History):
         w(f"    self->m_{node.id} = {_float_lit(node.init)};")
     elif isinstance(node, DelayLine):
@@ -448,10 +865,22 @@ def _emit_state_reset(node: Node, w: _Writer) -> None:
             f"    memset(self->m_{node.id}_buf, 0, self->m_{node.id}_len * sizeof(float));"
         )
         w(f"    self->m_{node.id}_wr = 0;")
+    elif isinstance(node, FDN):
+        w(f"    memset(self->m_{node.id}_buf, 0, {sum(node.delays)} * sizeof(float));")
+        _emit_fdn_clear(node, w)
+    elif isinstance(node, (WindowMax, WindowMin)):
+        # An empty deque never reads stale slots, so the rings stay as they are
+        _emit_window_clear(node, w)
+    elif isinstance(node, MovingAverage):
+        w(f"    memset(self->m_{node.id}_buf, 0, {node.window} * sizeof(float));")
+        _emit_average_clear(node, w)
     elif isinstance(node, (Phasor, SinOsc, TriOsc, SawOsc, PulseOsc)):
         w(f"    self->m_{node.id}_phase = 0.0f;")
     elif isinstance(node, Noise):
         w(f"    self->m_{node.id}_seed = 123456789u;")
+    elif isinstance(node, Granulator):
+        # Slots past the live count are never read, so the pool stays as it is
+        _emit_grain_clear(node, w)
     elif isinstance(node, (Delta, Change)):
         w(f"    self->m_{node.id}_prev = 0.0f;")
     elif isinstance(node, (Biquad, SVF)):
@@ -462,6 +891,10 @@ def _emit_state_reset(node: Node, w: _Writer) -> None:
     elif isinstance(node, (DCBlock, Allpass)):
         w(f"    self->m_{node.id}_xprev = 0.0f;")
         w(f"    self->m_{node.id}_yprev = 0.0f;")
+    elif isinstance(node, FIR):
+        taps = _fir_taps(node, "self->m_")
+        w(f"    memset(self->m_{node.id}_hist, 0, 2 * {taps} * sizeof(float));")
+        w(f"    self->m_{node.id}_pos = 0;")
     elif isinstance(node, (SampleHold, Latch)):
         w(f"    self->m_{node.id}_held = 0.0f;")
         w(f"    self->m_{node.id}_ptrig = 0.0f;")
@@ -488,15 +921,45 @@ def _emit_state_reset(node: Node, w: _Writer) -> None:
     elif isinstance(node, Peek):
         w(f"    self->m_{node.id}_value = 0.0f;")
     elif isinstance(node, Buffer):
+        guarded = node.id in tables
+        ctype = _buf_ctype(node)
         if node.fill == "sine":
             w(f"    for (int _k = 0; _k < self->m_{node.id}_len; _k++)")
+            sine = (
+                f"sinf(2.0f * 3.14159265f * (float)_k / (float)self->m_{node.id}_len)"
+            )
+            w(
+                f"        self->m_{node.id}_buf[_k] = {_buf_store(name, sine, node.format == 'int16')};"
+            )
+            if guarded:
+                _emit_table_guards(f"self->m_{node.id}_buf", node.size, "    ", w)
+        elif guarded:
             w(
-                f"        self->m_{node.id}_buf[_k] = sinf(2.0f * 3.14159265f * (float)_k / (float)self->m_{node.id}_len);"
+                f"    memset(self->m_{node.id}_buf, 0, {node.size + _TABLE_GUARD} * sizeof({ctype}));"
             )
         else:
             w(
-                f"    memset(self->m_{node.id}_buf, 0, self->m_{node.id}_len * sizeof(float));"
+                f"    memset(self->m_{node.id}_buf, 0, self->m_{node.id}_len * sizeof({ctype}));"
             )
+        if node.id in mips:
+            _emit_mip_build(name, node, "    ", w)
+    elif isinstance(node, WavetableOsc):
+        w(f"    self->m_{node.id}_phase = 0.0f;")
+        w(f"    self->m_{node.id}_f = 0.0f;")
+        w(f"    self->m_{node.id}_inc = 0.0f;")
+        w(f"    self->m_{node.id}_t = 0.0f;")
+        w(f"    self->m_{node.id}_lo = 0;")
+    elif isinstance(node, Subgraph):
+        w(f"    {node.graph.name}_reset(self->m_{node.id}_inner);")
+    elif isinstance(node, Undersample):
+        nid = node.id
+        w(f"    {_undersample_inner_name(name, nid)}_reset(self->m_{nid}_inner);")
+        if node.inputs:
+            w(f"    memset(self->m_{nid}_dec, 0, sizeof(self->m_{nid}_dec));")
+        w(f"    memset(self->m_{nid}_hist, 0, sizeof(self->m_{nid}_hist));")
+        w(f"    self->m_{nid}_dpos = 0;")
+        w(f"    self->m_{nid}_hpos = 0;")
+        w(f"    self->m_{nid}_phase = 0;")
 
 
 # ---------------------------------------------------------------------------
@@ -504,9 +967,6 @@ def _emit_state_reset(node: Node, w: _Writer) -> None:
 # ---------------------------------------------------------------------------
 
 
-_NON_REF_FIELDS = frozenset({"id", "op", "interp", "mode", "count", "channel"})
-
-
 def _classify_loop_invariance(
     sorted_nodes: list[Node],
     input_ids: set[str],
@@ -526,7 +986,7 @@ def _classify_loop_invariance(
 
         is_invariant = True
         for field_name, value in node.__dict__.items():
-            if field_name in _NON_REF_FIELDS:
+            if field_name in NON_REF_FIELDS:
                 continue
             if isinstance(value, float):
                 continue
@@ -575,6 +1035,30 @@ def _classify_control_rate(
     return control_node_ids - invariant_ids
 
 
+def _classify_block_adsr(
+    sorted_nodes: list[Node],
+    param_names: set[str],
+    invariant_ids: set[str],
+    ctrl_rate_ids: set[str],
+) -> frozenset[str]:
+    """Return ADSR node IDs that can be rendered by segment.
+
+    An envelope qualifies when every input (gate and times) is a literal,
+    a param, or a loop-invariant node: gate edges can then only occur at
+    the start of a block.
+    """
+    result: set[str] = set()
+    for node in sorted_nodes:
+        if not isinstance(node, ADSR) or node.id in ctrl_rate_ids:
+            continue
+        refs = (node.gate, node.attack, node.decay, node.sustain, node.release)
+        if all(
+            isinstance(r, float) or r in param_names or r in invariant_ids for r in refs
+        ):
+            result.add(node.id)
+    return frozenset(result)
+
+
 def _indent_line(line: str, extra: int) -> str:
     """Add *extra* spaces of indentation to a line."""
     return " " * extra + line
@@ -588,7 +1072,16 @@ def _emit_perform(
     name: str,
     struct_name: str,
     w: _Writer,
+    ranges: _Ranges | None = None,
 ) -> None:
+    """Emit ``{name}_perform``.
+
+    With params, the block runs as a loop of segments that hold every
+    param constant. While any param ramps, a segment is one sample (one
+    control block in control-rate graphs) and the ramp steps after it, so
+    the first sample of a block still sees the value it started with;
+    otherwise the rest of the block is one segment.
+    """
     w(f"void {name}_perform({struct_name}* self, float** ins, float** outs, int n) {{")
 
     # Unpack I/O pointers with __restrict
@@ -600,13 +1093,34 @@ def _emit_perform(
     # Load params to locals
     for p in graph.params:
         w(f"    float {p.name} = self->p_{p.name};")
+    for p in graph.params:
+        w(f"    float {p.name}_inc = self->r_{p.name}_inc;")
+        w(f"    float {p.name}_target = self->r_{p.name}_target;")
+        w(f"    int {p.name}_left = self->r_{p.name}_left;")
 
     # Load state to locals
+    skip_bufs = _mip_only_buffers(sorted_nodes)
     for node in sorted_nodes:
-        _emit_state_load(node, w)
+        if node.id not in skip_bufs:
+            _emit_state_load(node, w)
 
     w("    float sr = self->sr;")
 
+    ctrl_interval = graph.control_interval
+    seg = max(ctrl_interval, 1)
+    lo, hi = ("_s", "_e") if graph.params else ("0", "n")
+    body_w = w
+    if graph.params:
+        lefts = " || ".join(f"{p.name}_left > 0" for p in graph.params)
+        w("    for (int _s = 0, _e = n; _s < n; _s = _e) {")
+        w(f"        int _ramp = {lefts};")
+        w(f"        _e = _ramp ? _s + {seg} : n;")
+        if seg > 1:
+            w("        if (_e > n) _e = n;")
+
+        def body_w(line: str) -> None:
+            w(_indent_line(line, 4))
+
     # Classify loop invariance
     invariant_ids = _classify_loop_invariance(sorted_nodes, input_ids, param_names)
 
@@ -623,18 +1137,28 @@ def _emit_perform(
                 hoisted_lines.append,
                 hoisted_history,
                 hoisted_dw,
+                name,
+                ranges,
             )
             for line in hoisted_lines:
                 # Strip 4 leading spaces: 8-space indent -> 4-space indent
                 if line.startswith("        "):
-                    w(line[4:])
+                    body_w(line[4:])
                 else:
-                    w(line)
+                    body_w(line)
 
-    ctrl_interval = graph.control_interval
     ctrl_node_ids = set(graph.control_nodes) if ctrl_interval > 0 else set()
     ctrl_rate_ids = _classify_control_rate(sorted_nodes, ctrl_node_ids, invariant_ids)
 
+    # ADSR envelopes whose inputs are all block-invariant are rendered by
+    # segment into a small scratch span instead of stepping per sample.
+    block_adsr_ids = _classify_block_adsr(
+        sorted_nodes, param_names, invariant_ids, ctrl_rate_ids
+    )
+    for node in sorted_nodes:
+        if isinstance(node, ADSR) and node.id in block_adsr_ids:
+            _emit_adsr_block_setup(node, input_ids, param_names, body_w)
+
     if ctrl_interval > 0 and ctrl_rate_ids:
         _emit_perform_two_tier(
             graph,
@@ -644,7 +1168,27 @@ def _emit_perform(
             invariant_ids,
             ctrl_rate_ids,
             ctrl_interval,
-            w,
+            body_w,
+            block_adsr_ids,
+            name,
+            ranges,
+            (lo, hi),
+        )
+    elif levels := _plan_outlined_levels(
+        graph, sorted_nodes, invariant_ids, param_names
+    ):
+        _emit_perform_staged(
+            graph,
+            sorted_nodes,
+            input_ids,
+            param_names,
+            invariant_ids,
+            levels,
+            body_w,
+            block_adsr_ids,
+            name,
+            ranges,
+            (lo, hi),
         )
     else:
         _emit_perform_single(
@@ -653,16 +1197,50 @@ def _emit_perform(
             input_ids,
             param_names,
             invariant_ids,
-            w,
+            body_w,
+            block_adsr_ids,
+            name,
+            ranges,
+            (lo, hi),
         )
 
+    if graph.params:
+        _emit_ramp_advance(graph.params, seg, w)
+        w("    }")
+
     # Save state back
+    for p in graph.params:
+        w(f"    self->p_{p.name} = {p.name};")
+        w(f"    self->r_{p.name}_left = {p.name}_left;")
     for node in sorted_nodes:
         _emit_state_save(node, w)
 
     w("}")
 
 
+def _ramp_step(p: Param, indent: str) -> str:
+    """One ramp step; lands exactly on the target at the end."""
+    n = p.name
+    return (
+        f"{indent}if ({n}_left > 0) "
+        f"{n} = (--{n}_left == 0) ? {n}_target : {n} + {n}_inc;"
+    )
+
+
+def _emit_ramp_advance(params: list[Param], seg: int, w: _Writer) -> None:
+    """Step ramping params once per sample of the segment just rendered."""
+    w("        if (_ramp) {")
+    if seg > 1:
+        w("            for (int _k = _s; _k < _e; _k++) {")
+        for p in params:
+            w(_ramp_step(p, "                "))
+        w("            }")
+    else:
+        for p in params:
+            w(_ramp_step(p, "            "))
+    w("        }")
+
+
 def _emit_perform_single(
     graph: Graph,
     sorted_nodes: list[Node],
@@ -670,8 +1248,13 @@ def _emit_perform_single(
     param_names: set[str],
     invariant_ids: set[str],
     w: _Writer,
+    block_adsr_ids: frozenset[str] = frozenset(),
+    name: str = "",
+    ranges: _Ranges | None = None,
+    span: tuple[str, str] = ("0", "n"),
 ) -> None:
     """Emit the single-loop perform body (no control-rate tier)."""
+    lo, hi = span
     # Vectorization pragma -- only when no stateful nodes exist
     has_stateful = any(isinstance(n, _STATEFUL_TYPES) for n in sorted_nodes)
     if not has_stateful:
@@ -681,15 +1264,24 @@ def _emit_perform_single(
         w("    #pragma GCC ivdep")
         w("#endif")
 
-    w("    for (int i = 0; i < n; i++) {")
+    w(f"    for (int i = {lo}; i < {hi}; i++) {{")
 
     # Topo-sorted node computations (variant nodes only)
     history_nodes: list[History] = []
     delay_write_nodes: list[DelayWrite] = []
     for node in sorted_nodes:
-        if node.id not in invariant_ids:
+        if node.id in block_adsr_ids:
+            _emit_adsr_block_read(node.id, name, w, span)
+        elif node.id not in invariant_ids:
             _emit_node_compute(
-                node, input_ids, param_names, w, history_nodes, delay_write_nodes
+                node,
+                input_ids,
+                param_names,
+                w,
+                history_nodes,
+                delay_write_nodes,
+                name,
+                ranges,
             )
 
     # History write-backs
@@ -704,6 +1296,130 @@ def _emit_perform_single(
     w("    }")
 
 
+def _emit_perform_staged(
+    graph: Graph,
+    sorted_nodes: list[Node],
+    input_ids: set[str],
+    param_names: set[str],
+    invariant_ids: set[str],
+    levels: dict[str, int],
+    w: _Writer,
+    block_adsr_ids: frozenset[str] = frozenset(),
+    name: str = "",
+    ranges: _Ranges | None = None,
+    span: tuple[str, str] = ("0", "n"),
+) -> None:
+    """Emit a single-tier body that calls outlined subgraphs per chunk.
+
+    The block runs in ``_OUTLINE_CHUNK``-sample chunks. Within a chunk,
+    every level of *levels* (see ``_plan_outlined_levels``) gets one block
+    call per outlined Subgraph on it, then one sample loop over its other
+    nodes. Values read on a later level pass through chunk scratch.
+    """
+    lo, hi = span
+    chunk = _OUTLINE_CHUNK
+    calls = {n.id: n for n in sorted_nodes if isinstance(n, Subgraph)}
+    call_outputs: dict[str, tuple[str, int]] = {}
+    for sg in calls.values():
+        sel_id = sg.output or sg.graph.outputs[0].id
+        for k, out in enumerate(sg.graph.outputs):
+            call_outputs[f"{sg.id}__{out.id}"] = (sg.id, k)
+            if out.id == sel_id:
+                call_outputs[sg.id] = (sg.id, k)
+    staged = [
+        n for n in sorted_nodes if n.id not in invariant_ids and n.id not in calls
+    ]
+    histories = [n for n in staged if isinstance(n, History)]
+    values = {
+        n.id: levels[n.id] for n in staged if not isinstance(n, (DelayLine, Buffer))
+    }
+
+    def level_of(r: str) -> int:
+        return levels[call_outputs[r][0]] if r in call_outputs else levels.get(r, 0)
+
+    # Refs each level's sample loop reads
+    reads: dict[int, set[str]] = {}
+    for node in staged:
+        reads.setdefault(levels[node.id], set()).update(_node_refs(node))
+    for h in histories:
+        if isinstance(h.input, str):
+            reads.setdefault(levels[h.id], set()).add(h.input)
+    for out in graph.outputs:
+        reads.setdefault(level_of(out.source), set()).add(out.source)
+    call_reads = {
+        r for sg in calls.values() for r in sg.inputs.values() if isinstance(r, str)
+    }
+    crossing = [
+        v
+        for v, lv in values.items()
+        if v in call_reads or any(v in reads[k] for k in reads if k > lv)
+    ]
+
+    def scratch(r: str | float) -> str | None:
+        """Chunk span holding ref *r* per sample, if it varies."""
+        if isinstance(r, float):
+            return None
+        if r in input_ids:
+            return f"{r} + _c0"
+        if r in values:
+            return f"{r}_blk"
+        if r in call_outputs:
+            sg_id, k = call_outputs[r]
+            return f"{sg_id}_y[{k}]"
+        return None
+
+    has_stateful = any(isinstance(n, _STATEFUL_TYPES) for n in sorted_nodes)
+    w(f"    for (int _c0 = {lo}; _c0 < {hi}; _c0 += {chunk}) {{")
+    w(f"        int _cn = ({hi} - _c0 < {chunk}) ? {hi} - _c0 : {chunk};")
+    for v in crossing:
+        w(f"        float {v}_blk[{chunk}];")
+    for level in range(max(levels[c] for c in calls) + 1):
+        for sg in calls.values():
+            if levels[sg.id] == level:
+                _emit_outlined_block_call(sg, scratch, input_ids, param_names, w)
+
+        body: list[str] = []
+        for node in staged:
+            if levels[node.id] != level:
+                continue
+            if node.id in block_adsr_ids:
+                _emit_adsr_block_read(node.id, name, body.append, span)
+            else:
+                _emit_node_compute(
+                    node, input_ids, param_names, body.append, [], [], name, ranges
+                )
+        for v in crossing:
+            if values[v] == level:
+                body.append(f"        {v}_blk[_j] = {v};")
+        for h in histories:
+            if levels[h.id] == level:
+                ref = _emit_ref(h.input, input_ids, param_names)
+                body.append(f"        {h.id} = {ref};")
+        for out in graph.outputs:
+            if level_of(out.source) == level:
+                body.append(f"        {out.id}[i] = {out.source};")
+        if not body:
+            continue
+
+        if not has_stateful:
+            w("#if defined(__clang__)")
+            w("        #pragma clang loop vectorize(enable) interleave(enable)")
+            w("#elif defined(__GNUC__)")
+            w("        #pragma GCC ivdep")
+            w("#endif")
+        w("        for (int _j = 0; _j < _cn; _j++) {")
+        if any(re.search(r"\bi\b", line) for line in body):
+            w("            int i = _c0 + _j;")
+        # Values from earlier levels, read back per sample
+        for r in sorted(reads.get(level, ())):
+            if r in values and values[r] < level or r in call_outputs:
+                w(f"            float {r} = {scratch(r)}[_j];")
+        for line in body:
+            w(_indent_line(line, 4))
+        w("        }")
+    w("    }")
+
+
 def _emit_perform_two_tier(
     graph: Graph,
     sorted_nodes: list[Node],
@@ -713,12 +1429,17 @@ def _emit_perform_two_tier(
     ctrl_rate_ids: set[str],
     ctrl_interval: int,
     w: _Writer,
+    block_adsr_ids: frozenset[str] = frozenset(),
+    name: str = "",
+    ranges: _Ranges | None = None,
+    span: tuple[str, str] = ("0", "n"),
 ) -> None:
     """Emit the two-tier (control-rate / audio-rate) perform body."""
+    lo, hi = span
     # Outer loop: control blocks
-    w(f"    for (int _cb = 0; _cb < n; _cb += {ctrl_interval}) {{")
+    w(f"    for (int _cb = {lo}; _cb < {hi}; _cb += {ctrl_interval}) {{")
     w(
-        f"        int _block_end = (_cb + {ctrl_interval} < n) ? _cb + {ctrl_interval} : n;"
+        f"        int _block_end = (_cb + {ctrl_interval} < {hi}) ? _cb + {ctrl_interval} : {hi};"
     )
 
     # Control-rate nodes (8-space indent = inside outer loop)
@@ -726,7 +1447,9 @@ def _emit_perform_two_tier(
     ctrl_dw: list[DelayWrite] = []
     for node in sorted_nodes:
         if node.id in ctrl_rate_ids:
-            _emit_node_compute(node, input_ids, param_names, w, ctrl_history, ctrl_dw)
+            _emit_node_compute(
+                node, input_ids, param_names, w, ctrl_history, ctrl_dw, name, ranges
+            )
 
     # Inner loop: audio-rate per-sample
     w("        for (int i = _cb; i < _block_end; i++) {")
@@ -738,14 +1461,19 @@ def _emit_perform_two_tier(
         if node.id not in invariant_ids and node.id not in ctrl_rate_ids:
             # Collect lines at standard 8-space indent, then add 4 more
             node_lines: list[str] = []
-            _emit_node_compute(
-                node,
-                input_ids,
-                param_names,
-                node_lines.append,
-                audio_history,
-                audio_dw,
-            )
+            if node.id in block_adsr_ids:
+                _emit_adsr_block_read(node.id, name, node_lines.append, span)
+            else:
+                _emit_node_compute(
+                    node,
+                    input_ids,
+                    param_names,
+                    node_lines.append,
+                    audio_history,
+                    audio_dw,
+                    name,
+                    ranges,
+                )
             for line in node_lines:
                 w(_indent_line(line, 4))
 
@@ -777,10 +1505,42 @@ def _emit_state_load(node: Node, w: _Writer) -> None:
         w(f"    float* {node.id}_buf = self->m_{node.id}_buf;")
         w(f"    int {node.id}_len = self->m_{node.id}_len;")
         w(f"    int {node.id}_wr = self->m_{node.id}_wr;")
+    elif isinstance(node, FDN):
+        # Ring heads and damping state live in locals for the whole block
+        w(f"    float* {node.id}_buf = self->m_{node.id}_buf;")
+        for k in range(len(node.delays)):
+            w(f"    int {node.id}_p{k} = self->m_{node.id}_pos[{k}];")
+        for k in range(len(node.delays)):
+            w(f"    float {node.id}_lp{k} = self->m_{node.id}_lp[{k}];")
+    elif isinstance(node, (WindowMax, WindowMin)):
+        w(f"    float* {node.id}_val = self->m_{node.id}_val;")
+        w(f"    uint32_t* {node.id}_at = self->m_{node.id}_at;")
+        w(f"    int {node.id}_head = self->m_{node.id}_head;")
+        w(f"    int {node.id}_count = self->m_{node.id}_count;")
+        w(f"    uint32_t {node.id}_t = self->m_{node.id}_t;")
+    elif isinstance(node, MovingAverage):
+        w(f"    float* {node.id}_buf = self->m_{node.id}_buf;")
+        w(f"    int {node.id}_pos = self->m_{node.id}_pos;")
+        w(f"    float {node.id}_sum = self->m_{node.id}_sum;")
+        w(f"    float {node.id}_fresh = self->m_{node.id}_fresh;")
     elif isinstance(node, Phasor):
         w(f"    float {node.id}_phase = self->m_{node.id}_phase;")
     elif isinstance(node, Noise):
         w(f"    uint32_t {node.id}_seed = self->m_{node.id}_seed;")
+    elif isinstance(node, Granulator):
+        nid = node.id
+        for arr in ("gpos", "ginc"):
+            w(f"    float* {nid}_{arr} = self->m_{nid}_{arr};")
+        for arr in ("gph", "gstep"):
+            w(f"    uint32_t* {nid}_{arr} = self->m_{nid}_{arr};")
+        w(f"    int* {nid}_gleft = self->m_{nid}_gleft;")
+        w(f"    int {nid}_count = self->m_{nid}_count;")
+        w(f"    float {nid}_wait = self->m_{nid}_wait;")
+        w(f"    uint32_t {nid}_seed = self->m_{nid}_seed;")
+        # Rendered span: samples base..end-1 of this block
+        w(f"    float {nid}_blk[{_GRAIN_SPAN}];")
+        w(f"    int {nid}_base = 0;")
+        w(f"    int {nid}_end = 0;")
     elif isinstance(node, (Delta, Change)):
         w(f"    float {node.id}_prev = self->m_{node.id}_prev;")
     elif isinstance(node, Biquad):
@@ -797,6 +1557,9 @@ def _emit_state_load(node: Node, w: _Writer) -> None:
     elif isinstance(node, Allpass):
         w(f"    float {node.id}_xprev = self->m_{node.id}_xprev;")
         w(f"    float {node.id}_yprev = self->m_{node.id}_yprev;")
+    elif isinstance(node, FIR):
+        w(f"    float* {node.id}_hist = self->m_{node.id}_hist;")
+        w(f"    int {node.id}_pos = self->m_{node.id}_pos;")
     elif isinstance(node, (SinOsc, TriOsc, SawOsc, PulseOsc)):
         w(f"    float {node.id}_phase = self->m_{node.id}_phase;")
     elif isinstance(node, (SampleHold, Latch)):
@@ -825,8 +1588,19 @@ def _emit_state_load(node: Node, w: _Writer) -> None:
     elif isinstance(node, Peek):
         w(f"    float {node.id}_value = self->m_{node.id}_value;")
     elif isinstance(node, Buffer):
-        w(f"    float* {node.id}_buf = self->m_{node.id}_buf;")
+        w(f"    {_buf_ctype(node)}* {node.id}_buf = self->m_{node.id}_buf;")
         w(f"    int {node.id}_len = self->m_{node.id}_len;")
+    elif isinstance(node, WavetableOsc):
+        w(f"    const float* {node.id}_mip = self->m_{node.buffer}_mip;")
+        w(f"    float {node.id}_phase = self->m_{node.id}_phase;")
+        w(f"    float {node.id}_f = self->m_{node.id}_f;")
+        w(f"    float {node.id}_inc = self->m_{node.id}_inc;")
+        w(f"    float {node.id}_t = self->m_{node.id}_t;")
+        w(f"    int {node.id}_lo = self->m_{node.id}_lo;")
+    elif isinstance(node, Undersample):
+        w(f"    int {node.id}_dpos = self->m_{node.id}_dpos;")
+        w(f"    int {node.id}_hpos = self->m_{node.id}_hpos;")
+        w(f"    int {node.id}_phase = self->m_{node.id}_phase;")
 
 
 def _emit_state_save(node: Node, w: _Writer) -> None:
@@ -834,10 +1608,27 @@ def _emit_state_save(node: Node, w: _Writer) -> None:
         w(f"    self->m_{node.id} = {node.id};")
     elif isinstance(node, DelayLine):
         w(f"    self->m_{node.id}_wr = {node.id}_wr;")
+    elif isinstance(node, FDN):
+        for k in range(len(node.delays)):
+            w(f"    self->m_{node.id}_pos[{k}] = {node.id}_p{k};")
+        for k in range(len(node.delays)):
+            w(f"    self->m_{node.id}_lp[{k}] = {node.id}_lp{k};")
+    elif isinstance(node, (WindowMax, WindowMin)):
+        w(f"    self->m_{node.id}_head = {node.id}_head;")
+        w(f"    self->m_{node.id}_count = {node.id}_count;")
+        w(f"    self->m_{node.id}_t = {node.id}_t;")
+    elif isinstance(node, MovingAverage):
+        w(f"    self->m_{node.id}_pos = {node.id}_pos;")
+        w(f"    self->m_{node.id}_sum = {node.id}_sum;")
+        w(f"    self->m_{node.id}_fresh = {node.id}_fresh;")
     elif isinstance(node, Phasor):
         w(f"    self->m_{node.id}_phase = {node.id}_phase;")
     elif isinstance(node, Noise):
         w(f"    self->m_{node.id}_seed = {node.id}_seed;")
+    elif isinstance(node, Granulator):
+        w(f"    self->m_{node.id}_count = {node.id}_count;")
+        w(f"    self->m_{node.id}_wait = {node.id}_wait;")
+        w(f"    self->m_{node.id}_seed = {node.id}_seed;")
     elif isinstance(node, (Delta, Change)):
         w(f"    self->m_{node.id}_prev = {node.id}_prev;")
     elif isinstance(node, Biquad):
@@ -854,6 +1645,8 @@ def _emit_state_save(node: Node, w: _Writer) -> None:
     elif isinstance(node, Allpass):
         w(f"    self->m_{node.id}_xprev = {node.id}_xprev;")
         w(f"    self->m_{node.id}_yprev = {node.id}_yprev;")
+    elif isinstance(node, FIR):
+        w(f"    self->m_{node.id}_pos = {node.id}_pos;")
     elif isinstance(node, (SinOsc, TriOsc, SawOsc, PulseOsc)):
         w(f"    self->m_{node.id}_phase = {node.id}_phase;")
     elif isinstance(node, (SampleHold, Latch)):
@@ -881,6 +1674,16 @@ def _emit_state_save(node: Node, w: _Writer) -> None:
         w(f"    self->m_{node.id}_ptrig = {node.id}_ptrig;")
     elif isinstance(node, Peek):
         w(f"    self->m_{node.id}_value = {node.id}_value;")
+    elif isinstance(node, WavetableOsc):
+        w(f"    self->m_{node.id}_phase = {node.id}_phase;")
+        w(f"    self->m_{node.id}_f = {node.id}_f;")
+        w(f"    self->m_{node.id}_inc = {node.id}_inc;")
+        w(f"    self->m_{node.id}_t = {node.id}_t;")
+        w(f"    self->m_{node.id}_lo = {node.id}_lo;")
+    elif isinstance(node, Undersample):
+        w(f"    self->m_{node.id}_dpos = {node.id}_dpos;")
+        w(f"    self->m_{node.id}_hpos = {node.id}_hpos;")
+        w(f"    self->m_{node.id}_phase = {node.id}_phase;")
 
 
 def _emit_node_compute(
@@ -890,10 +1693,15 @@ def _emit_node_compute(
     w: _Writer,
     history_nodes: list[History],
     delay_write_nodes: list[DelayWrite],
+    name: str = "",
+    ranges: _Ranges | None = None,
 ) -> None:
     def ref(r: str | float) -> str:
         return _emit_ref(r, input_ids, param_names)
 
+    def rng(r: str | float) -> Interval:
+        return ranges.of(r) if ranges else UNBOUNDED
+
     if isinstance(node, BinOp):
         if node.op in _BINOP_FUNCS:
             func = _BINOP_FUNCS[node.op]
@@ -966,12 +1774,14 @@ def _emit_node_compute(
             w(f"        float {node.id} = 440.0f * powf(2.0f, ({a} - 69.0f) / 12.0f);")
         elif node.op == "ftom":
             a = ref(node.a)
-            w(
-                f"        float {node.id} = 69.0f + 12.0f * log2f(fmaxf({a}, 1e-10f) / 440.0f);"
-            )
+            if rng(node.a)[0] < 1e-10:
+                a = f"fmaxf({a}, 1e-10f)"
+            w(f"        float {node.id} = 69.0f + 12.0f * log2f({a} / 440.0f);")
         elif node.op == "atodb":
             a = ref(node.a)
-            w(f"        float {node.id} = 20.0f * log10f(fmaxf({a}, 1e-10f));")
+            if rng(node.a)[0] < 1e-10:
+                a = f"fmaxf({a}, 1e-10f)"
+            w(f"        float {node.id} = 20.0f * log10f({a});")
         elif node.op == "dbtoa":
             a = ref(node.a)
             w(f"        float {node.id} = powf(10.0f, {a} / 20.0f);")
@@ -1049,7 +1859,10 @@ def _emit_node_compute(
 
     elif isinstance(node, Clamp):
         a, lo, hi = ref(node.a), ref(node.lo), ref(node.hi)
-        w(f"        float {node.id} = fminf(fmaxf({a}, {lo}), {hi});")
+        if _within(rng(node.a), rng(node.lo)[1], rng(node.hi)[0]):
+            w(f"        float {node.id} = {a};")
+        else:
+            w(f"        float {node.id} = fminf(fmaxf({a}, {lo}), {hi});")
 
     elif isinstance(node, Constant):
         w(f"        float {node.id} = {_float_lit(node.value)};")
@@ -1065,18 +1878,29 @@ def _emit_node_compute(
     elif isinstance(node, DelayRead):
         dl = node.delay
         tap = ref(node.tap)
+        # A tap in [0, len - k] (k extra taps behind it) keeps every read
+        # index within one length of the write head: one conditional add
+        # replaces the double modulo.
+        span = _int_span(rng(node.tap))
+        extra = {"none": 0, "linear": 1, "cubic": 2}[node.interp]
+        near = (
+            ranges is not None
+            and span is not None
+            and span[0] >= 0
+            and span[1] + extra <= ranges.sizes[dl]
+        )
         if node.interp == "none":
-            w(
-                f"        int {node.id}_pos = "
-                f"(({dl}_wr - (int)({tap})) % {dl}_len + {dl}_len) % {dl}_len;"
-            )
+            _emit_delay_idx(f"{node.id}_pos", f"{dl}_wr - (int)({tap})", dl, near, w)
             w(f"        float {node.id} = {dl}_buf[{node.id}_pos];")
         elif node.interp == "linear":
             nid = node.id
-            _emit_interp_linear(nid, dl, tap, w)
+            _emit_interp_linear(nid, dl, tap, w, near)
         elif node.interp == "cubic":
             nid = node.id
-            _emit_interp_cubic(nid, dl, tap, w)
+            _emit_interp_cubic(nid, dl, tap, w, near)
+
+    elif isinstance(node, MultiTapRead):
+        _emit_multitap_compute(node, ref, rng, ranges, w)
 
     elif isinstance(node, DelayWrite):
         delay_write_nodes.append(node)
@@ -1084,11 +1908,19 @@ def _emit_node_compute(
         w(f"        {node.delay}_buf[{node.delay}_wr] = {val};")
         w(f"        {node.delay}_wr = ({node.delay}_wr + 1) % {node.delay}_len;")
 
+    elif isinstance(node, FDN):
+        _emit_fdn_compute(node, ref, w)
+
+    elif isinstance(node, (WindowMax, WindowMin)):
+        _emit_window_compute(node, ref, w)
+
+    elif isinstance(node, MovingAverage):
+        _emit_average_compute(node, ref, w)
+
     elif isinstance(node, Phasor):
         freq = ref(node.freq)
         w(f"        float {node.id} = {node.id}_phase;")
-        w(f"        {node.id}_phase += {freq} / sr;")
-        w(f"        if ({node.id}_phase >= 1.0f) {node.id}_phase -= 1.0f;")
+        _emit_phase_advance(node.id, freq, w)
 
     elif isinstance(node, Noise):
         w(f"        {node.id}_seed = {node.id}_seed * 1664525u + 1013904223u;")
@@ -1103,6 +1935,17 @@ def _emit_node_compute(
             f"        float {node.id} = {ref(node.cond)} > 0.0f ? {ref(node.a)} : {ref(node.b)};"
         )
 
+    elif isinstance(node, Wrap) and _within(
+        rng(node.a), rng(node.lo)[1], _math.nextafter(rng(node.hi)[0], -_math.inf)
+    ):
+        # Already inside [lo, hi): wrapping is the identity
+        w(f"        float {node.id} = {ref(node.a)};")
+
+    elif isinstance(node, Fold) and _within(
+        rng(node.a), rng(node.lo)[1], rng(node.hi)[0]
+    ):
+        w(f"        float {node.id} = {ref(node.a)};")
+
     elif isinstance(node, Wrap):
         nid = node.id
         a, lo, hi = ref(node.a), ref(node.lo), ref(node.hi)
@@ -1202,34 +2045,33 @@ def _emit_node_compute(
         w(f"        {nid}_xprev = {nid}_x;")
         w(f"        {nid}_yprev = {nid};")
 
+    elif isinstance(node, FIR):
+        _emit_fir_compute(node, ref, name, w)
+
     elif isinstance(node, SinOsc):
         nid = node.id
         freq = ref(node.freq)
         w(f"        float {nid} = sinf(6.28318530f * {nid}_phase);")
-        w(f"        {nid}_phase += {freq} / sr;")
-        w(f"        if ({nid}_phase >= 1.0f) {nid}_phase -= 1.0f;")
+        _emit_phase_advance(nid, freq, w)
 
     elif isinstance(node, TriOsc):
         nid = node.id
         freq = ref(node.freq)
         w(f"        float {nid} = 4.0f * fabsf({nid}_phase - 0.5f) - 1.0f;")
-        w(f"        {nid}_phase += {freq} / sr;")
-        w(f"        if ({nid}_phase >= 1.0f) {nid}_phase -= 1.0f;")
+        _emit_phase_advance(nid, freq, w)
 
     elif isinstance(node, SawOsc):
         nid = node.id
         freq = ref(node.freq)
         w(f"        float {nid} = 2.0f * {nid}_phase - 1.0f;")
-        w(f"        {nid}_phase += {freq} / sr;")
-        w(f"        if ({nid}_phase >= 1.0f) {nid}_phase -= 1.0f;")
+        _emit_phase_advance(nid, freq, w)
 
     elif isinstance(node, PulseOsc):
         nid = node.id
         freq = ref(node.freq)
         width = ref(node.width)
         w(f"        float {nid} = {nid}_phase < {width} ? 1.0f : -1.0f;")
-        w(f"        {nid}_phase += {freq} / sr;")
-        w(f"        if ({nid}_phase >= 1.0f) {nid}_phase -= 1.0f;")
+        _emit_phase_advance(nid, freq, w)
 
     elif isinstance(node, SampleHold):
         nid = node.id
@@ -1295,15 +2137,26 @@ def _emit_node_compute(
         nid = node.id
         buf = node.buffer
         idx = ref(node.index)
+        # Known index spans let the per-index clamps be dropped
+        bound = None
+        span = _int_span(rng(node.index))
+        if ranges is not None and span is not None:
+            bound = (span[0], span[1], ranges.sizes[buf])
         if node.interp == "none":
             w(f"        int {nid}_idx = (int)({idx});")
-            w(f"        if ({nid}_idx < 0) {nid}_idx = 0;")
-            w(f"        if ({nid}_idx >= {buf}_len) {nid}_idx = {buf}_len - 1;")
-            w(f"        float {nid} = {buf}_buf[{nid}_idx];")
+            _clamp_buf_idx(nid, "idx", buf, w, bound)
+            sample = _buf_load(buf, f"{nid}_idx", ranges)
+            w(f"        float {nid} = {_buf_scaled(buf, sample, ranges)};")
         elif node.interp == "linear":
-            _emit_buf_interp_linear(nid, buf, idx, w)
+            _emit_buf_interp_linear(nid, buf, idx, w, bound, ranges)
         elif node.interp == "cubic":
-            _emit_buf_interp_cubic(nid, buf, idx, w)
+            _emit_buf_interp_cubic(nid, buf, idx, w, bound, ranges)
+
+    elif isinstance(node, Resample):
+        _emit_resample_compute(node, ref, name, w)
+
+    elif isinstance(node, Granulator):
+        _emit_granulator_compute(node, ref, name, w)
 
     elif isinstance(node, BufWrite):
         nid = node.id
@@ -1311,8 +2164,15 @@ def _emit_node_compute(
         idx = ref(node.index)
         val = ref(node.value)
         w(f"        int {nid}_idx = (int)({idx});")
-        w(f"        if ({nid}_idx >= 0 && {nid}_idx < {buf}_len)")
-        w(f"            {buf}_buf[{nid}_idx] = {val};")
+        store = _buf_store(name, val, ranges is not None and buf in ranges.s16)
+        if ranges and buf in ranges.tables:
+            w(f"        if ({nid}_idx >= 0 && {nid}_idx < {buf}_len) {{")
+            w(f"            {buf}_buf[{nid}_idx] = {store};")
+            _emit_table_write_guard(nid, buf, ranges.sizes[buf], w)
+            w("        }")
+        else:
+            w(f"        if ({nid}_idx >= 0 && {nid}_idx < {buf}_len)")
+            w(f"            {buf}_buf[{nid}_idx] = {store};")
 
     elif isinstance(node, Splat):
         nid = node.id
@@ -1320,8 +2180,20 @@ def _emit_node_compute(
         idx = ref(node.index)
         val = ref(node.value)
         w(f"        int {nid}_idx = (int)({idx});")
-        w(f"        if ({nid}_idx >= 0 && {nid}_idx < {buf}_len)")
-        w(f"            {buf}_buf[{nid}_idx] += {val};")
+        if ranges is not None and buf in ranges.s16:
+            # Read-modify-write through float, saturating the sum
+            acc = _buf_scaled(buf, _buf_load(buf, f"{nid}_idx", ranges), ranges)
+            op = f"= {_buf_store(name, f'{acc} + {val}', True)}"
+        else:
+            op = f"+= {val}"
+        if ranges and buf in ranges.tables:
+            w(f"        if ({nid}_idx >= 0 && {nid}_idx < {buf}_len) {{")
+            w(f"            {buf}_buf[{nid}_idx] {op};")
+            _emit_table_write_guard(nid, buf, ranges.sizes[buf], w)
+            w("        }")
+        else:
+            w(f"        if ({nid}_idx >= 0 && {nid}_idx < {buf}_len)")
+            w(f"            {buf}_buf[{nid}_idx] {op};")
 
     elif isinstance(node, BufSize):
         w(f"        float {node.id} = (float)self->m_{node.buffer}_len;")
@@ -1330,16 +2202,30 @@ def _emit_node_compute(
         nid = node.id
         buf = node.buffer
         phase = ref(node.phase)
-        # phase [0,1) wraps, linear interpolation
-        w(f"        float {nid}_p = {phase} - floorf({phase});")
-        w(f"        float {nid}_fidx = {nid}_p * (float){buf}_len;")
-        w(f"        int {nid}_i0 = (int){nid}_fidx;")
-        w(f"        float {nid}_frac = {nid}_fidx - (float){nid}_i0;")
-        w(f"        int {nid}_i1 = ({nid}_i0 + 1) % {buf}_len;")
-        w(f"        {nid}_i0 = {nid}_i0 % {buf}_len;")
-        w(
-            f"        float {nid} = {buf}_buf[{nid}_i0] + {nid}_frac * ({buf}_buf[{nid}_i1] - {buf}_buf[{nid}_i0]);"
-        )
+        # phase [0,1) wraps, linear interpolation. The table's guard
+        # samples stand in for buf[0] and buf[1], so i0 + 1 needs no wrap.
+        size = ranges.sizes[buf] if ranges else 0
+        in_unit = _within(rng(node.phase), 0.0, _math.nextafter(1.0, 0.0))
+        if (
+            not in_unit
+            and _is_pow2(size)
+            and _within(rng(node.phase), 0.0, 2**24 / size)
+        ):
+            # Scaling by a power of two is exact, so masking the integer
+            # part of phase * len matches the floorf() wrap bit for bit
+            w(f"        float {nid}_fidx = {phase} * (float){buf}_len;")
+            w(f"        int {nid}_ip = (int){nid}_fidx;")
+            w(f"        float {nid}_frac = {nid}_fidx - (float){nid}_ip;")
+            w(f"        int {nid}_i0 = {nid}_ip & ({buf}_len - 1);")
+        else:
+            if in_unit:
+                w(f"        float {nid}_p = {phase};")
+            else:
+                w(f"        float {nid}_p = {phase} - floorf({phase});")
+            w(f"        float {nid}_fidx = {nid}_p * (float){buf}_len;")
+            w(f"        int {nid}_i0 = (int){nid}_fidx;")
+            w(f"        float {nid}_frac = {nid}_fidx - (float){nid}_i0;")
+        _emit_table_lerp(nid, buf, ranges, w)
 
     elif isinstance(node, Wave):
         nid = node.id
@@ -1348,17 +2234,15 @@ def _emit_node_compute(
         # phase [-1,1] maps to [0, len), clamped
         w(f"        float {nid}_norm = ({phase} + 1.0f) * 0.5f;")
         w(f"        float {nid}_fidx = {nid}_norm * (float)({buf}_len - 1);")
-        w(f"        if ({nid}_fidx < 0.0f) {nid}_fidx = 0.0f;")
-        w(
-            f"        if ({nid}_fidx > (float)({buf}_len - 1)) {nid}_fidx = (float)({buf}_len - 1);"
-        )
+        if not _within(rng(node.phase), -1.0, 1.0):
+            w(f"        if ({nid}_fidx < 0.0f) {nid}_fidx = 0.0f;")
+            w(
+                f"        if ({nid}_fidx > (float)({buf}_len - 1)) {nid}_fidx = (float)({buf}_len - 1);"
+            )
         w(f"        int {nid}_i0 = (int){nid}_fidx;")
         w(f"        float {nid}_frac = {nid}_fidx - (float){nid}_i0;")
-        w(f"        int {nid}_i1 = {nid}_i0 + 1;")
-        w(f"        if ({nid}_i1 >= {buf}_len) {nid}_i1 = {buf}_len - 1;")
-        w(
-            f"        float {nid} = {buf}_buf[{nid}_i0] + {nid}_frac * ({buf}_buf[{nid}_i1] - {buf}_buf[{nid}_i0]);"
-        )
+        # i0 + 1 reaches the guard only at the end, where frac is 0
+        _emit_table_lerp(nid, buf, ranges, w)
 
     elif isinstance(node, Lookup):
         nid = node.id
@@ -1366,16 +2250,51 @@ def _emit_node_compute(
         idx = ref(node.index)
         # index [0,1] clamped, linear interpolation
         w(f"        float {nid}_ci = {idx};")
-        w(f"        if ({nid}_ci < 0.0f) {nid}_ci = 0.0f;")
-        w(f"        if ({nid}_ci > 1.0f) {nid}_ci = 1.0f;")
+        if not _within(rng(node.index), 0.0, 1.0):
+            w(f"        if ({nid}_ci < 0.0f) {nid}_ci = 0.0f;")
+            w(f"        if ({nid}_ci > 1.0f) {nid}_ci = 1.0f;")
         w(f"        float {nid}_fidx = {nid}_ci * (float)({buf}_len - 1);")
         w(f"        int {nid}_i0 = (int){nid}_fidx;")
         w(f"        float {nid}_frac = {nid}_fidx - (float){nid}_i0;")
-        w(f"        int {nid}_i1 = {nid}_i0 + 1;")
-        w(f"        if ({nid}_i1 >= {buf}_len) {nid}_i1 = {buf}_len - 1;")
+        # i0 + 1 reaches the guard only at the end, where frac is 0
+        _emit_table_lerp(nid, buf, ranges, w)
+
+    elif isinstance(node, WavetableOsc):
+        nid = node.id
+        size = ranges.sizes[node.buffer] if ranges else 0
+        levels = mip_levels(size)
+        stride = size + 2
+        # Level choice and increment follow freq changes only. Level l keeps
+        # harmonics up to size >> (l + 1); crossfading l and l + 1 at
+        # log2(2 * size * f / sr) keeps every partial below Nyquist.
+        w(f"        float {nid}_fq = {ref(node.freq)};")
+        w(f"        if ({nid}_fq != {nid}_f) {{")
+        w(f"            {nid}_f = {nid}_fq;")
+        w(f"            float {nid}_af = fminf(fabsf({nid}_fq), 0.5f * sr);")
+        w(f"            {nid}_inc = copysignf({nid}_af, {nid}_fq) / sr;")
+        w(
+            f"            float {nid}_pos = fminf(fmaxf(log2f({_float_lit(2.0 * size)} * {nid}_af / sr), 0.0f), {_float_lit(float(levels - 1))});"
+        )
+        w(f"            int {nid}_l = (int){nid}_pos;")
+        w(f"            if ({nid}_l > {levels - 2}) {nid}_l = {levels - 2};")
+        w(f"            {nid}_t = {nid}_pos - (float){nid}_l;")
+        w(f"            {nid}_lo = {nid}_l * {stride};")
+        w("        }")
+        w(f"        float {nid}_x = {nid}_phase * {_float_lit(float(size))};")
+        w(f"        int {nid}_i = (int){nid}_x;")
+        w(f"        float {nid}_fr = {nid}_x - (float){nid}_i;")
+        w(f"        const float* {nid}_a = {nid}_mip + {nid}_lo + {nid}_i;")
+        w(f"        const float* {nid}_b = {nid}_a + {stride};")
+        w(
+            f"        float {nid}_va = {nid}_a[0] + {nid}_fr * ({nid}_a[1] - {nid}_a[0]);"
+        )
         w(
-            f"        float {nid} = {buf}_buf[{nid}_i0] + {nid}_frac * ({buf}_buf[{nid}_i1] - {buf}_buf[{nid}_i0]);"
+            f"        float {nid}_vb = {nid}_b[0] + {nid}_fr * ({nid}_b[1] - {nid}_b[0]);"
         )
+        w(f"        float {nid} = {nid}_va + {nid}_t * ({nid}_vb - {nid}_va);")
+        w(f"        {nid}_phase += {nid}_inc;")
+        w(f"        if ({nid}_phase >= 1.0f) {nid}_phase -= 1.0f;")
+        w(f"        else if ({nid}_phase < 0.0f) {nid}_phase += 1.0f;")
 
     elif isinstance(node, RateDiv):
         nid = node.id
@@ -1471,6 +2390,12 @@ def _emit_node_compute(
         w("        }")
         w(f"        float {nid} = {nid}_output;")
 
+    elif isinstance(node, Undersample):
+        _emit_undersample_compute(node, ref, name, w)
+
+    elif isinstance(node, Subgraph):
+        _emit_outlined_call(node, ref, w)
+
     elif isinstance(node, Peek):
         nid = node.id
         a = ref(node.a)
@@ -1504,8 +2429,7 @@ def _emit_node_compute(
         idx = ref(node.index)
         a = ref(node.a)
         w(f"        int {nid}_idx = (int)({idx});")
-        w(f"        if ({nid}_idx < 0) {nid}_idx = 0;")
-        w(f"        if ({nid}_idx > {node.count}) {nid}_idx = {node.count};")
+        _clamp_select_idx(nid, node.count, _int_span(rng(node.index)), w)
         w(f"        float {nid}_val = {a};")
 
     elif isinstance(node, GateOut):
@@ -1518,8 +2442,7 @@ def _emit_node_compute(
         idx = ref(node.index)
         n = len(node.inputs)
         w(f"        int {nid}_idx = (int)({idx});")
-        w(f"        if ({nid}_idx < 0) {nid}_idx = 0;")
-        w(f"        if ({nid}_idx > {n}) {nid}_idx = {n};")
+        _clamp_select_idx(nid, n, _int_span(rng(node.index)), w)
         # Build cascading ternary
         expr = "0.0f"
         for i in range(n, 0, -1):
@@ -1527,6 +2450,21 @@ def _emit_node_compute(
             expr = f"{nid}_idx == {i} ? {input_ref} : {expr}"
         w(f"        float {nid} = {expr};")
 
+    if ranges is not None and ranges.check and not isinstance(node, History):
+        _emit_range_check(node.id, ranges.of(node.id), w)
+
+
+def _emit_range_check(nid: str, iv: Interval, w: _Writer) -> None:
+    """Assert a node value against its inferred range (debug builds).
+
+    Bounds are widened slightly: they were derived in double precision.
+    """
+    if not is_bounded(iv):
+        return
+    lo = iv[0] - 1e-5 * max(1.0, abs(iv[0]))
+    hi = iv[1] + 1e-5 * max(1.0, abs(iv[1]))
+    w(f"        assert({nid} >= {_float_lit(lo)} && {nid} <= {_float_lit(hi)});")
+
 
 # ---------------------------------------------------------------------------
 # Interpolation helpers
@@ -1538,30 +2476,38 @@ def _wrap_idx(expr: str, dl: str) -> str:
     return f"(({expr}) % {dl}_len + {dl}_len) % {dl}_len"
 
 
-def _emit_interp_linear(nid: str, dl: str, tap: str, w: _Writer) -> None:
+def _emit_delay_idx(var: str, expr: str, dl: str, near: bool, w: _Writer) -> None:
+    """Declare a wrapped delay index; *near* means expr is in [-len, len)."""
+    if near:
+        w(f"        int {var} = {expr};")
+        w(f"        if ({var} < 0) {var} += {dl}_len;")
+    else:
+        w(f"        int {var} = {_wrap_idx(expr, dl)};")
+
+
+def _emit_interp_linear(
+    nid: str, dl: str, tap: str, w: _Writer, near: bool = False
+) -> None:
     w(f"        float {nid}_ftap = {tap};")
     w(f"        int {nid}_itap = (int){nid}_ftap;")
     w(f"        float {nid}_frac = {nid}_ftap - (float){nid}_itap;")
-    i0 = _wrap_idx(f"{dl}_wr - {nid}_itap", dl)
-    i1 = _wrap_idx(f"{dl}_wr - {nid}_itap - 1", dl)
-    w(f"        int {nid}_i0 = {i0};")
-    w(f"        int {nid}_i1 = {i1};")
+    _emit_delay_idx(f"{nid}_i0", f"{dl}_wr - {nid}_itap", dl, near, w)
+    _emit_delay_idx(f"{nid}_i1", f"{dl}_wr - {nid}_itap - 1", dl, near, w)
     s0 = f"{dl}_buf[{nid}_i0]"
     s1 = f"{dl}_buf[{nid}_i1]"
     w(f"        float {nid} = {s0} + {nid}_frac * ({s1} - {s0});")
 
 
-def _emit_interp_cubic(nid: str, dl: str, tap: str, w: _Writer) -> None:
+def _emit_interp_cubic(
+    nid: str, dl: str, tap: str, w: _Writer, near: bool = False
+) -> None:
     w(f"        float {nid}_ftap = {tap};")
     w(f"        int {nid}_itap = (int){nid}_ftap;")
     w(f"        float {nid}_frac = {nid}_ftap - (float){nid}_itap;")
-    i0 = _wrap_idx(f"{dl}_wr - {nid}_itap", dl)
-    w(f"        int {nid}_i0 = {i0};")
+    _emit_delay_idx(f"{nid}_i0", f"{dl}_wr - {nid}_itap", dl, near, w)
     w(f"        int {nid}_im1 = ({nid}_i0 + 1) % {dl}_len;")
-    i1 = _wrap_idx(f"{dl}_wr - {nid}_itap - 1", dl)
-    i2 = _wrap_idx(f"{dl}_wr - {nid}_itap - 2", dl)
-    w(f"        int {nid}_i1 = {i1};")
-    w(f"        int {nid}_i2 = {i2};")
+    _emit_delay_idx(f"{nid}_i1", f"{dl}_wr - {nid}_itap - 1", dl, near, w)
+    _emit_delay_idx(f"{nid}_i2", f"{dl}_wr - {nid}_itap - 2", dl, near, w)
     w(f"        float {nid}_ym1 = {dl}_buf[{nid}_im1];")
     w(f"        float {nid}_y0 = {dl}_buf[{nid}_i0];")
     w(f"        float {nid}_y1 = {dl}_buf[{nid}_i1];")
@@ -1579,44 +2525,203 @@ def _emit_interp_cubic(nid: str, dl: str, tap: str, w: _Writer) -> None:
 
 
 # ---------------------------------------------------------------------------
-# Buffer interpolation helpers
+# Multi-tap delay reads
 # ---------------------------------------------------------------------------
 
 
-def _clamp_buf_idx(nid: str, suffix: str, buf: str, w: _Writer) -> None:
-    """Emit clamping for a buffer index variable to [0, buf_len-1]."""
-    var = f"{nid}_{suffix}"
-    w(f"        if ({var} < 0) {var} = 0;")
-    w(f"        if ({var} >= {buf}_len) {var} = {buf}_len - 1;")
-
-
-def _emit_buf_interp_linear(nid: str, buf: str, idx: str, w: _Writer) -> None:
-    w(f"        float {nid}_fidx = {idx};")
-    w(f"        int {nid}_i0 = (int){nid}_fidx;")
-    w(f"        float {nid}_frac = {nid}_fidx - (float){nid}_i0;")
-    w(f"        int {nid}_i1 = {nid}_i0 + 1;")
-    _clamp_buf_idx(nid, "i0", buf, w)
-    _clamp_buf_idx(nid, "i1", buf, w)
-    w(f"        float {nid}_s0 = {buf}_buf[{nid}_i0];")
-    w(f"        float {nid}_s1 = {buf}_buf[{nid}_i1];")
-    w(f"        float {nid} = {nid}_s0 + {nid}_frac * ({nid}_s1 - {nid}_s0);")
-
+def _emit_multitap_compute(
+    node: MultiTapRead,
+    ref: Callable[[str | float], str],
+    rng: Callable[[str | float], Interval],
+    ranges: _Ranges | None,
+    w: _Writer,
+) -> None:
+    """Emit a multi-tap read as offsets from one shared base index.
 
-def _emit_buf_interp_cubic(nid: str, buf: str, idx: str, w: _Writer) -> None:
-    w(f"        float {nid}_fidx = {idx};")
-    w(f"        int {nid}_i0 = (int){nid}_fidx;")
-    w(f"        float {nid}_frac = {nid}_fidx - (float){nid}_i0;")
-    w(f"        int {nid}_im1 = {nid}_i0 - 1;")
-    w(f"        int {nid}_i1 = {nid}_i0 + 1;")
+    ``base = wr + len`` puts every in-range tap's index in ``[0, 2 len)``,
+    so a single conditional subtract wraps it. Literal taps are validated
+    in range; runtime taps proven in range by range inference get the same
+    treatment and the rest fall back to the double modulo. Term ``k`` goes
+    into partial sum ``k % 4`` so the adds are not one serial chain.
+    """
+    nid = node.id
+    dl = node.delay
+    n = len(node.taps)
+    table = multitap_table(node)
+    lanes = multitap_lanes(len(table) if table is not None else n)
+    acc = [f"{nid}_acc[{lane}]" for lane in range(lanes)]
+    w(f"        float {nid};")
+    w(f"        {{ // MultiTapRead {nid}: {n} taps on {dl}")
+    w(f"            int {nid}_base = {dl}_wr + {dl}_len;")
+    w(f"            float {nid}_acc[{lanes}] = {{0.0f}};")
+    if table is not None:
+        # Constant taps: a table-driven loop, one term per partial sum
+        k = len(table)
+        whole = k - k % lanes
+        offsets = ", ".join(str(off) for off, _ in table)
+        weights = ", ".join(_float_lit(g) for _, g in table)
+        w(f"            static const int {nid}_off[{k}] = {{{offsets}}};")
+        w(f"            static const float {nid}_w[{k}] = {{{weights}}};")
+        if whole:
+            w(
+                f"            for (int {nid}_k = 0; {nid}_k < {whole}; {nid}_k += {lanes}) {{"
+            )
+            w(f"                for (int {nid}_l = 0; {nid}_l < {lanes}; {nid}_l++) {{")
+            w(
+                f"                    int {nid}_j = {nid}_base - {nid}_off[{nid}_k + {nid}_l];"
+            )
+            w(f"                    if ({nid}_j >= {dl}_len) {nid}_j -= {dl}_len;")
+            w(
+                f"                    {nid}_acc[{nid}_l] += "
+                f"{nid}_w[{nid}_k + {nid}_l] * {dl}_buf[{nid}_j];"
+            )
+            w("                }")
+            w("            }")
+        if whole < k:
+            w(f"            for (int {nid}_k = {whole}; {nid}_k < {k}; {nid}_k++) {{")
+            w(f"                int {nid}_j = {nid}_base - {nid}_off[{nid}_k];")
+            w(f"                if ({nid}_j >= {dl}_len) {nid}_j -= {dl}_len;")
+            w(
+                f"                {nid}_acc[{nid}_k - {whole}] += "
+                f"{nid}_w[{nid}_k] * {dl}_buf[{nid}_j];"
+            )
+            w("            }")
+        w(f"            {nid} = {_sum_tree(acc)};")
+        w("        }")
+        return
+
+    linear = node.interp == "linear"
+    size = ranges.sizes[dl] if ranges else None
+    gains: list[str | float] = list(node.gains) or [1.0] * n
+    for k, (tap, gain) in enumerate(zip(node.taps, gains)):
+        j = f"{nid}_j{k}"
+        frac: str | None = None
+        if isinstance(tap, float):
+            whole = int(tap)
+            itap = str(whole)
+            near = True
+            if linear and tap != whole:
+                frac = _float_lit(tap - whole)
+        else:
+            span = _int_span(rng(tap))
+            near = (
+                size is not None
+                and span is not None
+                and span[0] >= 0
+                and span[1] + int(linear) <= size
+            )
+            if linear:
+                w(f"            float {nid}_t{k} = {ref(tap)};")
+                w(f"            int {nid}_i{k} = (int){nid}_t{k};")
+                itap = f"{nid}_i{k}"
+                frac = f"({nid}_t{k} - (float){nid}_i{k})"
+            else:
+                itap = f"(int)({ref(tap)})"
+        if near:
+            w(f"            int {j} = {nid}_base - {itap};")
+            w(f"            if ({j} >= {dl}_len) {j} -= {dl}_len;")
+        else:
+            w(f"            int {j} = {_wrap_idx(f'{dl}_wr - {itap}', dl)};")
+        read = f"{dl}_buf[{j}]"
+        if frac is not None:
+            # The next-older sample is always one step behind, so it wraps
+            # with a conditional add whatever the tap
+            h = f"{nid}_h{k}"
+            w(f"            int {h} = {j} - 1;")
+            w(f"            if ({h} < 0) {h} += {dl}_len;")
+            read = f"({read} + {frac} * ({dl}_buf[{h}] - {read}))"
+        scale = "" if gain == 1.0 else f"{ref(gain)} * "
+        w(f"            {acc[k % lanes]} += {scale}{read};")
+    w(f"            {nid} = {_sum_tree(acc)};")
+    w("        }")
+
+
+# ---------------------------------------------------------------------------
+# Buffer interpolation helpers
+# ---------------------------------------------------------------------------
+
+
+_IdxBound = tuple[int, int, int]  # (lo, hi) of the base index, buffer length
+
+
+def _clamp_buf_idx(
+    nid: str,
+    suffix: str,
+    buf: str,
+    w: _Writer,
+    bound: _IdxBound | None = None,
+    offset: int = 0,
+) -> None:
+    """Emit clamping for a buffer index variable to [0, buf_len-1].
+
+    With a known *bound* on the base index, each side is clamped only if
+    base + *offset* can actually leave the buffer.
+    """
+    var = f"{nid}_{suffix}"
+    if bound is None or bound[0] + offset < 0:
+        w(f"        if ({var} < 0) {var} = 0;")
+    if bound is None or bound[1] + offset > bound[2] - 1:
+        w(f"        if ({var} >= {buf}_len) {var} = {buf}_len - 1;")
+
+
+def _clamp_select_idx(
+    nid: str, count: int, span: tuple[int, int] | None, w: _Writer
+) -> None:
+    """Clamp a 1-based selector index to [0, count] unless known in range."""
+    if span is None or span[0] < 0:
+        w(f"        if ({nid}_idx < 0) {nid}_idx = 0;")
+    if span is None or span[1] > count:
+        w(f"        if ({nid}_idx > {count}) {nid}_idx = {count};")
+
+
+def _emit_table_lerp(nid: str, buf: str, ranges: _Ranges | None, w: _Writer) -> None:
+    """Linear read of samples ``i0`` and ``i0 + 1`` for Cycle/Wave/Lookup."""
+    s0 = _buf_load(buf, f"{nid}_i0", ranges)
+    s1 = _buf_load(buf, f"{nid}_i0 + 1", ranges)
+    lerp = f"{s0} + {nid}_frac * ({s1} - {s0})"
+    w(f"        float {nid} = {_buf_scaled(buf, lerp, ranges)};")
+
+
+def _emit_buf_interp_linear(
+    nid: str,
+    buf: str,
+    idx: str,
+    w: _Writer,
+    bound: _IdxBound | None = None,
+    ranges: _Ranges | None = None,
+) -> None:
+    w(f"        float {nid}_fidx = {idx};")
+    w(f"        int {nid}_i0 = (int){nid}_fidx;")
+    w(f"        float {nid}_frac = {nid}_fidx - (float){nid}_i0;")
+    w(f"        int {nid}_i1 = {nid}_i0 + 1;")
+    _clamp_buf_idx(nid, "i0", buf, w, bound)
+    _clamp_buf_idx(nid, "i1", buf, w, bound, 1)
+    w(f"        float {nid}_s0 = {_buf_load(buf, f'{nid}_i0', ranges)};")
+    w(f"        float {nid}_s1 = {_buf_load(buf, f'{nid}_i1', ranges)};")
+    lerp = f"{nid}_s0 + {nid}_frac * ({nid}_s1 - {nid}_s0)"
+    w(f"        float {nid} = {_buf_scaled(buf, lerp, ranges)};")
+
+
+def _emit_buf_interp_cubic(
+    nid: str,
+    buf: str,
+    idx: str,
+    w: _Writer,
+    bound: _IdxBound | None = None,
+    ranges: _Ranges | None = None,
+) -> None:
+    w(f"        float {nid}_fidx = {idx};")
+    w(f"        int {nid}_i0 = (int){nid}_fidx;")
+    w(f"        float {nid}_frac = {nid}_fidx - (float){nid}_i0;")
+    w(f"        int {nid}_im1 = {nid}_i0 - 1;")
+    w(f"        int {nid}_i1 = {nid}_i0 + 1;")
     w(f"        int {nid}_i2 = {nid}_i0 + 2;")
-    _clamp_buf_idx(nid, "im1", buf, w)
-    _clamp_buf_idx(nid, "i0", buf, w)
-    _clamp_buf_idx(nid, "i1", buf, w)
-    _clamp_buf_idx(nid, "i2", buf, w)
-    w(f"        float {nid}_ym1 = {buf}_buf[{nid}_im1];")
-    w(f"        float {nid}_y0 = {buf}_buf[{nid}_i0];")
-    w(f"        float {nid}_y1 = {buf}_buf[{nid}_i1];")
-    w(f"        float {nid}_y2 = {buf}_buf[{nid}_i2];")
+    _clamp_buf_idx(nid, "im1", buf, w, bound, -1)
+    _clamp_buf_idx(nid, "i0", buf, w, bound)
+    _clamp_buf_idx(nid, "i1", buf, w, bound, 1)
+    _clamp_buf_idx(nid, "i2", buf, w, bound, 2)
+    for k in ("m1", "0", "1", "2"):
+        w(f"        float {nid}_y{k} = {_buf_load(buf, f'{nid}_i{k}', ranges)};")
     w(f"        float {nid}_c0 = {nid}_y0;")
     w(f"        float {nid}_c1 = 0.5f * ({nid}_y1 - {nid}_ym1);")
     c2a = f"{nid}_ym1 - 2.5f * {nid}_y0"
@@ -1626,7 +2731,7 @@ def _emit_buf_interp_cubic(nid: str, buf: str, idx: str, w: _Writer) -> None:
     c3b = f"1.5f * ({nid}_y0 - {nid}_y1)"
     w(f"        float {nid}_c3 = {c3a} + {c3b};")
     horner = f"(({nid}_c3 * {nid}_frac + {nid}_c2) * {nid}_frac + {nid}_c1) * {nid}_frac + {nid}_c0"
-    w(f"        float {nid} = {horner};")
+    w(f"        float {nid} = {_buf_scaled(buf, horner, ranges)};")
 
 
 # ---------------------------------------------------------------------------
@@ -1665,7 +2770,45 @@ def _emit_param_set(
     w(f"void {name}_set_param({struct_name}* self, int index, float value) {{")
     w("    switch (index) {")
     for idx, p in enumerate(params):
-        w(f"    case {idx}: self->p_{p.name} = value; break;")
+        w(
+            f"    case {idx}: self->p_{p.name} = value; self->r_{p.name}_left = 0; break;"
+        )
+    w("    default: break;")
+    w("    }")
+    w("}")
+
+
+def _emit_param_ramp(
+    params: list[Param], name: str, struct_name: str, w: _Writer
+) -> None:
+    """Emit ``{name}_set_param_ramp``: glide a param linearly over n samples.
+
+    A non-positive sample count (or an unchanged value) jumps immediately,
+    like ``set_param``; a new ramp replaces any ramp already in flight.
+    """
+    if params:
+        w(
+            f"static void {name}_ramp_to(float* p, float* inc, float* tgt, int* left, float target, int nsamples) {{"
+        )
+        w("    if (nsamples <= 0 || target == *p) {")
+        w("        *p = target;")
+        w("        *left = 0;")
+        w("        return;")
+        w("    }")
+        w("    *tgt = target;")
+        w("    *inc = (target - *p) / (float)nsamples;")
+        w("    *left = nsamples;")
+        w("}")
+        w("")
+    w(
+        f"void {name}_set_param_ramp({struct_name}* self, int index, float target, int nsamples) {{"
+    )
+    w("    switch (index) {")
+    for idx, p in enumerate(params):
+        r = f"self->r_{p.name}"
+        w(
+            f"    case {idx}: {name}_ramp_to(&self->p_{p.name}, &{r}_inc, &{r}_target, &{r}_left, target, nsamples); break;"
+        )
     w("    default: break;")
     w("    }")
     w("}")
@@ -1689,7 +2832,12 @@ def _emit_param_get(
 
 
 def _emit_buffer_api(
-    buffer_nodes: list[Buffer], name: str, struct_name: str, w: _Writer
+    buffer_nodes: list[Buffer],
+    name: str,
+    struct_name: str,
+    w: _Writer,
+    tables: frozenset[str] = frozenset(),
+    mips: frozenset[str] = frozenset(),
 ) -> None:
     count = len(buffer_nodes)
 
@@ -1717,11 +2865,12 @@ def _emit_buffer_api(
     w("}")
     w("")
 
-    # get_buffer
+    # get_buffer (float storage only; int16 buffers load via set_buffer)
     w(f"float* {name}_get_buffer({struct_name}* self, int index) {{")
     w("    switch (index) {")
     for idx, buf in enumerate(buffer_nodes):
-        w(f"    case {idx}: return self->m_{buf.id}_buf;")
+        if buf.format == "float32":
+            w(f"    case {idx}: return self->m_{buf.id}_buf;")
     w("    default: return nullptr;")
     w("    }")
     w("}")
@@ -1731,18 +2880,1060 @@ def _emit_buffer_api(
     w(
         f"void {name}_set_buffer({struct_name}* self, int index, const float* data, int len) {{"
     )
+    s16 = any(buf.format == "int16" for buf in buffer_nodes)
     w("    float* dst = nullptr;")
+    if s16:
+        w("    int16_t* dst16 = nullptr;")
     w("    int cap = 0;")
+    if tables:
+        w("    int guard = 0;")
     w("    switch (index) {")
     for idx, buf in enumerate(buffer_nodes):
+        guard = f" guard = {_TABLE_GUARD};" if buf.id in tables else ""
+        dst = "dst16" if buf.format == "int16" else "dst"
         w(
-            f"    case {idx}: dst = self->m_{buf.id}_buf; cap = self->m_{buf.id}_len; break;"
+            f"    case {idx}: {dst} = self->m_{buf.id}_buf; cap = self->m_{buf.id}_len;{guard} break;"
         )
     w("    default: return;")
     w("    }")
     w("    int copy_len = len < cap ? len : cap;")
+    if s16:
+        # Float input, converted and saturated once here
+        w("    if (dst16) {")
+        w(
+            f"        for (int i = 0; i < copy_len; i++) dst16[i] = {name}_to_s16(data[i]);"
+        )
+        w("        for (int i = copy_len; i < cap; i++) dst16[i] = 0;")
+        if tables:
+            w(
+                "        for (int i = 0; i < guard; i++) dst16[cap + i] = dst16[i % cap];"
+            )
+        w("        return;")
+        w("    }")
     w("    for (int i = 0; i < copy_len; i++) dst[i] = data[i];")
     w("    for (int i = copy_len; i < cap; i++) dst[i] = 0.0f;")
+    if tables:
+        w("    for (int i = 0; i < guard; i++) dst[cap + i] = dst[i % cap];")
+    if mips:
+        w("    switch (index) {")
+        for idx, buf in enumerate(buffer_nodes):
+            if buf.id in mips:
+                w(f"    case {idx}:")
+                _emit_mip_build(name, buf, "        ", w)
+                w("        break;")
+        w("    }")
+    w("}")
+
+
+# ---------------------------------------------------------------------------
+# Undersample container
+# ---------------------------------------------------------------------------
+
+
+def _undersample_inner_name(name: str, nid: str) -> str:
+    """Name prefix of the inner graph compiled for Undersample *nid*."""
+    return f"{name}_{nid}"
+
+
+def _emit_float_table(
+    ident: str,
+    values: list[float],
+    w: _Writer,
+    lit: Callable[[float], str] = _float_lit,
+) -> None:
+    """Emit ``static const float ident[N] = {...};`` eight values per line."""
+    w(f"static const float {ident}[{len(values)}] = {{")
+    for k in range(0, len(values), 8):
+        chunk = ", ".join(lit(float(v)) for v in values[k : k + 8])
+        w(f"    {chunk},")
+    w("};")
+
+
+def _emit_undersample_defs(node: Undersample, name: str, w: _Writer) -> None:
+    """Emit the inner graph's code and filter tables ahead of the outer struct."""
+    inner_name = _undersample_inner_name(name, node.id)
+    inner_code = compile_graph(node.graph.model_copy(update={"name": inner_name}))
+    w(
+        f"// -- Undersample {node.id}: inner graph '{node.graph.name}' at sr/{node.factor}"
+    )
+    body = [ln for ln in inner_code.splitlines() if not ln.startswith(_STD_INCLUDE)]
+    while body and not body[0]:
+        body.pop(0)
+    for line in body:
+        w(line)
+    w("")
+    taps = undersample_taps(node)
+    _emit_float_table(f"{inner_name}_aa", undersample_filter(node.factor, taps), w)
+    _emit_float_table(f"{inner_name}_poly", undersample_poly(node), w)
+    w("")
+
+
+def _emit_undersample_compute(
+    node: Undersample, ref: Callable[[str | float], str], name: str, w: _Writer
+) -> None:
+    """Emit the per-sample decimate / inner step / interpolate sequence."""
+    nid = node.id
+    inner = node.graph
+    inner_name = _undersample_inner_name(name, nid)
+    taps = undersample_taps(node)
+    hist = undersample_hist_len(node)
+    n_in = len(node.inputs)
+    n_out = len(inner.outputs)
+    sel_id = node.output or inner.outputs[0].id
+    sel = next(k for k, o in enumerate(inner.outputs) if o.id == sel_id)
+
+    w(f"        float {nid};")
+    w(f"        {{ // Undersample {nid}: inner graph at sr/{node.factor}")
+    if n_in:
+        # Doubled history ring: the newest `taps` samples are contiguous
+        w(f"            if (++{nid}_dpos == {taps}) {nid}_dpos = 0;")
+        for k, r in enumerate(node.inputs):
+            base = k * 2 * taps
+            w(
+                f"            self->m_{nid}_dec[{base} + {nid}_dpos] = "
+                f"self->m_{nid}_dec[{base + taps} + {nid}_dpos] = {ref(r)};"
+            )
+    w(f"            if (++{nid}_phase == {node.factor}) {{")
+    w(f"                {nid}_phase = 0;")
+    if n_in:
+        w(f"                float {nid}_x[{n_in}];")
+        w(f"                float* {nid}_ins[{n_in}];")
+        w(f"                for (int _c = 0; _c < {n_in}; _c++) {{")
+        w(
+            f"                    const float* _d = self->m_{nid}_dec + _c * {2 * taps} + {nid}_dpos + {taps};"
+        )
+        w("                    float _acc = 0.0f;")
+        w(
+            f"                    for (int _t = 0; _t < {taps}; _t++) _acc += {inner_name}_aa[_t] * _d[-_t];"
+        )
+        w(f"                    {nid}_x[_c] = _acc;")
+        w(f"                    {nid}_ins[_c] = &{nid}_x[_c];")
+        w("                }")
+    # Through the setter, which also cancels any inner ramp
+    for k, r in enumerate(node.params):
+        w(
+            f"                {inner_name}_set_param(self->m_{nid}_inner, {k}, {ref(r)});"
+        )
+    w(f"                float {nid}_y[{n_out}];")
+    w(f"                float* {nid}_outs[{n_out}];")
+    w(
+        f"                for (int _c = 0; _c < {n_out}; _c++) {nid}_outs[_c] = &{nid}_y[_c];"
+    )
+    ins = f"{nid}_ins" if n_in else "nullptr"
+    w(
+        f"                {inner_name}_perform(self->m_{nid}_inner, {ins}, {nid}_outs, 1);"
+    )
+    w(f"                if (++{nid}_hpos == {hist}) {nid}_hpos = 0;")
+    w(
+        f"                self->m_{nid}_hist[{nid}_hpos] = "
+        f"self->m_{nid}_hist[{nid}_hpos + {hist}] = {nid}_y[{sel}];"
+    )
+    w("            }")
+    w(f"            const float* _h = {inner_name}_poly + {nid}_phase * {hist};")
+    w(f"            const float* _v = self->m_{nid}_hist + {nid}_hpos + {hist};")
+    w("            float _acc = 0.0f;")
+    w(f"            for (int _t = 0; _t < {hist}; _t++) _acc += _h[_t] * _v[-_t];")
+    w(f"            {nid} = _acc;")
+    w("        }")
+
+
+# ---------------------------------------------------------------------------
+# Feedback delay networks
+# ---------------------------------------------------------------------------
+
+
+def _sum_tree(terms: list[str]) -> str:
+    """Pairwise sum expression (independent adds instead of one long chain)."""
+    while len(terms) > 1:
+        pairs = [f"({a} + {b})" for a, b in zip(terms[::2], terms[1::2])]
+        terms = pairs + terms[len(pairs) * 2 :]
+    return terms[0]
+
+
+def _emit_fdn_clear(node: FDN, w: _Writer) -> None:
+    w(f"    memset(self->m_{node.id}_pos, 0, sizeof(self->m_{node.id}_pos));")
+    w(f"    memset(self->m_{node.id}_lp, 0, sizeof(self->m_{node.id}_lp));")
+
+
+def _emit_fdn_compute(node: FDN, ref: Callable[[str | float], str], w: _Writer) -> None:
+    """Emit one FDN step: read every line, damp, mix, write back.
+
+    The mix is straight-line code over small local arrays, so the C++
+    compiler can keep it in vector registers: a fast Walsh-Hadamard
+    transform (N log2 N adds, normalisation folded into the feedback
+    gain) or a Householder reflection (2N adds). Either way the plain sum
+    of the line outputs falls out of the mix and gives the node output.
+    """
+    nid = node.id
+    n = len(node.delays)
+    heads = [
+        f"{nid}_buf[{off} + {nid}_p{k}]" if off else f"{nid}_buf[{nid}_p{k}]"
+        for k, off in enumerate(fdn_offsets(node))
+    ]
+    w(f"        float {nid};")
+    w(f"        {{ // FDN {nid}: {n} lines, {node.matrix} feedback matrix")
+    w(f"            float {nid}_v[{n}];")
+    for k, head in enumerate(heads):
+        w(f"            {nid}_v[{k}] = {head};")
+    if node.damping != 0.0:
+        w(f"            float {nid}_dc = {ref(node.damping)};")
+        for k in range(n):
+            w(
+                f"            {nid}_v[{k}] = {nid}_lp{k} = "
+                f"{nid}_v[{k}] + {nid}_dc * ({nid}_lp{k} - {nid}_v[{k}]);"
+            )
+    if node.matrix == "hadamard":
+        src, dst = f"{nid}_v", f"{nid}_u"
+        w(f"            float {nid}_u[{n}];")
+        h = 1
+        while h < n:
+            for i in range(0, n, 2 * h):
+                for j in range(i, i + h):
+                    w(f"            {dst}[{j}] = {src}[{j}] + {src}[{j + h}];")
+                for j in range(i, i + h):
+                    w(f"            {dst}[{j + h}] = {src}[{j}] - {src}[{j + h}];")
+            src, dst = dst, src
+            h *= 2
+        # Row 0 of the unnormalised transform is the plain sum
+        w(f"            {nid} = {src}[0] * {_float_lit(1.0 / n)};")
+        gain = f"{ref(node.feedback)} * {_float_lit(1.0 / _math.sqrt(n))}"
+        mixed = [f"{src}[{k}]" for k in range(n)]
+    else:
+        terms = [f"{nid}_v[{k}]" for k in range(n)]
+        w(f"            float {nid}_sum = {_sum_tree(terms)};")
+        w(f"            {nid} = {nid}_sum * {_float_lit(1.0 / n)};")
+        w(f"            float {nid}_r = {nid}_sum * {_float_lit(2.0 / n)};")
+        gain = ref(node.feedback)
+        mixed = [f"({nid}_v[{k}] - {nid}_r)" for k in range(n)]
+    w(f"            float {nid}_g = {gain};")
+    w(f"            float {nid}_x = {ref(node.a)};")
+    for head, m in zip(heads, mixed):
+        w(f"            {head} = {nid}_x + {nid}_g * {m};")
+    for k, d in enumerate(node.delays):
+        w(f"            if (++{nid}_p{k} == {d}) {nid}_p{k} = 0;")
+    w("        }")
+
+
+# ---------------------------------------------------------------------------
+# Sliding-window extrema
+# ---------------------------------------------------------------------------
+
+
+def _emit_window_clear(node: WindowMax | WindowMin, w: _Writer) -> None:
+    w(f"    self->m_{node.id}_head = 0;")
+    w(f"    self->m_{node.id}_count = 0;")
+    w(f"    self->m_{node.id}_t = 0;")
+
+
+def _emit_window_compute(
+    node: WindowMax | WindowMin, ref: Callable[[str | float], str], w: _Writer
+) -> None:
+    """Emit one step of a monotonic-deque sliding max/min.
+
+    The deque holds the samples that can still become the extremum, in
+    arrival order and strictly decreasing (max) or increasing (min), so
+    the front is the answer. Each sample is pushed once and popped at
+    most once -- amortised O(1) per sample for any window length. Ages
+    are unsigned differences of a wrapping sample counter, so the counter
+    may overflow freely.
+    """
+    nid = node.id
+    cap = node.max_window
+    keep = ">" if isinstance(node, WindowMax) else "<"
+    kind = "WindowMax" if isinstance(node, WindowMax) else "WindowMin"
+    if isinstance(node.window, float):
+        span = f"{min(max(int(node.window), 1), cap)}u"
+    else:
+        # fmaxf first so a NaN window falls back to 1
+        span = f"(uint32_t)fminf(fmaxf({ref(node.window)}, 1.0f), {_float_lit(cap)})"
+    w(f"        float {nid};")
+    w(f"        {{ // {kind} {nid}: monotonic deque, capacity {cap}")
+    w(f"            float {nid}_x = {ref(node.a)};")
+    w(f"            uint32_t {nid}_w = {span};")
+    w(f"            uint32_t {nid}_now = {nid}_t++;")
+    # Expire from the front
+    w(
+        f"            while ({nid}_count && "
+        f"{nid}_now - {nid}_at[{nid}_head] >= {nid}_w) {{"
+    )
+    w(f"                if (++{nid}_head == {cap}) {nid}_head = 0;")
+    w(f"                {nid}_count--;")
+    w("            }")
+    # Drop dominated candidates from the back
+    w(f"            int {nid}_tail = {nid}_head + {nid}_count;")
+    w(f"            if ({nid}_tail >= {cap}) {nid}_tail -= {cap};")
+    w(f"            while ({nid}_count) {{")
+    w(f"                int {nid}_b = ({nid}_tail ? {nid}_tail : {cap}) - 1;")
+    w(f"                if ({nid}_val[{nid}_b] {keep} {nid}_x) break;")
+    w(f"                {nid}_tail = {nid}_b;")
+    w(f"                {nid}_count--;")
+    w("            }")
+    w(f"            {nid}_val[{nid}_tail] = {nid}_x;")
+    w(f"            {nid}_at[{nid}_tail] = {nid}_now;")
+    w(f"            {nid}_count++;")
+    w(f"            {nid} = {nid}_val[{nid}_head];")
+    w("        }")
+
+
+# ---------------------------------------------------------------------------
+# Moving averages
+# ---------------------------------------------------------------------------
+
+
+def _emit_average_clear(node: MovingAverage, w: _Writer) -> None:
+    w(f"    self->m_{node.id}_pos = 0;")
+    w(f"    self->m_{node.id}_sum = 0.0f;")
+    w(f"    self->m_{node.id}_fresh = 0.0f;")
+
+
+def _emit_average_compute(
+    node: MovingAverage, ref: Callable[[str | float], str], w: _Writer
+) -> None:
+    """Emit one step of a running-sum moving average.
+
+    ``sum`` is updated by adding the new term and subtracting the one it
+    evicts, which drifts as rounding errors pile up. ``fresh`` sums only
+    the terms written since the ring head last wrapped; at the wrap it
+    holds exactly the current window, so it replaces ``sum`` and starts
+    over. The error is bounded by one window of additions however long
+    the node runs, with no re-summation burst.
+    """
+    nid = node.id
+    n = node.window
+    w(f"        float {nid};")
+    w(f"        {{ // MovingAverage {nid}: {node.mode} over {n} samples")
+    w(f"            float {nid}_x = {ref(node.a)};")
+    term = f"{nid}_x * {nid}_x" if node.mode == "rms" else f"{nid}_x"
+    w(f"            float {nid}_v = {term};")
+    w(f"            {nid}_sum += {nid}_v - {nid}_buf[{nid}_pos];")
+    w(f"            {nid}_fresh += {nid}_v;")
+    w(f"            {nid}_buf[{nid}_pos] = {nid}_v;")
+    w(f"            if (++{nid}_pos == {n}) {{")
+    w(f"                {nid}_pos = 0;")
+    w(f"                {nid}_sum = {nid}_fresh;")
+    w(f"                {nid}_fresh = 0.0f;")
+    w("            }")
+    mean = f"{nid}_sum * {_float_lit(1.0 / n)}"
+    if node.mode == "rms":
+        # The running sum can dip just below zero between restarts
+        w(f"            {nid} = sqrtf(fmaxf({mean}, 0.0f));")
+    else:
+        w(f"            {nid} = {mean};")
+    w("        }")
+
+
+# ---------------------------------------------------------------------------
+# FIR filters
+# ---------------------------------------------------------------------------
+
+
+def _fir_taps(node: FIR, prefix: str = "") -> str:
+    """Tap count of *node*: a literal, or its coefficient buffer's length.
+
+    *prefix* reaches the buffer's length field (``"self->m_"`` outside
+    ``perform``, ``""`` for the local inside it).
+    """
+    if isinstance(node.coeffs, str):
+        return f"{prefix}{node.coeffs}_len"
+    return str(len(node.coeffs))
+
+
+def _emit_fir_dot(name: str, w: _Writer) -> None:
+    """Emit the dot product shared by every FIR and Resample node.
+
+    Four interleaved partial sums, combined as ``(s0 + s2) + (s1 + s3)``,
+    then the ``n % 4`` leftover taps in order. The SSE2, NEON and scalar
+    paths therefore round identically (without fused multiply-adds);
+    ``GEN_DSP_SIMD_SCALAR`` forces the scalar one, as in gen_dsp_simd.h.
+    """
+    flag = f"{name.upper()}_FIR"
+    w(
+        "#if !defined(GEN_DSP_SIMD_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || \\"
+    )
+    w("    (defined(_M_IX86_FP) && _M_IX86_FP >= 2))")
+    w("#include <emmintrin.h>")
+    w(f"#define {flag}_SSE2 1")
+    w(
+        "#elif !defined(GEN_DSP_SIMD_SCALAR) && (defined(__ARM_NEON) || defined(__ARM_NEON__))"
+    )
+    w("#include <arm_neon.h>")
+    w(f"#define {flag}_NEON 1")
+    w("#endif")
+    w("")
+    w(f"static inline float {name}_fir_dot(const float* c, const float* h, int n) {{")
+    w("    int k = 0;")
+    w("    float s;")
+    w(f"#if defined({flag}_SSE2)")
+    w("    __m128 acc = _mm_setzero_ps();")
+    w("    for (; k + 4 <= n; k += 4)")
+    w(
+        "        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(c + k), _mm_loadu_ps(h + k)));"
+    )
+    w("    __m128 pair = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));")
+    w("    s = _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, 1)));")
+    w(f"#elif defined({flag}_NEON)")
+    w("    float32x4_t acc = vdupq_n_f32(0.0f);")
+    w("    for (; k + 4 <= n; k += 4)")
+    w("        acc = vaddq_f32(acc, vmulq_f32(vld1q_f32(c + k), vld1q_f32(h + k)));")
+    w("    float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));")
+    w("    s = vget_lane_f32(pair, 0) + vget_lane_f32(pair, 1);")
+    w("#else")
+    w("    float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;")
+    w("    for (; k + 4 <= n; k += 4) {")
+    w("        s0 += c[k] * h[k];")
+    w("        s1 += c[k + 1] * h[k + 1];")
+    w("        s2 += c[k + 2] * h[k + 2];")
+    w("        s3 += c[k + 3] * h[k + 3];")
+    w("    }")
+    w("    s = (s0 + s2) + (s1 + s3);")
+    w("#endif")
+    w("    for (; k < n; k++) s += c[k] * h[k];")
+    w("    return s;")
+    w("}")
+
+
+def _emit_fir_compute(
+    node: FIR, ref: Callable[[str | float], str], name: str, w: _Writer
+) -> None:
+    """Emit one FIR step over a doubled history ring.
+
+    The ring head moves backwards and each input is stored at ``pos`` and
+    ``pos + N``, so ``hist + pos`` always holds the last N inputs newest
+    first and the output is a single unwrapped dot product.
+    """
+    nid = node.id
+    taps = _fir_taps(node)
+    if isinstance(node.coeffs, str):
+        coeffs = f"{node.coeffs}_buf"
+        w(f"        float {nid};")
+        w(f"        {{ // FIR {nid}: {taps} taps from {node.coeffs}")
+    else:
+        coeffs = f"{nid}_c"
+        values = ", ".join(_float_lit(c) for c in node.coeffs)
+        w(f"        float {nid};")
+        w(f"        {{ // FIR {nid}: {taps} taps")
+        w(f"            static const float {nid}_c[{taps}] = {{{values}}};")
+    w(f"            if (--{nid}_pos < 0) {nid}_pos = {taps} - 1;")
+    w(
+        f"            {nid}_hist[{nid}_pos] = {nid}_hist[{nid}_pos + {taps}] = {ref(node.a)};"
+    )
+    w(f"            {nid} = {name}_fir_dot({coeffs}, {nid}_hist + {nid}_pos, {taps});")
+    w("        }")
+
+
+# ---------------------------------------------------------------------------
+# Resample (polyphase windowed-sinc buffer reads)
+# ---------------------------------------------------------------------------
+
+
+def _emit_resample_compute(
+    node: Resample, ref: Callable[[str | float], str], name: str, w: _Writer
+) -> None:
+    """Emit one polyphase windowed-sinc read of a Buffer.
+
+    The read position picks a kernel row pair and blend weight, the
+    playback ratio picks the cutoff level, and the output is two dot
+    products over the same *taps* samples. Reads near either end of the
+    buffer gather clamped samples into a local window first.
+    """
+    nid = node.id
+    buf = node.buffer
+    taps = node.taps
+    rows = RESAMPLE_PHASES + 1
+    w(f"        float {nid};")
+    w(f"        {{ // Resample {nid}: {taps} taps from {buf}")
+    w(
+        f"            float {nid}_pos = fminf(fmaxf({ref(node.index)}, 0.0f), (float)({buf}_len - 1));"
+    )
+    w(f"            int {nid}_i = (int){nid}_pos;")
+    w(
+        f"            float {nid}_fp = ({nid}_pos - (float){nid}_i) * {_float_lit(float(RESAMPLE_PHASES))};"
+    )
+    w(f"            int {nid}_ph = (int){nid}_fp;")
+    w(f"            float {nid}_pf = {nid}_fp - (float){nid}_ph;")
+    w(f"            float {nid}_r = fabsf({ref(node.rate)});")
+    steps = " + ".join(f"({nid}_r > {_float_lit(r)})" for r in resample_ratios()[:-1])
+    w(f"            int {nid}_lvl = {steps};")
+    w(
+        f"            const float* {nid}_k = {name}_sinc{taps} + ({nid}_lvl * {rows} + {nid}_ph) * {taps};"
+    )
+    w(f"            int {nid}_j = {nid}_i - {taps // 2 - 1};")
+    w(f"            const float* {nid}_x = {buf}_buf + {nid}_j;")
+    w(f"            float {nid}_w[{taps}];")
+    w(f"            if ({nid}_j < 0 || {nid}_j + {taps} > {buf}_len) {{")
+    w(f"                for (int t = 0; t < {taps}; t++) {{")
+    w(f"                    int j = {nid}_j + t;")
+    w(
+        f"                    {nid}_w[t] = {buf}_buf[j < 0 ? 0 : (j >= {buf}_len ? {buf}_len - 1 : j)];"
+    )
+    w("                }")
+    w(f"                {nid}_x = {nid}_w;")
+    w("            }")
+    w(f"            float {nid}_s0 = {name}_fir_dot({nid}_k, {nid}_x, {taps});")
+    w(
+        f"            float {nid}_s1 = {name}_fir_dot({nid}_k + {taps}, {nid}_x, {taps});"
+    )
+    w(f"            {nid} = {nid}_s0 + {nid}_pf * ({nid}_s1 - {nid}_s0);")
+    w("        }")
+
+
+# ---------------------------------------------------------------------------
+# Granular synthesis
+# ---------------------------------------------------------------------------
+
+# Most samples rendered per call to the grain renderer
+_GRAIN_SPAN = 64
+
+
+def _emit_grain_clear(node: Granulator, w: _Writer) -> None:
+    w(f"    self->m_{node.id}_count = 0;")
+    w(f"    self->m_{node.id}_wait = 0.0f;")
+    w(f"    self->m_{node.id}_seed = 123456789u;")
+
+
+def _emit_grain_render(name: str, w: _Writer) -> None:
+    """Emit the shared renderer for Granulator grain pools.
+
+    Clears *span* output samples, then adds each live grain in turn over
+    the part of the span it lasts, in a loop of its own: a linear read of
+    the (guard-padded) buffer times a window table lookup. Finished grains
+    are dropped by moving the survivors down, so slots keep onset order
+    and the per-sample sum order does not depend on where spans split.
+    """
+    win = f"{name}_grain_win"
+    shift = 32 - (GRAIN_WINDOW.bit_length() - 1)
+    mask = (1 << shift) - 1
+    w(
+        f"static void {name}_grain_render(float* pos, float* inc, uint32_t* ph, "
+        "uint32_t* step, int* left, int* count, const float* buf, float len, "
+        "float* out, int span) {"
+    )
+    w("    for (int k = 0; k < span; k++) out[k] = 0.0f;")
+    w("    int live = 0;")
+    w("    for (int g = 0; g < *count; g++) {")
+    w("        float p = pos[g];")
+    w("        float dp = inc[g];")
+    w("        uint32_t wp = ph[g];")
+    w("        uint32_t ws = step[g];")
+    w("        int m = left[g] < span ? left[g] : span;")
+    w("        for (int k = 0; k < m; k++) {")
+    w("            int j = (int)p;")
+    w("            float f = p - (float)j;")
+    w("            float s = buf[j] + f * (buf[j + 1] - buf[j]);")
+    w(f"            int wk = (int)(wp >> {shift});")
+    w(
+        f"            float wf = (float)(wp & {mask:#x}u) * (1.0f / {float(1 << shift)}f);"
+    )
+    w(f"            float a = {win}[wk] + wf * ({win}[wk + 1] - {win}[wk]);")
+    w("            out[k] += s * a;")
+    w("            p += dp;")
+    w("            if (p >= len) p -= len;")
+    w("            else if (p < 0.0f) p += len;")
+    w("            wp += ws;")
+    w("        }")
+    w("        if (left[g] > m) {")
+    w("            pos[live] = p;")
+    w("            inc[live] = dp;")
+    w("            ph[live] = wp;")
+    w("            step[live] = ws;")
+    w("            left[live] = left[g] - m;")
+    w("            live++;")
+    w("        }")
+    w("    }")
+    w("    *count = live;")
+    w("}")
+
+
+def _emit_granulator_compute(
+    node: Granulator, ref: Callable[[str | float], str], name: str, w: _Writer
+) -> None:
+    """Emit a Granulator: onsets at exact samples, grains rendered by span.
+
+    At the start of a span the node starts a grain if one is due, then
+    renders every live grain up to the next onset (at most
+    ``_GRAIN_SPAN`` samples, never past the block). Inputs are only read
+    at onsets, so the output does not depend on the host block size.
+    """
+    nid = node.id
+    buf = node.buffer
+    cap = node.grains
+    w(
+        f"        if (i == {nid}_end) {{ // Granulator {nid}: up to {cap} grains of {buf}"
+    )
+    w(f"            if ({nid}_wait <= 0.0f) {{")
+    w(f"                float {nid}_d = {ref(node.density)};")
+    w(f"                if ({nid}_d > 0.0f) {{")
+    w(f"                    if ({nid}_count < {cap}) {{")
+    w(f"                        {nid}_seed = {nid}_seed * 1664525u + 1013904223u;")
+    w(
+        f"                        float {nid}_r = (float)(int32_t){nid}_seed / 2147483648.0f;"
+    )
+    w(f"                        float {nid}_lenf = (float){buf}_len;")
+    w(
+        f"                        float {nid}_st = {ref(node.position)} + {ref(node.jitter)} * {nid}_r;"
+    )
+    w(f"                        {nid}_st -= floorf({nid}_st);")
+    w(f"                        float {nid}_p = {nid}_st * {nid}_lenf;")
+    w(f"                        if ({nid}_p >= {nid}_lenf) {nid}_p -= {nid}_lenf;")
+    w(f"                        float {nid}_h = 0.5f * {nid}_lenf;")
+    w(
+        f"                        float {nid}_ms = fminf(fmaxf({ref(node.size)} * sr * 0.001f, 1.0f), {_float_lit(GRAIN_MAX_LEN)});"
+    )
+    w(f"                        int {nid}_len = (int){nid}_ms;")
+    w(f"                        {nid}_gpos[{nid}_count] = {nid}_p;")
+    w(
+        f"                        {nid}_ginc[{nid}_count] = fminf(fmaxf({ref(node.pitch)}, -{nid}_h), {nid}_h);"
+    )
+    w(f"                        {nid}_gph[{nid}_count] = 0u;")
+    w(
+        f"                        {nid}_gstep[{nid}_count] = 0xffffffffu / (uint32_t){nid}_len;"
+    )
+    w(f"                        {nid}_gleft[{nid}_count] = {nid}_len;")
+    w(f"                        {nid}_count++;")
+    w("                    }")
+    w(
+        f"                    {nid}_wait += fminf(fmaxf(sr / {nid}_d, 1.0f), {_float_lit(GRAIN_MAX_WAIT)});"
+    )
+    w("                } else {")
+    w(f"                    {nid}_wait = 1.0f; // stopped: poll density every sample")
+    w("                }")
+    w("            }")
+    w(f"            int {nid}_span = (n - i < {_GRAIN_SPAN}) ? n - i : {_GRAIN_SPAN};")
+    w(f"            float {nid}_due = ceilf({nid}_wait);")
+    w(f"            if ((float){nid}_span > {nid}_due) {nid}_span = (int){nid}_due;")
+    w(f"            {nid}_wait -= (float){nid}_span;")
+    w(
+        f"            {name}_grain_render({nid}_gpos, {nid}_ginc, {nid}_gph, {nid}_gstep, "
+        f"{nid}_gleft, &{nid}_count, {buf}_buf, (float){buf}_len, {nid}_blk, {nid}_span);"
+    )
+    w(f"            {nid}_base = i;")
+    w(f"            {nid}_end = i + {nid}_span;")
+    w("        }")
+    w(f"        float {nid} = {nid}_blk[i - {nid}_base];")
+
+
+# ---------------------------------------------------------------------------
+# Outlined subgraphs
+# ---------------------------------------------------------------------------
+
+# Inner graphs smaller than this are always inlined: the call and chunk
+# scratch would cost more than the code it saves.
+_OUTLINE_MIN_NODES = 8
+
+# Minimum number of duplicated inner nodes an outlined function must save.
+_OUTLINE_MIN_SAVED = 32
+
+# Chunk (in samples) over which outlined subgraphs are called block-wise.
+_OUTLINE_CHUNK = 64
+
+
+def _plan_outlining(graph: Graph) -> dict[str, Subgraph]:
+    """Pick the top-level Subgraph instances to compile as function calls.
+
+    Instances are grouped by identical inner graph. A group is outlined
+    when its (expanded) inner graph has at least ``_OUTLINE_MIN_NODES``
+    nodes and outlining saves at least ``_OUTLINE_MIN_SAVED`` inlined node
+    copies. Inner graphs with control-rate nodes (which run on the outer
+    graph's control grid when flattened) or with buffers, peeks or
+    envelopes (which the outer graph's APIs expose) are always inlined.
+
+    Returns ``{instance id: instance}`` with each instance's inner graph
+    renamed to the shared function prefix ``{outer}_{first instance id}``.
+    """
+    groups: dict[str, list[Subgraph]] = {}
+    for node in graph.nodes:
+        if isinstance(node, Subgraph) and node.id not in graph.control_nodes:
+            groups.setdefault(node.graph.model_dump_json(), []).append(node)
+
+    plan: dict[str, Subgraph] = {}
+    for members in groups.values():
+        inner = expand_subgraphs(members[0].graph)
+        size = len(inner.nodes)
+        if size < _OUTLINE_MIN_NODES or (len(members) - 1) * size < _OUTLINE_MIN_SAVED:
+            continue
+        if inner.control_nodes or any(
+            isinstance(n, (Buffer, Peek, ADSR)) for n in inner.nodes
+        ):
+            continue
+        renamed = members[0].graph.model_copy(
+            update={"name": f"{graph.name}_{members[0].id}"}
+        )
+        for sg in members:
+            plan[sg.id] = sg.model_copy(update={"graph": renamed})
+    return plan
+
+
+def _emit_outlined_defs(node: Subgraph, check_ranges: bool, w: _Writer) -> None:
+    """Emit the shared inner graph code for an outlined Subgraph."""
+    inner_code = compile_graph(node.graph, check_ranges, outline_subgraphs=True)
+    w(f"// -- Outlined subgraph '{node.graph.name}'")
+    body = [ln for ln in inner_code.splitlines() if not ln.startswith(_STD_INCLUDE)]
+    while body and not body[0]:
+        body.pop(0)
+    for line in body:
+        w(line)
+    w("")
+
+
+def _emit_outlined_call(
+    node: Subgraph, ref: Callable[[str | float], str], w: _Writer
+) -> None:
+    """Emit a one-sample call into an outlined Subgraph's perform function.
+
+    Every inner output is exposed: the selected one as ``{id}`` and all of
+    them as ``{id}__{output}`` for compound refs.
+    """
+    nid = node.id
+    inner = node.graph
+    n_in = len(inner.inputs)
+    n_out = len(inner.outputs)
+    sel_id = node.output or inner.outputs[0].id
+    sel = next(k for k, o in enumerate(inner.outputs) if o.id == sel_id)
+
+    w(f"        float {nid}_y[{n_out}];")
+    w(f"        {{ // Subgraph {nid}: outlined call")
+    if n_in:
+        vals = ", ".join(ref(node.inputs[inp.id]) for inp in inner.inputs)
+        ptrs = ", ".join(f"&{nid}_x[{k}]" for k in range(n_in))
+        w(f"            float {nid}_x[{n_in}] = {{{vals}}};")
+        w(f"            float* {nid}_ins[{n_in}] = {{{ptrs}}};")
+    ptrs = ", ".join(f"&{nid}_y[{k}]" for k in range(n_out))
+    w(f"            float* {nid}_outs[{n_out}] = {{{ptrs}}};")
+    # Through the setter, which also cancels any inner ramp
+    for k, p in enumerate(inner.params):
+        if p.name in node.params:
+            w(
+                f"            {inner.name}_set_param(self->m_{nid}_inner, {k}, {ref(node.params[p.name])});"
+            )
+    ins = f"{nid}_ins" if n_in else "nullptr"
+    w(f"            {inner.name}_perform(self->m_{nid}_inner, {ins}, {nid}_outs, 1);")
+    w("        }")
+    w(f"        float {nid} = {nid}_y[{sel}];")
+    for k, out in enumerate(inner.outputs):
+        w(f"        float {nid}__{out.id} = {nid}_y[{k}];")
+
+
+def _plan_outlined_levels(
+    graph: Graph,
+    sorted_nodes: list[Node],
+    invariant_ids: set[str],
+    param_names: set[str],
+) -> dict[str, int] | None:
+    """Assign each node the chunk loop it runs in, around outlined calls.
+
+    An outlined Subgraph sits one level above everything it reads, and
+    other nodes sit on the level of their latest input. A History is
+    written back on its input's level, and all nodes sharing a delay line
+    or buffer share a level. Returns None (call per sample instead) when
+    there is nothing to outline, a mapped param varies per sample, or a
+    call feeds back into its own inputs.
+    """
+    calls = [n for n in sorted_nodes if isinstance(n, Subgraph)]
+    if not calls:
+        return None
+    for sg in calls:
+        for r in sg.params.values():
+            if isinstance(r, str) and r not in param_names and r not in invariant_ids:
+                return None
+
+    deps = build_forward_deps(graph)
+    compound = {f"{sg.id}__{out.id}": sg.id for sg in calls for out in sg.graph.outputs}
+    shared: dict[str, list[str]] = {}
+    containers = {n.id for n in sorted_nodes if isinstance(n, (DelayLine, Buffer))}
+    for node in sorted_nodes:
+        for d in deps.get(node.id, ()):
+            if d in containers:
+                shared.setdefault(d, []).append(node.id)
+
+    levels = {n.id: 0 for n in sorted_nodes}
+    while True:
+        changed = False
+        for node in sorted_nodes:
+            if node.id in invariant_ids:
+                continue
+            lv = max((levels[d] for d in deps.get(node.id, ())), default=0)
+            if isinstance(node, Subgraph):
+                lv += 1
+            if isinstance(node, History) and isinstance(node.input, str):
+                lv = max(lv, levels.get(compound.get(node.input, node.input), 0))
+            for d in deps.get(node.id, ()):
+                for peer in shared.get(d, ()):
+                    lv = max(lv, levels[peer])
+            if lv > levels[node.id]:
+                levels[node.id] = lv
+                changed = True
+        if not changed:
+            return levels
+        # Only a cycle through a call keeps raising levels past this
+        if max(levels.values()) > len(calls):
+            return None
+
+
+def _node_refs(node: Node) -> set[str]:
+    """Every string ref a node reads in its own sample (not History input)."""
+    refs: set[str] = set()
+    for field_name, value in node.__dict__.items():
+        if field_name in NON_REF_FIELDS:
+            continue
+        if isinstance(node, History) and field_name == "input":
+            continue
+        if isinstance(value, str):
+            refs.add(value)
+        elif isinstance(value, list | dict):
+            items = value.values() if isinstance(value, dict) else value
+            refs.update(r for r in items if isinstance(r, str))
+    return refs
+
+
+def _emit_outlined_block_call(
+    node: Subgraph,
+    scratch: Callable[[str | float], str | None],
+    input_ids: set[str],
+    param_names: set[str],
+    w: _Writer,
+) -> None:
+    """Emit a call into an outlined Subgraph's perform over one chunk.
+
+    *scratch* maps an input ref to the chunk span holding it; constant
+    refs are broadcast into a local span. Outputs land in ``{id}_y``.
+    """
+    nid = node.id
+    inner = node.graph
+    n_in = len(inner.inputs)
+    n_out = len(inner.outputs)
+    chunk = _OUTLINE_CHUNK
+
+    w(f"        float {nid}_y[{n_out}][{chunk}];")
+    w(f"        {{ // Subgraph {nid}: outlined call over the chunk")
+    ptrs: list[str] = []
+    for k, inp in enumerate(inner.inputs):
+        r = node.inputs[inp.id]
+        span = scratch(r)
+        if span is None:
+            span = f"{nid}_x{k}"
+            val = _emit_ref(r, input_ids, param_names)
+            w(f"            float {span}[{chunk}];")
+            w(f"            for (int _j = 0; _j < _cn; _j++) {span}[_j] = {val};")
+        ptrs.append(span)
+    if n_in:
+        w(f"            float* {nid}_ins[{n_in}] = {{{', '.join(ptrs)}}};")
+    outs = ", ".join(f"{nid}_y[{k}]" for k in range(n_out))
+    w(f"            float* {nid}_outs[{n_out}] = {{{outs}}};")
+    # Through the setter, which also cancels any inner ramp
+    for k, p in enumerate(inner.params):
+        if p.name in node.params:
+            val = _emit_ref(node.params[p.name], input_ids, param_names)
+            w(f"            {inner.name}_set_param(self->m_{nid}_inner, {k}, {val});")
+    ins = f"{nid}_ins" if n_in else "nullptr"
+    w(f"            {inner.name}_perform(self->m_{nid}_inner, {ins}, {nid}_outs, _cn);")
+    w("        }")
+
+
+# ---------------------------------------------------------------------------
+# ADSR segment rendering
+# ---------------------------------------------------------------------------
+
+# Scratch span (in samples) filled per call to the segment renderer.
+_ADSR_BLOCK = 64
+
+
+def _emit_mip_build(name: str, node: Buffer, indent: str, w: _Writer) -> None:
+    """Rebuild the mip pyramid of *node* from its current contents."""
+    levels = mip_levels(node.size)
+    w(
+        f"{indent}{name}_build_mips(self->m_{node.id}_buf, {node.size}, {levels}, self->m_{node.id}_mip);"
+    )
+
+
+def _emit_mip_builder(name: str, w: _Writer) -> None:
+    """Emit the band-limited mip pyramid builder used by WavetableOsc.
+
+    Level 0 is the table itself; level l >= 1 is resynthesised from the
+    DFT with harmonics 0..n >> (l + 1). Every level is followed by two
+    guard samples repeating its first two. O(n^2): run at create, reset
+    and set_buffer time, never per sample.
+    """
+    w(
+        f"static void {name}_build_mips(const float* src, int n, int levels, float* mip) {{"
+    )
+    w("    int kmax = n >> 2;")
+    w(
+        "    double* re = (double*)calloc((size_t)(kmax + 1) * 2 + (size_t)n * 2, sizeof(double));"
+    )
+    w("    if (!re) return;")
+    w("    double* im = re + kmax + 1;")
+    w("    double* cs = im + kmax + 1;")
+    w("    double* sn = cs + n;")
+    w("    for (int j = 0; j < n; j++) {")
+    w("        cs[j] = cos(6.283185307179586 * (double)j / (double)n);")
+    w("        sn[j] = sin(6.283185307179586 * (double)j / (double)n);")
+    w("    }")
+    w("    for (int k = 0; k <= kmax; k++) {")
+    w("        double r = 0.0;")
+    w("        double q = 0.0;")
+    w("        int m = 0;")
+    w("        for (int j = 0; j < n; j++) {")
+    w("            r += (double)src[j] * cs[m];")
+    w("            q += (double)src[j] * sn[m];")
+    w("            m += k;")
+    w("            if (m >= n) m -= n;")
+    w("        }")
+    w("        re[k] = r;")
+    w("        im[k] = q;")
+    w("    }")
+    w("    for (int j = 0; j < n; j++) mip[j] = src[j];")
+    w("    mip[n] = mip[0];")
+    w("    mip[n + 1] = mip[1];")
+    w("    for (int l = 1; l < levels; l++) {")
+    w("        float* lvl = mip + (size_t)l * (size_t)(n + 2);")
+    w("        int kh = n >> (l + 1);")
+    w("        for (int j = 0; j < n; j++) {")
+    w("            double v = re[0];")
+    w("            int m = 0;")
+    w("            for (int k = 1; k <= kh; k++) {")
+    w("                m += j;")
+    w("                if (m >= n) m -= n;")
+    w("                v += 2.0 * (re[k] * cs[m] + im[k] * sn[m]);")
+    w("            }")
+    w("            lvl[j] = (float)(v / (double)n);")
+    w("        }")
+    w("        lvl[n] = lvl[0];")
+    w("        lvl[n + 1] = lvl[1];")
+    w("    }")
+    w("    free(re);")
+    w("}")
+
+
+def _emit_adsr_render(name: str, w: _Writer) -> None:
+    """Emit the shared segment renderer for block-rate ADSR envelopes.
+
+    Linear ramps are written in closed form up to one sample short of the
+    next phase boundary; the remaining samples run the per-sample state
+    machine so rounding in the closed form cannot move a transition.
+
+    Each call restarts the ramp from the rounded float ``out``, so a long
+    segment drifts from ``simulate()`` (per-sample, double precision) by
+    up to 2^-24 per ``_ADSR_BLOCK`` chunk; sustain and idle are exact.
+    """
+    w(
+        f"static void {name}_adsr_render(int* phase_p, float* out_p, float a_samps, "
+        "float d_samps, float sus, float r_samps, float* dst, int count) {"
+    )
+    w("    int phase = *phase_p;")
+    w("    float out = *out_p;")
+    w("    int k = 0;")
+    w("    while (k < count) {")
+    w("        if (phase == 0 || phase == 3) {")
+    w("            if (phase == 3) out = sus;")
+    w("            while (k < count) dst[k++] = out;")
+    w("            break;")
+    w("        }")
+    w("        float inc;")
+    w("        float dist;")
+    w("        if (phase == 1) { inc = 1.0f / a_samps; dist = 1.0f - out; }")
+    w(
+        "        else if (phase == 2) { inc = -(1.0f - sus) / d_samps; dist = sus - out; }"
+    )
+    w("        else { inc = -1.0f / r_samps; dist = -out; }")
+    w("        int span = 0;")
+    w("        if ((phase == 1 && dist > 0.0f) || (inc < 0.0f && dist < 0.0f)) {")
+    w("            float q = ceilf(dist / inc) - 2.0f;")
+    w("            span = (q < (float)(count - k)) ? (int)q : count - k;")
+    w("            if (span < 0) span = 0;")
+    w("        }")
+    w("        float base = out;")
+    w(
+        "        for (int j = 0; j < span; j++) dst[k + j] = base + inc * (float)(j + 1);"
+    )
+    w("        if (span > 0) out = base + inc * (float)span;")
+    w("        k += span;")
+    w("        if (k >= count) break;")
+    w("        // Near a boundary: exact per-sample state machine")
+    w("        if (phase == 1) {")
+    w("            out += 1.0f / a_samps;")
+    w("            if (out >= 1.0f) { out = 1.0f; phase = 2; }")
+    w("        }")
+    w("        if (phase == 2) {")
+    w("            out -= (1.0f - sus) / d_samps;")
+    w("            if (out <= sus) { out = sus; phase = 3; }")
+    w("        }")
+    w("        if (phase == 3) out = sus;")
+    w("        if (phase == 4) {")
+    w("            out -= 1.0f / r_samps;")
+    w("            if (out <= 0.0f) { out = 0.0f; phase = 0; }")
+    w("        }")
+    w("        dst[k++] = out;")
+    w("    }")
+    w("    *phase_p = phase;")
+    w("    *out_p = out;")
+    w("}")
+
+
+def _emit_adsr_block_setup(
+    node: ADSR, input_ids: set[str], param_names: set[str], w: _Writer
+) -> None:
+    """Emit pre-loop gate edge detection and segment lengths for *node*."""
+    nid = node.id
+
+    def ref(r: str | float) -> str:
+        return _emit_ref(r, input_ids, param_names)
+
+    w(f"    // ADSR {nid}: block-invariant inputs, rendered by segment")
+    w(f"    float {nid}_gate = {ref(node.gate)};")
+    w(f"    if ({nid}_gate > 0.0f && {nid}_ptrig <= 0.0f) {nid}_phase = 1;")
+    w(f"    if ({nid}_gate <= 0.0f && {nid}_ptrig > 0.0f) {nid}_phase = 4;")
+    w(f"    {nid}_ptrig = {nid}_gate;")
+    w(f"    float {nid}_a_samps = fmaxf({ref(node.attack)} * sr * 0.001f, 1.0f);")
+    w(f"    float {nid}_d_samps = fmaxf({ref(node.decay)} * sr * 0.001f, 1.0f);")
+    w(f"    float {nid}_sus = {ref(node.sustain)};")
+    w(f"    float {nid}_r_samps = fmaxf({ref(node.release)} * sr * 0.001f, 1.0f);")
+    w(f"    float {nid}_blk[{_ADSR_BLOCK}];")
+
+
+def _emit_adsr_block_read(
+    nid: str, name: str, w: _Writer, span: tuple[str, str] = ("0", "n")
+) -> None:
+    """Emit the in-loop read of a segment-rendered envelope.
+
+    Chunks are aligned to the block; a param segment starting mid-chunk
+    renders up to the next chunk boundary with its own inputs.
+    """
+    mask = _ADSR_BLOCK - 1
+    lo, hi = span
+    if lo == "0":
+        w(f"        if ((i & {mask}) == 0) {{")
+        w(
+            f"            int {nid}_cnt = (n - i < {_ADSR_BLOCK}) ? n - i : {_ADSR_BLOCK};"
+        )
+        dst = f"{nid}_blk"
+    else:
+        w(f"        if (i == {lo} || (i & {mask}) == 0) {{")
+        w(f"            int {nid}_cnt = {_ADSR_BLOCK} - (i & {mask});")
+        w(f"            if ({hi} - i < {nid}_cnt) {nid}_cnt = {hi} - i;")
+        dst = f"{nid}_blk + (i & {mask})"
+    w(
+        f"            {name}_adsr_render(&{nid}_phase, &{nid}_output, {nid}_a_samps, "
+        f"{nid}_d_samps, {nid}_sus, {nid}_r_samps, {dst}, {nid}_cnt);"
+    )
+    w("        }")
+    w(f"        float {nid} = {nid}_blk[i & {mask}];")
+
+
+def _emit_adsr_idle_api(
+    adsr_nodes: list[ADSR], name: str, struct_name: str, w: _Writer
+) -> None:
+    """Emit ``{name}_adsr_idle``: 1 when every envelope has finished.
+
+    Graphs without envelopes report 0 so hosts never deactivate on it.
+    """
+    w("")
+    w(f"int {name}_adsr_idle({struct_name}* self) {{")
+    if not adsr_nodes:
+        w("    (void)self;")
+        w("    return 0;")
+    else:
+        conds = " && ".join(f"self->m_{n.id}_phase == 0" for n in adsr_nodes)
+        w(f"    return ({conds}) ? 1 : 0;")
     w("}")
 
 
@@ -0,0 +1,339 @@
+"""Static cost and memory footprint of a DSP graph.
+
+Walks the (subgraph-expanded) node list and produces the same
+``CostReport`` as ``gen-dsp detect --cost`` does for gen~ exports: state
+struct bytes, delay line and buffer bytes, and operations per sample.
+
+State bytes are read off the fields ``compile_graph`` emits, so they track
+the generated struct exactly. Per-node operation counts approximate the
+emitted C++: nodes the compiler hoists out of the sample loop (pure
+functions of params and literals) are amortised over the block, control
+rate nodes over ``control_interval``, and an ``Undersample`` inner graph
+over its ``factor``.
+"""
+
+from __future__ import annotations
+
+import re
+
+from gen_dsp.core.cost import CostReport, MemoryItem, OpCounts
+from gen_dsp.graph.compile import (
+    _classify_loop_invariance,
+    _emit_state_fields,
+)
+from gen_dsp.graph.models import (
+    ADSR,
+    FDN,
+    FIR,
+    SVF,
+    Accum,
+    Allpass,
+    BinOp,
+    Biquad,
+    Buffer,
+    BufRead,
+    BufWrite,
+    Change,
+    Clamp,
+    Compare,
+    Counter,
+    Cycle,
+    DCBlock,
+    DelayLine,
+    DelayRead,
+    DelayWrite,
+    Delta,
+    Elapsed,
+    Fold,
+    GateRoute,
+    Granulator,
+    Graph,
+    Latch,
+    Lookup,
+    Mix,
+    MovingAverage,
+    MulAccum,
+    MultiTapRead,
+    Node,
+    Noise,
+    OnePole,
+    Phasor,
+    PulseOsc,
+    RateDiv,
+    Resample,
+    SampleHold,
+    SawOsc,
+    Scale,
+    Select,
+    Selector,
+    SinOsc,
+    Slide,
+    SmoothParam,
+    Smoothstep,
+    Splat,
+    TriOsc,
+    UnaryOp,
+    Undersample,
+    Wave,
+    WavetableOsc,
+    WindowMax,
+    WindowMin,
+    Wrap,
+)
+from gen_dsp.graph.subgraph import expand_subgraphs
+from gen_dsp.graph.tables import (
+    mip_buffers,
+    mip_levels,
+    multitap_table,
+    undersample_taps,
+)
+
+_ADD_BINOPS = {
+    "add", "sub", "rsub", "min", "max", "step", "and", "or", "xor",
+    "gtp", "ltp", "gtep", "ltep", "eqp", "neqp",
+}  # fmt: skip
+_MATH_UNARY = {
+    "sin", "cos", "tan", "tanh", "exp", "log", "atan", "asin", "acos",
+    "sinh", "cosh", "asinh", "acosh", "atanh", "exp2", "log2", "log10",
+    "mtof", "ftom", "atodb", "dbtoa", "t60", "t60time",
+}  # fmt: skip
+_MUL_UNARY = {"degrees", "radians", "mstosamps", "sampstoms"}
+_FAST_UNARY = {"fastsin", "fastcos", "fasttan", "fastexp"}
+
+_INTERP_READ: dict[str, OpCounts] = {
+    "none": OpCounts(add=2, mem=1),
+    "linear": OpCounts(add=4, mul=1, mem=2),
+    "cubic": OpCounts(add=12, mul=8, mem=4),
+}
+
+# Fixed per-sample cost of the remaining node types
+_NODE_OPS: dict[type, OpCounts] = {
+    Clamp: OpCounts(add=2),
+    DelayWrite: OpCounts(add=1, mem=1),
+    Phasor: OpCounts(add=2, mul=1),
+    Noise: OpCounts(add=1, mul=2),
+    Compare: OpCounts(add=1),
+    Select: OpCounts(add=1),
+    Wrap: OpCounts(add=3, mul=1),
+    Fold: OpCounts(add=5, mul=1),
+    Mix: OpCounts(add=2, mul=1),
+    Delta: OpCounts(add=1),
+    Change: OpCounts(add=2),
+    Biquad: OpCounts(add=4, mul=5),
+    SVF: OpCounts(add=6, mul=6, div=1, math=1),
+    OnePole: OpCounts(add=2, mul=2),
+    DCBlock: OpCounts(add=2, mul=1),
+    Allpass: OpCounts(add=2, mul=2),
+    SinOsc: OpCounts(add=2, mul=2, math=1),
+    TriOsc: OpCounts(add=4, mul=2),
+    SawOsc: OpCounts(add=3, mul=2),
+    PulseOsc: OpCounts(add=3, mul=1),
+    SampleHold: OpCounts(add=2),
+    Latch: OpCounts(add=2),
+    Accum: OpCounts(add=2),
+    Counter: OpCounts(add=3),
+    Elapsed: OpCounts(add=1),
+    MulAccum: OpCounts(add=1, mul=1),
+    RateDiv: OpCounts(add=2),
+    SmoothParam: OpCounts(add=2, mul=2),
+    Slide: OpCounts(add=4, mul=1, div=1),
+    # Amortised: one push and at most one pop per sample
+    WindowMax: OpCounts(add=6, mem=5),
+    WindowMin: OpCounts(add=6, mem=5),
+    ADSR: OpCounts(add=6, mul=2, div=1),
+    Scale: OpCounts(add=3, mul=1, div=1),
+    Smoothstep: OpCounts(add=3, mul=3, div=1),
+    BufWrite: OpCounts(add=2, mem=1),
+    Splat: OpCounts(add=3, mem=2),
+    Cycle: OpCounts(add=4, mul=2, mem=2),
+    Wave: OpCounts(add=5, mul=2, mem=2),
+    Lookup: OpCounts(add=4, mul=2, mem=2),
+    WavetableOsc: OpCounts(add=9, mul=4, mem=4),
+    GateRoute: OpCounts(add=2),
+}
+
+_FIELD_RE = re.compile(r"^\s*([\w:]+)(\*?)\s+\w+(?:\[(\d+)\])?;")
+_FIELD_BYTES = {"float": 4, "int": 4, "uint32_t": 4}
+_SAMPLE_BYTES = 4
+
+
+def _state_field_bytes(
+    node: Node, name: str, mips: frozenset[str] = frozenset()
+) -> int:
+    """Bytes of the struct fields ``compile_graph`` emits for *node*."""
+    fields: list[str] = []
+    _emit_state_fields(node, fields.append, name, mips)
+    total = 0
+    for line in fields:
+        m = _FIELD_RE.match(line)
+        if not m:
+            continue
+        ctype, ptr, count = m.group(1), m.group(2), m.group(3)
+        size = 8 if ptr else _FIELD_BYTES.get(ctype, 8)
+        total += size * (int(count) if count else 1)
+    return total
+
+
+def node_ops(node: Node, buf_sizes: dict[str, int] | None = None) -> OpCounts:
+    """Approximate operations one evaluation of *node* executes.
+
+    *buf_sizes* maps Buffer IDs to sample counts, for nodes whose work
+    scales with a buffer (an FIR with a coefficient buffer).
+    """
+    if isinstance(node, BinOp):
+        if node.op in _ADD_BINOPS:
+            return OpCounts(add=1)
+        if node.op == "absdiff":
+            return OpCounts(add=2)
+        if node.op == "mul":
+            return OpCounts(mul=1)
+        if node.op in ("div", "rdiv", "mod", "rmod"):
+            return OpCounts(div=1)
+        if node.op == "fastpow":
+            return OpCounts(add=4, mul=4)
+        return OpCounts(math=1)  # pow, atan2, hypot
+    if isinstance(node, UnaryOp):
+        if node.op in _MATH_UNARY:
+            return OpCounts(math=1)
+        if node.op == "sqrt":
+            return OpCounts(div=1)
+        if node.op in _MUL_UNARY:
+            return OpCounts(mul=1)
+        if node.op in _FAST_UNARY:
+            return OpCounts(add=4, mul=5)
+        if node.op in ("fract", "phasewrap"):
+            return OpCounts(add=3, mul=1)
+        return OpCounts(add=1)
+    if isinstance(node, (DelayRead, BufRead)):
+        return _INTERP_READ[node.interp]
+    if isinstance(node, MultiTapRead):
+        # Per read: index offset, one-compare wrap, weighted accumulate.
+        # Fractional taps read twice (folded weights or a lerp).
+        table = multitap_table(node)
+        if table is not None:
+            k = float(len(table))
+        else:
+            k = float(len(node.taps)) * (2 if node.interp == "linear" else 1)
+        return OpCounts(add=3 * k, mul=k, mem=k)
+    if isinstance(node, Selector):
+        return OpCounts(add=float(len(node.inputs)))
+    if isinstance(node, MovingAverage):
+        # Running and restarted sums, ring head wrap, 1/N scaling
+        if node.mode == "rms":
+            return OpCounts(add=5, mul=2, div=1, mem=2)
+        return OpCounts(add=4, mul=1, mem=2)
+    if isinstance(node, FDN):
+        # Line reads/writes, head wraps, feedback scaling and (if enabled)
+        # damping, plus the mix: N log2 N adds (Hadamard) or 2N (Householder)
+        n = len(node.delays)
+        mix = n * (n.bit_length() - 1) if node.matrix == "hadamard" else 2 * n
+        damp = 0 if node.damping == 0.0 else n
+        return OpCounts(
+            add=float(2 * n + mix + 2 * damp), mul=float(n + 1 + damp), mem=float(2 * n)
+        )
+    if isinstance(node, Resample):
+        # Clamp and phase split, cutoff level compares, two N-tap dot
+        # products over the same window, row blend
+        k = float(node.taps)
+        return OpCounts(add=2 * k + 14, mul=2 * k + 2, mem=3 * k)
+    if isinstance(node, Granulator):
+        # Every slot live (worst case): a linear buffer read, a window table
+        # lookup, the accumulate and the position/phase advance per grain
+        g = float(node.grains)
+        return OpCounts(add=9 * g + 4, mul=3 * g, mem=5 * g + 1)
+    if isinstance(node, FIR):
+        # Head wrap, mirrored history write, N-tap dot product
+        taps = float(_fir_taps(node, buf_sizes or {}))
+        return OpCounts(add=taps + 3, mul=taps, mem=2 * taps + 2)
+    return _NODE_OPS.get(type(node), OpCounts())
+
+
+def _fir_taps(node: FIR, buf_sizes: dict[str, int]) -> int:
+    if isinstance(node.coeffs, str):
+        return buf_sizes.get(node.coeffs, 0)
+    return len(node.coeffs)
+
+
+def graph_cost(
+    graph: Graph, block_size: int = 64, sample_rate: float | None = None
+) -> CostReport:
+    """Estimate the memory and per-sample cost of *graph*.
+
+    Subgraphs are expanded first, as ``compile_graph`` does. CPU load is
+    reported at *sample_rate*, defaulting to the graph's ``sample_rate``.
+    """
+    flat = expand_subgraphs(graph)
+    rate = sample_rate if sample_rate is not None else flat.sample_rate
+    report = CostReport(flat.name, rate, block_size, state_bytes=4)
+    # p_<name>, plus r_<name>_inc / _target / _left for set_param_ramp
+    report.state_bytes += 16 * len(flat.params)
+
+    input_ids = {i.id for i in flat.inputs}
+    param_names = {p.name for p in flat.params}
+    invariant = _classify_loop_invariance(flat.nodes, input_ids, param_names)
+    control = (
+        set(flat.control_nodes) - invariant if flat.control_interval > 0 else set()
+    )
+
+    mips = mip_buffers(flat.nodes)
+    buf_sizes = {n.id: n.size for n in flat.nodes if isinstance(n, Buffer)}
+    for node in flat.nodes:
+        report.state_bytes += _state_field_bytes(node, flat.name, mips)
+        if isinstance(node, DelayLine):
+            report.items.append(
+                MemoryItem(node.id, "delay", node.max_samples * _SAMPLE_BYTES)
+            )
+        elif isinstance(node, FDN):
+            report.items.append(
+                MemoryItem(node.id, "delay", sum(node.delays) * _SAMPLE_BYTES)
+            )
+        elif isinstance(node, FIR):
+            # Doubled history ring
+            taps = _fir_taps(node, buf_sizes)
+            report.items.append(MemoryItem(node.id, "delay", 2 * taps * _SAMPLE_BYTES))
+        elif isinstance(node, (WindowMax, WindowMin)):
+            # Deque values plus their uint32 arrival times
+            report.items.append(
+                MemoryItem(node.id, "delay", node.max_window * 2 * _SAMPLE_BYTES)
+            )
+        elif isinstance(node, MovingAverage):
+            report.items.append(
+                MemoryItem(node.id, "delay", node.window * _SAMPLE_BYTES)
+            )
+        elif isinstance(node, Buffer):
+            width = 2 if node.format == "int16" else _SAMPLE_BYTES
+            report.items.append(MemoryItem(node.id, "data", node.size * width))
+            if node.id in mips:
+                # WavetableOsc mip pyramid: one guarded copy per level
+                mip = mip_levels(node.size) * (node.size + 2)
+                report.items.append(
+                    MemoryItem(f"{node.id}_mip", "data", mip * _SAMPLE_BYTES)
+                )
+
+        if isinstance(node, Undersample):
+            _add_undersample(report, node, block_size)
+            continue
+        ops = node_ops(node, buf_sizes)
+        if node.id in invariant:
+            ops = ops.scaled(1.0 / max(block_size, 1))
+        elif node.id in control:
+            ops = ops.scaled(1.0 / flat.control_interval)
+        report.ops += ops
+
+    return report
+
+
+def _add_undersample(report: CostReport, node: Undersample, block_size: int) -> None:
+    """Fold an Undersample's inner graph and resampling filters into *report*."""
+    inner = graph_cost(node.graph, block_size)
+    report.state_bytes += inner.state_bytes
+    for item in inner.items:
+        report.items.append(MemoryItem(f"{node.id}.{item.name}", item.kind, item.bytes))
+    report.notes.extend(f"{node.id}: {n}" for n in inner.notes)
+    report.ops += inner.ops.scaled(1.0 / node.factor)
+
+    # Decimator: one taps-long MAC per input per inner sample; polyphase
+    # interpolator: taps/factor MACs per outer sample
+    taps = undersample_taps(node)
+    macs = len(node.inputs) * taps / node.factor + taps / node.factor
+    report.ops += OpCounts(add=macs, mul=macs, mem=macs)
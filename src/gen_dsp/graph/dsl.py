@@ -46,14 +46,19 @@ from gen_dsp.graph.models import (
     DelayWrite,
     Delta,
     Elapsed,
+    FDN,
+    FIR,
     Fold,
     GateOut,
     GateRoute,
+    Granulator,
     Graph,
     History,
     Latch,
     Lookup,
     Mix,
+    MovingAverage,
+    MultiTapRead,
     NamedConstant,
     Noise,
     Node,
@@ -64,6 +69,7 @@ from gen_dsp.graph.models import (
     Phasor,
     PulseOsc,
     RateDiv,
+    Resample,
     SampleHold,
     SampleRate,
     SawOsc,
@@ -79,6 +85,9 @@ from gen_dsp.graph.models import (
     TriOsc,
     UnaryOp,
     Wave,
+    WavetableOsc,
+    WindowMax,
+    WindowMin,
     Wrap,
 )
 
@@ -284,6 +293,7 @@ class ASTBufferDecl:
     name: str
     size: int
     fill: str = "zeros"
+    format: str = "float32"
     line: int = 0
 
 
@@ -632,6 +642,7 @@ class Parser:
         name = self._expect(IDENT).value
         size = int(self._expect(NUMBER).value)
         fill = "zeros"
+        fmt = "float32"
         # Optional key=value pairs
         while self._at(IDENT) and self.pos + 1 < len(self.tokens):
             next_tok = self.tokens[self.pos + 1]
@@ -641,9 +652,11 @@ class Parser:
                 val = self._expect(IDENT).value
                 if key == "fill":
                     fill = val
+                elif key == "format":
+                    fmt = val
             else:
                 break
-        return ASTBufferDecl(name=name, size=size, fill=fill, line=tok.line)
+        return ASTBufferDecl(name=name, size=size, fill=fill, format=fmt, line=tok.line)
 
     def _parse_delay_decl(self) -> ASTDelayDecl:
         tok = self._advance()  # consume 'delay'
@@ -869,8 +882,9 @@ class Parser:
 
         # Identifier or function call
         if tok.type == IDENT:
-            # Special: delay_read is parsed as a call with delay name as first arg
-            if tok.value == "delay_read":
+            # Special: delay_read/delay_taps are parsed as a call with the
+            # delay name as first arg
+            if tok.value in ("delay_read", "delay_taps"):
                 return self._parse_delay_read_expr()
 
             self._advance()
@@ -892,8 +906,8 @@ class Parser:
         )
 
     def _parse_delay_read_expr(self) -> ASTCall:
-        """Parse: delay_read NAME (args)"""
-        tok = self._advance()  # consume 'delay_read'
+        """Parse: delay_read NAME (args) / delay_taps NAME (args)"""
+        tok = self._advance()  # consume 'delay_read' / 'delay_taps'
         name_tok = self._expect(IDENT)
         self._expect(OP, "(")
         args: list[ASTArg] = []
@@ -909,7 +923,7 @@ class Parser:
         if not self._at(OP, ")"):
             args.extend(self._parse_arg_list())
         self._expect(OP, ")")
-        return ASTCall(name="delay_read", args=args, line=tok.line, col=tok.col)
+        return ASTCall(name=tok.value, args=args, line=tok.line, col=tok.col)
 
     def _parse_arg_list(self) -> list[ASTArg]:
         args: list[ASTArg] = []
@@ -1041,6 +1055,9 @@ _BUILTINS: dict[str, tuple[type, list[str], dict[str, str]]] = {
     "smoothstep": (Smoothstep, ["a", "edge0", "edge1"], {}),
     "smooth": (SmoothParam, ["a", "coeff"], {}),
     "slide": (Slide, ["a", "up", "down"], {}),
+    "window_max": (WindowMax, ["a", "window", "max_window"], {}),
+    "window_min": (WindowMin, ["a", "window", "max_window"], {}),
+    "moving_average": (MovingAverage, ["a", "window"], {}),
     "adsr": (ADSR, ["gate", "attack", "decay", "sustain", "release"], {}),
     "select": (Select, ["cond", "a", "b"], {}),
     "delta": (Delta, ["a"], {}),
@@ -1057,7 +1074,14 @@ _BUILTINS: dict[str, tuple[type, list[str], dict[str, str]]] = {
     "cycle": (Cycle, ["buffer", "phase"], {}),
     "wave": (Wave, ["buffer", "phase"], {}),
     "lookup": (Lookup, ["buffer", "index"], {}),
+    "wavetable": (WavetableOsc, ["buffer", "freq"], {}),
     "buf_read": (BufRead, ["buffer", "index"], {}),
+    "resample": (Resample, ["buffer", "index", "rate", "taps"], {}),
+    "granulator": (
+        Granulator,
+        ["buffer", "density", "pitch", "position", "jitter", "size", "grains"],
+        {},
+    ),
     "buf_size": (BufSize, ["buffer"], {}),
 }
 
@@ -1196,7 +1220,7 @@ class _GraphCtx:
 
         elif isinstance(stmt, ASTBufferDecl):
             self._add_node(
-                Buffer(id=stmt.name, size=stmt.size, fill=stmt.fill)  # type: ignore[arg-type]
+                Buffer(id=stmt.name, size=stmt.size, fill=stmt.fill, format=stmt.format)  # type: ignore[arg-type]
             )
 
         elif isinstance(stmt, ASTDelayDecl):
@@ -1500,9 +1524,19 @@ class _GraphCtx:
         if name == "selector":
             return self._compile_selector(pos_args, kw_args, target_id, line, col)
 
+        # fdn (variadic literal line lengths)
+        if name == "fdn":
+            return self._compile_fdn(pos_args, kw_args, target_id, line, col)
+
+        # fir (coefficient buffer or variadic literal taps)
+        if name == "fir":
+            return self._compile_fir(pos_args, kw_args, target_id, line, col)
+
         # delay_read (special syntax already parsed with delay name injected)
         if name == "delay_read":
             return self._compile_delay_read(pos_args, kw_args, target_id, line, col)
+        if name == "delay_taps":
+            return self._compile_delay_taps(pos_args, kw_args, target_id, line, col)
 
         # Builtins registry
         if name in _BUILTINS:
@@ -1619,6 +1653,77 @@ class _GraphCtx:
         )
         return nid
 
+    def _compile_fdn(
+        self,
+        pos_args: list[ASTExpr],
+        kw_args: dict[str, ASTExpr],
+        target_id: str | None = None,
+        line: int = 0,
+        col: int = 0,
+    ) -> str:
+        if len(pos_args) < 3:
+            raise self._err(
+                "fdn requires an input and at least 2 delay line lengths", line, col
+            )
+        a_ref = self._compile_expr(pos_args[0])
+        delays: list[int] = []
+        for d_expr in pos_args[1:]:
+            if not isinstance(d_expr, ASTNumber) or d_expr.value != int(d_expr.value):
+                raise self._err(
+                    "fdn delay line lengths must be literal integers", line, col
+                )
+            delays.append(int(d_expr.value))
+
+        kwargs: dict[str, object] = {}
+        for k, v_expr in kw_args.items():
+            if k == "matrix":
+                if not isinstance(v_expr, ASTIdent):
+                    raise self._err("fdn matrix must be an identifier", line, col)
+                kwargs[k] = v_expr.name
+            elif k in ("feedback", "damping"):
+                kwargs[k] = self._to_ref(self._compile_expr(v_expr))
+            else:
+                raise self._err(f"fdn has no argument '{k}'", line, col)
+
+        nid = target_id or self._auto_id("fdn")
+        self._add_node(
+            FDN(id=nid, a=self._to_ref(a_ref), delays=delays, **kwargs)  # type: ignore[arg-type]
+        )
+        return nid
+
+    def _compile_fir(
+        self,
+        pos_args: list[ASTExpr],
+        kw_args: dict[str, ASTExpr],
+        target_id: str | None = None,
+        line: int = 0,
+        col: int = 0,
+    ) -> str:
+        if kw_args:
+            raise self._err(f"fir has no argument '{next(iter(kw_args))}'", line, col)
+        if len(pos_args) < 2:
+            raise self._err(
+                "fir requires an input and a coefficient buffer or taps", line, col
+            )
+        a_ref = self._compile_expr(pos_args[0])
+        coeffs: list[float] | str
+        if len(pos_args) == 2 and isinstance(pos_args[1], ASTIdent):
+            coeffs = pos_args[1].name
+        else:
+            coeffs = []
+            for c_expr in pos_args[1:]:
+                if not isinstance(c_expr, ASTNumber):
+                    raise self._err(
+                        "fir taps must be literal numbers or one buffer name",
+                        line,
+                        col,
+                    )
+                coeffs.append(c_expr.value)
+
+        nid = target_id or self._auto_id("fir")
+        self._add_node(FIR(id=nid, a=self._to_ref(a_ref), coeffs=coeffs))
+        return nid
+
     def _compile_delay_read(
         self,
         pos_args: list[ASTExpr],
@@ -1658,6 +1763,45 @@ class _GraphCtx:
         )
         return nid
 
+    def _compile_delay_taps(
+        self,
+        pos_args: list[ASTExpr],
+        kw_args: dict[str, ASTExpr],
+        target_id: str | None = None,
+        line: int = 0,
+        col: int = 0,
+    ) -> str:
+        # pos_args[0] is the delay name, then (tap, gain) pairs
+        pairs = pos_args[1:]
+        if not pairs or len(pairs) % 2:
+            raise self._err(
+                "delay_taps requires delay name and (tap, gain) pairs", line, col
+            )
+        delay_name_expr = pos_args[0]
+        if not isinstance(delay_name_expr, ASTIdent):
+            raise self._err("delay_taps first arg must be delay line name", line, col)
+
+        interp = "none"
+        for k, v_expr in kw_args.items():
+            if k != "interp":
+                raise self._err(f"delay_taps has no argument '{k}'", line, col)
+            if not isinstance(v_expr, ASTIdent):
+                raise self._err("delay_taps interp must be an identifier", line, col)
+            interp = v_expr.name
+
+        refs = [self._to_ref(self._compile_expr(e)) for e in pairs]
+        nid = target_id or self._auto_id("taps")
+        self._add_node(
+            MultiTapRead(
+                id=nid,
+                delay=delay_name_expr.name,
+                taps=refs[::2],
+                gains=refs[1::2],
+                interp=interp,  # type: ignore[arg-type]
+            )
+        )
+        return nid
+
     def _compile_builtin(
         self,
         name: str,
@@ -7,6 +7,22 @@ from pydantic import BaseModel, Field
 # Type alias for node input references: either a node/input/param ID or a literal float.
 Ref = Union[str, float]
 
+# String node fields that are enum selectors or settings, not node references.
+NON_REF_FIELDS = frozenset(
+    {
+        "id",
+        "op",
+        "interp",
+        "mode",
+        "output",
+        "count",
+        "channel",
+        "fill",
+        "format",
+        "matrix",
+    }
+)
+
 
 # ---------------------------------------------------------------------------
 # Param & I/O declarations
@@ -156,6 +172,17 @@ class DelayRead(BaseModel):
     interp: Literal["none", "linear", "cubic"] = "none"
 
 
+class MultiTapRead(BaseModel):
+    """Gain-weighted sum of several taps on one delay line."""
+
+    id: str
+    op: Literal["multi_tap_read"] = "multi_tap_read"
+    delay: str  # delay line ID
+    taps: list[Ref]  # tap positions (samples)
+    gains: list[Ref] = []  # one per tap; empty means unit gains
+    interp: Literal["none", "linear"] = "none"
+
+
 class DelayWrite(BaseModel):
     id: str
     op: Literal["delay_write"] = "delay_write"
@@ -163,6 +190,18 @@ class DelayWrite(BaseModel):
     value: Ref  # node ID or literal to write
 
 
+class FDN(BaseModel):
+    """Feedback delay network of ``len(delays)`` lines in one buffer."""
+
+    id: str
+    op: Literal["fdn"] = "fdn"
+    a: Ref
+    delays: list[int]  # per-line length in samples
+    feedback: Ref = 0.7
+    damping: Ref = 0.0  # one-pole lowpass coefficient in each loop (0 = off)
+    matrix: Literal["hadamard", "householder"] = "hadamard"  # hadamard: 2^k lines
+
+
 class Phasor(BaseModel):
     id: str
     op: Literal["phasor"] = "phasor"
@@ -270,6 +309,15 @@ class Allpass(BaseModel):
     coeff: Ref
 
 
+class FIR(BaseModel):
+    """Direct-form FIR filter: ``y[n] = sum_k coeffs[k] * a[n - k]``."""
+
+    id: str
+    op: Literal["fir"] = "fir"
+    a: Ref
+    coeffs: Union[list[float], str]  # inline taps or Buffer node ID
+
+
 # ---------------------------------------------------------------------------
 # Oscillators
 # ---------------------------------------------------------------------------
@@ -367,6 +415,36 @@ class Slide(BaseModel):
     down: Ref  # slide-down rate (samples)
 
 
+class WindowMax(BaseModel):
+    """Maximum of ``a`` over the last ``window`` samples (current included)."""
+
+    id: str
+    op: Literal["window_max"] = "window_max"
+    a: Ref
+    window: Ref  # window length (samples)
+    max_window: int = 4800  # deque capacity (samples)
+
+
+class WindowMin(BaseModel):
+    """Minimum of ``a`` over the last ``window`` samples; see ``WindowMax``."""
+
+    id: str
+    op: Literal["window_min"] = "window_min"
+    a: Ref
+    window: Ref  # window length (samples)
+    max_window: int = 4800  # deque capacity (samples)
+
+
+class MovingAverage(BaseModel):
+    """Mean (or RMS) of ``a`` over the last ``window`` samples."""
+
+    id: str
+    op: Literal["moving_average"] = "moving_average"
+    a: Ref
+    window: int = 4800  # samples
+    mode: Literal["mean", "rms"] = "mean"
+
+
 class ADSR(BaseModel):
     id: str
     op: Literal["adsr"] = "adsr"
@@ -456,16 +534,32 @@ class Subgraph(BaseModel):
     output: str = ""
 
 
+class Undersample(BaseModel):
+    """Run an inner graph at ``sr / factor`` behind anti-alias filters."""
+
+    id: str
+    op: Literal["undersample"] = "undersample"
+    graph: Graph
+    factor: int = 4
+    inputs: list[Ref] = []  # positional, onto the inner graph's inputs
+    params: list[Ref] = []  # positional; unmapped params keep defaults
+    output: str = ""
+    taps: int = 0  # anti-alias filter length; 0 picks 16 * factor + 1
+
+
 # ---------------------------------------------------------------------------
 # Buffer / Table
 # ---------------------------------------------------------------------------
 
 
 class Buffer(BaseModel):
+    """Sample storage; ``format="int16"`` keeps round(x * 32768), saturated."""
+
     id: str
     op: Literal["buffer"] = "buffer"
     size: int = 48000
     fill: Literal["zeros", "sine"] = "zeros"
+    format: Literal["float32", "int16"] = "float32"
 
 
 class BufRead(BaseModel):
@@ -476,6 +570,31 @@ class BufRead(BaseModel):
     interp: Literal["none", "linear", "cubic"] = "none"
 
 
+class Resample(BaseModel):
+    """Band-limited ``Buffer`` read for varispeed playback."""
+
+    id: str
+    op: Literal["resample"] = "resample"
+    buffer: str  # Buffer node ID
+    index: Ref  # read position in samples (clamped)
+    rate: Ref = 1.0  # playback ratio; sign is ignored
+    taps: int = 16  # kernel length, a multiple of 4 in 4..64
+
+
+class Granulator(BaseModel):
+    """Granular playback of a ``Buffer`` from a fixed pool of grains."""
+
+    id: str
+    op: Literal["granulator"] = "granulator"
+    buffer: str  # Buffer node ID
+    density: Ref = 10.0  # grain onsets per second; <= 0 stops new grains
+    pitch: Ref = 1.0  # playback ratio per grain; negative plays backwards
+    position: Ref = 0.0  # grain start as a fraction of the buffer (wraps)
+    jitter: Ref = 0.0  # random start offset, +/- this fraction of the buffer
+    size: Ref = 50.0  # grain length in ms
+    grains: int = 32  # pool capacity (maximum overlapping grains)
+
+
 class BufWrite(BaseModel):
     id: str
     op: Literal["buf_write"] = "buf_write"
@@ -519,6 +638,13 @@ class Lookup(BaseModel):
     index: Ref  # [0, 1] index, clamped
 
 
+class WavetableOsc(BaseModel):
+    id: str
+    op: Literal["wavetable"] = "wavetable"
+    buffer: str  # Buffer node ID holding one cycle (mip pyramid source)
+    freq: Ref  # Hz, band-limited by crossfading per-octave mip levels
+
+
 # ---------------------------------------------------------------------------
 # Routing
 # ---------------------------------------------------------------------------
@@ -556,7 +682,9 @@ Node = Annotated[
         History,
         DelayLine,
         DelayRead,
+        MultiTapRead,
         DelayWrite,
+        FDN,
         Phasor,
         Noise,
         Compare,
@@ -571,6 +699,7 @@ Node = Annotated[
         OnePole,
         DCBlock,
         Allpass,
+        FIR,
         SinOsc,
         TriOsc,
         SawOsc,
@@ -584,6 +713,9 @@ Node = Annotated[
         RateDiv,
         SmoothParam,
         Slide,
+        WindowMax,
+        WindowMin,
+        MovingAverage,
         ADSR,
         Peek,
         Scale,
@@ -592,14 +724,18 @@ Node = Annotated[
         SampleRate,
         Smoothstep,
         Subgraph,
+        Undersample,
         Buffer,
         BufRead,
+        Resample,
+        Granulator,
         BufWrite,
         Splat,
         BufSize,
         Cycle,
         Wave,
         Lookup,
+        WavetableOsc,
         GateRoute,
         GateOut,
         Selector,
@@ -626,3 +762,4 @@ class Graph(BaseModel):
 
 # Resolve circular reference: Subgraph.graph -> Graph -> list[Node] -> Subgraph
 Subgraph.model_rebuild()
+Undersample.model_rebuild()
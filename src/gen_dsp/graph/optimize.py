@@ -3,9 +3,11 @@
 from __future__ import annotations
 
 import math
+from collections.abc import Callable
 from typing import NamedTuple, Union
 
 from gen_dsp.graph.models import (
+    NON_REF_FIELDS,
     SVF,
     ADSR,
     Accum,
@@ -28,15 +30,20 @@ from gen_dsp.graph.models import (
     DelayWrite,
     Delta,
     Elapsed,
+    FDN,
+    FIR,
     Fold,
     GateOut,
     GateRoute,
+    Granulator,
     Graph,
     History,
     Latch,
     Lookup,
     Mix,
+    MovingAverage,
     MulAccum,
+    MultiTapRead,
     NamedConstant,
     Node,
     Noise,
@@ -46,6 +53,7 @@ from gen_dsp.graph.models import (
     Phasor,
     PulseOsc,
     RateDiv,
+    Resample,
     SampleHold,
     SampleRate,
     SawOsc,
@@ -57,9 +65,14 @@ from gen_dsp.graph.models import (
     Smoothstep,
     SmoothParam,
     Splat,
+    Subgraph,
     TriOsc,
     UnaryOp,
+    Undersample,
     Wave,
+    WavetableOsc,
+    WindowMax,
+    WindowMin,
     Wrap,
 )
 
@@ -68,7 +81,9 @@ _STATEFUL_TYPES = (
     History,
     DelayLine,
     DelayRead,
+    MultiTapRead,
     DelayWrite,
+    FDN,
     Phasor,
     Noise,
     Delta,
@@ -78,6 +93,7 @@ _STATEFUL_TYPES = (
     OnePole,
     DCBlock,
     Allpass,
+    FIR,
     SinOsc,
     TriOsc,
     SawOsc,
@@ -91,18 +107,31 @@ _STATEFUL_TYPES = (
     RateDiv,
     SmoothParam,
     Slide,
+    WindowMax,
+    WindowMin,
+    MovingAverage,
     ADSR,
     Peek,
     Buffer,
     BufRead,
+    Resample,
+    Granulator,
     BufWrite,
     Splat,
     Cycle,
     Wave,
     Lookup,
+    WavetableOsc,
+    Undersample,
+    Subgraph,
 )
 
 
+def _roundf(x: float) -> float:
+    """C ``roundf``: halves round away from zero (Python's ``round`` is to even)."""
+    return math.copysign(math.floor(abs(x) + 0.5), x)
+
+
 def _resolve_ref(ref: Union[str, float], constants: dict[str, float]) -> float | None:
     """Resolve a Ref to a float if it is a literal or a known constant node."""
     if isinstance(ref, float):
@@ -149,7 +178,7 @@ _UNARYOP_EVAL: dict[str, object] = {
     "neg": lambda x: -x,
     "floor": math.floor,
     "ceil": math.ceil,
-    "round": round,
+    "round": _roundf,
     "sign": lambda x: 1.0 if x > 0 else (-1.0 if x < 0 else 0.0),
     "atan": math.atan,
     "asin": lambda x: math.asin(x) if -1 <= x <= 1 else 0.0,
@@ -434,14 +463,17 @@ def eliminate_dead_nodes(graph: Graph) -> Graph:
                         worklist.append(item)
             elif isinstance(value, str) and value in node_ids:
                 worklist.append(value)
-        # If this is a DelayRead, also mark the corresponding writers
-        if isinstance(node, DelayRead):
+        # If this is a delay read, also mark the corresponding writers
+        if isinstance(node, (DelayRead, MultiTapRead)):
             for writer_id in delay_writers.get(node.delay, []):
                 worklist.append(writer_id)
-        # If this is a BufRead or BufSize, also mark the corresponding writers
-        if isinstance(node, (BufRead, BufSize)):
+        # If this reads a buffer, also mark the corresponding writers
+        if isinstance(node, (BufRead, Resample, Granulator, BufSize)):
             for writer_id in buffer_writers.get(node.buffer, []):
                 worklist.append(writer_id)
+        if isinstance(node, FIR) and isinstance(node.coeffs, str):
+            for writer_id in buffer_writers.get(node.coeffs, []):
+                worklist.append(writer_id)
 
     new_nodes = [node for node in graph.nodes if node.id in reachable]
     return graph.model_copy(update={"nodes": new_nodes})
@@ -473,7 +505,7 @@ def promote_control_rate(graph: Graph) -> Graph:
             continue
         is_invariant = True
         for field_name, value in node.__dict__.items():
-            if field_name in _NON_REF_FIELDS:
+            if field_name in NON_REF_FIELDS:
                 continue
             if isinstance(value, float):
                 continue
@@ -513,7 +545,7 @@ def promote_control_rate(graph: Graph) -> Graph:
             continue
         is_promotable = True
         for field_name, value in node.__dict__.items():
-            if field_name in _NON_REF_FIELDS:
+            if field_name in NON_REF_FIELDS:
                 continue
             if isinstance(value, float):
                 continue
@@ -553,8 +585,6 @@ def promote_control_rate(graph: Graph) -> Graph:
 
 _COMMUTATIVE_OPS = frozenset({"add", "mul", "min", "max"})
 
-_NON_REF_FIELDS = frozenset({"id", "op", "interp", "mode", "count", "channel"})
-
 
 def _operand_key(ref: Union[str, float]) -> tuple[int, Union[str, float]]:
     """Sort key for commutative operand canonicalization."""
@@ -629,7 +659,7 @@ def _rewrite_refs(node: Node, rewrite: dict[str, str]) -> Node:
     """Return a copy of *node* with string ref fields remapped through *rewrite*."""
     updates: dict[str, object] = {}
     for field_name, value in node.__dict__.items():
-        if field_name in _NON_REF_FIELDS:
+        if field_name in NON_REF_FIELDS:
             continue
         if isinstance(value, list):
             new_list = [rewrite.get(v, v) if isinstance(v, str) else v for v in value]
@@ -682,6 +712,213 @@ def eliminate_cse(graph: Graph) -> Graph:
     return graph.model_copy(update={"nodes": new_nodes, "outputs": new_outputs})
 
 
+# ---------------------------------------------------------------------------
+# Value-range analysis
+# ---------------------------------------------------------------------------
+
+Interval = tuple[float, float]
+"""Closed ``(lo, hi)`` bounds on every value a node can produce."""
+
+UNBOUNDED: Interval = (-math.inf, math.inf)
+
+# Largest float32 below 1.0: a wrapped phase accumulator never reaches 1.0f
+_BELOW_ONE = 1.0 - 2.0**-24
+
+_MONOTONIC_UNARY: dict[str, object] = {
+    "floor": math.floor,
+    "ceil": math.ceil,
+    "round": _roundf,
+    "trunc": math.trunc,
+    "exp": math.exp,
+    "exp2": lambda x: math.pow(2.0, x),
+    "mtof": lambda x: 440.0 * math.pow(2.0, (x - 69.0) / 12.0),
+    "dbtoa": lambda x: math.pow(10.0, x / 20.0),
+    "degrees": lambda x: x * (180.0 / math.pi),
+    "radians": lambda x: x * (math.pi / 180.0),
+    "atan": math.atan,
+}
+
+
+def is_bounded(iv: Interval) -> bool:
+    """True when both bounds are finite (which also rules out NaN values)."""
+    return math.isfinite(iv[0]) and math.isfinite(iv[1])
+
+
+def _iv(lo: float, hi: float) -> Interval:
+    """Build an interval, widening to UNBOUNDED on overflow or NaN."""
+    if not (math.isfinite(lo) and math.isfinite(hi)):
+        return UNBOUNDED
+    return (lo, hi)
+
+
+def _iv_hull(*ivs: Interval) -> Interval:
+    if not all(is_bounded(iv) for iv in ivs):
+        return UNBOUNDED
+    return (min(iv[0] for iv in ivs), max(iv[1] for iv in ivs))
+
+
+def _iv_mul(a: Interval, b: Interval) -> Interval:
+    if not (is_bounded(a) and is_bounded(b)):
+        return UNBOUNDED
+    prods = [a[0] * b[0], a[0] * b[1], a[1] * b[0], a[1] * b[1]]
+    return _iv(min(prods), max(prods))
+
+
+def _iv_binop(op: str, a: Interval, b: Interval) -> Interval:
+    # Logic ops produce 0 or 1 whatever their operands (NaN compares false)
+    if op in ("step", "and", "or", "xor"):
+        return (0.0, 1.0)
+    if op in ("rsub", "rdiv", "rmod"):
+        return _iv_binop(op[1:], b, a)
+    if not (is_bounded(a) and is_bounded(b)):
+        return UNBOUNDED
+    if op == "add":
+        return _iv(a[0] + b[0], a[1] + b[1])
+    if op == "sub":
+        return _iv(a[0] - b[1], a[1] - b[0])
+    if op == "mul":
+        return _iv_mul(a, b)
+    if op == "div":
+        if b[0] > 0.0 or b[1] < 0.0:
+            return _iv_mul(a, (1.0 / b[1], 1.0 / b[0]))
+        return UNBOUNDED
+    if op == "min":
+        return (min(a[0], b[0]), min(a[1], b[1]))
+    if op == "max":
+        return (max(a[0], b[0]), max(a[1], b[1]))
+    if op == "absdiff":
+        d = _iv_binop("sub", a, b)
+        return _iv_unary("abs", d)
+    if op == "mod":
+        if b[0] > 0.0 or b[1] < 0.0:
+            m = max(abs(b[0]), abs(b[1]))
+            return (max(min(a[0], 0.0), -m), min(max(a[1], 0.0), m))
+        return UNBOUNDED
+    if op in ("gtp", "ltp", "gtep", "ltep", "eqp", "neqp"):
+        return _iv_hull(a, (0.0, 0.0))
+    if op == "atan2":
+        return (-math.pi, math.pi)
+    return UNBOUNDED
+
+
+def _iv_unary(op: str, a: Interval) -> Interval:
+    # Ops with a fixed output set regardless of the operand
+    if op == "sign":
+        return (-1.0, 1.0)
+    if op in ("not", "bool", "isdenorm"):
+        return (0.0, 1.0)
+    if not is_bounded(a):
+        return UNBOUNDED
+    if op == "neg":
+        return (-a[1], -a[0])
+    if op == "abs":
+        if a[0] >= 0.0:
+            return a
+        if a[1] <= 0.0:
+            return (-a[1], -a[0])
+        return (0.0, max(-a[0], a[1]))
+    if op in ("sin", "cos", "tanh"):
+        return (-1.0, 1.0)
+    if op == "fract":
+        return (0.0, 1.0)
+    if op == "sqrt":
+        return _iv(math.sqrt(a[0]), math.sqrt(a[1])) if a[0] >= 0.0 else UNBOUNDED
+    if op in ("fixdenorm", "fixnan"):
+        return _iv_hull(a, (0.0, 0.0))
+    fn = _MONOTONIC_UNARY.get(op)
+    if fn is not None:
+        try:
+            return _iv(float(fn(a[0])), float(fn(a[1])))  # type: ignore[operator]
+        except OverflowError:
+            return UNBOUNDED
+    return UNBOUNDED
+
+
+def _node_range(node: Node, get: Callable[[str | float], Interval]) -> Interval:
+    """Range of a single node's output given the ranges of its operands."""
+    if isinstance(node, Constant):
+        return (node.value, node.value)
+    if isinstance(node, BinOp):
+        return _iv_binop(node.op, get(node.a), get(node.b))
+    if isinstance(node, UnaryOp):
+        return _iv_unary(node.op, get(node.a))
+    if isinstance(node, Compare):
+        return (0.0, 1.0)
+    if isinstance(node, (SinOsc, TriOsc, SawOsc, PulseOsc, Noise)):
+        return (-1.0, 1.0)
+    if isinstance(node, Phasor):
+        # The compiled phase wrap holds for any frequency, even NaN
+        return (0.0, _BELOW_ONE)
+    if isinstance(node, Pass):
+        return get(node.a)
+    if isinstance(node, Select):
+        return _iv_hull(get(node.a), get(node.b))
+    if isinstance(node, Mix):
+        a, b, t = get(node.a), get(node.b), get(node.t)
+        return _iv_binop("add", a, _iv_mul(_iv_binop("sub", b, a), t))
+    if isinstance(node, Clamp):
+        lo, hi = get(node.lo), get(node.hi)
+        if not (is_bounded(lo) and is_bounded(hi)):
+            return UNBOUNDED
+        # fminf/fmaxf discard a NaN operand, so any input lands in range
+        a = get(node.a)
+        x = (max(a[0], lo[0]), max(a[1], lo[1]))
+        return _iv(min(x[0], hi[0]), min(x[1], hi[1]))
+    if isinstance(node, (Wrap, Fold)):
+        a, lo, hi = get(node.a), get(node.lo), get(node.hi)
+        if is_bounded(a) and is_bounded(lo) and is_bounded(hi) and lo[1] < hi[0]:
+            return (lo[0], hi[1])
+        return UNBOUNDED
+    if isinstance(node, (SampleHold, Latch)):
+        return _iv_hull(get(node.a), (0.0, 0.0))
+    if isinstance(node, (WindowMax, WindowMin)):
+        # Always one of the last few input samples
+        return get(node.a)
+    if isinstance(node, FIR) and not isinstance(node.coeffs, str):
+        # Each history slot holds a past input or its initial zero
+        x = _iv_hull(get(node.a), (0.0, 0.0))
+        total: Interval = (0.0, 0.0)
+        for c in node.coeffs:
+            total = _iv_binop("add", total, _iv_mul(x, (c, c)))
+        return total
+    return UNBOUNDED
+
+
+def infer_ranges(graph: Graph) -> dict[str, Interval]:
+    """Infer closed value ranges for every node by interval arithmetic.
+
+    Used by the compiler to drop clamps, wraps and index guards that can
+    never trigger. A bounded interval also guarantees the value is never
+    NaN. Params and audio inputs are unbounded: ``set_param`` does not
+    enforce the declared min/max. Feedback (History) and stateful filter
+    outputs are unbounded as well. Oscillators are bounded for any
+    frequency and sample rate.
+    """
+    from gen_dsp.graph.toposort import toposort
+
+    ranges: dict[str, Interval] = {}
+    for node in graph.nodes:
+        if isinstance(node, Buffer):
+            ranges[node.id] = UNBOUNDED
+    buf_sizes = {n.id: n.size for n in graph.nodes if isinstance(n, Buffer)}
+
+    def get(ref: str | float) -> Interval:
+        if isinstance(ref, float):
+            return (ref, ref)
+        return ranges.get(ref, UNBOUNDED)
+
+    for node in toposort(graph):
+        if isinstance(node, BufSize) and node.buffer in buf_sizes:
+            size = float(buf_sizes[node.buffer])
+            ranges[node.id] = (size, size)
+        elif isinstance(node, NamedConstant):
+            value = _try_fold(node, {})
+            ranges[node.id] = (value, value) if value is not None else UNBOUNDED
+        else:
+            ranges[node.id] = _node_range(node, get)
+    return ranges
+
+
 class OptimizeStats(NamedTuple):
     """Statistics from a single optimize_graph() run."""
 
@@ -5,6 +5,8 @@ from __future__ import annotations
 from typing import Union
 
 from gen_dsp.graph.models import (
+    FDN,
+    FIR,
     SVF,
     BinOp,
     Buffer,
@@ -19,11 +21,15 @@ from gen_dsp.graph.models import (
     DelayWrite,
     GateOut,
     GateRoute,
+    Granulator,
     Graph,
     History,
     Lookup,
+    MovingAverage,
+    MultiTapRead,
     NamedConstant,
     Node,
+    Resample,
     SampleRate,
     Selector,
     Splat,
@@ -85,6 +91,8 @@ _BUILTIN_FIELDS: dict[str, list[str]] = {
     "rate_div": ["a", "divisor"],
     "smooth": ["a", "coeff"],
     "slide": ["a", "up", "down"],
+    "window_max": ["a", "window", "max_window"],
+    "window_min": ["a", "window", "max_window"],
     "adsr": ["gate", "attack", "decay", "sustain", "release"],
     "pass": ["a"],
     "peek": ["a"],
@@ -92,6 +100,7 @@ _BUILTIN_FIELDS: dict[str, list[str]] = {
     "cycle": ["buffer", "phase"],
     "wave": ["buffer", "phase"],
     "lookup": ["buffer", "index"],
+    "wavetable": ["buffer", "freq"],
     "buf_read": ["buffer", "index"],
     "buf_size": ["buffer"],
     "gate_route": ["a", "index"],
@@ -181,6 +190,8 @@ def graph_to_gdsp(graph: Graph) -> str:
     for node in graph.nodes:
         if isinstance(node, Buffer):
             fill_part = f" fill={node.fill}" if node.fill != "zeros" else ""
+            if node.format != "float32":
+                fill_part += f" format={node.format}"
             lines.append(f"{indent}buffer {node.id} {node.size}{fill_part}")
         elif isinstance(node, DelayLine):
             lines.append(f"{indent}delay {node.id} {node.max_samples}")
@@ -282,6 +293,13 @@ def _node_to_expr(
         interp_part = f", interp={node.interp}" if node.interp != "none" else ""
         return f"delay_read {node.delay} ({ref(node.tap)}{interp_part})"
 
+    # MultiTapRead: delay_taps NAME (tap, gain, ...)
+    if isinstance(node, MultiTapRead):
+        gains = node.gains or [1.0] * len(node.taps)
+        pairs = [f"{ref(t)}, {ref(g)}" for t, g in zip(node.taps, gains)]
+        interp_part = f", interp={node.interp}" if node.interp != "none" else ""
+        return f"delay_taps {node.delay} ({', '.join(pairs)}{interp_part})"
+
     # BufWrite: function-call statement
     if isinstance(node, BufWrite):
         return f"buf_write({node.buffer}, {ref(node.index)}, {ref(node.value)})"
@@ -295,6 +313,22 @@ def _node_to_expr(
         interp_part = f", interp={node.interp}" if node.interp != "none" else ""
         return f"buf_read({node.buffer}, {ref(node.index)}{interp_part})"
 
+    # Resample: taps kwarg (omit if default 16)
+    if isinstance(node, Resample):
+        taps_part = f", taps={node.taps}" if node.taps != 16 else ""
+        return (
+            f"resample({node.buffer}, {ref(node.index)}, {ref(node.rate)}{taps_part})"
+        )
+
+    # Granulator: grains kwarg (omit if default 32)
+    if isinstance(node, Granulator):
+        inputs = ", ".join(
+            ref(r)
+            for r in (node.density, node.pitch, node.position, node.jitter, node.size)
+        )
+        grains_part = f", grains={node.grains}" if node.grains != 32 else ""
+        return f"granulator({node.buffer}, {inputs}{grains_part})"
+
     # BufSize
     if isinstance(node, BufSize):
         return f"buf_size({node.buffer})"
@@ -312,6 +346,28 @@ def _node_to_expr(
         mode_part = f", mode={node.mode}" if node.mode != "lp" else ""
         return f"svf({ref(node.a)}, {ref(node.freq)}, {ref(node.q)}{mode_part})"
 
+    # MovingAverage: optional mode kwarg (omit if default 'mean')
+    if isinstance(node, MovingAverage):
+        mode_part = f", mode={node.mode}" if node.mode != "mean" else ""
+        return f"moving_average({ref(node.a)}, {node.window}{mode_part})"
+
+    # FDN: literal line lengths, then keyword args (defaults omitted)
+    if isinstance(node, FDN):
+        parts = [ref(node.a), *(str(d) for d in node.delays)]
+        parts.append(f"feedback={ref(node.feedback)}")
+        if node.damping != 0.0:
+            parts.append(f"damping={ref(node.damping)}")
+        if node.matrix != "hadamard":
+            parts.append(f"matrix={node.matrix}")
+        return f"fdn({', '.join(parts)})"
+
+    # FIR: coefficient buffer name or literal taps
+    if isinstance(node, FIR):
+        if isinstance(node.coeffs, str):
+            return f"fir({ref(node.a)}, {node.coeffs})"
+        taps = ", ".join(_format_num(c) for c in node.coeffs)
+        return f"fir({ref(node.a)}, {taps})"
+
     # Selector: variable-length inputs
     if isinstance(node, Selector):
         inputs_str = ", ".join(ref(i) for i in node.inputs)
@@ -14,6 +14,8 @@ Requires numpy (install via ``pip install gen-dsp[sim]``).
 from __future__ import annotations
 
 import math
+from collections import deque
+from collections.abc import Callable
 from dataclasses import dataclass, field
 from typing import Any
 
@@ -25,9 +27,12 @@ except ImportError as exc:
         "numpy is required for simulation. Install with: pip install gen-dsp[sim]"
     ) from exc
 
+from gen_dsp.graph.compile import _NAMED_CONSTANT_VALUES
 from gen_dsp.graph.models import (
-    SVF,
     ADSR,
+    FDN,
+    FIR,
+    SVF,
     Accum,
     Allpass,
     BinOp,
@@ -51,12 +56,15 @@ from gen_dsp.graph.models import (
     Fold,
     GateOut,
     GateRoute,
+    Granulator,
     Graph,
     History,
     Latch,
     Lookup,
     Mix,
+    MovingAverage,
     MulAccum,
+    MultiTapRead,
     NamedConstant,
     Node,
     Noise,
@@ -66,6 +74,7 @@ from gen_dsp.graph.models import (
     Phasor,
     PulseOsc,
     RateDiv,
+    Resample,
     SampleHold,
     SampleRate,
     SawOsc,
@@ -74,16 +83,37 @@ from gen_dsp.graph.models import (
     Selector,
     SinOsc,
     Slide,
-    Smoothstep,
     SmoothParam,
+    Smoothstep,
     Splat,
     TriOsc,
     UnaryOp,
+    Undersample,
     Wave,
+    WavetableOsc,
+    WindowMax,
+    WindowMin,
     Wrap,
 )
-from gen_dsp.graph.compile import _NAMED_CONSTANT_VALUES
 from gen_dsp.graph.subgraph import expand_subgraphs
+from gen_dsp.graph.tables import (
+    GRAIN_MAX_LEN,
+    GRAIN_MAX_WAIT,
+    GRAIN_WINDOW,
+    RESAMPLE_PHASES,
+    fdn_offsets,
+    grain_window,
+    mip_buffers,
+    mip_levels,
+    multitap_lanes,
+    multitap_table,
+    resample_kernel,
+    resample_ratios,
+    undersample_filter,
+    undersample_hist_len,
+    undersample_poly,
+    undersample_taps,
+)
 from gen_dsp.graph.toposort import toposort
 from gen_dsp.graph.validate import validate_graph
 
@@ -101,9 +131,26 @@ class SimState:
         self.sr = sample_rate if sample_rate > 0.0 else graph.sample_rate
         self._sorted_nodes = toposort(graph)
         self._params: dict[str, float] = {p.name: p.default for p in graph.params}
+        # Active ramps: name -> [increment, target, samples left]
+        self._ramps: dict[str, list[Any]] = {}
         self._state: dict[str, Any] = {}
+        self._mips = mip_buffers(self._sorted_nodes)
+        # int16 buffers hold float32 values already quantized to int16
+        self._s16 = frozenset(
+            n.id
+            for n in self._sorted_nodes
+            if isinstance(n, Buffer) and n.format == "int16"
+        )
         self._init_state()
 
+    def _fir_taps(self, node: FIR) -> int:
+        """Tap count of an FIR: its inline list or its coefficient buffer."""
+        if isinstance(node.coeffs, str):
+            for other in self._graph.nodes:
+                if isinstance(other, Buffer) and other.id == node.coeffs:
+                    return other.size
+        return len(node.coeffs)
+
     def _init_state(self) -> None:
         """Initialize node state, mirroring compile.py:_emit_state_init."""
         for node in self._sorted_nodes:
@@ -114,10 +161,21 @@ class SimState:
                 self._state[f"{nid}.buf"] = np.zeros(node.max_samples, dtype=np.float32)
                 self._state[f"{nid}.len"] = node.max_samples
                 self._state[f"{nid}.wr"] = 0
+            elif isinstance(node, FDN):
+                n = len(node.delays)
+                self._state[f"{nid}.buf"] = np.zeros(sum(node.delays), dtype=np.float32)
+                self._state[f"{nid}.off"] = np.array(fdn_offsets(node), dtype=np.intp)
+                self._state[f"{nid}.len"] = np.array(node.delays, dtype=np.intp)
+                self._state[f"{nid}.pos"] = np.zeros(n, dtype=np.intp)
+                self._state[f"{nid}.lp"] = np.zeros(n, dtype=np.float32)
             elif isinstance(node, Phasor):
                 self._state[f"{nid}.phase"] = 0.0
             elif isinstance(node, Noise):
                 self._state[f"{nid}.seed"] = np.uint32(123456789)
+            elif isinstance(node, Granulator):
+                # Constant window table, emitted as static data in C
+                self._state[f"{nid}.win"] = np.array(grain_window(), dtype=np.float32)
+                self._clear_grains(nid)
             elif isinstance(node, (Delta, Change)):
                 self._state[f"{nid}.prev"] = 0.0
             elif isinstance(node, (Biquad, SVF)):
@@ -128,6 +186,15 @@ class SimState:
             elif isinstance(node, (DCBlock, Allpass)):
                 self._state[f"{nid}.xprev"] = 0.0
                 self._state[f"{nid}.yprev"] = 0.0
+            elif isinstance(node, FIR):
+                taps = self._fir_taps(node)
+                self._state[f"{nid}.hist"] = np.zeros(2 * taps, dtype=np.float32)
+                self._state[f"{nid}.pos"] = 0
+            elif isinstance(node, Resample):
+                # Constant kernel table, emitted as static data in C
+                self._state[f"{nid}.kern"] = np.array(
+                    resample_kernel(node.taps), dtype=np.float32
+                )
             elif isinstance(node, (SinOsc, TriOsc, SawOsc, PulseOsc)):
                 self._state[f"{nid}.phase"] = 0.0
             elif isinstance(node, (SampleHold, Latch)):
@@ -149,6 +216,15 @@ class SimState:
                 self._state[f"{nid}.prev"] = 0.0
             elif isinstance(node, Slide):
                 self._state[f"{nid}.prev"] = 0.0
+            elif isinstance(node, (WindowMax, WindowMin)):
+                # (arrival sample, value) candidates, front = extremum
+                self._state[f"{nid}.deque"] = deque()
+                self._state[f"{nid}.t"] = 0
+            elif isinstance(node, MovingAverage):
+                self._state[f"{nid}.buf"] = np.zeros(node.window, dtype=np.float32)
+                self._state[f"{nid}.pos"] = 0
+                self._state[f"{nid}.sum"] = np.float32(0.0)
+                self._state[f"{nid}.fresh"] = np.float32(0.0)
             elif isinstance(node, ADSR):
                 self._state[f"{nid}.phase"] = 0
                 self._state[f"{nid}.output"] = 0.0
@@ -161,12 +237,41 @@ class SimState:
                     buf[:] = np.sin(
                         2.0 * np.pi * np.arange(node.size, dtype=np.float32) / node.size
                     ).astype(np.float32)
+                    if nid in self._s16:
+                        buf[:] = _to_s16(buf)
                 self._state[f"{nid}.buf"] = buf
                 self._state[f"{nid}.len"] = node.size
+                if nid in self._mips:
+                    self._state[f"{nid}.mip"] = _build_mips(buf)
+            elif isinstance(node, WavetableOsc):
+                self._state[f"{nid}.phase"] = 0.0
+                self._state[f"{nid}.f"] = 0.0
+                self._state[f"{nid}.inc"] = 0.0
+                self._state[f"{nid}.t"] = 0.0
+                self._state[f"{nid}.lvl"] = 0
+            elif isinstance(node, Undersample):
+                taps = undersample_taps(node)
+                hist = undersample_hist_len(node)
+                self._state[f"{nid}.inner"] = SimState(
+                    node.graph, self.sr / node.factor
+                )
+                self._state[f"{nid}.aa"] = np.array(
+                    undersample_filter(node.factor, taps), dtype=np.float32
+                )
+                self._state[f"{nid}.poly"] = np.array(
+                    undersample_poly(node), dtype=np.float32
+                ).reshape(node.factor, hist)
+                # Histories are stored newest-first
+                self._state[f"{nid}.dec"] = np.zeros(
+                    (len(node.inputs), taps), dtype=np.float32
+                )
+                self._state[f"{nid}.hist"] = np.zeros(hist, dtype=np.float32)
+                self._state[f"{nid}.phase"] = 0
 
     def reset(self) -> None:
         """Reset all state to initial values, mirroring compile.py:_emit_state_reset."""
         self._params = {p.name: p.default for p in self._graph.params}
+        self._ramps.clear()
         for node in self._sorted_nodes:
             nid = node.id
             if isinstance(node, History):
@@ -175,10 +280,16 @@ class SimState:
                 buf = self._state[f"{nid}.buf"]
                 buf[:] = 0.0
                 self._state[f"{nid}.wr"] = 0
+            elif isinstance(node, FDN):
+                self._state[f"{nid}.buf"][:] = 0.0
+                self._state[f"{nid}.pos"][:] = 0
+                self._state[f"{nid}.lp"][:] = 0.0
             elif isinstance(node, (Phasor, SinOsc, TriOsc, SawOsc, PulseOsc)):
                 self._state[f"{nid}.phase"] = 0.0
             elif isinstance(node, Noise):
                 self._state[f"{nid}.seed"] = np.uint32(123456789)
+            elif isinstance(node, Granulator):
+                self._clear_grains(nid)
             elif isinstance(node, (Delta, Change)):
                 self._state[f"{nid}.prev"] = 0.0
             elif isinstance(node, (Biquad, SVF)):
@@ -189,6 +300,9 @@ class SimState:
             elif isinstance(node, (DCBlock, Allpass)):
                 self._state[f"{nid}.xprev"] = 0.0
                 self._state[f"{nid}.yprev"] = 0.0
+            elif isinstance(node, FIR):
+                self._state[f"{nid}.hist"][:] = 0.0
+                self._state[f"{nid}.pos"] = 0
             elif isinstance(node, (SampleHold, Latch)):
                 self._state[f"{nid}.held"] = 0.0
                 self._state[f"{nid}.ptrig"] = 0.0
@@ -208,6 +322,15 @@ class SimState:
                 self._state[f"{nid}.prev"] = 0.0
             elif isinstance(node, Slide):
                 self._state[f"{nid}.prev"] = 0.0
+            elif isinstance(node, (WindowMax, WindowMin)):
+                # (arrival sample, value) candidates, front = extremum
+                self._state[f"{nid}.deque"] = deque()
+                self._state[f"{nid}.t"] = 0
+            elif isinstance(node, MovingAverage):
+                self._state[f"{nid}.buf"] = np.zeros(node.window, dtype=np.float32)
+                self._state[f"{nid}.pos"] = 0
+                self._state[f"{nid}.sum"] = np.float32(0.0)
+                self._state[f"{nid}.fresh"] = np.float32(0.0)
             elif isinstance(node, ADSR):
                 self._state[f"{nid}.phase"] = 0
                 self._state[f"{nid}.output"] = 0.0
@@ -220,14 +343,64 @@ class SimState:
                     buf[:] = np.sin(
                         2.0 * np.pi * np.arange(node.size, dtype=np.float32) / node.size
                     ).astype(np.float32)
+                    if nid in self._s16:
+                        buf[:] = _to_s16(buf)
                 else:
                     buf[:] = 0.0
+                if nid in self._mips:
+                    self._state[f"{nid}.mip"] = _build_mips(buf)
+            elif isinstance(node, WavetableOsc):
+                self._state[f"{nid}.phase"] = 0.0
+                self._state[f"{nid}.f"] = 0.0
+                self._state[f"{nid}.inc"] = 0.0
+                self._state[f"{nid}.t"] = 0.0
+                self._state[f"{nid}.lvl"] = 0
+            elif isinstance(node, Undersample):
+                self._state[f"{nid}.inner"].reset()
+                self._state[f"{nid}.dec"][:] = 0.0
+                self._state[f"{nid}.hist"][:] = 0.0
+                self._state[f"{nid}.phase"] = 0
+
+    def _clear_grains(self, nid: str) -> None:
+        # Live grains in onset order: [pos, inc, window phase, step, left]
+        self._state[f"{nid}.grains"] = []
+        self._state[f"{nid}.wait"] = np.float32(0.0)
+        self._state[f"{nid}.seed"] = np.uint32(123456789)
 
     def set_param(self, name: str, value: float) -> None:
         """Set a parameter value. Raises KeyError if name is unknown."""
         if name not in self._params:
             raise KeyError(f"Unknown param: '{name}'")
         self._params[name] = value
+        self._ramps.pop(name, None)
+
+    def set_param_ramp(self, name: str, target: float, nsamples: int) -> None:
+        """Glide a parameter linearly to *target* over *nsamples* samples.
+
+        Mirrors ``{name}_set_param_ramp``: the next sample keeps the current
+        value and *target* is reached after *nsamples* samples (held per
+        control block in control-rate graphs). A non-positive count jumps
+        immediately.
+        Raises KeyError if name is unknown.
+        """
+        if name not in self._params:
+            raise KeyError(f"Unknown param: '{name}'")
+        current = self._params[name]
+        if nsamples <= 0 or target == current:
+            self.set_param(name, target)
+            return
+        self._ramps[name] = [(target - current) / nsamples, target, nsamples]
+
+    def _advance_ramps(self) -> None:
+        """Step every active ramp by one sample."""
+        for name in list(self._ramps):
+            ramp = self._ramps[name]
+            ramp[2] -= 1
+            if ramp[2] == 0:
+                self._params[name] = ramp[1]
+                del self._ramps[name]
+            else:
+                self._params[name] += ramp[0]
 
     def get_param(self, name: str) -> float:
         """Get current parameter value. Raises KeyError if name is unknown."""
@@ -236,14 +409,21 @@ class SimState:
         return self._params[name]
 
     def set_buffer(self, buffer_id: str, data: NDArray[np.float32]) -> None:
-        """Set buffer contents. Data is truncated/zero-padded to buffer size."""
+        """Set buffer contents. Data is truncated/zero-padded to buffer size.
+
+        An int16 buffer saturates and rounds the float data as it stores it.
+        """
         key = f"{buffer_id}.buf"
         if key not in self._state:
             raise KeyError(f"Unknown buffer: '{buffer_id}'")
         buf: NDArray[np.float32] = self._state[key]
         copy_len = min(len(data), len(buf))
         buf[:copy_len] = data[:copy_len]
+        if buffer_id in self._s16:
+            buf[:copy_len] = _to_s16(buf[:copy_len])
         buf[copy_len:] = 0.0
+        if buffer_id in self._mips:
+            self._state[f"{buffer_id}.mip"] = _build_mips(buf)
 
     def get_buffer(self, buffer_id: str) -> NDArray[np.float32]:
         """Get a copy of buffer contents."""
@@ -260,6 +440,16 @@ class SimState:
             raise KeyError(f"Unknown peek: '{peek_id}'")
         return float(self._state[key])
 
+    def adsr_idle(self) -> bool:
+        """True when every ADSR envelope has finished (mirrors ``_adsr_idle``).
+
+        Graphs without envelopes report False.
+        """
+        adsr_ids = [n.id for n in self._sorted_nodes if isinstance(n, ADSR)]
+        if not adsr_ids:
+            return False
+        return all(self._state[f"{nid}.phase"] == 0 for nid in adsr_ids)
+
 
 @dataclass
 class SimResult:
@@ -348,6 +538,7 @@ def simulate(
 
     # Persistent vals dict for holding control-rate values across samples
     held_vals: dict[str, float] = {}
+    held_params: dict[str, float] = {}
 
     # Sample loop
     for i in range(n_samples):
@@ -358,9 +549,11 @@ def simulate(
             for iid, arr in inputs.items():
                 vals[iid] = float(arr[i])
 
-        # Load param values
-        for pname, pval in state._params.items():
-            vals[pname] = pval
+        # Load param values; they hold for a control block, like a compiled
+        # param segment
+        if ctrl_interval <= 0 or i % ctrl_interval == 0:
+            held_params = dict(state._params)
+        vals.update(held_params)
 
         # Load sr
         vals["sr"] = state.sr
@@ -403,9 +596,25 @@ def simulate(
         for out in state._graph.outputs:
             output_arrays[out.id][i] = np.float32(vals[out.source])
 
+        # Ramps step after the sample, so a block starts on the value it had
+        if state._ramps:
+            state._advance_ramps()
+
     return SimResult(outputs=output_arrays, state=state)
 
 
+def _advance_phase(phase: float, inc: float) -> float:
+    """Advance an oscillator phase and wrap it into [0, 1), as compiled."""
+    phase += inc
+    if phase >= 1.0:
+        phase -= 1.0
+    if not 0.0 <= phase < 1.0:
+        phase = phase - math.floor(phase) if math.isfinite(phase) else 0.0
+        if not phase < 1.0:
+            phase = 0.0
+    return phase
+
+
 def _resolve_ref(
     ref: str | float,
     vals: dict[str, float],
@@ -622,6 +831,33 @@ def _compute_node(
         elif node.interp == "cubic":
             vals[nid] = _interp_cubic_delay(tap, buf, length, wr)
 
+    elif isinstance(node, MultiTapRead):
+        dl = node.delay
+        buf = state._state[f"{dl}.buf"]
+        length = state._state[f"{dl}.len"]
+        wr = state._state[f"{dl}.wr"]
+        table = multitap_table(node)
+        lanes = multitap_lanes(len(table) if table is not None else len(node.taps))
+        acc = [np.float32(0.0)] * lanes
+        if table is not None:
+            for term, (off, weight) in enumerate(table):
+                acc[term % lanes] += np.float32(weight) * buf[(wr - off) % length]
+        else:
+            gains = node.gains or [1.0] * len(node.taps)
+            for term, (tap_ref, gain) in enumerate(zip(node.taps, gains)):
+                tap32 = np.float32(ref(tap_ref))
+                itap = int(tap32)
+                s0 = buf[(wr - itap) % length]
+                if node.interp == "linear" and tap32 != itap:
+                    s1 = buf[(wr - itap - 1) % length]
+                    s0 = s0 + (tap32 - np.float32(itap)) * (s1 - s0)
+                acc[term % lanes] += s0 if gain == 1.0 else np.float32(ref(gain)) * s0
+        # Same pairwise combine as the generated code's _sum_tree
+        while len(acc) > 1:
+            pairs = [a + b for a, b in zip(acc[::2], acc[1::2])]
+            acc = pairs + acc[len(pairs) * 2 :]
+        vals[nid] = float(acc[0])
+
     elif isinstance(node, DelayWrite):
         dl = node.delay
         val = ref(node.value)
@@ -631,14 +867,34 @@ def _compute_node(
         buf[wr] = np.float32(val)
         state._state[f"{dl}.wr"] = (wr + 1) % length
 
+    elif isinstance(node, FDN):
+        buf = state._state[f"{nid}.buf"]
+        line_pos: NDArray[np.intp] = state._state[f"{nid}.pos"]
+        heads = state._state[f"{nid}.off"] + line_pos
+        v = buf[heads]
+        if node.damping != 0.0:
+            lp = state._state[f"{nid}.lp"]
+            v = v + np.float32(ref(node.damping)) * (lp - v)
+            lp[:] = v
+        n = len(node.delays)
+        if node.matrix == "hadamard":
+            mixed = _fwht(v)
+            total = mixed[0]
+            gain = ref(node.feedback) / math.sqrt(n)
+        else:
+            total = v.sum(dtype=np.float32)
+            mixed = v - total * np.float32(2.0 / n)
+            gain = ref(node.feedback)
+        vals[nid] = float(total * np.float32(1.0 / n))
+        buf[heads] = np.float32(ref(node.a)) + np.float32(gain) * mixed
+        line_pos += 1
+        line_pos[line_pos == state._state[f"{nid}.len"]] = 0
+
     elif isinstance(node, Phasor):
         freq = ref(node.freq)
         phase = state._state[f"{nid}.phase"]
         vals[nid] = phase
-        phase += freq / state.sr
-        if phase >= 1.0:
-            phase -= 1.0
-        state._state[f"{nid}.phase"] = phase
+        state._state[f"{nid}.phase"] = _advance_phase(phase, freq / state.sr)
 
     elif isinstance(node, Noise):
         seed = state._state[f"{nid}.seed"]
@@ -765,42 +1021,44 @@ def _compute_node(
         state._state[f"{nid}.yprev"] = y
         vals[nid] = y
 
+    elif isinstance(node, FIR):
+        hist = state._state[f"{nid}.hist"]
+        taps = len(hist) // 2
+        pos = state._state[f"{nid}.pos"] - 1
+        if pos < 0:
+            pos = taps - 1
+        state._state[f"{nid}.pos"] = pos
+        hist[pos] = hist[pos + taps] = np.float32(ref(node.a))
+        if isinstance(node.coeffs, str):
+            coeffs = state._state[f"{node.coeffs}.buf"][:taps]
+        else:
+            coeffs = np.array(node.coeffs, dtype=np.float32)
+        vals[nid] = float(_fir_dot(coeffs, hist[pos : pos + taps]))
+
     elif isinstance(node, SinOsc):
         freq = ref(node.freq)
         phase = state._state[f"{nid}.phase"]
         vals[nid] = math.sin(6.28318530 * phase)
-        phase += freq / state.sr
-        if phase >= 1.0:
-            phase -= 1.0
-        state._state[f"{nid}.phase"] = phase
+        state._state[f"{nid}.phase"] = _advance_phase(phase, freq / state.sr)
 
     elif isinstance(node, TriOsc):
         freq = ref(node.freq)
         phase = state._state[f"{nid}.phase"]
         vals[nid] = 4.0 * abs(phase - 0.5) - 1.0
-        phase += freq / state.sr
-        if phase >= 1.0:
-            phase -= 1.0
-        state._state[f"{nid}.phase"] = phase
+        state._state[f"{nid}.phase"] = _advance_phase(phase, freq / state.sr)
 
     elif isinstance(node, SawOsc):
         freq = ref(node.freq)
         phase = state._state[f"{nid}.phase"]
         vals[nid] = 2.0 * phase - 1.0
-        phase += freq / state.sr
-        if phase >= 1.0:
-            phase -= 1.0
-        state._state[f"{nid}.phase"] = phase
+        state._state[f"{nid}.phase"] = _advance_phase(phase, freq / state.sr)
 
     elif isinstance(node, PulseOsc):
         freq = ref(node.freq)
         width = ref(node.width)
         phase = state._state[f"{nid}.phase"]
         vals[nid] = 1.0 if phase < width else -1.0
-        phase += freq / state.sr
-        if phase >= 1.0:
-            phase -= 1.0
-        state._state[f"{nid}.phase"] = phase
+        state._state[f"{nid}.phase"] = _advance_phase(phase, freq / state.sr)
 
     elif isinstance(node, SampleHold):
         a = ref(node.a)
@@ -880,6 +1138,30 @@ def _compute_node(
         elif node.interp == "cubic":
             vals[nid] = _interp_cubic_buf(idx, buf, buf_len)
 
+    elif isinstance(node, Granulator):
+        _granulator_step(node, ref, state, vals)
+
+    elif isinstance(node, Resample):
+        buf = state._state[f"{node.buffer}.buf"]
+        buf_len = state._state[f"{node.buffer}.len"]
+        taps = node.taps
+        # fmaxf/fminf clamp: a NaN index reads from the start
+        at = np.float32(ref(node.index))
+        at = min(at if at > 0.0 else np.float32(0.0), np.float32(buf_len - 1))
+        i0 = int(at)
+        fp = (at - np.float32(i0)) * np.float32(RESAMPLE_PHASES)
+        ph = int(fp)
+        pf = fp - np.float32(ph)
+        rate = abs(np.float32(ref(node.rate)))
+        lvl = sum(int(rate > np.float32(r)) for r in resample_ratios()[:-1])
+        row = (lvl * (RESAMPLE_PHASES + 1) + ph) * taps
+        kern = state._state[f"{nid}.kern"]
+        j = i0 - (taps // 2 - 1)
+        window = buf[np.clip(np.arange(j, j + taps), 0, buf_len - 1)]
+        s0 = _fir_dot(kern[row : row + taps], window)
+        s1 = _fir_dot(kern[row + taps : row + 2 * taps], window)
+        vals[nid] = float(s0 + pf * (s1 - s0))
+
     elif isinstance(node, BufWrite):
         buf_id = node.buffer
         idx = ref(node.index)
@@ -889,6 +1171,8 @@ def _compute_node(
         ii = int(idx)
         if 0 <= ii < buf_len:
             buf[ii] = np.float32(val)
+            if buf_id in state._s16:
+                buf[ii] = _to_s16(buf[ii])
 
     elif isinstance(node, Splat):
         buf_id = node.buffer
@@ -899,6 +1183,8 @@ def _compute_node(
         ii = int(idx)
         if 0 <= ii < buf_len:
             buf[ii] += np.float32(val)
+            if buf_id in state._s16:
+                buf[ii] = _to_s16(buf[ii])
 
     elif isinstance(node, BufSize):
         buf_id = node.buffer
@@ -941,6 +1227,41 @@ def _compute_node(
         i1 = min(i0 + 1, llen - 1)
         vals[nid] = float(buf[i0]) + frac * (float(buf[i1]) - float(buf[i0]))
 
+    elif isinstance(node, WavetableOsc):
+        freq = ref(node.freq)
+        mips = state._state[f"{node.buffer}.mip"]
+        levels = mips.shape[0]
+        size = mips.shape[1] - 2
+        if freq != state._state[f"{nid}.f"]:
+            half = 0.5 * state.sr
+            af = abs(freq)
+            if not af <= half:
+                af = half
+            octave = math.log2(2.0 * size * af / state.sr) if af > 0.0 else 0.0
+            octave = min(max(octave, 0.0), float(levels - 1))
+            lvl = min(int(octave), levels - 2)
+            state._state[f"{nid}.f"] = freq
+            state._state[f"{nid}.inc"] = math.copysign(af, freq) / state.sr
+            state._state[f"{nid}.t"] = octave - lvl
+            state._state[f"{nid}.lvl"] = lvl
+        lvl = state._state[f"{nid}.lvl"]
+        t = state._state[f"{nid}.t"]
+        phase = state._state[f"{nid}.phase"]
+        x = phase * size
+        i = int(x)
+        fr = x - i
+        a = mips[lvl]
+        b = mips[lvl + 1]
+        va = float(a[i]) + fr * (float(a[i + 1]) - float(a[i]))
+        vb = float(b[i]) + fr * (float(b[i + 1]) - float(b[i]))
+        vals[nid] = va + t * (vb - va)
+        phase += state._state[f"{nid}.inc"]
+        if phase >= 1.0:
+            phase -= 1.0
+        elif phase < 0.0:
+            phase += 1.0
+        state._state[f"{nid}.phase"] = phase
+
     elif isinstance(node, RateDiv):
         a = ref(node.a)
         divisor = ref(node.divisor)
@@ -986,6 +1307,47 @@ def _compute_node(
         state._state[f"{nid}.prev"] = y
         vals[nid] = y
 
+    elif isinstance(node, (WindowMax, WindowMin)):
+        x = float(np.float32(ref(node.a)))
+        # 1.0 first, so a NaN window falls back to 1 like fmaxf
+        span = int(min(max(1.0, ref(node.window)), node.max_window))
+        now = state._state[f"{nid}.t"]
+        state._state[f"{nid}.t"] = now + 1
+        cands: deque[tuple[int, float]] = state._state[f"{nid}.deque"]
+        while cands and now - cands[0][0] >= span:
+            cands.popleft()
+        # Negated like the C++ so NaN candidates are dropped the same way
+        if isinstance(node, WindowMax):
+            while cands and not cands[-1][1] > x:
+                cands.pop()
+        else:
+            while cands and not cands[-1][1] < x:
+                cands.pop()
+        cands.append((now, x))
+        vals[nid] = cands[0][1]
+
+    elif isinstance(node, MovingAverage):
+        # float32 throughout: the drift correction is part of what's mirrored
+        buf = state._state[f"{nid}.buf"]
+        pos = state._state[f"{nid}.pos"]
+        x32 = np.float32(ref(node.a))
+        v = x32 * x32 if node.mode == "rms" else x32
+        total = state._state[f"{nid}.sum"] + (v - buf[pos])
+        fresh = state._state[f"{nid}.fresh"] + v
+        buf[pos] = v
+        pos += 1
+        if pos == node.window:
+            pos = 0
+            total = fresh
+            fresh = np.float32(0.0)
+        state._state[f"{nid}.pos"] = pos
+        state._state[f"{nid}.sum"] = total
+        state._state[f"{nid}.fresh"] = fresh
+        mean = total * np.float32(1.0 / node.window)
+        if node.mode == "rms":
+            mean = np.sqrt(max(mean, np.float32(0.0)))
+        vals[nid] = float(mean)
+
     elif isinstance(node, ADSR):
         gate_val = ref(node.gate)
         attack_ms = ref(node.attack)
@@ -1032,6 +1394,32 @@ def _compute_node(
         state._state[f"{nid}.ptrig"] = ptrig
         vals[nid] = output
 
+    elif isinstance(node, Undersample):
+        dec = state._state[f"{nid}.dec"]
+        if len(node.inputs):
+            dec[:, 1:] = dec[:, :-1].copy()
+            dec[:, 0] = [ref(r) for r in node.inputs]
+        phase = state._state[f"{nid}.phase"] + 1
+        hist = state._state[f"{nid}.hist"]
+        if phase == node.factor:
+            phase = 0
+            inner = state._state[f"{nid}.inner"]
+            for inner_param, r in zip(node.graph.params, node.params):
+                inner.set_param(inner_param.name, ref(r))
+            aa = state._state[f"{nid}.aa"]
+            inner_inputs = {
+                inp.id: np.array([np.dot(aa, dec[k])], dtype=np.float32)
+                for k, inp in enumerate(node.graph.inputs)
+            }
+            res = simulate(
+                node.graph, inputs=inner_inputs or None, n_samples=1, state=inner
+            )
+            sel = node.output or node.graph.outputs[0].id
+            hist[1:] = hist[:-1].copy()
+            hist[0] = res.outputs[sel][0]
+        state._state[f"{nid}.phase"] = phase
+        vals[nid] = float(np.dot(state._state[f"{nid}.poly"][phase], hist))
+
     elif isinstance(node, Peek):
         a = ref(node.a)
         vals[nid] = a
@@ -1119,6 +1507,144 @@ def _interp_cubic_delay(
 # ---------------------------------------------------------------------------
 
 
+def _fwht(v: NDArray[np.float32]) -> NDArray[np.float32]:
+    """Unnormalised fast Walsh-Hadamard transform, mirroring the FDN codegen."""
+    n = len(v)
+    h = 1
+    while h < n:
+        blocks = v.reshape(-1, 2, h)
+        a, b = blocks[:, 0, :], blocks[:, 1, :]
+        v = np.stack([a + b, a - b], axis=1).reshape(n)
+        h *= 2
+    return v
+
+
+def _granulator_step(
+    node: Granulator,
+    ref: Callable[[str | float], float],
+    state: SimState,
+    vals: dict[str, float],
+) -> None:
+    """One sample of a Granulator, mirroring the span renderer in float32.
+
+    C renders spans that end at the next onset; starting a due grain first
+    and then summing every live grain for one sample gives the same values.
+    """
+    nid = node.id
+    st = state._state
+    buf = st[f"{node.buffer}.buf"]
+    buf_len = st[f"{node.buffer}.len"]
+    lenf = np.float32(buf_len)
+    grains: list[list[Any]] = st[f"{nid}.grains"]
+    wait = st[f"{nid}.wait"]
+    sr = np.float32(state.sr)
+    if wait <= 0.0:
+        dens = np.float32(ref(node.density))
+        if dens > 0.0:
+            if len(grains) < node.grains:
+                with np.errstate(over="ignore"):
+                    seed = np.uint32(
+                        np.uint32(st[f"{nid}.seed"]) * np.uint32(1664525)
+                        + np.uint32(1013904223)
+                    )
+                st[f"{nid}.seed"] = seed
+                r = np.float32(np.int32(seed)) / np.float32(2147483648.0)
+                start = (
+                    np.float32(ref(node.position)) + np.float32(ref(node.jitter)) * r
+                )
+                start = start - np.floor(start)
+                p = start * lenf
+                if p >= lenf:
+                    p = p - lenf
+                half = np.float32(0.5) * lenf
+                inc = min(max(np.float32(ref(node.pitch)), -half), half)
+                ms = np.float32(ref(node.size)) * sr * np.float32(0.001)
+                length = int(min(max(ms, np.float32(1.0)), np.float32(GRAIN_MAX_LEN)))
+                grains.append([p, inc, 0, 0xFFFFFFFF // length, length])
+            gap = min(max(sr / dens, np.float32(1.0)), np.float32(GRAIN_MAX_WAIT))
+            wait = np.float32(wait + gap)
+        else:
+            wait = np.float32(1.0)
+
+    win = st[f"{nid}.win"]
+    shift = 32 - (GRAIN_WINDOW.bit_length() - 1)
+    mask = (1 << shift) - 1
+    scale = np.float32(1.0 / (1 << shift))
+    out = np.float32(0.0)
+    for g in grains:
+        p, inc, ph = g[0], g[1], g[2]
+        j = int(p)
+        f = p - np.float32(j)
+        # Guard samples mirror the head of the buffer
+        b0 = buf[j % buf_len]
+        s = b0 + f * (buf[(j + 1) % buf_len] - b0)
+        wk = ph >> shift
+        wf = np.float32(ph & mask) * scale
+        a = win[wk] + wf * (win[wk + 1] - win[wk])
+        out = out + s * a
+        p = p + inc
+        if p >= lenf:
+            p = p - lenf
+        elif p < 0.0:
+            p = p + lenf
+        g[0] = p
+        g[2] = ph + g[3]
+        g[4] -= 1
+    st[f"{nid}.grains"] = [g for g in grains if g[4] > 0]
+    st[f"{nid}.wait"] = np.float32(wait - np.float32(1.0))
+    vals[nid] = float(out)
+
+
+def _fir_dot(coeffs: NDArray[np.float32], hist: NDArray[np.float32]) -> np.float32:
+    """FIR dot product in the compiled ``{name}_fir_dot`` summation order.
+
+    Four interleaved partial sums (each accumulated front to back),
+    combined as ``(s0 + s2) + (s1 + s3)``, then the leftover taps in order.
+    """
+    prod = coeffs * hist
+    whole = len(prod) - len(prod) % 4
+    s = np.float32(0.0)
+    if whole:
+        lanes = np.cumsum(prod[:whole].reshape(-1, 4), axis=0, dtype=np.float32)[-1]
+        s = (lanes[0] + lanes[2]) + (lanes[1] + lanes[3])
+    for p in prod[whole:]:
+        s += p
+    return s
+
+
+def _to_s16(x: Any) -> Any:
+    """Quantize float32 samples as ``{name}_to_s16`` stores them in int16.
+
+    NaN -> 0, scale by 32768, round to nearest (ties to even, like
+    ``lrintf``) and saturate to [-32768, 32767]. The result stays float32
+    (``int16 / 32768`` is exact), so reads of an int16 buffer need no
+    conversion.
+    """
+    s = np.nan_to_num(np.asarray(x, dtype=np.float32), nan=0.0)
+    s = np.clip(s, np.float32(-1.0), np.float32(1.0))
+    q = np.clip(np.rint(s * np.float32(32768.0)), -32768.0, 32767.0)
+    return (q / np.float32(32768.0)).astype(np.float32)
+
+
+def _build_mips(table: NDArray[np.float32]) -> NDArray[np.float32]:
+    """Band-limited mip pyramid, mirroring the compiled ``{name}_build_mips``.
+
+    Row 0 is *table*; row l keeps harmonics 0..n >> (l + 1). Each row ends
+    with two guard samples repeating its first two.
+    """
+    n = len(table)
+    levels = mip_levels(n)
+    spectrum = np.fft.rfft(table.astype(np.float64))
+    mips = np.empty((levels, n + 2), dtype=np.float32)
+    mips[0, :n] = table
+    for lvl in range(1, levels):
+        band = spectrum.copy()
+        band[(n >> (lvl + 1)) + 1 :] = 0.0
+        mips[lvl, :n] = np.fft.irfft(band, n)
+    mips[:, n:] = mips[:, :2]
+    return mips
+
+
 def _clamp_buf_idx(idx: int, buf_len: int) -> int:
     if idx < 0:
         return 0
@@ -2,16 +2,17 @@
 
 from __future__ import annotations
 
-from gen_dsp.graph.models import Graph, Node, Subgraph
+from collections.abc import Collection
 
-_NON_REF_FIELDS = frozenset(
-    {"id", "op", "interp", "mode", "output", "count", "channel"}
-)
+from gen_dsp.graph.models import NON_REF_FIELDS, Graph, Node, Subgraph
 
 
-def expand_subgraphs(graph: Graph) -> Graph:
+def expand_subgraphs(graph: Graph, keep: Collection[str] = ()) -> Graph:
     """Recursively expand all Subgraph nodes into a flat graph.
 
+    Top-level Subgraph nodes whose IDs are in *keep* are left in place
+    (their input and param refs are still rewritten); the compiler emits
+    those as calls to a separately compiled function.
     Returns the graph unchanged if it contains no Subgraph nodes.
     Raises ValueError on invalid subgraph wiring.
     """
@@ -29,7 +30,7 @@ def expand_subgraphs(graph: Graph) -> Graph:
     parent_input_ids = {inp.id for inp in graph.inputs}
 
     for node in graph.nodes:
-        if isinstance(node, Subgraph):
+        if isinstance(node, Subgraph) and node.id not in keep:
             pre_count = len(out_nodes)
             _expand_one(node, out_nodes, output_map)
             # Check for namespace collisions with parent params/inputs
@@ -157,7 +158,7 @@ def _rewrite_node(
     """Clone a node with prefixed ID and rewritten ref fields."""
     updates: dict[str, object] = {"id": prefix + node.id}
     for field_name, value in node.__dict__.items():
-        if field_name in _NON_REF_FIELDS:
+        if field_name in NON_REF_FIELDS:
             continue
         if isinstance(value, list):
             new_list = [
@@ -178,7 +179,7 @@ def _rewrite_refs(node: Node, output_map: dict[str, str]) -> Node:
     """Rewrite parent-level refs pointing to subgraph IDs."""
     updates: dict[str, object] = {}
     for field_name, value in node.__dict__.items():
-        if field_name in _NON_REF_FIELDS:
+        if field_name in NON_REF_FIELDS:
             continue
         if isinstance(value, list):
             new_list = [
@@ -186,6 +187,14 @@ def _rewrite_refs(node: Node, output_map: dict[str, str]) -> Node:
             ]
             if new_list != value:
                 updates[field_name] = new_list
+        elif isinstance(value, dict):
+            # Kept Subgraph inputs / params
+            new_map = {
+                k: output_map.get(v, v) if isinstance(v, str) else v
+                for k, v in value.items()
+            }
+            if new_map != value:
+                updates[field_name] = new_map
         elif isinstance(value, str) and value in output_map:
             updates[field_name] = output_map[value]
     if not updates:
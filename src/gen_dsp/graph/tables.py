@@ -0,0 +1,205 @@
+"""Tables and layouts shared by the compiler and the simulator.
+
+Filter kernels, window tables and buffer layouts that compiled code bakes
+in as constants and ``simulate()`` has to reproduce exactly.
+"""
+
+from __future__ import annotations
+
+import math
+import struct
+
+from gen_dsp.graph.models import FDN, MultiTapRead, Node, Undersample, WavetableOsc
+
+
+def f32(v: float) -> float:
+    """Round *v* to the nearest float32."""
+    result: float = struct.unpack("f", struct.pack("f", v))[0]
+    return result
+
+
+# ---------------------------------------------------------------------------
+# Wavetable mipmaps
+# ---------------------------------------------------------------------------
+
+
+def mip_buffers(nodes: list[Node]) -> frozenset[str]:
+    """Buffers read by WavetableOsc (each gets one shared mip pyramid)."""
+    return frozenset(n.buffer for n in nodes if isinstance(n, WavetableOsc))
+
+
+def mip_levels(size: int) -> int:
+    """Mip levels for a *size*-sample table; the last keeps one harmonic."""
+    return size.bit_length() - 1
+
+
+# ---------------------------------------------------------------------------
+# Multi-tap delay reads
+# ---------------------------------------------------------------------------
+
+
+MULTITAP_LANES = 4
+
+
+def multitap_table(node: MultiTapRead) -> list[tuple[int, float]] | None:
+    """Constant ``(offset, weight)`` pairs when every tap and gain is a literal.
+
+    Linear interpolation is folded in as two integer taps per fractional
+    read, weighted ``gain * (1 - frac)`` and ``gain * frac``; reads that land
+    on the same offset are merged into one entry.
+    """
+    gains = node.gains or [1.0] * len(node.taps)
+    weights: dict[int, float] = {}
+    for tap, gain in zip(node.taps, gains):
+        if not isinstance(tap, float) or not isinstance(gain, float):
+            return None
+        whole = int(tap)
+        frac = tap - whole
+        if node.interp == "none" or frac == 0.0:
+            weights[whole] = weights.get(whole, 0.0) + gain
+        else:
+            weights[whole] = weights.get(whole, 0.0) + gain * (1.0 - frac)
+            weights[whole + 1] = weights.get(whole + 1, 0.0) + gain * frac
+    return list(weights.items())
+
+
+def multitap_lanes(n: int) -> int:
+    """Number of partial sums a multi-tap read with *n* terms spreads over."""
+    return min(MULTITAP_LANES, n)
+
+
+# ---------------------------------------------------------------------------
+# Undersample
+# ---------------------------------------------------------------------------
+
+
+def undersample_taps(node: Undersample) -> int:
+    """Anti-alias filter length (``taps`` or the ``16 * factor + 1`` default)."""
+    return node.taps if node.taps > 0 else 16 * node.factor + 1
+
+
+def undersample_hist_len(node: Undersample) -> int:
+    """Inner-rate samples covered by the interpolation filter."""
+    return -(-undersample_taps(node) // node.factor)
+
+
+def undersample_filter(factor: int, taps: int) -> list[float]:
+    """Blackman-windowed sinc lowpass at the decimated Nyquist, unity DC gain."""
+    fc = 0.5 / factor
+    center = (taps - 1) / 2.0
+    h: list[float] = []
+    for t in range(taps):
+        x = t - center
+        sinc = (
+            2.0 * fc if x == 0.0 else math.sin(2.0 * math.pi * fc * x) / (math.pi * x)
+        )
+        if taps > 1:
+            ph = 2.0 * math.pi * t / (taps - 1)
+            win = 0.42 - 0.5 * math.cos(ph) + 0.08 * math.cos(2.0 * ph)
+        else:
+            win = 1.0
+        h.append(sinc * win)
+    total = sum(h)
+    return [v / total for v in h]
+
+
+def undersample_poly(node: Undersample) -> list[float]:
+    """Interpolation filter split into ``factor`` phases of equal length.
+
+    Phase ``p`` holds ``factor * h[p + j * factor]`` for ``j`` in
+    ``[0, hist_len)``, zero-padded past the end of ``h``; the gain
+    compensates for the zero-stuffed upsampling.
+    """
+    factor = node.factor
+    taps = undersample_taps(node)
+    hist = undersample_hist_len(node)
+    h = undersample_filter(factor, taps)
+    poly: list[float] = []
+    for p in range(factor):
+        for j in range(hist):
+            k = p + j * factor
+            poly.append(factor * h[k] if k < taps else 0.0)
+    return poly
+
+
+# ---------------------------------------------------------------------------
+# Feedback delay networks
+# ---------------------------------------------------------------------------
+
+
+def fdn_offsets(node: FDN) -> list[int]:
+    """Start of each line in the FDN's shared buffer."""
+    offsets = [0]
+    for d in node.delays[:-1]:
+        offsets.append(offsets[-1] + d)
+    return offsets
+
+
+# ---------------------------------------------------------------------------
+# Resample
+# ---------------------------------------------------------------------------
+
+
+# Kernel rows per sample of fractional offset; a read blends the two nearest
+RESAMPLE_PHASES = 32
+
+# Cutoff levels, half an octave apart: playback ratios 1 to 8
+RESAMPLE_LEVELS = 7
+
+
+def resample_ratios() -> list[float]:
+    """Playback ratio each Resample kernel level is designed for."""
+    return [2.0 ** (0.5 * lvl) for lvl in range(RESAMPLE_LEVELS)]
+
+
+def resample_kernel(taps: int) -> list[float]:
+    """Blackman-windowed sinc rows for Resample, each with unity DC gain.
+
+    Row ``(level, p)`` weights the *taps* samples around a read that falls
+    ``p / RESAMPLE_PHASES`` past sample ``taps / 2 - 1`` of the window,
+    with its cutoff at ``0.5 / ratio`` cycles per sample. Phases run to
+    ``RESAMPLE_PHASES`` inclusive, so every row has a successor to blend.
+    Values are rounded to float32, as emitted.
+    """
+    half = taps // 2
+    kernel: list[float] = []
+    for ratio in resample_ratios():
+        fc = 0.5 / ratio
+        for p in range(RESAMPLE_PHASES + 1):
+            frac = p / RESAMPLE_PHASES
+            row: list[float] = []
+            for t in range(taps):
+                d = t - half + 1 - frac
+                x = 2.0 * fc * d
+                if x == 0.0:
+                    sinc = 1.0
+                elif x == round(x):
+                    sinc = 0.0  # exact zero crossing (sin(pi * k) is not 0.0)
+                else:
+                    sinc = math.sin(math.pi * x) / (math.pi * x)
+                ph = 2.0 * math.pi * d / taps
+                win = 0.42 + 0.5 * math.cos(ph) + 0.08 * math.cos(2.0 * ph)
+                row.append(sinc * win)
+            total = sum(row)
+            kernel.extend(f32(v / total) for v in row)
+    return kernel
+
+
+# ---------------------------------------------------------------------------
+# Granulator
+# ---------------------------------------------------------------------------
+
+
+# Hann window table points (plus one guard point)
+GRAIN_WINDOW = 512
+
+# Longest onset interval and grain, in samples: the countdown and grain
+# lengths stay exact in float32
+GRAIN_MAX_WAIT = 4194304.0
+GRAIN_MAX_LEN = 16777216.0
+
+
+def grain_window() -> list[float]:
+    """Hann window over ``GRAIN_WINDOW`` points, ending on a guard zero."""
+    n = GRAIN_WINDOW
+    return [f32(0.5 - 0.5 * math.cos(2.0 * math.pi * k / n)) for k in range(n + 1)]
@@ -3,9 +3,31 @@
 from __future__ import annotations
 
 from collections import defaultdict
+from collections.abc import Iterator
 
 from gen_dsp.graph._deps import build_forward_deps
-from gen_dsp.graph.models import Graph, Node
+from gen_dsp.graph.models import (
+    FIR,
+    Buffer,
+    BufRead,
+    BufWrite,
+    Cycle,
+    DelayLine,
+    DelayRead,
+    DelayWrite,
+    Granulator,
+    Graph,
+    History,
+    Lookup,
+    MultiTapRead,
+    Node,
+    Resample,
+    Splat,
+    Wave,
+)
+
+# Nodes that only hold or mutate state and never produce a sample value
+_NO_VALUE = (DelayLine, DelayWrite, Buffer, BufWrite, Splat)
 
 
 def toposort(graph: Graph) -> list[Node]:
@@ -51,6 +73,199 @@ def toposort(graph: Graph) -> list[Node]:
     return result
 
 
+def schedule(graph: Graph) -> list[Node]:
+    """Return a register-pressure-aware topological order for code emission.
+
+    Greedy list scheduling: among the nodes whose operands are all
+    available, emit the one that retires the most live values (operands
+    it is the last consumer of) and creates the fewest new ones. Ties go
+    to the node consuming the most recently computed value, so consumers
+    follow their producers, then to the node a depth-first walk from the
+    sinks reaches first, so independent chains are finished one at a time.
+    Two walks are tried (heaviest operand first, and ``toposort`` order)
+    and the schedule with fewer simultaneously live values is kept.
+
+    Nodes that touch the same delay line or buffer keep their relative
+    ``toposort`` order, so read-before-write semantics (and therefore the
+    output) are identical to the alphabetical order. Only IDs break ties,
+    so the result is deterministic.
+    Raises ValueError if the graph contains a cycle.
+    """
+    reference = toposort(graph)
+    if not reference:
+        return []
+
+    pos = {node.id: i for i, node in enumerate(reference)}
+    operands = _operands(graph, pos)
+
+    # Accesses to the same delay line / buffer stay in reference order
+    before = {nid: set(ops) for nid, ops in operands.items()}
+    last_access: dict[str, str] = {}
+    for node in reference:
+        res = _shared_resource(node)
+        if res is None:
+            continue
+        if res in last_access:
+            before[node.id].add(last_access[res])
+        last_access[res] = node.id
+
+    candidates = [
+        _list_schedule(graph, reference, operands, before, rank)
+        for rank in (
+            _depth_first_rank(before, pos, heaviest_first=True),
+            _depth_first_rank(before, pos, heaviest_first=False),
+        )
+    ]
+    return min(candidates, key=lambda order: max_live(graph, order))
+
+
+def max_live(graph: Graph, order: list[Node]) -> int:
+    """Return the peak number of simultaneously live node values in *order*.
+
+    A value is live from the node that computes it until its last consumer.
+    Values feeding audio outputs or History write-backs stay live until the
+    end of the sample. Used to compare schedules.
+    """
+    at = {node.id: i for i, node in enumerate(order)}
+    operands = _operands(graph, at)
+    valued = _valued(graph, order)
+    end = len(order)
+    last_use = dict(at)
+    for nid, ops in operands.items():
+        for dep in ops:
+            last_use[dep] = max(last_use[dep], at[nid])
+    for nid in _held(graph):
+        if nid in last_use:
+            last_use[nid] = end
+
+    delta = [0] * (end + 2)
+    for nid in valued:
+        delta[at[nid]] += 1
+        delta[last_use[nid] + 1] -= 1
+    peak = live = 0
+    for d in delta:
+        live += d
+        peak = max(peak, live)
+    return peak
+
+
+def _list_schedule(
+    graph: Graph,
+    reference: list[Node],
+    operands: dict[str, list[str]],
+    before: dict[str, set[str]],
+    rank: dict[str, int],
+) -> list[Node]:
+    """Greedy list scheduling of *reference* under the *before* constraints."""
+    pos = {node.id: i for i, node in enumerate(reference)}
+    valued = _valued(graph, reference)
+    after: dict[str, list[str]] = {nid: [] for nid in pos}
+    for nid, preds in before.items():
+        for dep in preds:
+            after[dep].append(nid)
+    waiting = {nid: len(preds) for nid, preds in before.items()}
+    # Unscheduled consumers per value; values still needed after the
+    # loop body (outputs, History write-backs) are never retired here
+    uses = {nid: 0 for nid in pos}
+    for ops in operands.values():
+        for dep in ops:
+            uses[dep] += 1
+    held = _held(graph)
+    emitted_at: dict[str, int] = {}
+
+    def priority(nid: str) -> tuple[int, int, int]:
+        ops = operands[nid]
+        retired = sum(1 for d in ops if uses[d] == 1 and d not in held)
+        created = 1 if nid in valued else 0
+        recent = max((emitted_at[d] for d in ops), default=-1)
+        return (retired - created, recent, -rank[nid])
+
+    ready = {nid for nid, cnt in waiting.items() if cnt == 0}
+    result: list[Node] = []
+    while ready:
+        best = max(ready, key=priority)
+        ready.discard(best)
+        emitted_at[best] = len(result)
+        result.append(reference[pos[best]])
+        for dep in operands[best]:
+            uses[dep] -= 1
+        for nxt in after[best]:
+            waiting[nxt] -= 1
+            if waiting[nxt] == 0:
+                ready.add(nxt)
+    return result
+
+
+def _depth_first_rank(
+    before: dict[str, set[str]], pos: dict[str, int], heaviest_first: bool
+) -> dict[str, int]:
+    """Return each node's index in a post-order walk from the sinks.
+
+    Operands are visited in ``toposort`` order or, with *heaviest_first*,
+    by descending Sethi-Ullman label (the number of live values needed to
+    evaluate them) first.
+    """
+    need: dict[str, int] = {}
+    for nid in sorted(pos, key=pos.__getitem__):
+        labels = sorted((need[d] for d in before[nid]), reverse=True)
+        need[nid] = max([1] + [lab + i for i, lab in enumerate(labels)])
+
+    def visit(nid: str) -> Iterator[str]:
+        if heaviest_first:
+            return iter(sorted(before[nid], key=lambda d: (-need[d], pos[d])))
+        return iter(sorted(before[nid], key=pos.__getitem__))
+
+    consumed = {dep for preds in before.values() for dep in preds}
+    rank: dict[str, int] = {}
+    for root in (nid for nid in pos if nid not in consumed):
+        # Iterative: large graphs exceed the recursion limit
+        stack = [(root, visit(root))]
+        while stack:
+            nid, pending = stack[-1]
+            for dep in pending:
+                if dep not in rank:
+                    stack.append((dep, visit(dep)))
+                    break
+            else:
+                stack.pop()
+                rank.setdefault(nid, len(rank))
+    return rank
+
+
+def _operands(graph: Graph, known: dict[str, int]) -> dict[str, list[str]]:
+    """Return each node's node-valued operands (no feedback edges)."""
+    deps = build_forward_deps(graph)
+    return {
+        nid: sorted((d for d in deps.get(nid, ()) if d in known), key=known.__getitem__)
+        for nid in known
+    }
+
+
+def _valued(graph: Graph, nodes: list[Node]) -> set[str]:
+    """Return IDs of nodes that produce a per-sample value."""
+    return {n.id for n in nodes if not isinstance(n, _NO_VALUE)}
+
+
+def _held(graph: Graph) -> set[str]:
+    """Return IDs whose values are read after the loop body's node statements."""
+    held = {out.source for out in graph.outputs}
+    held.update(n.input for n in graph.nodes if isinstance(n, History))
+    return held
+
+
+def _shared_resource(node: Node) -> str | None:
+    """Return the delay line / buffer a node reads or writes, if any."""
+    if isinstance(node, (DelayRead, MultiTapRead, DelayWrite)):
+        return node.delay
+    if isinstance(
+        node, (BufRead, Resample, Granulator, BufWrite, Splat, Cycle, Wave, Lookup)
+    ):
+        return node.buffer
+    if isinstance(node, FIR) and isinstance(node.coeffs, str):
+        return node.coeffs
+    return None
+
+
 def _insort(lst: list[str], val: str) -> None:
     """Insert val into sorted list lst, maintaining sort order."""
     lo, hi = 0, len(lst)
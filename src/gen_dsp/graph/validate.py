@@ -4,6 +4,9 @@ from collections import defaultdict
 
 from gen_dsp.graph._deps import build_forward_deps
 from gen_dsp.graph.models import (
+    FDN,
+    FIR,
+    NON_REF_FIELDS,
     Buffer,
     BufRead,
     BufSize,
@@ -14,15 +17,38 @@ from gen_dsp.graph.models import (
     DelayWrite,
     GateOut,
     GateRoute,
+    Granulator,
     Graph,
     History,
     Lookup,
+    MovingAverage,
+    MultiTapRead,
+    Resample,
     Splat,
     Subgraph,
+    Undersample,
     Wave,
+    WavetableOsc,
+    WindowMax,
+    WindowMin,
 )
 from gen_dsp.graph.optimize import _STATEFUL_TYPES
 
+# Longest WavetableOsc table; the mip pyramid build is O(n^2)
+_MAX_WAVETABLE = 16384
+
+# Most FDN lines; the mix is emitted as straight-line code
+_MAX_FDN_LINES = 64
+
+# Most FIR taps; direct form costs one multiply-add per tap per sample
+_MAX_FIR_TAPS = 4096
+
+# Longest Resample kernel; its table is emitted as static data per length
+_MAX_RESAMPLE_TAPS = 64
+
+# Largest Granulator pool; the slots are arrays inside the state struct
+_MAX_GRAINS = 1024
+
 
 class GraphValidationError(str):
     """A structured validation error that behaves as a plain string.
@@ -44,10 +70,16 @@ class GraphValidationError(str):
         ``"bad_output_source"``
             ``AudioOutput.source`` does not reference a node.
         ``"missing_delay_line"``
-            ``DelayRead``/``DelayWrite`` references a non-existent ``DelayLine``.
+            ``DelayRead``/``MultiTapRead``/``DelayWrite`` references a
+            non-existent ``DelayLine``.
         ``"missing_buffer"``
             A buffer consumer (``BufRead``, ``BufWrite``, ``BufSize``, ``Splat``,
-            ``Cycle``, ``Wave``, ``Lookup``) references a non-existent ``Buffer``.
+            ``Cycle``, ``Wave``, ``Lookup``, ``WavetableOsc``, ``Resample``,
+            ``Granulator``, or an ``FIR`` with buffer coefficients) references
+            a non-existent ``Buffer``.
+        ``"wavetable_size"``
+            A ``WavetableOsc`` table is shorter than 4 or longer than 16384
+            samples (its mip pyramid is built by an O(n^2) DFT).
         ``"missing_gate_route"``
             ``GateOut.gate`` references a non-existent ``GateRoute``.
         ``"gate_channel_range"``
@@ -58,6 +90,30 @@ class GraphValidationError(str):
             A control-rate node depends on an audio input.
         ``"control_rate_dep"``
             A control-rate node depends on an audio-rate node.
+        ``"fdn_error"``
+            An ``FDN`` has fewer than 2 or more than 64 lines, a line shorter
+            than 1 sample, or a non-power-of-two line count with the
+            ``hadamard`` matrix.
+        ``"fir_taps"``
+            An ``FIR`` has no taps or more than 4096 (inline ``coeffs`` or
+            the length of its coefficient ``Buffer``).
+        ``"resample_taps"``
+            A ``Resample`` kernel length is not a multiple of 4 in 4..64.
+        ``"granulator_grains"``
+            A ``Granulator`` pool holds fewer than 1 or more than 1024 grains.
+        ``"buffer_format"``
+            A ``Resample``, ``Granulator``, ``WavetableOsc`` or ``FIR`` reads
+            an ``int16`` ``Buffer`` (these read float storage directly).
+        ``"window_capacity"``
+            A ``WindowMax``/``WindowMin`` has ``max_window`` below 1, or a
+            ``MovingAverage`` has ``window`` below 1.
+        ``"multitap_error"``
+            A ``MultiTapRead`` has no taps, a ``gains`` list whose length is
+            neither 0 nor the tap count, or a literal tap outside
+            ``[0, max_samples]`` (less one for ``linear``).
+        ``"undersample_error"``
+            An ``Undersample`` has a bad factor/taps, mismatched input or
+            param mapping, an unknown output selector, or an invalid inner graph.
         ``"cycle"``
             Graph contains a pure cycle (not through ``History`` or delay feedback).
         ``"expansion_error"``
@@ -207,22 +263,10 @@ def validate_graph(
 
     all_ids = set(node_ids) | all_sources
 
-    # String fields that are enum selectors, not node references
-    _NON_REF_FIELDS = {
-        "id",
-        "op",
-        "interp",
-        "mode",
-        "output",
-        "count",
-        "channel",
-        "fill",
-    }
-
     # 2. Reference resolution -- every str input resolves to a known ID
     for node in graph.nodes:
         for field_name, value in node.__dict__.items():
-            if field_name in _NON_REF_FIELDS:
+            if field_name in NON_REF_FIELDS:
                 continue
             if isinstance(value, list):
                 for idx, item in enumerate(value):
@@ -260,18 +304,24 @@ def validate_graph(
                 )
             )
 
-    # 4. Delay consistency -- DelayRead/DelayWrite must reference a DelayLine
-    delay_line_ids = {node.id for node in graph.nodes if isinstance(node, DelayLine)}
+    # 4. Delay consistency -- delay reads/writes must reference a DelayLine
+    delay_lines = {node.id: node for node in graph.nodes if isinstance(node, DelayLine)}
+    delay_line_ids = set(delay_lines)
     for node in graph.nodes:
-        if isinstance(node, DelayRead) and node.delay not in delay_line_ids:
+        if (
+            isinstance(node, (DelayRead, MultiTapRead))
+            and node.delay not in delay_line_ids
+        ):
             errors.append(
                 GraphValidationError(
                     "missing_delay_line",
-                    f"DelayRead '{node.id}' references non-existent delay line '{node.delay}'",
+                    f"{type(node).__name__} '{node.id}' references non-existent delay line '{node.delay}'",
                     node_id=node.id,
                     field_name="delay",
                 )
             )
+        if isinstance(node, MultiTapRead):
+            errors.extend(_check_multitap(node, delay_lines.get(node.delay)))
         if isinstance(node, DelayWrite) and node.delay not in delay_line_ids:
             errors.append(
                 GraphValidationError(
@@ -284,6 +334,7 @@ def validate_graph(
 
     # 4b. Buffer consistency -- BufRead/BufWrite/BufSize must reference a Buffer
     buffer_ids = {node.id for node in graph.nodes if isinstance(node, Buffer)}
+    buffer_sizes = {n.id: n.size for n in graph.nodes if isinstance(n, Buffer)}
     for node in graph.nodes:
         if isinstance(node, BufRead) and node.buffer not in buffer_ids:
             errors.append(
@@ -348,6 +399,57 @@ def validate_graph(
                     field_name="buffer",
                 )
             )
+        if isinstance(node, Resample) and node.buffer not in buffer_ids:
+            errors.append(
+                GraphValidationError(
+                    "missing_buffer",
+                    f"Resample '{node.id}' references non-existent buffer '{node.buffer}'",
+                    node_id=node.id,
+                    field_name="buffer",
+                )
+            )
+        if isinstance(node, Granulator) and node.buffer not in buffer_ids:
+            errors.append(
+                GraphValidationError(
+                    "missing_buffer",
+                    f"Granulator '{node.id}' references non-existent buffer '{node.buffer}'",
+                    node_id=node.id,
+                    field_name="buffer",
+                )
+            )
+        if (
+            isinstance(node, FIR)
+            and isinstance(node.coeffs, str)
+            and node.coeffs not in buffer_ids
+        ):
+            errors.append(
+                GraphValidationError(
+                    "missing_buffer",
+                    f"FIR '{node.id}' references non-existent buffer '{node.coeffs}'",
+                    node_id=node.id,
+                    field_name="coeffs",
+                )
+            )
+        if isinstance(node, WavetableOsc):
+            if node.buffer not in buffer_sizes:
+                errors.append(
+                    GraphValidationError(
+                        "missing_buffer",
+                        f"WavetableOsc '{node.id}' references non-existent buffer '{node.buffer}'",
+                        node_id=node.id,
+                        field_name="buffer",
+                    )
+                )
+            elif not 4 <= buffer_sizes[node.buffer] <= _MAX_WAVETABLE:
+                errors.append(
+                    GraphValidationError(
+                        "wavetable_size",
+                        f"WavetableOsc '{node.id}' table '{node.buffer}' has "
+                        f"{buffer_sizes[node.buffer]} samples (must be 4..{_MAX_WAVETABLE})",
+                        node_id=node.id,
+                        field_name="buffer",
+                    )
+                )
 
     # 4c. Gate consistency -- GateOut must reference a GateRoute, channel in range
     gate_route_map = {
@@ -376,6 +478,104 @@ def validate_graph(
                         )
                     )
 
+    # 4d. Undersample consistency -- factor, mappings, inner graph validity
+    for node in graph.nodes:
+        if isinstance(node, Undersample):
+            errors.extend(_check_undersample(node))
+
+    # 4e. FDN shape -- line count and lengths
+    for node in graph.nodes:
+        if isinstance(node, FDN):
+            errors.extend(_check_fdn(node))
+
+    # 4f. Sliding-window ring capacity
+    for node in graph.nodes:
+        if isinstance(node, (WindowMax, WindowMin)):
+            field_name, size = "max_window", node.max_window
+        elif isinstance(node, MovingAverage):
+            field_name, size = "window", node.window
+        else:
+            continue
+        if size < 1:
+            errors.append(
+                GraphValidationError(
+                    "window_capacity",
+                    f"{type(node).__name__} '{node.id}': {field_name} must be >= 1,"
+                    f" got {size}",
+                    node_id=node.id,
+                    field_name=field_name,
+                )
+            )
+
+    # 4g. FIR tap count
+    for node in graph.nodes:
+        if isinstance(node, FIR):
+            if isinstance(node.coeffs, str):
+                taps = buffer_sizes.get(node.coeffs)
+                if taps is None:
+                    continue  # reported as missing_buffer
+            else:
+                taps = len(node.coeffs)
+            if not 1 <= taps <= _MAX_FIR_TAPS:
+                errors.append(
+                    GraphValidationError(
+                        "fir_taps",
+                        f"FIR '{node.id}' has {taps} taps (must be 1..{_MAX_FIR_TAPS})",
+                        node_id=node.id,
+                        field_name="coeffs",
+                    )
+                )
+
+    # 4h. Resample kernel length (whole SIMD lanes, bounded table size)
+    for node in graph.nodes:
+        if isinstance(node, Resample) and (
+            node.taps % 4 or not 4 <= node.taps <= _MAX_RESAMPLE_TAPS
+        ):
+            errors.append(
+                GraphValidationError(
+                    "resample_taps",
+                    f"Resample '{node.id}' has {node.taps} taps (must be a multiple"
+                    f" of 4 in 4..{_MAX_RESAMPLE_TAPS})",
+                    node_id=node.id,
+                    field_name="taps",
+                )
+            )
+
+    # 4i. Granulator pool capacity
+    for node in graph.nodes:
+        if isinstance(node, Granulator) and not 1 <= node.grains <= _MAX_GRAINS:
+            errors.append(
+                GraphValidationError(
+                    "granulator_grains",
+                    f"Granulator '{node.id}' has {node.grains} grains"
+                    f" (must be 1..{_MAX_GRAINS})",
+                    node_id=node.id,
+                    field_name="grains",
+                )
+            )
+
+    # 4j. int16 buffers -- only the converting read paths accept them
+    s16_ids = {
+        n.id for n in graph.nodes if isinstance(n, Buffer) and n.format == "int16"
+    }
+    for node in graph.nodes:
+        if isinstance(node, (Resample, Granulator, WavetableOsc)):
+            field_name, buf_id = "buffer", node.buffer
+        elif isinstance(node, FIR) and isinstance(node.coeffs, str):
+            field_name, buf_id = "coeffs", node.coeffs
+        else:
+            continue
+        if buf_id in s16_ids:
+            errors.append(
+                GraphValidationError(
+                    "buffer_format",
+                    f"{type(node).__name__} '{node.id}' cannot read int16 buffer"
+                    f" '{buf_id}' (use a float32 buffer)",
+                    node_id=node.id,
+                    field_name=field_name,
+                )
+            )
+
     # 5. Control-rate consistency
     if graph.control_interval > 0 and graph.control_nodes:
         ctrl_set = set(graph.control_nodes)
@@ -401,7 +601,7 @@ def validate_graph(
                 continue
             is_inv = True
             for fn, val in node.__dict__.items():
-                if fn in _NON_REF_FIELDS:
+                if fn in NON_REF_FIELDS:
                     continue
                 if isinstance(val, float):
                     continue
@@ -434,7 +634,7 @@ def validate_graph(
             if isinstance(node, History):
                 continue
             for field_name, value in node.__dict__.items():
-                if field_name in _NON_REF_FIELDS:
+                if field_name in NON_REF_FIELDS:
                     continue
                 str_refs: list[str] = []
                 if isinstance(value, list):
@@ -498,3 +698,96 @@ def validate_graph(
     errors.extend(warnings)
 
     return errors
+
+
+def _check_undersample(node: Undersample) -> list[GraphValidationError]:
+    """Validate an Undersample node's parameters and inner graph."""
+    errors: list[GraphValidationError] = []
+    nid = node.id
+
+    def err(msg: str, field_name: str | None = None) -> None:
+        errors.append(
+            GraphValidationError(
+                "undersample_error",
+                f"Undersample '{nid}': {msg}",
+                node_id=nid,
+                field_name=field_name,
+            )
+        )
+
+    inner = node.graph
+    if node.factor < 2:
+        err(f"factor must be >= 2, got {node.factor}", "factor")
+    if node.taps < 0:
+        err(f"taps must be >= 0, got {node.taps}", "taps")
+    if len(node.inputs) != len(inner.inputs):
+        err(
+            f"expects {len(inner.inputs)} input(s), got {len(node.inputs)}",
+            "inputs",
+        )
+    if len(node.params) > len(inner.params):
+        err(
+            f"maps {len(node.params)} param(s) but inner graph has {len(inner.params)}",
+            "params",
+        )
+    if not inner.outputs:
+        err("inner graph has no outputs", "graph")
+    elif node.output and node.output not in {o.id for o in inner.outputs}:
+        err(f"output '{node.output}' not found in inner graph", "output")
+    for inner_err in validate_graph(inner):
+        err(f"inner graph: {inner_err}", "graph")
+    return errors
+
+
+def _check_multitap(
+    node: MultiTapRead, line: DelayLine | None
+) -> list[GraphValidationError]:
+    """Validate a MultiTapRead's tap/gain counts and literal tap positions."""
+    errors: list[GraphValidationError] = []
+
+    def err(msg: str, field_name: str) -> None:
+        errors.append(
+            GraphValidationError(
+                "multitap_error",
+                f"MultiTapRead '{node.id}': {msg}",
+                node_id=node.id,
+                field_name=field_name,
+            )
+        )
+
+    if not node.taps:
+        err("needs at least one tap", "taps")
+    if node.gains and len(node.gains) != len(node.taps):
+        err(f"{len(node.gains)} gains for {len(node.taps)} taps", "gains")
+    if line is not None:
+        # Literal taps compile to offsets that are only wrapped once
+        hi = line.max_samples - (1 if node.interp == "linear" else 0)
+        for k, tap in enumerate(node.taps):
+            if isinstance(tap, float) and not 0.0 <= tap <= hi:
+                err(f"tap {k} ({tap:g}) outside [0, {hi}]", "taps")
+    return errors
+
+
+def _check_fdn(node: FDN) -> list[GraphValidationError]:
+    """Validate an FDN node's line count and lengths."""
+    errors: list[GraphValidationError] = []
+    n = len(node.delays)
+
+    def err(msg: str, field_name: str) -> None:
+        errors.append(
+            GraphValidationError(
+                "fdn_error",
+                f"FDN '{node.id}': {msg}",
+                node_id=node.id,
+                field_name=field_name,
+            )
+        )
+
+    if not 2 <= n <= _MAX_FDN_LINES:
+        err(f"needs 2..{_MAX_FDN_LINES} delay lines, got {n}", "delays")
+    elif node.matrix == "hadamard" and n & (n - 1):
+        err(f"hadamard matrix needs a power-of-two line count, got {n}", "matrix")
+    for k, d in enumerate(node.delays):
+        if d < 1:
+            err(f"line {k} length must be >= 1, got {d}", "delays")
+    return errors
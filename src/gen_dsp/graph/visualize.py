@@ -30,15 +30,20 @@ from gen_dsp.graph.models import (
     Cycle,
     Delta,
     Elapsed,
+    FDN,
+    FIR,
     Fold,
     GateOut,
     GateRoute,
+    Granulator,
     Graph,
     History,
     Latch,
     Lookup,
     Mix,
+    MovingAverage,
     MulAccum,
+    MultiTapRead,
     NamedConstant,
     Noise,
     OnePole,
@@ -47,6 +52,7 @@ from gen_dsp.graph.models import (
     Phasor,
     PulseOsc,
     RateDiv,
+    Resample,
     SampleHold,
     SampleRate,
     SawOsc,
@@ -61,7 +67,11 @@ from gen_dsp.graph.models import (
     Subgraph,
     TriOsc,
     UnaryOp,
+    Undersample,
     Wave,
+    WavetableOsc,
+    WindowMax,
+    WindowMin,
     Wrap,
 )
 
@@ -82,8 +92,13 @@ def _node_attrs(node: object) -> tuple[str, str, str]:
         return "box3d", "#fde0c8", f"{node.id}\\ndelay[{node.max_samples}]"
     if isinstance(node, DelayRead):
         return "box", "#fde0c8", f"{node.id}\\nread"
+    if isinstance(node, MultiTapRead):
+        return "box", "#fde0c8", f"{node.id}\\nread x{len(node.taps)}"
     if isinstance(node, DelayWrite):
         return "box", "#fde0c8", f"{node.id}\\nwrite"
+    if isinstance(node, FDN):
+        n = len(node.delays)
+        return "box3d", "#fde0c8", f"{node.id}\\nfdn[{n}] {node.matrix}"
     if isinstance(node, Phasor):
         return "box", "#e2d5f1", f"{node.id}\\nphasor"
     if isinstance(node, Noise):
@@ -112,6 +127,10 @@ def _node_attrs(node: object) -> tuple[str, str, str]:
         return "box", "#fde0c8", f"{node.id}\\ndcblock"
     if isinstance(node, Allpass):
         return "box", "#fde0c8", f"{node.id}\\nallpass"
+    if isinstance(node, FIR):
+        if isinstance(node.coeffs, str):
+            return "box", "#fde0c8", f"{node.id}\\nfir({node.coeffs})"
+        return "box", "#fde0c8", f"{node.id}\\nfir[{len(node.coeffs)}]"
     if isinstance(node, SinOsc):
         return "box", "#e2d5f1", f"{node.id}\\nsinosc"
     if isinstance(node, TriOsc):
@@ -129,9 +148,14 @@ def _node_attrs(node: object) -> tuple[str, str, str]:
     if isinstance(node, Counter):
         return "box", "#fde0c8", f"{node.id}\\ncounter"
     if isinstance(node, Buffer):
-        return "box3d", "#fde0c8", f"{node.id}\\nbuffer[{node.size}]"
+        fmt = "" if node.format == "float32" else f" {node.format}"
+        return "box3d", "#fde0c8", f"{node.id}\\nbuffer[{node.size}]{fmt}"
     if isinstance(node, BufRead):
         return "box", "#fde0c8", f"{node.id}\\nbuf_read"
+    if isinstance(node, Resample):
+        return "box", "#fde0c8", f"{node.id}\\nresample[{node.taps}]"
+    if isinstance(node, Granulator):
+        return "box", "#fde0c8", f"{node.id}\\ngranulator[{node.grains}]"
     if isinstance(node, BufWrite):
         return "box", "#fde0c8", f"{node.id}\\nbuf_write"
     if isinstance(node, Splat):
@@ -144,6 +168,8 @@ def _node_attrs(node: object) -> tuple[str, str, str]:
         return "box", "#fde0c8", f"{node.id}\\nwave"
     if isinstance(node, Lookup):
         return "box", "#fde0c8", f"{node.id}\\nlookup"
+    if isinstance(node, WavetableOsc):
+        return "box", "#e2d5f1", f"{node.id}\\nwavetable"
     if isinstance(node, Elapsed):
         return "box", "#fde0c8", f"{node.id}\\nelapsed"
     if isinstance(node, MulAccum):
@@ -156,6 +182,10 @@ def _node_attrs(node: object) -> tuple[str, str, str]:
         return "box", "#fde0c8", f"{node.id}\\nsmooth"
     if isinstance(node, Slide):
         return "box", "#fde0c8", f"{node.id}\\nslide"
+    if isinstance(node, (WindowMax, WindowMin)):
+        return "box", "#fde0c8", f"{node.id}\\n{node.op} [{node.max_window}]"
+    if isinstance(node, MovingAverage):
+        return "box", "#fde0c8", f"{node.id}\\n{node.mode} [{node.window}]"
     if isinstance(node, ADSR):
         return "box", "#fde0c8", f"{node.id}\\nadsr"
     if isinstance(node, Peek):
@@ -178,6 +208,8 @@ def _node_attrs(node: object) -> tuple[str, str, str]:
         n_in = len(node.graph.inputs)
         n_out = len(node.graph.outputs)
         return "box3d", "#cce5ff", f"{node.id}\\nsubgraph ({n_in}in/{n_out}out)"
+    if isinstance(node, Undersample):
+        return "box3d", "#cce5ff", f"{node.id}\\nundersample /{node.factor}"
     return "box", "#ffffff", str(getattr(node, "id", "?"))
 
 
@@ -71,6 +71,7 @@ class AudioUnitPlatform(CMakePlatform):
 
         self.generate_ext_header(output_dir, "au")
         self.copy_remap_header(output_dir)
+        self.copy_lto_module(output_dir)
         self.copy_voice_alloc_header(output_dir, config)
 
         # Detect AU type from I/O configuration
@@ -76,6 +76,7 @@ class Auv3Platform(Platform):
 
         self.generate_ext_header(output_dir, "auv3")
         self.copy_remap_header(output_dir)
+        self.copy_lto_module(output_dir)
         self.copy_voice_alloc_header(output_dir, config)
 
         # Detect AU type
@@ -50,6 +50,15 @@ class Platform(ABC):
     # Version string for generated projects
     GENEXT_VERSION = "0.8.0"
 
+    # Whether generated projects carry the hooks for `gen-dsp build --pgo`
+    supports_pgo: bool = False
+
+    # Whether generated build files honour GEN_DSP_LTO (`gen-dsp build --lto`)
+    supports_lto: bool = True
+
+    # Whether the wrapper shuffles host buffers with gen_dsp_simd.h
+    uses_simd_kernels: bool = False
+
     @abstractmethod
     def generate_project(
         self,
@@ -209,6 +218,46 @@ class Platform(ABC):
         if src.exists():
             shutil.copy2(src, output_dir / "gen_remap_inputs.h")
 
+    def copy_pgo_files(self, output_dir: Path, cmake: bool = True) -> None:
+        """Copy the profile-guided build files used by `gen-dsp build --pgo`.
+
+        gen_dsp_pgo_train.cpp is the training workload; CMake projects also
+        get gen_dsp_pgo.cmake, which their CMakeLists.txt includes.
+        """
+        from gen_dsp.templates import get_templates_dir
+
+        shared = get_templates_dir("shared")
+        names = ["gen_dsp_pgo_train.cpp"]
+        if cmake:
+            names.append("gen_dsp_pgo.cmake")
+        for name in names:
+            src = shared / name
+            if src.exists():
+                shutil.copy2(src, output_dir / name)
+
+    def copy_lto_module(self, output_dir: Path) -> None:
+        """Copy gen_dsp_lto.cmake, included by CMake projects for `--lto`."""
+        from gen_dsp.templates import get_templates_dir
+
+        src = get_templates_dir("shared") / "gen_dsp_lto.cmake"
+        if src.exists():
+            shutil.copy2(src, output_dir / "gen_dsp_lto.cmake")
+
+    def copy_simd_header(self, output_dir: Path) -> None:
+        """Copy gen_dsp_simd.h for wrappers that set uses_simd_kernels.
+
+        The header holds the SSE2/NEON/scalar interleave and sample format
+        conversion kernels used in the wrappers' audio callbacks.
+        """
+        if not self.uses_simd_kernels:
+            return
+
+        from gen_dsp.templates import get_templates_dir
+
+        src = get_templates_dir("shared") / "gen_dsp_simd.h"
+        if src.exists():
+            shutil.copy2(src, output_dir / "gen_dsp_simd.h")
+
     def generate_ext_header(self, output_dir: Path, platform_key: str) -> None:
         """Generate the standard _ext_{platform}.h header from shared template.
 
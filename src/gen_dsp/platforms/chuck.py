@@ -22,6 +22,7 @@ class ChuckPlatform(Platform):
     """ChucK chugin platform implementation using make."""
 
     name = "chuck"
+    uses_simd_kernels = True
 
     @property
     def extension(self) -> str:
@@ -66,6 +67,7 @@ class ChuckPlatform(Platform):
                 shutil.copy2(src, output_dir / filename)
 
         self.copy_remap_header(output_dir)
+        self.copy_simd_header(output_dir)
 
         # Copy chugin.h (bundled header in chuck/include/)
         chugin_include_src = templates_dir / "chuck" / "include"
@@ -940,6 +940,9 @@ class CirclePlatform(Platform):
     """Circle bare metal Raspberry Pi platform implementation using Make."""
 
     name = "circle"
+    # Circle's Rules.mk links with the bare linker, which has no LTO plugin
+    supports_lto = False
+    uses_simd_kernels = True
 
     @property
     def extension(self) -> str:
@@ -989,6 +992,7 @@ class CirclePlatform(Platform):
 
         self.generate_ext_header(output_dir, "circle")
         self.copy_remap_header(output_dir)
+        self.copy_simd_header(output_dir)
 
         # Select template based on audio device type
         if board.audio_device == "usb":
@@ -1224,6 +1228,7 @@ class CirclePlatform(Platform):
             src = templates_dir / filename
             if src.exists():
                 shutil.copy2(src, output_dir / filename)
+        self.copy_simd_header(output_dir)
 
         # Compute chain metrics
         max_channels = max(
@@ -1453,6 +1458,7 @@ class CirclePlatform(Platform):
             src = templates_dir / filename
             if src.exists():
                 shutil.copy2(src, output_dir / filename)
+        self.copy_simd_header(output_dir)
 
         # Compute max channels across all nodes
         max_channels = max(
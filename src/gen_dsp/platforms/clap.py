@@ -23,6 +23,7 @@ class ClapPlatform(CMakePlatform):
     """CLAP plugin platform implementation using CMake."""
 
     name = "clap"
+    supports_pgo = True
 
     @property
     def extension(self) -> str:
@@ -56,6 +57,8 @@ class ClapPlatform(CMakePlatform):
 
         self.generate_ext_header(output_dir, "clap")
         self.copy_remap_header(output_dir)
+        self.copy_pgo_files(output_dir)
+        self.copy_lto_module(output_dir)
         self.copy_voice_alloc_header(output_dir, config)
 
         # Resolve shared cache settings
@@ -39,6 +39,7 @@ class CsoundPlatform(Platform):
     """Csound opcode plugin platform using make."""
 
     name = "csound"
+    uses_simd_kernels = True
 
     @property
     def extension(self) -> str:
@@ -80,6 +81,7 @@ class CsoundPlatform(Platform):
         # Generate _ext_csound.h via shared template
         self.generate_ext_header(output_dir, "csound")
         self.copy_remap_header(output_dir)
+        self.copy_simd_header(output_dir)
 
         # Generate gen_buffer.h using base class method
         self.generate_buffer_header(
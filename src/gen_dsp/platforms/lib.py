@@ -0,0 +1,142 @@
+"""
+Shared library platform implementation.
+
+Generates a plain shared library (libgendsp_<name>.so / .dylib / .dll)
+with a stable C API for embedding in servers, batch pipelines, and
+FFI bindings. The library exports only the functions declared in the
+generated ``include/gendsp_<name>.h`` header: versioned lifecycle,
+processing, parameter and state calls, an instance pool, and
+``process_batch`` for running many independent streams in one call.
+Builds with CMake and installs a pkg-config file.
+"""
+
+import platform as sys_platform
+import shutil
+from pathlib import Path
+from string import Template
+
+from gen_dsp.core.manifest import Manifest, build_remap_defines
+from gen_dsp.core.project import ProjectConfig
+from gen_dsp.errors import ProjectError
+from gen_dsp.platforms.cmake_platform import CMakePlatform
+from gen_dsp.templates import get_lib_templates_dir
+
+# Version of the exported C ABI (also the library SOVERSION).
+# Bump on any incompatible change to gendsp_lib.h.template.
+LIB_API_VERSION = 1
+
+
+def generate_lib_header(output_dir: Path, lib_name: str, genext_version: str) -> Path:
+    """Render the public C header to ``include/gendsp_<lib_name>.h``.
+
+    Shared by the gen~ export path and the dsp-graph adapter.
+
+    Returns:
+        Path to the generated header.
+    """
+    template_path = get_lib_templates_dir() / "gendsp_lib.h.template"
+    if not template_path.exists():
+        raise ProjectError(f"Library header template not found at {template_path}")
+
+    template = Template(template_path.read_text(encoding="utf-8"))
+    content = template.safe_substitute(
+        lib_name=lib_name,
+        lib_upper=lib_name.upper(),
+        api_version=LIB_API_VERSION,
+        genext_version=genext_version,
+    )
+    include_dir = output_dir / "include"
+    include_dir.mkdir(parents=True, exist_ok=True)
+    header = include_dir / f"gendsp_{lib_name}.h"
+    header.write_text(content, encoding="utf-8")
+    return header
+
+
+class LibPlatform(CMakePlatform):
+    """Shared library platform with a C ABI, built with CMake."""
+
+    name = "lib"
+    supports_pgo = True
+
+    @property
+    def extension(self) -> str:
+        """Get the file extension for the shared library."""
+        system = sys_platform.system().lower()
+        if system == "darwin":
+            return ".dylib"
+        if system == "windows":
+            return ".dll"
+        return ".so"
+
+    def get_build_instructions(self) -> list[str]:
+        """Get build instructions for the shared library."""
+        return [
+            "cmake -B build && cmake --build build",
+            "cmake --install build --prefix <prefix>",
+        ]
+
+    def generate_project(
+        self,
+        manifest: Manifest,
+        output_dir: Path,
+        lib_name: str,
+        config: ProjectConfig | None = None,
+    ) -> None:
+        """Generate shared library project files."""
+        templates_dir = get_lib_templates_dir()
+        if not templates_dir.is_dir():
+            raise ProjectError(f"Lib templates not found at {templates_dir}")
+
+        # Copy static files
+        static_files = [
+            "gen_ext_lib.cpp",
+            "_ext_lib.cpp",
+            "gen_ext_common_lib.h",
+            "lib_buffer.h",
+            "gendsp.pc.in",
+        ]
+
+        for filename in static_files:
+            src = templates_dir / filename
+            if src.exists():
+                shutil.copy2(src, output_dir / filename)
+
+        self.generate_ext_header(output_dir, "lib")
+        self.copy_remap_header(output_dir)
+        self.copy_pgo_files(output_dir)
+        self.copy_lto_module(output_dir)
+        generate_lib_header(output_dir, lib_name, self.GENEXT_VERSION)
+
+        # Generate gen_buffer.h using base class method
+        self.generate_buffer_header(
+            templates_dir / "gen_buffer.h.template",
+            output_dir / "gen_buffer.h",
+            manifest.buffers,
+            header_comment="Buffer configuration for gen_dsp shared library wrapper",
+        )
+
+        # Generate CMakeLists.txt
+        template_path = templates_dir / "CMakeLists.txt.template"
+        if not template_path.exists():
+            raise ProjectError(f"CMakeLists.txt template not found at {template_path}")
+        template = Template(template_path.read_text(encoding="utf-8"))
+        content = template.safe_substitute(
+            gen_name=manifest.gen_name,
+            lib_name=lib_name,
+            lib_upper=lib_name.upper(),
+            genext_version=self.GENEXT_VERSION,
+            api_version=LIB_API_VERSION,
+            remap_defines=build_remap_defines(manifest),
+        )
+        (output_dir / "CMakeLists.txt").write_text(content, encoding="utf-8")
+
+        # Create build directory
+        (output_dir / "build").mkdir(exist_ok=True)
+
+    def find_output(self, project_dir: Path) -> Path | None:
+        """Find the built shared library."""
+        build_dir = project_dir / "build"
+        if build_dir.is_dir():
+            for f in sorted(build_dir.glob(f"**/*gendsp_*{self.extension}")):
+                return f
+        return None
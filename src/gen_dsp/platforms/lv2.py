@@ -31,6 +31,7 @@ class Lv2Platform(CMakePlatform):
     """LV2 plugin platform implementation using CMake."""
 
     name = "lv2"
+    supports_pgo = True
     LV2_URI_BASE = "http://gen-dsp.com/plugins"
 
     _LV2_TYPE_MAP = {
@@ -71,6 +72,8 @@ class Lv2Platform(CMakePlatform):
 
         self.generate_ext_header(output_dir, "lv2")
         self.copy_remap_header(output_dir)
+        self.copy_pgo_files(output_dir)
+        self.copy_lto_module(output_dir)
         self.copy_voice_alloc_header(output_dir, config)
 
         # Build MIDI compile definitions
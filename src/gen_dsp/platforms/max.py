@@ -74,6 +74,7 @@ class MaxPlatform(CMakePlatform):
         remap_defines = build_remap_defines(manifest)
 
         self.copy_remap_header(output_dir)
+        self.copy_lto_module(output_dir)
 
         # Generate CMakeLists.txt
         self._generate_cmakelists(
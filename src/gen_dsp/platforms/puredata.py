@@ -20,6 +20,7 @@ class PureDataPlatform(Platform):
     """PureData platform implementation using pd-lib-builder."""
 
     name = "pd"
+    supports_pgo = True
 
     @property
     def extension(self) -> str:
@@ -64,6 +65,7 @@ class PureDataPlatform(Platform):
                 shutil.copy2(src, output_dir / filename)
 
         self.copy_remap_header(output_dir)
+        self.copy_pgo_files(output_dir, cmake=False)
 
         # Copy bundled m_pd.h
         pd_include_dst = output_dir / "pd-include"
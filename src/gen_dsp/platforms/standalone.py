@@ -25,6 +25,8 @@ class StandalonePlatform(Platform):
     """Standalone audio application platform using miniaudio."""
 
     name = "standalone"
+    supports_pgo = True
+    uses_simd_kernels = True
 
     @property
     def extension(self) -> str:
@@ -66,6 +68,8 @@ class StandalonePlatform(Platform):
         # Generate _ext_standalone.h via shared template
         self.generate_ext_header(output_dir, "standalone")
         self.copy_remap_header(output_dir)
+        self.copy_simd_header(output_dir)
+        self.copy_pgo_files(output_dir, cmake=False)
 
         # Generate gen_buffer.h using base class method
         self.generate_buffer_header(
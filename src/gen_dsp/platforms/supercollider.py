@@ -28,6 +28,7 @@ class SuperColliderPlatform(CMakePlatform):
     """SuperCollider UGen platform implementation using CMake."""
 
     name = "sc"
+    supports_pgo = True
 
     @property
     def extension(self) -> str:
@@ -62,6 +63,8 @@ class SuperColliderPlatform(CMakePlatform):
 
         self.generate_ext_header(output_dir, "sc")
         self.copy_remap_header(output_dir)
+        self.copy_pgo_files(output_dir)
+        self.copy_lto_module(output_dir)
 
         # UGen name (first letter capitalized, required by SC)
         ugen_name = self._capitalize_name(lib_name)
@@ -25,6 +25,7 @@ class Vst3Platform(CMakePlatform):
     """VST3 plugin platform implementation using CMake."""
 
     name = "vst3"
+    supports_pgo = True
 
     @property
     def extension(self) -> str:
@@ -58,6 +59,8 @@ class Vst3Platform(CMakePlatform):
 
         self.generate_ext_header(output_dir, "vst3")
         self.copy_remap_header(output_dir)
+        self.copy_pgo_files(output_dir)
+        self.copy_lto_module(output_dir)
         self.copy_voice_alloc_header(output_dir, config)
 
         # Generate FUID from lib_name
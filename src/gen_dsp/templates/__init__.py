@@ -83,3 +83,7 @@ def get_csound_templates_dir() -> Path:
 
 def get_auv3_templates_dir() -> Path:
     return get_templates_dir("auv3")
+
+
+def get_lib_templates_dir() -> Path:
+    return get_templates_dir("lib")
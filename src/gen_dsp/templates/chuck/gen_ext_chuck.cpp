@@ -5,6 +5,7 @@
 
 #include "gen_ext_common_chuck.h"
 #include "_ext_chuck.h"
+#include "gen_dsp_simd.h"
 
 #include <cstring>
 #include <cstdlib>
@@ -12,6 +13,10 @@
 
 using namespace WRAPPER_NAMESPACE;
 
+// Frames per wrapper_perform() call in the multi-channel tick; longer
+// tickf requests are processed in chunks of this size
+#define GENEXT_MAX_FRAMES 256
+
 // Internal data structure for the chugin instance
 struct GenExtData {
     GenState* gen_state;
@@ -127,20 +132,20 @@ CK_DLL_CTOR(genext_ctor)
     data->num_inputs = wrapper_num_inputs();
     data->num_outputs = wrapper_num_outputs();
 
-    // Create gen~ state (block size 1 since we process per-frame)
-    data->gen_state = wrapper_create(data->samplerate, 1);
+    // Create gen~ state (tick processes 1 frame, tickf up to GENEXT_MAX_FRAMES)
+    data->gen_state = wrapper_create(data->samplerate, GENEXT_MAX_FRAMES);
 
     // Allocate per-channel I/O buffers
     data->in_buffers = new float*[data->num_inputs > 0 ? data->num_inputs : 1];
     for (int i = 0; i < data->num_inputs; i++) {
-        data->in_buffers[i] = new float[1];
-        data->in_buffers[i][0] = 0.0f;
+        data->in_buffers[i] = new float[GENEXT_MAX_FRAMES];
+        gen_dsp_zero(data->in_buffers[i], GENEXT_MAX_FRAMES);
     }
 
     data->out_buffers = new float*[data->num_outputs > 0 ? data->num_outputs : 1];
     for (int i = 0; i < data->num_outputs; i++) {
-        data->out_buffers[i] = new float[1];
-        data->out_buffers[i][0] = 0.0f;
+        data->out_buffers[i] = new float[GENEXT_MAX_FRAMES];
+        gen_dsp_zero(data->out_buffers[i], GENEXT_MAX_FRAMES);
     }
 
     OBJ_MEMBER_INT(SELF, genext_data_offset) = (t_CKINT)data;
@@ -219,9 +224,10 @@ CK_DLL_TICKF(genext_tickf)
     GenExtData* data = (GenExtData*)OBJ_MEMBER_INT(SELF, genext_data_offset);
     if (!data || !data->gen_state) {
         // Zero output
+        int num_out = data ? data->num_outputs : wrapper_num_outputs();
         for (t_CKUINT f = 0; f < nframes; f++) {
-            for (int ch = 0; ch < data->num_outputs; ch++) {
-                out[f * data->num_outputs + ch] = 0.0f;
+            for (int ch = 0; ch < num_out; ch++) {
+                out[f * num_out + ch] = 0.0f;
             }
         }
         return TRUE;
@@ -230,22 +236,23 @@ CK_DLL_TICKF(genext_tickf)
     int num_in = data->num_inputs;
     int num_out = data->num_outputs;
 
-    // Process frame by frame
-    for (t_CKUINT f = 0; f < nframes; f++) {
+    // Process in chunks of up to GENEXT_MAX_FRAMES
+    for (t_CKUINT f = 0; f < nframes; f += GENEXT_MAX_FRAMES) {
+        long n = (long)(nframes - f < GENEXT_MAX_FRAMES ? nframes - f : GENEXT_MAX_FRAMES);
+
         // Deinterleave input: ChucK interleaved -> gen~ per-channel
-        for (int ch = 0; ch < num_in; ch++) {
-            data->in_buffers[ch][0] = in[f * num_in + ch];
+        if (num_in > 0) {
+            gen_dsp_deinterleave(in + f * num_in, data->in_buffers, num_in, n);
         }
 
-        // Call gen~ perform with block size 1
         wrapper_perform(data->gen_state,
                         data->in_buffers, num_in,
                         data->out_buffers, num_out,
-                        1);
+                        n);
 
         // Interleave output: gen~ per-channel -> ChucK interleaved
-        for (int ch = 0; ch < num_out; ch++) {
-            out[f * num_out + ch] = data->out_buffers[ch][0];
+        if (num_out > 0) {
+            gen_dsp_interleave(data->out_buffers, out + f * num_out, num_out, n);
         }
     }
 
@@ -474,10 +474,13 @@ static clap_process_status clap_gen_process(const clap_plugin_t* plugin,
             const clap_event_param_value_t* ev = (const clap_event_param_value_t*)hdr;
             int idx = (int)ev->param_id;
             if (idx >= 0 && idx < plug->numParams) {
+                // Ramp across the block rather than stepping (zipper-free)
 #if NUM_VOICES > 1
-                voice_alloc_set_global_param(&plug->voiceAlloc, idx, (float)ev->value);
+                voice_alloc_set_global_param_ramp(&plug->voiceAlloc, idx,
+                                                  (float)ev->value, (int)nframes);
 #else
-                wrapper_set_param(plug->genState, idx, (float)ev->value);
+                wrapper_set_param_ramp(plug->genState, idx, (float)ev->value,
+                                       (int)nframes);
 #endif
             }
         }
@@ -25,6 +25,7 @@
 
 #include "csdl.h"
 #include "_ext_csound.h"
+#include "gen_dsp_simd.h"
 
 using namespace WRAPPER_NAMESPACE;
 
@@ -144,18 +145,14 @@ static int32_t gen_opcode_perf(CSOUND *csound, GENOPCODE *p)
     float *in_ptrs[MAX_AUDIO_INS];
     for (int ch = 0; ch < num_in && ch < MAX_AUDIO_INS; ch++) {
         in_ptrs[ch] = &p->in_buf[ch * nsmps];
-        for (uint32_t i = 0; i < n; i++) {
-            in_ptrs[ch][i] = (float)p->ain[ch][offset + i];
-        }
+        gen_dsp_convert(&p->ain[ch][offset], in_ptrs[ch], (long)n);
     }
 
     // Set up output float buffers
     float *out_ptrs[MAX_AUDIO_OUTS];
     for (int ch = 0; ch < num_out && ch < MAX_AUDIO_OUTS; ch++) {
         out_ptrs[ch] = &p->out_buf[ch * nsmps];
-        for (uint32_t i = 0; i < n; i++) {
-            out_ptrs[ch][i] = 0.0f;
-        }
+        gen_dsp_zero(out_ptrs[ch], (long)n);
     }
 
     // Process
@@ -164,9 +161,7 @@ static int32_t gen_opcode_perf(CSOUND *csound, GENOPCODE *p)
 
     // Convert gen~ float output back to Csound MYFLT
     for (int ch = 0; ch < num_out && ch < MAX_AUDIO_OUTS; ch++) {
-        for (uint32_t i = 0; i < n; i++) {
-            p->aout[ch][offset + i] = (MYFLT)out_ptrs[ch][i];
-        }
+        gen_dsp_convert(out_ptrs[ch], &p->aout[ch][offset], (long)n);
     }
 
     return OK;
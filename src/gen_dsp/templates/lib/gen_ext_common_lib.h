@@ -0,0 +1,27 @@
+// gen_ext_common_lib.h - Macro definitions for the shared library wrapper
+// This file provides name mangling macros for the lib backend
+
+#ifndef GEN_EXT_COMMON_LIB_H
+#define GEN_EXT_COMMON_LIB_H
+
+// Buffer configuration (defines WRAPPER_BUFFER_COUNT and buffer names)
+#include "gen_buffer.h"
+
+#define STR_EXPAND(s) #s
+#define STR(s) STR_EXPAND(s)
+
+// Macro concatenation helpers
+#define WRAPPER_FUN(NAME, POST) NAME ## POST
+#define WRAPPER_FUN2(NAME, POST) WRAPPER_FUN(NAME, POST)
+
+// Namespace for wrapper functions (isolates genlib from the C API)
+#define WRAPPER_NAMESPACE WRAPPER_FUN2(LIB_EXT_NAME, _lib)
+
+// Exported C symbol names: GENDSP_FN(create) -> gendsp_<name>_create
+#define GENDSP_PREFIX WRAPPER_FUN2(gendsp_, LIB_EXT_NAME)
+#define GENDSP_FN(NAME) WRAPPER_FUN2(GENDSP_PREFIX, _ ## NAME)
+
+// C ABI version; bumped on any incompatible change to the public header
+#define GENDSP_API_VERSION 1
+
+#endif // GEN_EXT_COMMON_LIB_H
@@ -0,0 +1,285 @@
+// gen_ext_lib.cpp - C API for the gen-dsp shared library
+// This file implements the exported gendsp_<name>_* functions declared in
+// the generated public header. It only sees the wrapper interface, never
+// genlib, so the library exports nothing but the C API.
+
+#include "_ext_lib.h"
+#include GENDSP_LIB_HEADER
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+using namespace WRAPPER_NAMESPACE;
+
+typedef struct GENDSP_PREFIX Instance;
+typedef struct GENDSP_FN(pool) Pool;
+
+// Upper bound on frames per wrapper_perform call and on channel count.
+// gen~ exports pad missing inputs from an 8192-sample silence buffer, and
+// the graph path has no padding at all, so we supply our own.
+static const int kMaxChunk = 4096;
+static const int kMaxChannels = 64;
+static const float kZeros[kMaxChunk] = {0};
+
+static const uint32_t kStateMagic = 0x47445350; // "GDSP" (matches CLAP/VST3)
+
+struct GENDSP_PREFIX {
+    GenState* state;
+    int maxBlock;
+};
+
+struct GENDSP_FN(pool) {
+    int count;
+    Instance* instances;
+    Instance** handles;
+};
+
+static bool instance_init(Instance* inst, float sr, int maxBlock) {
+    if (maxBlock <= 0 || maxBlock > kMaxChunk)
+        maxBlock = kMaxChunk;
+    inst->maxBlock = maxBlock;
+    inst->state = wrapper_create(sr, (long)maxBlock);
+    return inst->state != nullptr;
+}
+
+static bool param_in_range(int index) {
+    return index >= 0 && index < wrapper_num_params();
+}
+
+extern "C" {
+
+int GENDSP_FN(api_version)(void) {
+    return GENDSP_API_VERSION;
+}
+
+// ---------------------------------------------------------------------------
+// Lifecycle
+// ---------------------------------------------------------------------------
+
+Instance* GENDSP_FN(create)(float sample_rate, int max_block) {
+    Instance* inst = new (std::nothrow) Instance;
+    if (!inst) return nullptr;
+    if (!instance_init(inst, sample_rate, max_block)) {
+        delete inst;
+        return nullptr;
+    }
+    return inst;
+}
+
+void GENDSP_FN(destroy)(Instance* inst) {
+    if (!inst) return;
+    wrapper_destroy(inst->state);
+    delete inst;
+}
+
+void GENDSP_FN(reset)(Instance* inst) {
+    if (inst) wrapper_reset(inst->state);
+}
+
+// ---------------------------------------------------------------------------
+// Processing
+// ---------------------------------------------------------------------------
+
+int GENDSP_FN(num_inputs)(void) {
+    return wrapper_num_inputs();
+}
+
+int GENDSP_FN(num_outputs)(void) {
+    return wrapper_num_outputs();
+}
+
+int GENDSP_FN(process)(Instance* inst, const float* const* ins,
+                       float* const* outs, int nframes) {
+    if (!inst || !outs) return -1;
+    if (nframes <= 0) return 0;
+
+    const int numIns = wrapper_num_inputs();
+    const int numOuts = wrapper_num_outputs();
+    if (numIns > kMaxChannels || numOuts > kMaxChannels) return -1;
+
+    float* chunkIns[kMaxChannels];
+    float* chunkOuts[kMaxChannels];
+
+    for (int offset = 0; offset < nframes; offset += inst->maxBlock) {
+        int n = nframes - offset;
+        if (n > inst->maxBlock) n = inst->maxBlock;
+
+        for (int c = 0; c < numIns; c++) {
+            const float* src = (ins && ins[c]) ? ins[c] + offset : kZeros;
+            chunkIns[c] = const_cast<float*>(src);
+        }
+        for (int c = 0; c < numOuts; c++)
+            chunkOuts[c] = outs[c] + offset;
+
+        wrapper_perform(inst->state, chunkIns, numIns, chunkOuts, numOuts, n);
+    }
+    return 0;
+}
+
+int GENDSP_FN(process_batch)(Instance* const* insts, int count,
+                             const float* const* const* ins,
+                             float* const* const* outs, int nframes) {
+    if (!insts || !outs) return -1;
+    int result = 0;
+    for (int s = 0; s < count; s++) {
+        if (GENDSP_FN(process)(insts[s], ins ? ins[s] : nullptr, outs[s], nframes) != 0)
+            result = -1;
+    }
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Parameters
+// ---------------------------------------------------------------------------
+
+int GENDSP_FN(num_params)(void) {
+    return wrapper_num_params();
+}
+
+const char* GENDSP_FN(param_name)(Instance* inst, int index) {
+    if (!inst || !param_in_range(index)) return nullptr;
+    return wrapper_param_name(inst->state, index);
+}
+
+float GENDSP_FN(param_min)(Instance* inst, int index) {
+    if (!inst || !param_in_range(index)) return 0.0f;
+    return wrapper_param_min(inst->state, index);
+}
+
+float GENDSP_FN(param_max)(Instance* inst, int index) {
+    if (!inst || !param_in_range(index)) return 0.0f;
+    return wrapper_param_max(inst->state, index);
+}
+
+int GENDSP_FN(param_index)(Instance* inst, const char* name) {
+    if (!inst || !name) return -1;
+    for (int i = 0; i < wrapper_num_params(); i++) {
+        const char* pname = wrapper_param_name(inst->state, i);
+        if (pname && std::strcmp(pname, name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+void GENDSP_FN(set_param)(Instance* inst, int index, float value) {
+    if (inst && param_in_range(index))
+        wrapper_set_param(inst->state, index, value);
+}
+
+void GENDSP_FN(set_param_ramp)(Instance* inst, int index, float value,
+                               int nsamples) {
+    if (inst && param_in_range(index))
+        wrapper_set_param_ramp(inst->state, index, value, nsamples);
+}
+
+float GENDSP_FN(get_param)(Instance* inst, int index) {
+    if (!inst || !param_in_range(index)) return 0.0f;
+    return wrapper_get_param(inst->state, index);
+}
+
+// ---------------------------------------------------------------------------
+// State: magic followed by one float per parameter
+// ---------------------------------------------------------------------------
+
+size_t GENDSP_FN(state_size)(void) {
+    return sizeof(kStateMagic) + sizeof(float) * (size_t)wrapper_num_params();
+}
+
+size_t GENDSP_FN(save_state)(Instance* inst, void* data, size_t size) {
+    const size_t needed = GENDSP_FN(state_size)();
+    if (!inst || !data || size < needed) return 0;
+
+    unsigned char* p = (unsigned char*)data;
+    std::memcpy(p, &kStateMagic, sizeof(kStateMagic));
+    p += sizeof(kStateMagic);
+    for (int i = 0; i < wrapper_num_params(); i++) {
+        float val = wrapper_get_param(inst->state, i);
+        std::memcpy(p, &val, sizeof(float));
+        p += sizeof(float);
+    }
+    return needed;
+}
+
+int GENDSP_FN(load_state)(Instance* inst, const void* data, size_t size) {
+    if (!inst || !data || size != GENDSP_FN(state_size)()) return -1;
+
+    const unsigned char* p = (const unsigned char*)data;
+    uint32_t magic = 0;
+    std::memcpy(&magic, p, sizeof(magic));
+    if (magic != kStateMagic) return -1;
+    p += sizeof(magic);
+    for (int i = 0; i < wrapper_num_params(); i++) {
+        float val;
+        std::memcpy(&val, p, sizeof(float));
+        p += sizeof(float);
+        wrapper_set_param(inst->state, i, val);
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Buffers
+// ---------------------------------------------------------------------------
+
+int GENDSP_FN(num_buffers)(void) {
+    return wrapper_num_buffers();
+}
+
+const char* GENDSP_FN(buffer_name)(int index) {
+    return wrapper_buffer_name(index);
+}
+
+// ---------------------------------------------------------------------------
+// Instance pool
+// ---------------------------------------------------------------------------
+
+Pool* GENDSP_FN(pool_create)(int count, float sample_rate, int max_block) {
+    if (count <= 0) return nullptr;
+
+    Pool* pool = new (std::nothrow) Pool;
+    if (!pool) return nullptr;
+    pool->count = 0;
+    pool->instances = new (std::nothrow) Instance[count];
+    pool->handles = new (std::nothrow) Instance*[count];
+    if (!pool->instances || !pool->handles) {
+        GENDSP_FN(pool_destroy)(pool);
+        return nullptr;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (!instance_init(&pool->instances[i], sample_rate, max_block)) {
+            GENDSP_FN(pool_destroy)(pool);
+            return nullptr;
+        }
+        pool->handles[i] = &pool->instances[i];
+        pool->count = i + 1;
+    }
+    return pool;
+}
+
+void GENDSP_FN(pool_destroy)(Pool* pool) {
+    if (!pool) return;
+    for (int i = 0; i < pool->count; i++)
+        wrapper_destroy(pool->instances[i].state);
+    delete[] pool->instances;
+    delete[] pool->handles;
+    delete pool;
+}
+
+int GENDSP_FN(pool_size)(const Pool* pool) {
+    return pool ? pool->count : 0;
+}
+
+Instance* GENDSP_FN(pool_get)(Pool* pool, int index) {
+    if (!pool || index < 0 || index >= pool->count) return nullptr;
+    return pool->handles[index];
+}
+
+int GENDSP_FN(pool_process)(Pool* pool, const float* const* const* ins,
+                            float* const* const* outs, int nframes) {
+    if (!pool) return -1;
+    return GENDSP_FN(process_batch)(pool->handles, pool->count, ins, outs, nframes);
+}
+
+} // extern "C"
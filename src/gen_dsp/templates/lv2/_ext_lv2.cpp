@@ -209,6 +209,12 @@ void wrapper_set_param(GenState* state, int index, float value) {
     setparameter((CommonState*)state, index, (double)value, nullptr);
 }
 
+void wrapper_set_param_ramp(GenState* state, int index, float value, int nsamples) {
+    // gen~ exports have no ramp support; their params apply immediately
+    (void)nsamples;
+    wrapper_set_param(state, index, value);
+}
+
 float wrapper_get_param(GenState* state, int index) {
 #if defined(REMAP_INPUT_COUNT) && REMAP_INPUT_COUNT > 0
     if (_is_remap_param(index))
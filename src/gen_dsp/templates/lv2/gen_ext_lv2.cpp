@@ -106,6 +106,7 @@ struct Lv2GenPlugin {
 #else
     const float* control_in[1];  // placeholder to avoid zero-length array
 #endif
+    bool       paramsPrimed;  // false until the first run() after activate()
     LV2_URID_Map* urid_map;
     LV2_URID   state_params_urid;
     LV2_URID   atom_chunk_urid;
@@ -207,6 +208,7 @@ lv2_gen_activate(LV2_Handle instance)
         wrapper_reset(plug->genState);
     }
 #endif
+    plug->paramsPrimed = false;
 }
 
 static void
@@ -249,13 +251,20 @@ lv2_gen_run(LV2_Handle instance, uint32_t sample_count)
     }
 #endif
 
-    // Apply control port values to gen~ parameters
+    // Apply control port values to gen~ parameters, ramping across the
+    // block (an unchanged value is a no-op). The first run after activate()
+    // jumps straight to the port values instead of gliding from defaults.
+    int rampLen = plug->paramsPrimed ? (int)sample_count : 0;
+    plug->paramsPrimed = true;
     for (int i = 0; i < plug->numParams; i++) {
         if (plug->control_in[i]) {
 #if NUM_VOICES > 1
-            voice_alloc_set_global_param(&plug->voiceAlloc, i, *(plug->control_in[i]));
+            voice_alloc_set_global_param_ramp(&plug->voiceAlloc, i,
+                                              *(plug->control_in[i]),
+                                              rampLen);
 #else
-            wrapper_set_param(plug->genState, i, *(plug->control_in[i]));
+            wrapper_set_param_ramp(plug->genState, i, *(plug->control_in[i]),
+                                   rampLen);
 #endif
         }
     }
@@ -0,0 +1,46 @@
+# gen_dsp_lto.cmake - Link-time optimisation for gen-dsp CMake projects
+# Generated by gen-dsp; enabled by `gen-dsp build --lto`, -DGEN_DSP_LTO=ON
+# or the GEN_DSP_LTO environment variable (which takes precedence)
+#
+# CMake's IPO support also switches static archives to the compiler's
+# LTO-aware ar/ranlib (gcc-ar, llvm-ar), so nothing else needs changing.
+
+include(CheckIPOSupported)
+
+option(GEN_DSP_LTO "Link-time optimisation across the wrapper/kernel boundary" OFF)
+if(NOT "$ENV{GEN_DSP_LTO}" STREQUAL "")
+    set(GEN_DSP_LTO "$ENV{GEN_DSP_LTO}")
+endif()
+
+# Cross-unit inlining only happens with optimisation on; the plain
+# `cmake ..` configure gen-dsp runs leaves the build type empty (-O0)
+get_property(_gen_dsp_multi_config GLOBAL PROPERTY GENERATOR_IS_MULTI_CONFIG)
+if(GEN_DSP_LTO AND NOT CMAKE_BUILD_TYPE AND NOT _gen_dsp_multi_config)
+    set(CMAKE_BUILD_TYPE Release)
+endif()
+
+# gen_dsp_enable_lto(<target>...)
+# Call after gen_dsp_enable_pgo() so the PGO kernel objects and training
+# driver are optimised the same way as the plugin.
+function(gen_dsp_enable_lto)
+    if(NOT GEN_DSP_LTO)
+        return()
+    endif()
+
+    check_ipo_supported(RESULT _supported OUTPUT _reason LANGUAGES C CXX)
+    if(NOT _supported)
+        message(WARNING "gen-dsp LTO: not supported by this toolchain, building without it\n${_reason}")
+        return()
+    endif()
+
+    foreach(_target IN LISTS ARGN)
+        set(_lto_targets ${_target})
+        if(TARGET ${_target}_pgo_kernel)
+            list(APPEND _lto_targets ${_target}_pgo_kernel)
+        endif()
+        set_target_properties(${_lto_targets} PROPERTIES INTERPROCEDURAL_OPTIMIZATION ON)
+    endforeach()
+    if(TARGET gen_dsp_pgo_train)
+        set_target_properties(gen_dsp_pgo_train PROPERTIES INTERPROCEDURAL_OPTIMIZATION ON)
+    endif()
+endfunction()
@@ -0,0 +1,91 @@
+# gen_dsp_pgo.cmake - Profile-guided optimisation for gen-dsp CMake projects
+# Generated by gen-dsp; driven by `gen-dsp build --pgo`
+#
+#   GEN_DSP_PGO=generate  instrument the kernel and add gen_dsp_pgo_train
+#   GEN_DSP_PGO=use       build with the profile in GEN_DSP_PGO_DIR
+#
+# The kernel sources (_ext_<platform>.cpp with the gen~ export compiled in,
+# plus genlib) move into an object library shared by the plugin and the
+# training driver, so both phases compile them to the same object files.
+# Clang profiles are merged into default.profdata by gen-dsp between the
+# two phases; GCC reads its .gcda files from the directory as written.
+
+set(GEN_DSP_PGO "" CACHE STRING "Profile-guided optimisation phase (generate, use or empty)")
+set_property(CACHE GEN_DSP_PGO PROPERTY STRINGS "" generate use)
+set(GEN_DSP_PGO_DIR "${CMAKE_BINARY_DIR}/pgo" CACHE PATH "Profile data directory")
+
+function(gen_dsp_enable_pgo target platform)
+    if(NOT GEN_DSP_PGO)
+        return()
+    endif()
+    if(NOT GEN_DSP_PGO MATCHES "^(generate|use)$")
+        message(FATAL_ERROR "GEN_DSP_PGO must be 'generate' or 'use', got '${GEN_DSP_PGO}'")
+    endif()
+
+    if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        if(GEN_DSP_PGO STREQUAL "generate")
+            set(_compile_flags "-fprofile-generate=${GEN_DSP_PGO_DIR}")
+            set(_link_flags "-fprofile-generate=${GEN_DSP_PGO_DIR}")
+        else()
+            set(_compile_flags
+                "-fprofile-use=${GEN_DSP_PGO_DIR}/default.profdata"
+                -Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date)
+            set(_link_flags "")
+        endif()
+    elseif(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        if(GEN_DSP_PGO STREQUAL "generate")
+            set(_compile_flags "-fprofile-generate=${GEN_DSP_PGO_DIR}")
+            set(_link_flags "-fprofile-generate=${GEN_DSP_PGO_DIR}")
+        else()
+            set(_compile_flags "-fprofile-use=${GEN_DSP_PGO_DIR}"
+                -fprofile-correction -Wno-missing-profile)
+            set(_link_flags "")
+        endif()
+    else()
+        message(WARNING "gen-dsp PGO: unsupported compiler ${CMAKE_CXX_COMPILER_ID}, building without profile")
+        return()
+    endif()
+
+    get_target_property(_sources ${target} SOURCES)
+    set(_kernel_sources "")
+    set(_other_sources "")
+    foreach(_src IN LISTS _sources)
+        if(_src MATCHES "(^|/)_ext_${platform}\\.cpp$"
+           OR _src MATCHES "gen_dsp/(genlib\\.cpp|json\\.c|json_builder\\.c)$")
+            list(APPEND _kernel_sources "${_src}")
+        else()
+            list(APPEND _other_sources "${_src}")
+        endif()
+    endforeach()
+
+    set(_kernel ${target}_pgo_kernel)
+    add_library(${_kernel} OBJECT ${_kernel_sources})
+    set_target_properties(${_kernel} PROPERTIES POSITION_INDEPENDENT_CODE ON)
+    target_compile_definitions(${_kernel} PRIVATE
+        $<TARGET_PROPERTY:${target},COMPILE_DEFINITIONS>)
+    target_include_directories(${_kernel} PRIVATE
+        $<TARGET_PROPERTY:${target},INCLUDE_DIRECTORIES>)
+    target_compile_options(${_kernel} PRIVATE
+        $<TARGET_PROPERTY:${target},COMPILE_OPTIONS> ${_compile_flags})
+
+    set_property(TARGET ${target} PROPERTY SOURCES ${_other_sources})
+    target_sources(${target} PRIVATE $<TARGET_OBJECTS:${_kernel}>)
+    if(_link_flags)
+        target_link_options(${target} PRIVATE ${_link_flags})
+    endif()
+
+    if(GEN_DSP_PGO STREQUAL "generate")
+        add_executable(gen_dsp_pgo_train EXCLUDE_FROM_ALL
+            "${CMAKE_CURRENT_SOURCE_DIR}/gen_dsp_pgo_train.cpp"
+            $<TARGET_OBJECTS:${_kernel}>)
+        target_compile_definitions(gen_dsp_pgo_train PRIVATE
+            $<TARGET_PROPERTY:${target},COMPILE_DEFINITIONS>
+            GEN_DSP_PGO_EXT_HEADER="_ext_${platform}.h")
+        target_include_directories(gen_dsp_pgo_train PRIVATE
+            $<TARGET_PROPERTY:${target},INCLUDE_DIRECTORIES>)
+        target_link_options(gen_dsp_pgo_train PRIVATE ${_link_flags})
+        if(NOT WIN32)
+            target_link_libraries(gen_dsp_pgo_train PRIVATE m)
+        endif()
+    endif()
+endfunction()
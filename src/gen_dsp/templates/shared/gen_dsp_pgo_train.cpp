@@ -0,0 +1,193 @@
+// gen_dsp_pgo_train.cpp - Training workload for profile-guided builds
+//
+// Run by `gen-dsp build --pgo` between the instrumented and the optimised
+// build. It links the same kernel objects as the plugin (the project's
+// _ext_<platform>.cpp, with the gen~ export compiled in, plus genlib) and
+// renders a fixed, seeded schedule offline so the profile is reproducible:
+//
+//   - four input phases: white noise, a log sine sweep, sparse impulses
+//     and silence (which exercises denormal and gate paths)
+//   - within each phase, every parameter in turn is swept from min to max
+//     in per-block steps while the others sit at their defaults
+//   - every 16 blocks one random parameter jumps to a random value, which
+//     reaches selector, gate and state-machine branches a smooth sweep
+//     would miss
+//
+// Buffers are left unbound (zero-filled), as they are before a host binds
+// them.
+//
+// Build defines:
+//   GEN_DSP_PGO_EXT_HEADER  "_ext_<platform>.h" (wrapper_* API)
+//   GEN_DSP_PGO_GENLIB      drive the gen~ export directly (Pd, whose
+//                           _ext.cpp has no wrapper_* layer)
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifdef GEN_DSP_PGO_GENLIB
+
+#include "_ext.h"
+
+namespace pgo {
+using namespace WRAPPER_NAMESPACE::GEN_EXPORTED_NAME;
+typedef CommonState State;
+static State* create_state(float sr, long bs) { return (State*)create(sr, bs); }
+static void destroy_state(State* s) { destroy(s); }
+static void reset_state(State* s) { reset(s); }
+static int inputs() { return num_inputs(); }
+static int outputs() { return num_outputs(); }
+static int params() { return num_params(); }
+static float param_min(State* s, int i) { return getparameterhasminmax(s, i) ? (float)getparametermin(s, i) : 0.f; }
+static float param_max(State* s, int i) { return getparameterhasminmax(s, i) ? (float)getparametermax(s, i) : 1.f; }
+static float param_get(State* s, int i) { t_param v = 0; getparameter(s, i, &v); return (float)v; }
+static void param_set(State* s, int i, float v) { setparameter(s, i, v, 0); }
+static void process(State* s, float** ins, int ni, float** outs, int no, int n) { perform(s, ins, ni, outs, no, n); }
+} // namespace pgo
+
+#else
+
+#include GEN_DSP_PGO_EXT_HEADER
+
+namespace pgo {
+using namespace WRAPPER_NAMESPACE;
+typedef GenState State;
+static State* create_state(float sr, long bs) { return wrapper_create(sr, bs); }
+static void destroy_state(State* s) { wrapper_destroy(s); }
+static void reset_state(State* s) { wrapper_reset(s); }
+static int inputs() { return wrapper_num_inputs(); }
+static int outputs() { return wrapper_num_outputs(); }
+static int params() { return wrapper_num_params(); }
+static float param_min(State* s, int i) { return wrapper_param_hasminmax(s, i) ? wrapper_param_min(s, i) : 0.f; }
+static float param_max(State* s, int i) { return wrapper_param_hasminmax(s, i) ? wrapper_param_max(s, i) : 1.f; }
+static float param_get(State* s, int i) { return wrapper_get_param(s, i); }
+static void param_set(State* s, int i, float v) { wrapper_set_param(s, i, v); }
+static void process(State* s, float** ins, int ni, float** outs, int no, int n) { wrapper_perform(s, ins, ni, outs, no, n); }
+} // namespace pgo
+
+#endif
+
+enum { PHASE_NOISE, PHASE_SWEEP, PHASE_IMPULSE, PHASE_SILENCE, PHASE_COUNT };
+
+static uint32_t rng_state = 1;
+
+// xorshift32, uniform in [0, 1)
+static float rng_next()
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return (float)(rng_state >> 8) * (1.0f / 16777216.0f);
+}
+
+static void fill_inputs(int phase, std::vector<float*>& ins, int n,
+                        long frame, long phase_frames, float sr)
+{
+    const double two_pi = 6.283185307179586;
+    for (size_t c = 0; c < ins.size(); c++) {
+        float* buf = ins[c];
+        for (int i = 0; i < n; i++) {
+            long t = frame + i;
+            float v = 0.f;
+            if (phase == PHASE_NOISE) {
+                v = rng_next() * 2.f - 1.f;
+            } else if (phase == PHASE_SWEEP) {
+                // 20 Hz .. sr/2 over the phase, log spaced
+                double pos = (double)t / (double)(phase_frames > 0 ? phase_frames : 1);
+                double f0 = 20.0, f1 = sr * 0.5;
+                double k = std::log(f1 / f0);
+                double ph = two_pi * f0 * phase_frames / sr / k * (std::exp(k * pos) - 1.0);
+                v = (float)(0.5 * std::sin(ph + c));
+            } else if (phase == PHASE_IMPULSE) {
+                v = (t % 4801 == 0) ? 1.f : 0.f;
+            }
+            buf[i] = v;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    long blocks = 4000;
+    int block_size = 64;
+    float sr = 48000.f;
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--blocks") && i + 1 < argc) {
+            blocks = atol(argv[++i]);
+        } else if (!strcmp(argv[i], "--block-size") && i + 1 < argc) {
+            block_size = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--sr") && i + 1 < argc) {
+            sr = (float)atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--blocks N] [--block-size N] [--sr SR] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (blocks < PHASE_COUNT || block_size <= 0 || sr <= 0.f) {
+        fprintf(stderr, "invalid workload\n");
+        return 2;
+    }
+    rng_state = seed ? seed : 1;
+
+    pgo::State* state = pgo::create_state(sr, block_size);
+    if (!state) {
+        fprintf(stderr, "create failed\n");
+        return 1;
+    }
+
+    int ni = pgo::inputs();
+    int no = pgo::outputs();
+    int np = pgo::params();
+    std::vector<float> in_data((size_t)(ni > 0 ? ni : 1) * block_size);
+    std::vector<float> out_data((size_t)(no > 0 ? no : 1) * block_size);
+    std::vector<float*> ins(ni), outs(no);
+    for (int c = 0; c < ni; c++) ins[c] = &in_data[(size_t)c * block_size];
+    for (int c = 0; c < no; c++) outs[c] = &out_data[(size_t)c * block_size];
+
+    std::vector<float> pmin(np), pmax(np), pdefault(np);
+    for (int p = 0; p < np; p++) {
+        pmin[p] = pgo::param_min(state, p);
+        pmax[p] = pgo::param_max(state, p);
+        pdefault[p] = pgo::param_get(state, p);
+    }
+
+    long phase_blocks = blocks / PHASE_COUNT;
+    long sweep_blocks = np > 0 ? phase_blocks / np : phase_blocks;
+    if (sweep_blocks < 1) sweep_blocks = 1;
+    double energy = 0.0;
+
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        pgo::reset_state(state);
+        for (int p = 0; p < np; p++) pgo::param_set(state, p, pdefault[p]);
+
+        for (long b = 0; b < phase_blocks; b++) {
+            if (np > 0) {
+                int p = (int)((b / sweep_blocks) % np);
+                long step = b % sweep_blocks;
+                if (step == 0 && p > 0) pgo::param_set(state, p - 1, pdefault[p - 1]);
+                float pos = sweep_blocks > 1 ? (float)step / (float)(sweep_blocks - 1) : 0.f;
+                pgo::param_set(state, p, pmin[p] + (pmax[p] - pmin[p]) * pos);
+                if (b % 16 == 15) {
+                    int q = (int)(rng_next() * np) % np;
+                    pgo::param_set(state, q, pmin[q] + (pmax[q] - pmin[q]) * rng_next());
+                }
+            }
+            fill_inputs(phase, ins, block_size, b * block_size,
+                        phase_blocks * block_size, sr);
+            pgo::process(state, ni > 0 ? ins.data() : NULL, ni,
+                         no > 0 ? outs.data() : NULL, no, block_size);
+            for (int c = 0; c < no; c++) energy += (double)outs[c][0] * outs[c][0];
+        }
+    }
+
+    pgo::destroy_state(state);
+    printf("blocks %ld\nenergy %g\n", phase_blocks * PHASE_COUNT, energy);
+    return 0;
+}
@@ -0,0 +1,327 @@
+// gen_dsp_simd.h - Sample shuffling and format conversion kernels
+// Shared by the platform wrappers that move audio between a host's buffer
+// layout and gen~'s per-channel float buffers (standalone, ChucK, Circle,
+// Csound).
+//
+// Every kernel has an SSE2 (x86-64), NEON (ARM) and scalar path. The paths
+// are bit-exact with each other and with the plain C loops they replace:
+// conversions use the same operations in the same order, and float -> int
+// truncates like a C cast. Define GEN_DSP_SIMD_SCALAR to force the scalar
+// path (tests/hosts/simd_kernels.cpp checks one against the other). This
+// holds as long as the compiler does not fuse multiply-adds behind our back
+// (-ffp-contract=off); with contraction gen_dsp_float_to_range may differ
+// in the last integer step, exactly as the old loop did between builds.
+//
+// Header-only and free of library includes (Circle builds with
+// -nostdinc++); the SIMD intrinsic headers come with the compiler.
+//
+//   gen_dsp_zero              dst[i] = 0
+//   gen_dsp_copy_gain         dst[i] = src[i] * gain
+//   gen_dsp_deinterleave      interleaved float/double -> per-channel float
+//   gen_dsp_interleave        per-channel float -> interleaved float/double
+//   gen_dsp_convert           float <-> double blocks
+//   gen_dsp_float_to_range    per-channel float -> interleaved saturated
+//                             integers in [range_min, range_max] (Circle DMA)
+//   gen_dsp_float_to_s16      float -> saturated int16 (x * 32767)
+//   gen_dsp_s16_to_float      int16 -> float (x / 32768)
+//
+// Saturating conversions treat NaN as silence (0.0f).
+
+#ifndef GEN_DSP_SIMD_H
+#define GEN_DSP_SIMD_H
+
+#if !defined(GEN_DSP_SIMD_SCALAR)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GEN_DSP_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define GEN_DSP_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+// -- Fills and copies ---------------------------------------------------------
+
+static inline void gen_dsp_zero(float* dst, long n) {
+    long i = 0;
+#if defined(GEN_DSP_SIMD_SSE2)
+    const __m128 z = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) _mm_storeu_ps(dst + i, z);
+#elif defined(GEN_DSP_SIMD_NEON)
+    const float32x4_t z = vdupq_n_f32(0.0f);
+    for (; i + 4 <= n; i += 4) vst1q_f32(dst + i, z);
+#endif
+    for (; i < n; i++) dst[i] = 0.0f;
+}
+
+static inline void gen_dsp_copy_gain(const float* src, float* dst, float gain, long n) {
+    long i = 0;
+#if defined(GEN_DSP_SIMD_SSE2)
+    const __m128 g = _mm_set1_ps(gain);
+    for (; i + 4 <= n; i += 4) _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), g));
+#elif defined(GEN_DSP_SIMD_NEON)
+    const float32x4_t g = vdupq_n_f32(gain);
+    for (; i + 4 <= n; i += 4) vst1q_f32(dst + i, vmulq_f32(vld1q_f32(src + i), g));
+#endif
+    for (; i < n; i++) dst[i] = src[i] * gain;
+}
+
+// -- Interleave / deinterleave ------------------------------------------------
+
+// src holds `frames` frames of `channels` samples; dst[ch] receives channel ch
+static inline void gen_dsp_deinterleave(const float* src, float* const* dst, int channels, long frames) {
+    long i = 0;
+    if (channels == 1) {
+        float* d = dst[0];
+        for (; i < frames; i++) d[i] = src[i];
+        return;
+    }
+    if (channels == 2) {
+        float* l = dst[0];
+        float* r = dst[1];
+#if defined(GEN_DSP_SIMD_SSE2)
+        for (; i + 4 <= frames; i += 4) {
+            __m128 a = _mm_loadu_ps(src + 2 * i);
+            __m128 b = _mm_loadu_ps(src + 2 * i + 4);
+            _mm_storeu_ps(l + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(r + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+#elif defined(GEN_DSP_SIMD_NEON)
+        for (; i + 4 <= frames; i += 4) {
+            float32x4x2_t lr = vld2q_f32(src + 2 * i);
+            vst1q_f32(l + i, lr.val[0]);
+            vst1q_f32(r + i, lr.val[1]);
+        }
+#endif
+        for (; i < frames; i++) {
+            l[i] = src[2 * i];
+            r[i] = src[2 * i + 1];
+        }
+        return;
+    }
+    for (; i < frames; i++) {
+        for (int ch = 0; ch < channels; ch++) {
+            dst[ch][i] = src[i * channels + ch];
+        }
+    }
+}
+
+// src[ch] holds channel ch; dst receives `frames` frames of `channels` samples.
+// Pass the same pointer twice to duplicate a channel.
+static inline void gen_dsp_interleave(const float* const* src, float* dst, int channels, long frames) {
+    long i = 0;
+    if (channels == 1) {
+        const float* s = src[0];
+        for (; i < frames; i++) dst[i] = s[i];
+        return;
+    }
+    if (channels == 2) {
+        const float* l = src[0];
+        const float* r = src[1];
+#if defined(GEN_DSP_SIMD_SSE2)
+        for (; i + 4 <= frames; i += 4) {
+            __m128 a = _mm_loadu_ps(l + i);
+            __m128 b = _mm_loadu_ps(r + i);
+            _mm_storeu_ps(dst + 2 * i, _mm_unpacklo_ps(a, b));
+            _mm_storeu_ps(dst + 2 * i + 4, _mm_unpackhi_ps(a, b));
+        }
+#elif defined(GEN_DSP_SIMD_NEON)
+        for (; i + 4 <= frames; i += 4) {
+            float32x4x2_t lr;
+            lr.val[0] = vld1q_f32(l + i);
+            lr.val[1] = vld1q_f32(r + i);
+            vst2q_f32(dst + 2 * i, lr);
+        }
+#endif
+        for (; i < frames; i++) {
+            dst[2 * i] = l[i];
+            dst[2 * i + 1] = r[i];
+        }
+        return;
+    }
+    for (; i < frames; i++) {
+        for (int ch = 0; ch < channels; ch++) {
+            dst[i * channels + ch] = src[ch][i];
+        }
+    }
+}
+
+// -- float <-> double ---------------------------------------------------------
+
+static inline void gen_dsp_convert(const float* src, float* dst, long n) {
+    for (long i = 0; i < n; i++) dst[i] = src[i];
+}
+
+static inline void gen_dsp_convert(const double* src, float* dst, long n) {
+    long i = 0;
+#if defined(GEN_DSP_SIMD_SSE2)
+    for (; i + 4 <= n; i += 4) {
+        __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+        __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+        _mm_storeu_ps(dst + i, _mm_movelh_ps(lo, hi));
+    }
+#elif defined(GEN_DSP_SIMD_NEON) && defined(__aarch64__)
+    for (; i + 4 <= n; i += 4) {
+        float32x2_t lo = vcvt_f32_f64(vld1q_f64(src + i));
+        float32x2_t hi = vcvt_f32_f64(vld1q_f64(src + i + 2));
+        vst1q_f32(dst + i, vcombine_f32(lo, hi));
+    }
+#endif
+    for (; i < n; i++) dst[i] = (float)src[i];
+}
+
+static inline void gen_dsp_convert(const float* src, double* dst, long n) {
+    long i = 0;
+#if defined(GEN_DSP_SIMD_SSE2)
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(src + i);
+        _mm_storeu_pd(dst + i, _mm_cvtps_pd(v));
+        _mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+#elif defined(GEN_DSP_SIMD_NEON) && defined(__aarch64__)
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vld1q_f32(src + i);
+        vst1q_f64(dst + i, vcvt_f64_f32(vget_low_f32(v)));
+        vst1q_f64(dst + i + 2, vcvt_high_f64_f32(v));
+    }
+#endif
+    for (; i < n; i++) dst[i] = (double)src[i];
+}
+
+static inline void gen_dsp_deinterleave(const double* src, float* const* dst, int channels, long frames) {
+    if (channels == 1) {
+        gen_dsp_convert(src, dst[0], frames);
+        return;
+    }
+    for (long i = 0; i < frames; i++) {
+        for (int ch = 0; ch < channels; ch++) {
+            dst[ch][i] = (float)src[i * channels + ch];
+        }
+    }
+}
+
+static inline void gen_dsp_interleave(const float* const* src, double* dst, int channels, long frames) {
+    if (channels == 1) {
+        gen_dsp_convert(src[0], dst, frames);
+        return;
+    }
+    for (long i = 0; i < frames; i++) {
+        for (int ch = 0; ch < channels; ch++) {
+            dst[i * channels + ch] = (double)src[ch][i];
+        }
+    }
+}
+
+// -- Saturating float -> int --------------------------------------------------
+
+// NaN -> 0, then clamp to [-1, 1]
+static inline float gen_dsp_saturate(float x) {
+    if (!(x == x)) x = 0.0f;
+    x = x < 1.0f ? x : 1.0f;
+    return x > -1.0f ? x : -1.0f;
+}
+
+#if defined(GEN_DSP_SIMD_SSE2)
+static inline __m128 gen_dsp_saturate4(__m128 x) {
+    x = _mm_and_ps(x, _mm_cmpord_ps(x, x));
+    return _mm_max_ps(_mm_min_ps(x, _mm_set1_ps(1.0f)), _mm_set1_ps(-1.0f));
+}
+#elif defined(GEN_DSP_SIMD_NEON)
+static inline float32x4_t gen_dsp_saturate4(float32x4_t x) {
+    x = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(x), vceqq_f32(x, x)));
+    return vmaxq_f32(vminq_f32(x, vdupq_n_f32(1.0f)), vdupq_n_f32(-1.0f));
+}
+#endif
+
+// Map [-1, 1] -> [range_min, range_max] and interleave, as DMA sound devices
+// expect: (int)((x + 1) / 2 * (range_max - range_min) + range_min).
+// src[ch] may be NULL for a silent channel.
+static inline void gen_dsp_float_to_range(const float* const* src, unsigned int* dst, int channels,
+                                          long frames, int range_min, int range_max) {
+    const float span = (float)(range_max - range_min);
+    const float base = (float)range_min;
+    long i = 0;
+#if defined(GEN_DSP_SIMD_SSE2) || defined(GEN_DSP_SIMD_NEON)
+    if (channels == 2) {
+#if defined(GEN_DSP_SIMD_SSE2)
+        const __m128 one = _mm_set1_ps(1.0f), half = _mm_set1_ps(0.5f);
+        const __m128 vspan = _mm_set1_ps(span), vbase = _mm_set1_ps(base);
+        for (; i + 4 <= frames; i += 4) {
+            __m128 l = src[0] ? _mm_loadu_ps(src[0] + i) : _mm_setzero_ps();
+            __m128 r = src[1] ? _mm_loadu_ps(src[1] + i) : _mm_setzero_ps();
+            l = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_add_ps(gen_dsp_saturate4(l), one), half), vspan), vbase);
+            r = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_add_ps(gen_dsp_saturate4(r), one), half), vspan), vbase);
+            __m128i li = _mm_cvttps_epi32(l), ri = _mm_cvttps_epi32(r);
+            _mm_storeu_si128((__m128i*)(dst + 2 * i), _mm_unpacklo_epi32(li, ri));
+            _mm_storeu_si128((__m128i*)(dst + 2 * i + 4), _mm_unpackhi_epi32(li, ri));
+        }
+#else
+        const float32x4_t one = vdupq_n_f32(1.0f), half = vdupq_n_f32(0.5f);
+        const float32x4_t vspan = vdupq_n_f32(span), vbase = vdupq_n_f32(base);
+        for (; i + 4 <= frames; i += 4) {
+            float32x4_t l = src[0] ? vld1q_f32(src[0] + i) : vdupq_n_f32(0.0f);
+            float32x4_t r = src[1] ? vld1q_f32(src[1] + i) : vdupq_n_f32(0.0f);
+            // Separate multiply and add: a fused vmlaq/vfmaq would round differently
+            l = vaddq_f32(vmulq_f32(vmulq_f32(vaddq_f32(gen_dsp_saturate4(l), one), half), vspan), vbase);
+            r = vaddq_f32(vmulq_f32(vmulq_f32(vaddq_f32(gen_dsp_saturate4(r), one), half), vspan), vbase);
+            uint32x4x2_t lr;
+            lr.val[0] = vreinterpretq_u32_s32(vcvtq_s32_f32(l));
+            lr.val[1] = vreinterpretq_u32_s32(vcvtq_s32_f32(r));
+            vst2q_u32(dst + 2 * i, lr);
+        }
+#endif
+    }
+#endif
+    for (; i < frames; i++) {
+        for (int ch = 0; ch < channels; ch++) {
+            float x = src[ch] ? gen_dsp_saturate(src[ch][i]) : 0.0f;
+            dst[i * channels + ch] = (unsigned int)(int)((x + 1.0f) * 0.5f * span + base);
+        }
+    }
+}
+
+static inline void gen_dsp_float_to_s16(const float* src, short* dst, long n) {
+    long i = 0;
+#if defined(GEN_DSP_SIMD_SSE2)
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    for (; i + 8 <= n; i += 8) {
+        __m128i a = _mm_cvttps_epi32(_mm_mul_ps(gen_dsp_saturate4(_mm_loadu_ps(src + i)), scale));
+        __m128i b = _mm_cvttps_epi32(_mm_mul_ps(gen_dsp_saturate4(_mm_loadu_ps(src + i + 4)), scale));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(a, b));
+    }
+#elif defined(GEN_DSP_SIMD_NEON)
+    const float32x4_t scale = vdupq_n_f32(32767.0f);
+    for (; i + 8 <= n; i += 8) {
+        int32x4_t a = vcvtq_s32_f32(vmulq_f32(gen_dsp_saturate4(vld1q_f32(src + i)), scale));
+        int32x4_t b = vcvtq_s32_f32(vmulq_f32(gen_dsp_saturate4(vld1q_f32(src + i + 4)), scale));
+        vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)));
+    }
+#endif
+    for (; i < n; i++) dst[i] = (short)(int)(gen_dsp_saturate(src[i]) * 32767.0f);
+}
+
+static inline void gen_dsp_s16_to_float(const short* src, float* dst, long n) {
+    const float scale = 1.0f / 32768.0f;
+    long i = 0;
+#if defined(GEN_DSP_SIMD_SSE2)
+    const __m128 vscale = _mm_set1_ps(scale);
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        // Sign-extend 16 -> 32 bits: unpack into the high half, shift back down
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), vscale));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), vscale));
+    }
+#elif defined(GEN_DSP_SIMD_NEON)
+    const float32x4_t vscale = vdupq_n_f32(scale);
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t v = vld1q_s16(src + i);
+        vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), vscale));
+        vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), vscale));
+    }
+#endif
+    for (; i < n; i++) dst[i] = (float)src[i] * scale;
+}
+
+#endif // GEN_DSP_SIMD_H
@@ -151,6 +151,16 @@ static inline void voice_alloc_set_global_param(VoiceAllocator* va, int idx, flo
     }
 }
 
+// Broadcast a ramped (block-smoothed) parameter change to all voices
+static inline void voice_alloc_set_global_param_ramp(VoiceAllocator* va, int idx,
+                                                     float value, int nsamples) {
+    for (int v = 0; v < NUM_VOICES; v++) {
+        if (va->states[v]) {
+            wrapper_set_param_ramp(va->states[v], idx, value, nsamples);
+        }
+    }
+}
+
 // Get parameter value from the first voice (all voices share global params)
 static inline float voice_alloc_get_param(VoiceAllocator* va, int idx) {
     if (va->states[0]) {
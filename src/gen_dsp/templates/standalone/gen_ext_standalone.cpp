@@ -5,8 +5,18 @@
 #include <cstdlib>
 #include <cstring>
 #include <csignal>
+#include <cerrno>
+#include <atomic>
+#include <chrono>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
 
 #include "_ext_standalone.h"
+#include "gen_dsp_simd.h"
 
 #define MINIAUDIO_IMPLEMENTATION
 #include "miniaudio.h"
@@ -25,6 +35,110 @@ static void signal_handler(int) {
     g_running = false;
 }
 
+// -- Real-time options -----------------------------------------------------
+
+static int g_rt_priority = 0;  // --rt-priority: SCHED_FIFO priority (0 = leave alone)
+static int g_cpu = -1;         // --cpu: core to pin the audio thread to (-1 = any)
+static bool g_prefault = false;
+
+// Scheduling and affinity must be set from the audio thread itself, which
+// miniaudio creates; it does so on its first callback and main() reports
+// the outcome. Errors are errno values, or -1 if unsupported here.
+static std::atomic<bool> g_thread_setup_done(false);
+static int g_rt_priority_error = 0;
+static int g_cpu_error = 0;
+
+static void setup_audio_thread() {
+    if (g_rt_priority > 0) {
+#if defined(_WIN32)
+        g_rt_priority_error = -1;
+#else
+        int lo = sched_get_priority_min(SCHED_FIFO);
+        int hi = sched_get_priority_max(SCHED_FIFO);
+        struct sched_param sp;
+        memset(&sp, 0, sizeof(sp));
+        sp.sched_priority = g_rt_priority < lo ? lo : (g_rt_priority > hi ? hi : g_rt_priority);
+        g_rt_priority_error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+#endif
+    }
+    if (g_cpu >= 0) {
+#if defined(__linux__)
+        if (g_cpu >= CPU_SETSIZE) {
+            g_cpu_error = EINVAL;
+        } else {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(g_cpu, &set);
+            g_cpu_error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+#else
+        g_cpu_error = -1;
+#endif
+    }
+    if (g_prefault) {
+        // Fault in the top of the callback thread's stack (kept small: some
+        // hosts give audio threads only 64 KB)
+        volatile char stack[16 * 1024];
+        for (size_t i = 0; i < sizeof(stack); i += 1024) stack[i] = 0;
+    }
+    g_thread_setup_done.store(true, std::memory_order_release);
+}
+
+static const char* describe_error(int err) {
+    return err == -1 ? "not supported on this platform" : strerror(err);
+}
+
+static void report_thread_setup() {
+    if (g_rt_priority > 0) {
+        if (g_rt_priority_error == 0) {
+            fprintf(stderr, "  Audio thread: SCHED_FIFO priority %d\n", g_rt_priority);
+        } else {
+            fprintf(stderr, "Warning: --rt-priority %d failed (%s); keeping default scheduling%s\n",
+                    g_rt_priority, describe_error(g_rt_priority_error),
+                    g_rt_priority_error == EPERM
+                        ? " -- needs CAP_SYS_NICE or an rtprio limit (ulimit -r)" : "");
+        }
+    }
+    if (g_cpu >= 0) {
+        if (g_cpu_error == 0) {
+            fprintf(stderr, "  Audio thread: pinned to CPU %d\n", g_cpu);
+        } else {
+            fprintf(stderr, "Warning: --cpu %d failed (%s); audio thread not pinned\n",
+                    g_cpu, describe_error(g_cpu_error));
+        }
+    }
+}
+
+static void lock_memory() {
+#if defined(_WIN32)
+    fprintf(stderr, "Warning: --mlockall failed (%s)\n", describe_error(-1));
+#else
+    // MCL_FUTURE also locks the device buffers miniaudio allocates later
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        int err = errno;
+        fprintf(stderr, "Warning: --mlockall failed (%s); memory may be paged%s\n",
+                strerror(err),
+                err == EPERM || err == ENOMEM
+                    ? " -- needs CAP_IPC_LOCK or a larger memlock limit (ulimit -l)" : "");
+    }
+#endif
+}
+
+// -- Xrun accounting -------------------------------------------------------
+
+// Written only by the audio thread; read by main() after the device stops.
+// A gap between callbacks longer than the whole device buffer means the
+// device ran dry; a callback that takes longer than the audio it produces
+// is an overrun even if the buffer absorbed it.
+typedef std::chrono::steady_clock Clock;
+static double g_xrun_gap = 0.0;  // seconds; set from the device buffer size
+static Clock::time_point s_last_callback;
+static bool s_have_last_callback = false;
+static long g_callbacks = 0;
+static long g_xruns = 0;
+static long g_overruns = 0;
+static double g_peak_load = 0.0;
+
 // -- miniaudio callback ----------------------------------------------------
 
 // Static buffers for deinterleaving -- audio callback threads have small
@@ -41,48 +155,80 @@ static void audio_callback(
     const void* input,
     ma_uint32 frame_count
 ) {
-    (void)device;
+    if (!g_thread_setup_done.load(std::memory_order_relaxed)) {
+        setup_audio_thread();
+    }
+    Clock::time_point start = Clock::now();
 
     float* out_interleaved = (float*)output;
     const float* in_interleaved = (const float*)input;
 
-    int num_in = g_num_inputs;
-    int num_out = g_num_outputs;
+    // Device buffers keep their full interleave stride; the DSP sees at
+    // most MAX_CHANNELS of them
+    int dev_in = g_num_inputs;
+    int dev_out = g_device_out_channels;
+    int num_in = dev_in < MAX_CHANNELS ? dev_in : MAX_CHANNELS;
+    int num_out = g_num_outputs < MAX_CHANNELS ? g_num_outputs : MAX_CHANNELS;
     long n = (long)frame_count;
     if (n > MAX_FRAMES) n = MAX_FRAMES;
 
     // Deinterleave input
     float* in_channels[MAX_CHANNELS] = {};
     if (num_in > 0 && in_interleaved) {
-        for (int ch = 0; ch < num_in && ch < MAX_CHANNELS; ch++) {
+        for (int ch = 0; ch < num_in; ch++) {
             in_channels[ch] = &s_in_storage[ch * n];
         }
-        for (long i = 0; i < n; i++) {
-            for (int ch = 0; ch < num_in && ch < MAX_CHANNELS; ch++) {
-                in_channels[ch][i] = in_interleaved[i * num_in + ch];
+        if (dev_in == num_in) {
+            gen_dsp_deinterleave(in_interleaved, in_channels, num_in, n);
+        } else {
+            for (long i = 0; i < n; i++) {
+                for (int ch = 0; ch < num_in; ch++) {
+                    in_channels[ch][i] = in_interleaved[i * dev_in + ch];
+                }
             }
         }
     }
 
     // Set up output channel pointers
     float* out_channels[MAX_CHANNELS] = {};
-    for (int ch = 0; ch < num_out && ch < MAX_CHANNELS; ch++) {
+    for (int ch = 0; ch < num_out; ch++) {
         out_channels[ch] = &s_out_storage[ch * n];
-        for (long i = 0; i < n; i++) out_channels[ch][i] = 0.0f;
+        gen_dsp_zero(out_channels[ch], n);
     }
 
     // Process
     wrapper_perform(g_state, in_channels, (long)num_in, out_channels, (long)num_out, n);
 
     // Interleave output into device channels (may be wider than gen~ outputs)
-    int dev_ch = g_device_out_channels;
-    for (long i = 0; i < n; i++) {
-        for (int ch = 0; ch < dev_ch; ch++) {
+    if (dev_out <= MAX_CHANNELS) {
+        const float* dev_channels[MAX_CHANNELS];
+        for (int ch = 0; ch < dev_out; ch++) {
             // If device has more channels than gen~, duplicate last gen~ channel
-            int src_ch = ch < num_out ? ch : num_out - 1;
-            out_interleaved[i * dev_ch + ch] = out_channels[src_ch][i];
+            dev_channels[ch] = out_channels[ch < num_out ? ch : num_out - 1];
+        }
+        gen_dsp_interleave(dev_channels, out_interleaved, dev_out, n);
+    } else {
+        // Only here when gen~ has more than MAX_CHANNELS outputs: the
+        // channels past the cap are silent
+        for (long i = 0; i < n; i++) {
+            float* frame = out_interleaved + i * dev_out;
+            for (int ch = 0; ch < MAX_CHANNELS; ch++) frame[ch] = out_channels[ch][i];
+            for (int ch = MAX_CHANNELS; ch < dev_out; ch++) frame[ch] = 0.0f;
         }
     }
+
+    // Xrun accounting
+    double period = (double)frame_count / (double)device->sampleRate;
+    if (s_have_last_callback &&
+        std::chrono::duration<double>(start - s_last_callback).count() > g_xrun_gap) {
+        g_xruns++;
+    }
+    double load = std::chrono::duration<double>(Clock::now() - start).count() / period;
+    if (load > 1.0) g_overruns++;
+    if (load > g_peak_load) g_peak_load = load;
+    s_last_callback = start;
+    s_have_last_callback = true;
+    g_callbacks++;
 }
 
 // -- Usage / help ----------------------------------------------------------
@@ -94,6 +240,10 @@ static void print_usage(const char* prog) {
     fprintf(stderr, "  -bs <frames>        Block size (default: 256)\n");
     fprintf(stderr, "  -p <name> <value>   Set parameter value\n");
     fprintf(stderr, "  -l                  List parameters and exit\n");
+    fprintf(stderr, "  --rt-priority <n>   Run the audio thread SCHED_FIFO at priority n (1-99)\n");
+    fprintf(stderr, "  --cpu <n>           Pin the audio thread to CPU n (Linux)\n");
+    fprintf(stderr, "  --mlockall          Lock all current and future memory into RAM\n");
+    fprintf(stderr, "  --prefault          Touch the DSP state and I/O buffers before starting\n");
     fprintf(stderr, "  -h                  Show this help\n");
 }
 
@@ -103,6 +253,7 @@ int main(int argc, char* argv[]) {
     float sample_rate = 44100.0f;
     int block_size = 256;
     bool list_params = false;
+    bool lock_all = false;
 
     // Collect param settings to apply after state creation
     struct ParamSetting { const char* name; float value; };
@@ -124,6 +275,22 @@ int main(int argc, char* argv[]) {
             i += 2;
         } else if (strcmp(argv[i], "-l") == 0) {
             list_params = true;
+        } else if (strcmp(argv[i], "--rt-priority") == 0 && i + 1 < argc) {
+            g_rt_priority = atoi(argv[++i]);
+            if (g_rt_priority < 1 || g_rt_priority > 99) {
+                fprintf(stderr, "--rt-priority must be between 1 and 99\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+            g_cpu = atoi(argv[++i]);
+            if (g_cpu < 0) {
+                fprintf(stderr, "--cpu must be a CPU index >= 0\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--mlockall") == 0) {
+            lock_all = true;
+        } else if (strcmp(argv[i], "--prefault") == 0) {
+            g_prefault = true;
         } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
             print_usage(argv[0]);
             return 0;
@@ -134,6 +301,10 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    if (lock_all && !list_params) {
+        lock_memory();
+    }
+
     // Create gen~ state
     g_state = wrapper_create(sample_rate, (long)block_size);
     if (!g_state) {
@@ -162,6 +333,28 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+    // Prefault before applying parameters: reset restores their defaults.
+    // Silent blocks warm the code and I/O buffers; the second reset then
+    // zeroes every delay line and buffer, faulting in pages the first
+    // (allocating) reset left untouched, and leaves a clean initial state.
+    if (g_prefault) {
+        long bs = block_size < MAX_FRAMES ? (long)block_size : (long)MAX_FRAMES;
+        float* in_channels[MAX_CHANNELS];
+        float* out_channels[MAX_CHANNELS];
+        memset(s_in_storage, 0, sizeof(s_in_storage));
+        memset(s_out_storage, 0, sizeof(s_out_storage));
+        for (int ch = 0; ch < MAX_CHANNELS; ch++) {
+            in_channels[ch] = &s_in_storage[ch * bs];
+            out_channels[ch] = &s_out_storage[ch * bs];
+        }
+        long num_in = g_num_inputs < MAX_CHANNELS ? g_num_inputs : MAX_CHANNELS;
+        long num_out = g_num_outputs < MAX_CHANNELS ? g_num_outputs : MAX_CHANNELS;
+        for (int b = 0; b < 8; b++) {
+            wrapper_perform(g_state, in_channels, num_in, out_channels, num_out, bs);
+        }
+        wrapper_reset(g_state);
+    }
+
     // Apply parameter settings
     for (int s = 0; s < num_settings; s++) {
         bool found = false;
@@ -203,6 +396,13 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // Xrun threshold: one full device buffer without a callback
+    ma_uint32 dev_rate = device.playback.internalSampleRate;
+    ma_uint32 dev_frames = device.playback.internalPeriodSizeInFrames * device.playback.internalPeriods;
+    g_xrun_gap = (dev_rate > 0 && dev_frames > 0)
+        ? (double)dev_frames / (double)dev_rate
+        : 2.0 * (double)block_size / (double)sample_rate;
+
     // Print info
     fprintf(stderr, "%s (gen-dsp standalone v%s)\n",
             STR(STANDALONE_EXT_NAME), STR(GEN_EXT_VERSION));
@@ -226,13 +426,21 @@ int main(int argc, char* argv[]) {
     }
 
     // Run until interrupted
+    bool setup_reported = false;
     while (g_running) {
         ma_sleep(100);
+        if (!setup_reported && g_thread_setup_done.load(std::memory_order_acquire)) {
+            report_thread_setup();
+            setup_reported = true;
+        }
     }
 
     fprintf(stderr, "\nStopping...\n");
 
     ma_device_uninit(&device);
+
+    fprintf(stderr, "Xruns: %ld (%ld callbacks, %ld overruns, peak load %.0f%%)\n",
+            g_xruns, g_callbacks, g_overruns, g_peak_load * 100.0);
     wrapper_destroy(g_state);
 
     return 0;
@@ -401,10 +401,13 @@ tresult PLUGIN_API GenVst3Plugin::process(ProcessData& data) {
                 // Convert normalized (0-1) to plain using stored ranges
                 float range = mParamRanges[paramId].max - mParamRanges[paramId].min;
                 float plain = mParamRanges[paramId].min + (float)normValue * range;
+                // Ramp across the block rather than stepping (zipper-free)
 #if NUM_VOICES > 1
-                voice_alloc_set_global_param(&mVoiceAlloc, (int)paramId, plain);
+                voice_alloc_set_global_param_ramp(&mVoiceAlloc, (int)paramId, plain,
+                                                  (int)data.numSamples);
 #else
-                wrapper_set_param(mGenState, (int)paramId, plain);
+                wrapper_set_param_ramp(mGenState, (int)paramId, plain,
+                                       (int)data.numSamples);
 #endif
             }
         }
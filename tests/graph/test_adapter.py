@@ -176,6 +176,11 @@ class TestAdapterCpp:
         code = generate_adapter_cpp(gen_dsp_graph, "chuck")
         assert "return 1;" in code
 
+    def test_adapter_set_param_ramp(self, gen_dsp_graph):
+        code = generate_adapter_cpp(gen_dsp_graph, "clap")
+        assert "void wrapper_set_param_ramp(GenState* state, int index" in code
+        assert "test_synth_set_param_ramp(" in code
+
     def test_adapter_buffers(self, gen_dsp_graph):
         code = generate_adapter_cpp(gen_dsp_graph, "chuck")
         assert "test_synth_num_buffers()" in code
@@ -599,6 +599,157 @@ class TestBuildScFromGraph:
         assert len(sc_files) >= 1
 
 
+# ---------------------------------------------------------------------------
+# Shared library (cmake, no FetchContent)
+# ---------------------------------------------------------------------------
+
+_GAIN_LIB_CLIENT = r"""
+#include <stdio.h>
+#include "gendsp_gain.h"
+
+int main(void) {
+    float in[8] = {1, 2, 3, 4, 5, 6, 7, 8}, out_a[8], out_b[8];
+    const float* ins_a[1] = {in};
+    float* outs_a[1] = {out_a};
+    float* outs_b[1] = {out_b};
+    const float* const* ins[2] = {ins_a, NULL};
+    float* const* outs[2] = {outs_a, outs_b};
+    gendsp_gain_pool* pool = gendsp_gain_pool_create(2, 48000.0f, 4);
+    gendsp_gain* a = gendsp_gain_pool_get(pool, 0);
+    gendsp_gain_set_param(a, gendsp_gain_param_index(a, "volume"), 0.25f);
+    gendsp_gain_pool_process(pool, ins, outs, 8);
+    printf("%g %g %g\n", out_a[0], out_a[7], out_b[7]);
+    gendsp_gain_pool_destroy(pool);
+    return 0;
+}
+"""
+
+
+_WIDE_LIB_CLIENT = r"""
+#include <stdio.h>
+#include "gendsp_wide.h"
+
+int main(void) {
+    static float buf[65][4];
+    float* outs[65];
+    float* const* batch_outs[1] = {outs};
+    gendsp_wide* inst = gendsp_wide_create(48000.0f, 4);
+    int i;
+    for (i = 0; i < 65; i++) {
+        buf[i][0] = 7.0f;
+        outs[i] = buf[i];
+    }
+    printf("%d\n", gendsp_wide_num_outputs());
+    printf("%d\n", gendsp_wide_process(inst, NULL, outs, 4));
+    printf("%d\n", gendsp_wide_process_batch(&inst, 1, NULL, batch_outs, 4));
+    printf("%g\n", buf[64][0]);
+    gendsp_wide_destroy(inst);
+    return 0;
+}
+"""
+
+class TestBuildLibFromGraph:
+    @_skip_no_cmake
+    def test_build_lib_gain(self, gain_graph: Graph, tmp_path: Path) -> None:
+        """Build a shared library from a graph and drive it from C."""
+        if shutil.which("cc") is None:
+            pytest.skip("cc not found")
+        project_dir = tmp_path / "gain_lib"
+        config = ProjectConfig(name="gain", platform="lib")
+        gen = ProjectGenerator.from_graph(gain_graph, config)
+        gen.generate(project_dir)
+        assert (project_dir / "include" / "gendsp_gain.h").is_file()
+
+        _cmake_build(project_dir)
+
+        libs = list((project_dir / "build").glob("libgendsp_gain.*"))
+        assert len(libs) >= 1
+
+        src = tmp_path / "client.c"
+        src.write_text(_GAIN_LIB_CLIENT)
+        exe = tmp_path / "client"
+        build_dir = project_dir / "build"
+        result = subprocess.run(
+            [
+                "cc",
+                f"-I{project_dir / 'include'}",
+                str(src),
+                f"-L{build_dir}",
+                "-lgendsp_gain",
+                "-o",
+                str(exe),
+            ],
+            capture_output=True,
+            text=True,
+            timeout=60,
+            check=False,
+        )
+        assert result.returncode == 0, f"cc failed:\n{result.stderr}"
+
+        env = dict(os.environ, LD_LIBRARY_PATH=str(build_dir))
+        out = subprocess.run(
+            [str(exe)],
+            capture_output=True,
+            text=True,
+            timeout=10,
+            env=env,
+            check=False,
+        )
+        assert out.returncode == 0, out.stderr
+        # Stream 0 scaled by its own volume; stream 1 has NULL (silent) input
+        assert out.stdout.split() == ["0.25", "2", "0"]
+
+    @_skip_no_cmake
+    def test_process_rejects_too_many_channels(self, tmp_path: Path) -> None:
+        """process returns -1 instead of silently skipping >64 outputs."""
+        if shutil.which("cc") is None:
+            pytest.skip("cc not found")
+        graph = Graph(
+            name="wide",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id=f"out{i}", source="half") for i in range(65)],
+            nodes=[BinOp(id="half", op="mul", a="in1", b=0.5)],
+        )
+        project_dir = tmp_path / "wide_lib"
+        config = ProjectConfig(name="wide", platform="lib")
+        ProjectGenerator.from_graph(graph, config).generate(project_dir)
+        _cmake_build(project_dir)
+
+        src = tmp_path / "client.c"
+        src.write_text(_WIDE_LIB_CLIENT)
+        exe = tmp_path / "client"
+        build_dir = project_dir / "build"
+        result = subprocess.run(
+            [
+                "cc",
+                f"-I{project_dir / 'include'}",
+                str(src),
+                f"-L{build_dir}",
+                "-lgendsp_wide",
+                "-o",
+                str(exe),
+            ],
+            capture_output=True,
+            text=True,
+            timeout=60,
+            check=False,
+        )
+        assert result.returncode == 0, f"cc failed:\n{result.stderr}"
+
+        env = dict(os.environ, LD_LIBRARY_PATH=str(build_dir))
+        out = subprocess.run(
+            [str(exe)],
+            capture_output=True,
+            text=True,
+            timeout=10,
+            env=env,
+            check=False,
+        )
+        assert out.returncode == 0, out.stderr
+        # Return code, then the untouched output sentinel
+        assert out.stdout.split() == ["65", "-1", "-1", "7"]
+
+
 # ---------------------------------------------------------------------------
 # Max/MSP (cmake, no FetchContent -- SDK auto-cloned via git)
 # ---------------------------------------------------------------------------
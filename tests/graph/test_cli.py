@@ -94,6 +94,20 @@ class TestCompile:
         out = capsys.readouterr().out
         assert "test_graph_perform" in out
 
+    def test_compile_check_ranges(
+        self, graph_json: Path, capsys: pytest.CaptureFixture[str]
+    ) -> None:
+        rc = main(["compile", str(graph_json), "--check-ranges"])
+        assert rc == 0
+        assert "#include <cassert>" in capsys.readouterr().out
+
+    def test_compile_outline_subgraphs(
+        self, graph_json: Path, capsys: pytest.CaptureFixture[str]
+    ) -> None:
+        rc = main(["compile", str(graph_json), "--outline-subgraphs"])
+        assert rc == 0
+        assert "_perform(" in capsys.readouterr().out
+
 
 class TestValidate:
     def test_validate_valid(
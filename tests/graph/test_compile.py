@@ -3,6 +3,8 @@
 from __future__ import annotations
 
 pydantic = __import__("pytest").importorskip("pydantic")
+import os
+import re
 import shutil
 import subprocess
 import tempfile
@@ -35,15 +37,20 @@ from gen_dsp.graph import (
     DelayWrite,
     Delta,
     Elapsed,
+    FDN,
+    FIR,
     Fold,
     GateOut,
     GateRoute,
+    Granulator,
     Graph,
     History,
     Latch,
     Lookup,
     Mix,
+    MovingAverage,
     MulAccum,
+    MultiTapRead,
     NamedConstant,
     Noise,
     OnePole,
@@ -53,6 +60,7 @@ from gen_dsp.graph import (
     Phasor,
     PulseOsc,
     RateDiv,
+    Resample,
     SampleHold,
     SampleRate,
     SawOsc,
@@ -67,6 +75,9 @@ from gen_dsp.graph import (
     TriOsc,
     UnaryOp,
     Wave,
+    WavetableOsc,
+    WindowMax,
+    WindowMin,
     Wrap,
     compile_graph,
     compile_graph_to_file,
@@ -608,6 +619,66 @@ class TestOscillatorNodes:
         assert "float s_phase = self->m_s_phase;" in code
         assert "self->m_s_phase = s_phase;" in code
 
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_phase_wraps_any_freq(self, tmp_path: Path) -> None:
+        """Negative, above-rate and NaN frequencies keep the phase in [0, 1)."""
+        import numpy as np
+
+        from gen_dsp.graph.simulate import SimState, simulate
+
+        g = Graph(
+            name="ph",
+            outputs=[AudioOutput(id="out1", source="ph")],
+            params=[Param(name="f", min=0.0, max=20000.0, default=440.0)],
+            nodes=[Phasor(id="ph", freq="f")],
+        )
+        code = compile_graph(g)
+        assert "if (!(ph_phase >= 0.0f && ph_phase < 1.0f)) {" in code
+        freqs = (-300.0, 70000.0, 6000.0)
+        block = 64
+        total = block * (len(freqs) + 1)
+        driver = code + "\n".join(
+            [
+                "#include <cmath>",
+                "#include <cstdio>",
+                "int main() {",
+                "    PhState* s = ph_create(5512.5f);",
+                f"    static float out[{total}];",
+                f"    float fs[{len(freqs) + 1}] = {{{', '.join(map(str, freqs))}, NAN}};",
+                f"    for (int k = 0; k < {len(freqs) + 1}; k++) {{",
+                f"        float* outs[1] = {{out + k * {block}}};",
+                "        ph_set_param(s, 0, fs[k]);",
+                f"        ph_perform(s, nullptr, outs, {block});",
+                "    }",
+                f'    for (int i = 0; i < {total}; i++) printf("%.9g\\n", out[i]);',
+                "    ph_destroy(s);",
+                "    return 0;",
+                "}",
+                "",
+            ]
+        )
+        src = tmp_path / "ph.cpp"
+        exe = tmp_path / "ph"
+        src.write_text(driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O1", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=False)
+        assert run.returncode == 0, run.stderr
+        compiled = np.array([float(v) for v in run.stdout.split()])
+        assert np.all((compiled >= 0.0) & (compiled < 1.0))
+
+        state = SimState(g, sample_rate=5512.5)
+        expected = []
+        for f in (*freqs, float("nan")):
+            state.set_param("f", f)
+            expected.append(simulate(g, n_samples=block, state=state).outputs["out1"])
+        np.testing.assert_allclose(compiled, np.concatenate(expected), atol=1e-4)
+
 
 class TestStateTimingNodes:
     """Verify state/timing node code generation."""
@@ -802,6 +873,145 @@ class TestParamAPI:
         assert 'return "feedback";' in code
         assert 'return "mix";' in code
 
+    def test_set_param_cancels_ramp(self, onepole_graph: Graph) -> None:
+        code = compile_graph(onepole_graph)
+        assert "self->r_coeff_left = 0; break;" in code
+
+    def test_set_param_ramp(self, onepole_graph: Graph) -> None:
+        code = compile_graph(onepole_graph)
+        assert (
+            "void onepole_set_param_ramp(OnepoleState* self, int index, "
+            "float target, int nsamples) {"
+        ) in code
+        assert "*inc = (target - *p) / (float)nsamples;" in code
+
+    def test_ramp_single_body(self, onepole_graph: Graph) -> None:
+        code = compile_graph(onepole_graph)
+        assert "_perform_ramp" not in code
+        assert code.count("float result = ") == 1
+        assert "int _ramp = coeff_left > 0;" in code
+        assert "_e = _ramp ? _s + 1 : n;" in code
+        assert (
+            "if (coeff_left > 0) coeff = (--coeff_left == 0) "
+            "? coeff_target : coeff + coeff_inc;"
+        ) in code
+        # Ramps step after the segment, outside the sample loop
+        body = code.split("void onepole_perform(")[1].split("\n}")[0]
+        loop = body.split("for (int i = _s; i < _e; i++) {")[1]
+        assert loop.index("--coeff_left") > loop.index("\n        }")
+
+    def test_ramp_keeps_hoisting(self, onepole_graph: Graph) -> None:
+        """Param-only expressions stay hoisted, recomputed once per segment."""
+        code = compile_graph(onepole_graph)
+        body = code.split("void onepole_perform(")[1].split("\n}")[0]
+        seg, loop = body.split("for (int i = _s; i < _e; i++) {")
+        assert "for (int _s = 0, _e = n; _s < n; _s = _e) {" in seg
+        assert "float inv_coeff" in seg.split("_e = _ramp")[1]
+        assert "float inv_coeff" not in loop
+
+    def test_no_params_no_ramp_variant(self) -> None:
+        g = Graph(
+            name="fixed",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="half")],
+            nodes=[BinOp(id="half", op="mul", a="in1", b=0.5)],
+        )
+        code = compile_graph(g)
+        assert "_perform_ramp" not in code
+        assert "_ramp_to" not in code
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_ramp_matches_simulation(
+        self, onepole_graph: Graph, tmp_path: Path
+    ) -> None:
+        self._assert_ramp_parity(onepole_graph, "coeff", tmp_path)
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_ramp_matches_simulation_control_rate(self, tmp_path: Path) -> None:
+        """Control-rate graphs hold ramping params for a control block."""
+        g = Graph(
+            name="onepole",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="result")],
+            params=[Param(name="coeff", min=0.0, max=0.999, default=0.5)],
+            nodes=[
+                BinOp(id="inv_coeff", op="sub", a=1.0, b="coeff"),
+                BinOp(id="dry", op="mul", a="in1", b="inv_coeff"),
+                History(id="prev", init=0.0, input="result"),
+                BinOp(id="wet", op="mul", a="prev", b="coeff"),
+                BinOp(id="rate", op="mul", a="coeff", b=200.0),
+                Phasor(id="lfo", freq="rate"),
+                BinOp(id="mod", op="mul", a="wet", b="lfo"),
+                BinOp(id="result", op="add", a="dry", b="mod"),
+            ],
+            control_interval=16,
+            control_nodes=["rate", "lfo"],
+        )
+        code = compile_graph(g)
+        assert "_e = _ramp ? _s + 16 : n;" in code
+        self._assert_ramp_parity(g, "coeff", tmp_path)
+
+    @staticmethod
+    def _assert_ramp_parity(g: Graph, param: str, tmp_path: Path) -> None:
+        import numpy as np
+
+        from gen_dsp.graph.simulate import SimState, simulate
+
+        # (target, ramp length) per 64-sample block; ramps span block edges
+        steps = [(0.9, 100), (0.9, 0), (0.1, 20), (0.6, 64), (0.2, 0)]
+        block = 64
+        driver = compile_graph(g) + "\n".join(
+            [
+                "#include <cstdio>",
+                "#include <cmath>",
+                "int main() {",
+                "    OnepoleState* s = onepole_create(44100.0f);",
+                "    float in[64], out[64];",
+                "    float* ins[1] = {in};",
+                "    float* outs[1] = {out};",
+                f"    for (int b = 0; b < {len(steps)}; b++) {{",
+                "        for (int i = 0; i < 64; i++)",
+                "            in[i] = sinf(0.1f * (float)(b * 64 + i));",
+                *[
+                    f"        if (b == {b}) onepole_set_param_ramp(s, 0, {t}f, {k});"
+                    for b, (t, k) in enumerate(steps)
+                ],
+                f"        onepole_perform(s, ins, outs, {block});",
+                f'        for (int i = 0; i < {block}; i++) printf("%.9g\\n", out[i]);',
+                "    }",
+                "    onepole_destroy(s);",
+                "    return 0;",
+                "}",
+                "",
+            ]
+        )
+        src = tmp_path / "ramp.cpp"
+        exe = tmp_path / "ramp"
+        src.write_text(driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O2", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        out = subprocess.run(
+            [str(exe)], capture_output=True, text=True, check=True
+        ).stdout.split()
+        compiled = np.array([float(v) for v in out], dtype=np.float32)
+
+        state = SimState(g)
+        t = np.arange(len(steps) * block, dtype=np.float32)
+        x = np.sin(np.float32(0.1) * t).astype(np.float32)
+        expected = []
+        for b, (target, k) in enumerate(steps):
+            state.set_param_ramp(param, target, k)
+            chunk = x[b * block : (b + 1) * block]
+            expected.append(simulate(g, inputs={"in1": chunk}, state=state).outputs)
+        np.testing.assert_allclose(
+            compiled, np.concatenate([e["out1"] for e in expected]), atol=1e-5
+        )
+
 
 class TestEdgeCases:
     """Error conditions and edge cases."""
@@ -930,19 +1140,28 @@ class TestBufferNodes:
         assert "free(self->m_buf_buf);" in code
 
     def test_bufread_none_interp(self) -> None:
+        g = self._make_buf_graph(
+            BufRead(id="br", buffer="buf", index="pos"),
+        ).model_copy(update={"params": [Param(name="pos")]})
+        code = compile_graph(g)
+        assert "int br_idx = (int)(pos);" in code
+        assert "if (br_idx < 0) br_idx = 0;" in code
+        assert "if (br_idx >= buf_len) br_idx = buf_len - 1;" in code
+        assert "float br = buf_buf[br_idx];" in code
+
+    def test_bufread_in_range_index_unclamped(self) -> None:
         g = self._make_buf_graph(
             BufRead(id="br", buffer="buf", index=0.0),
         )
         code = compile_graph(g)
         assert "int br_idx = (int)(0.0f);" in code
-        assert "if (br_idx < 0) br_idx = 0;" in code
-        assert "if (br_idx >= buf_len) br_idx = buf_len - 1;" in code
+        assert "if (br_idx" not in code
         assert "float br = buf_buf[br_idx];" in code
 
     def test_bufread_linear_interp(self) -> None:
         g = self._make_buf_graph(
-            BufRead(id="br", buffer="buf", index=0.0, interp="linear"),
-        )
+            BufRead(id="br", buffer="buf", index="pos", interp="linear"),
+        ).model_copy(update={"params": [Param(name="pos")]})
         code = compile_graph(g)
         assert "br_fidx" in code
         assert "br_frac" in code
@@ -1480,10 +1699,13 @@ class TestLICM:
         assert code.index("w_range") < loop_pos
         assert code.index("w_raw") < loop_pos
         assert code.index("float w =") < loop_pos
-        # Hoisted lines should be at 4-space indent (not 8)
+        # Hoisted lines sit in the param segment loop (8-space indent), one
+        # level above the sample loop body (12)
         for line in code.splitlines():
             if "w_range" in line and "float" in line:
-                assert line.startswith("    ") and not line.startswith("        ")
+                assert line.startswith("        ") and not line.startswith(
+                    "            "
+                )
 
     def test_multiline_fold_hoisted(self) -> None:
         """A Fold node (multi-line emission with if statement) is correctly hoisted."""
@@ -1822,10 +2044,11 @@ class TestGateSelectorCodegen:
                 AudioOutput(id="out2", source="go2"),
             ],
             nodes=[
-                GateRoute(id="gr", a="in1", index=1.0, count=2),
+                GateRoute(id="gr", a="in1", index="ch", count=2),
                 GateOut(id="go1", gate="gr", channel=1),
                 GateOut(id="go2", gate="gr", channel=2),
             ],
+            params=[Param(name="ch", default=1.0)],
         )
         code = compile_graph(g)
         assert "int gr_idx = (int)" in code
@@ -1840,8 +2063,9 @@ class TestGateSelectorCodegen:
             inputs=[AudioInput(id="in1"), AudioInput(id="in2")],
             outputs=[AudioOutput(id="out1", source="mux")],
             nodes=[
-                Selector(id="mux", index=1.0, inputs=["in1", "in2"]),
+                Selector(id="mux", index="ch", inputs=["in1", "in2"]),
             ],
+            params=[Param(name="ch", default=1.0)],
         )
         code = compile_graph(g)
         assert "int mux_idx = (int)" in code
@@ -1849,6 +2073,19 @@ class TestGateSelectorCodegen:
         assert "mux_idx == 1" in code
         assert "mux_idx == 2" in code
 
+    def test_constant_index_unclamped(self) -> None:
+        g = Graph(
+            name="sel_test",
+            inputs=[AudioInput(id="in1"), AudioInput(id="in2")],
+            outputs=[AudioOutput(id="out1", source="mux")],
+            nodes=[
+                Selector(id="mux", index=1.0, inputs=["in1", "in2"]),
+            ],
+        )
+        code = compile_graph(g)
+        assert "int mux_idx = (int)(1.0f);" in code
+        assert "if (mux_idx" not in code
+
     @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
     def test_gate_selector_compiles(self) -> None:
         g = Graph(
@@ -2096,13 +2333,44 @@ class TestCycleWaveLookupCompile:
             nodes=[
                 Buffer(id="buf", size=1024),
                 BufWrite(id="bw", buffer="buf", index=0.0, value=0.0),
-                Cycle(id="cy", buffer="buf", phase=0.5),
+                Cycle(id="cy", buffer="buf", phase="ph"),
             ],
+            params=[Param(name="ph", default=0.5)],
         )
         code = compile_graph(g)
         assert "buf_buf" in code
         assert "floorf" in code
 
+    def test_cycle_bounded_phase_skips_wrap(self) -> None:
+        """A phase already in [0, 1): no floorf on the phase."""
+        g = Graph(
+            name="cy_test",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="cy")],
+            nodes=[
+                Buffer(id="buf", size=1024, fill="sine"),
+                Clamp(id="ph", a="in1", lo=0.0, hi=0.5),
+                Cycle(id="cy", buffer="buf", phase="ph"),
+            ],
+        )
+        code = compile_graph(g)
+        assert "float cy_p = ph;" in code
+
+    def test_cycle_phasor_skips_wrap(self) -> None:
+        """A Phasor-driven Cycle reads without re-wrapping the phase."""
+        g = Graph(
+            name="cy_test",
+            outputs=[AudioOutput(id="out1", source="cy")],
+            nodes=[
+                Buffer(id="buf", size=1024, fill="sine"),
+                Phasor(id="ph", freq=220.0),
+                Cycle(id="cy", buffer="buf", phase="ph"),
+            ],
+        )
+        code = compile_graph(g)
+        assert "float cy_p = ph;" in code
+        assert "floorf(ph)" not in code
+
     def test_wave_codegen(self) -> None:
         g = Graph(
             name="wv_test",
@@ -2162,6 +2430,1841 @@ class TestCycleWaveLookupCompile:
         assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
 
 
+class TestTableGuards:
+    """Buffers read by Cycle/Wave/Lookup carry guard samples past the end."""
+
+    def _table_graph(self, size: int = 256, phase: str = "ph3") -> Graph:
+        return Graph(
+            name="tguard",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="sum")],
+            params=[Param(name="off", min=-4.0, max=4.0, default=-0.25)],
+            nodes=[
+                Buffer(id="tab", size=size, fill="sine"),
+                # The Clamp is a no-op at 48k but bounds the phase for any sr
+                Phasor(id="ph0", freq=997.0),
+                Clamp(id="ph", a="ph0", lo=0.0, hi=1.0),
+                BinOp(id="ph3", op="mul", a="ph", b=3.0),
+                BinOp(id="sh", op="add", a="ph", b="off"),
+                Cycle(id="c1", buffer="tab", phase=phase),
+                Cycle(id="c2", buffer="tab", phase="sh"),
+                Wave(id="wv", buffer="tab", phase="in1"),
+                Lookup(id="lk", buffer="tab", index="ph"),
+                BufWrite(id="bw", buffer="tab", index=1.0, value=0.0),
+                Splat(id="sp", buffer="tab", index=0.0, value=1e-4),
+                BinOp(id="s1", op="add", a="c1", b="c2"),
+                BinOp(id="s2", op="add", a="wv", b="lk"),
+                BinOp(id="sum", op="add", a="s1", b="s2"),
+            ],
+            sample_rate=48000.0,
+        )
+
+    def test_guard_allocation(self) -> None:
+        code = compile_graph(self._table_graph())
+        assert "calloc(258, sizeof(float))" in code
+        assert "self->m_tab_buf[256] = self->m_tab_buf[0];" in code
+        assert "self->m_tab_buf[257] = self->m_tab_buf[1];" in code
+        assert "memset(self->m_tab_buf, 0, 258 * sizeof(float));" not in code
+
+    def test_plain_buffer_unpadded(self) -> None:
+        g = Graph(
+            name="plain",
+            outputs=[AudioOutput(id="out1", source="br")],
+            nodes=[
+                Buffer(id="buf", size=1024),
+                BufRead(id="br", buffer="buf", index=3.0),
+                BufWrite(id="bw", buffer="buf", index=0.0, value=1.0),
+            ],
+        )
+        code = compile_graph(g)
+        assert "calloc(1024, sizeof(float))" in code
+        assert "guard" not in code
+        assert "bw_idx < 2" not in code
+
+    def test_reads_are_branch_free(self) -> None:
+        code = compile_graph(self._table_graph())
+        assert "% tab_len" not in code
+        assert "_i1" not in code
+        assert "float c2 = tab_buf[c2_i0] + c2_frac * (tab_buf[c2_i0 + 1]" in code
+
+    def test_pow2_table_masks_index(self) -> None:
+        code = compile_graph(self._table_graph())
+        assert "int c1_i0 = c1_ip & (tab_len - 1);" in code
+        assert "floorf(ph3)" not in code
+        # Unbounded phase still wraps with floorf
+        assert "float c2_p = sh - floorf(sh);" in code
+
+    def test_non_pow2_table_wraps_with_floorf(self) -> None:
+        code = compile_graph(self._table_graph(size=250))
+        assert "c1_ip" not in code
+        assert "float c1_p = ph3 - floorf(ph3);" in code
+
+    def test_writes_and_set_buffer_refresh_guards(self) -> None:
+        code = compile_graph(self._table_graph())
+        assert "if (bw_idx < 2) tab_buf[tab_len + bw_idx] = tab_buf[bw_idx];" in code
+        assert "if (sp_idx < 2) tab_buf[tab_len + sp_idx] = tab_buf[sp_idx];" in code
+        assert "cap = self->m_tab_len; guard = 2;" in code
+        assert "for (int i = 0; i < guard; i++) dst[cap + i] = dst[i % cap];" in code
+
+    def test_tiny_table_guards_repeat_head(self) -> None:
+        code = compile_graph(self._table_graph(size=1))
+        assert "tab_buf[1] = tab_buf[0];" in code
+        assert "tab_buf[2] = tab_buf[0];" in code
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    @pytest.mark.parametrize("size", [256, 250])
+    def test_guarded_tables_match_simulation(self, size: int, tmp_path: Path) -> None:
+        """Guards stay in sync across BufWrite and set_buffer."""
+        import numpy as np
+
+        from gen_dsp.graph.simulate import SimState, simulate
+
+        g = self._table_graph(size=size)
+        n = 600
+        driver = compile_graph(g) + "\n".join(
+            [
+                "#include <cstdio>",
+                "int main() {",
+                "    TguardState* s = tguard_create(48000.0f);",
+                f"    float in[{n}], out[{n}], data[200];",
+                f"    for (int i = 0; i < {n}; i++) in[i] = 1.2f * sinf(0.05f * (float)i);",
+                "    for (int i = 0; i < 200; i++) data[i] = sinf(0.015f * (float)i);",
+                "    float* ins[1] = {in};",
+                "    float* outs[1] = {out};",
+                f"    tguard_perform(s, ins, outs, {n // 2});",
+                "    tguard_set_buffer(s, 0, data, 200);",
+                "    tguard_set_param(s, 0, 2.5f);",
+                f"    ins[0] = in + {n // 2};",
+                f"    outs[0] = out + {n // 2};",
+                f"    tguard_perform(s, ins, outs, {n - n // 2});",
+                f'    for (int i = 0; i < {n}; i++) printf("%.9g\\n", out[i]);',
+                "    tguard_destroy(s);",
+                "    return 0;",
+                "}",
+                "",
+            ]
+        )
+        src = tmp_path / "tguard.cpp"
+        exe = tmp_path / "tguard"
+        src.write_text(driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O1", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=False)
+        assert run.returncode == 0, run.stderr
+        compiled = np.array([float(v) for v in run.stdout.split()], dtype=np.float32)
+
+        x = (1.2 * np.sin(np.float32(0.05) * np.arange(n, dtype=np.float32))).astype(
+            np.float32
+        )
+        state = SimState(g)
+        a = simulate(g, inputs={"in1": x[: n // 2]}, state=state).outputs["out1"]
+        state.set_buffer(
+            "tab", np.sin(np.float32(0.015) * np.arange(200, dtype=np.float32))
+        )
+        state.set_param("off", 2.5)
+        b = simulate(g, inputs={"in1": x[n // 2 :]}, state=state).outputs["out1"]
+        # Loose enough for float32 phasor drift, tight enough to catch a
+        # stale guard (the Splat moves tab[0] by up to 0.03)
+        np.testing.assert_allclose(compiled, np.concatenate([a, b]), atol=1e-3)
+
+
+class TestWavetableOsc:
+    """WavetableOsc reads a per-buffer, per-octave band-limited mip pyramid."""
+
+    def _wt_graph(self, size: int = 1024) -> Graph:
+        return Graph(
+            name="wt",
+            outputs=[
+                AudioOutput(id="out1", source="o1"),
+                AudioOutput(id="out2", source="naive"),
+            ],
+            params=[Param(name="freq", min=0.0, max=20000.0, default=440.0)],
+            nodes=[
+                Buffer(id="tab", size=size),
+                WavetableOsc(id="o1", buffer="tab", freq="freq"),
+                WavetableOsc(id="o2", buffer="tab", freq=220.0),
+                SawOsc(id="naive", freq="freq"),
+            ],
+            sample_rate=48000.0,
+        )
+
+    def test_pyramid_shared_per_buffer(self) -> None:
+        code = compile_graph(self._wt_graph())
+        assert code.count("static void wt_build_mips(") == 1
+        assert code.count("float* m_tab_mip;") == 1
+        # 10 levels of 1024 + 2 guard samples
+        assert "self->m_tab_mip = (float*)calloc(10260, sizeof(float));" in code
+        assert "free(self->m_tab_mip);" in code
+        assert "const float* o1_mip = self->m_tab_mip;" in code
+        assert "const float* o2_mip = self->m_tab_mip;" in code
+
+    def test_level_selection_on_freq_change(self) -> None:
+        code = compile_graph(self._wt_graph())
+        assert "if (o1_fq != o1_f) {" in code
+        assert "log2f(2048.0f * o1_af / sr)" in code
+        assert "const float* o1_b = o1_a + 1026;" in code
+        assert "float o1 = o1_va + o1_t * (o1_vb - o1_va);" in code
+
+    def test_set_buffer_rebuilds_pyramid(self) -> None:
+        code = compile_graph(self._wt_graph())
+        api = code[code.index("void wt_set_buffer(") :]
+        assert "wt_build_mips(self->m_tab_buf, 1024, 10, self->m_tab_mip);" in api
+
+    def test_no_builder_without_wavetable(self, stereo_gain_graph: Graph) -> None:
+        assert "_build_mips" not in compile_graph(stereo_gain_graph)
+
+    def test_mip_only_buffer_skips_raw_locals(self) -> None:
+        code = compile_graph(self._wt_graph())
+        assert "float* tab_buf = self->m_tab_buf;" not in code
+        assert "int tab_len = self->m_tab_len;" not in code
+
+    def test_buffer_with_other_readers_keeps_raw_locals(self) -> None:
+        g = self._wt_graph()
+        g = g.model_copy(
+            update={
+                "outputs": [*g.outputs, AudioOutput(id="out3", source="rd")],
+                "nodes": [*g.nodes, BufRead(id="rd", buffer="tab", index=3.0)],
+            }
+        )
+        code = compile_graph(g)
+        assert "float* tab_buf = self->m_tab_buf;" in code
+        assert "int tab_len = self->m_tab_len;" in code
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_no_unused_variable_warnings(self, tmp_path: Path) -> None:
+        g = Graph(
+            name="wt",
+            outputs=[AudioOutput(id="out1", source="o1")],
+            params=[Param(name="freq", min=0.0, max=20000.0, default=440.0)],
+            nodes=[
+                Buffer(id="tab", size=1024),
+                WavetableOsc(id="o1", buffer="tab", freq="freq"),
+            ],
+        )
+        src = tmp_path / "wt.cpp"
+        src.write_text(compile_graph(g))
+        result = subprocess.run(
+            [
+                "g++",
+                "-std=c++17",
+                "-Wunused-variable",
+                "-Werror",
+                "-c",
+                "-o",
+                str(tmp_path / "wt.o"),
+                str(src),
+            ],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+
+    def _run(self, g: Graph, driver: list[str], tmp_path: Path) -> list[float]:
+        src = tmp_path / "wt.cpp"
+        exe = tmp_path / "wt"
+        src.write_text(compile_graph(g) + "\n".join(driver) + "\n")
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O1", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=False)
+        assert run.returncode == 0, run.stderr
+        return [float(v) for v in run.stdout.split()]
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_matches_simulation(self, tmp_path: Path) -> None:
+        import numpy as np
+
+        from gen_dsp.graph.simulate import SimState, simulate
+
+        g = self._wt_graph()
+        n = 2400
+        out = self._run(
+            g,
+            [
+                "#include <cstdio>",
+                "int main() {",
+                "    WtState* s = wt_create(48000.0f);",
+                f"    static float data[1024], o1[{n}], o2[{n}];",
+                "    for (int i = 0; i < 1024; i++) data[i] = 2.0f * (float)i / 1024.0f - 1.0f;",
+                "    wt_set_buffer(s, 0, data, 1024);",
+                "    float* outs[2] = {o1, o2};",
+                f"    wt_perform(s, nullptr, outs, {n // 2});",
+                "    wt_set_param(s, 0, 3520.0f);",
+                f"    outs[0] = o1 + {n // 2};",
+                f"    outs[1] = o2 + {n // 2};",
+                f"    wt_perform(s, nullptr, outs, {n - n // 2});",
+                f'    for (int i = 0; i < {n}; i++) printf("%.9g\\n", o1[i]);',
+                "    wt_destroy(s);",
+                "    return 0;",
+                "}",
+            ],
+            tmp_path,
+        )
+        state = SimState(g)
+        state.set_buffer("tab", 2.0 * np.arange(1024) / 1024.0 - 1.0)
+        a = simulate(g, n_samples=n // 2, state=state).outputs["out1"]
+        state.set_param("freq", 3520.0)
+        b = simulate(g, n_samples=n - n // 2, state=state).outputs["out1"]
+        # float32 vs float64 phase accumulation
+        np.testing.assert_allclose(out, np.concatenate([a, b]), atol=3e-3)
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_suppresses_aliasing(self, tmp_path: Path) -> None:
+        """A saw table at 2950 Hz stays clean where the naive SawOsc aliases."""
+        import numpy as np
+
+        g = self._wt_graph(size=2048)
+        n = 24000
+        out = self._run(
+            g,
+            [
+                "#include <cstdio>",
+                "int main() {",
+                "    WtState* s = wt_create(48000.0f);",
+                f"    static float data[2048], o1[{n}], o2[{n}];",
+                "    for (int i = 0; i < 2048; i++) data[i] = 2.0f * (float)i / 2048.0f - 1.0f;",
+                "    wt_set_buffer(s, 0, data, 2048);",
+                "    wt_set_param(s, 0, 2950.0f);",
+                "    float* outs[2] = {o1, o2};",
+                f"    wt_perform(s, nullptr, outs, {n});",
+                f'    for (int i = 0; i < {n}; i++) printf("%.9g %.9g\\n", o1[i], o2[i]);',
+                "    wt_destroy(s);",
+                "    return 0;",
+                "}",
+            ],
+            tmp_path,
+        )
+        pairs = np.array(out).reshape(-1, 2)
+        freqs = np.fft.rfftfreq(n, 1.0 / 48000.0)
+        harmonic = np.zeros(len(freqs), dtype=bool)
+        for k in range(1, int(24000.0 / 2950.0) + 1):
+            harmonic |= np.abs(freqs - k * 2950.0) < 8.0
+
+        def alias_db(x: np.ndarray) -> float:
+            power = np.abs(np.fft.rfft(x * np.hanning(n))) ** 2
+            return float(
+                10.0 * np.log10(power[~harmonic].sum() / power[harmonic].sum())
+            )
+
+        assert alias_db(pairs[:, 0]) < -50.0
+        assert alias_db(pairs[:, 1]) > -20.0
+
+
+class TestFDN:
+    """FDN mixes its lines with a fast transform over one shared buffer."""
+
+    _DELAYS = (101, 143, 165, 177, 199, 211, 223, 241)
+
+    def _fdn_graph(
+        self, matrix: str = "hadamard", damping: float | str = 0.0, n: int = 8
+    ) -> Graph:
+        return Graph(
+            name="rv",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="f")],
+            params=[
+                Param(name="fb", min=0.0, max=1.0, default=0.8),
+                Param(name="damp", min=0.0, max=0.99, default=0.3),
+            ],
+            nodes=[
+                FDN(
+                    id="f",
+                    a="in1",
+                    delays=list(self._DELAYS[:n]),
+                    feedback="fb",
+                    damping=damping,
+                    matrix=matrix,  # type: ignore[arg-type]
+                )
+            ],
+            sample_rate=48000.0,
+        )
+
+    def test_single_allocation(self) -> None:
+        code = compile_graph(self._fdn_graph())
+        assert f"calloc({sum(self._DELAYS)}, sizeof(float))" in code
+        assert "int m_f_pos[8];" in code
+        assert "free(self->m_f_buf);" in code
+        # Compile-time line offsets, no modulo on the heads
+        assert "f_v[1] = f_buf[101 + f_p1];" in code
+        assert "if (++f_p7 == 241) f_p7 = 0;" in code
+        assert "%" not in code[code.index("FDN f:") :].split("}")[0]
+
+    def test_hadamard_butterflies(self) -> None:
+        code = compile_graph(self._fdn_graph())
+        body = code[code.index("FDN f:") :].split("        }")[0]
+        butterfly = re.compile(r"f_[uv]\[\d\] = f_[uv]\[\d\] [+-] f_[uv]\[\d\];")
+        # log2(8) = 3 stages of 8 outputs each, no N^2 matrix multiply
+        assert len(butterfly.findall(body)) == 24
+        assert body.count(" * ") == 10  # output, gain, 8 feedback scalings
+        assert "float f_g = fb * 0.35355339059327373f;" in code
+        assert "f = f_u[0] * 0.125f;" in code
+
+    def test_householder_reflection(self) -> None:
+        code = compile_graph(self._fdn_graph(matrix="householder", n=5))
+        assert "float f_r = f_sum * 0.4f;" in code
+        assert "f_buf[101 + f_p1] = f_x + f_g * (f_v[1] - f_r);" in code
+        assert "f_u" not in code
+
+    def test_damping_skipped_when_zero(self) -> None:
+        assert "f_dc" not in compile_graph(self._fdn_graph())
+        code = compile_graph(self._fdn_graph(damping="damp"))
+        assert "f_v[0] = f_lp0 = f_v[0] + f_dc * (f_lp0 - f_v[0]);" in code
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    @pytest.mark.parametrize(
+        ("matrix", "n", "damping"),
+        [("hadamard", 8, "damp"), ("householder", 5, 0.0), ("hadamard", 2, 0.0)],
+    )
+    def test_matches_simulation(
+        self, matrix: str, n: int, damping: float | str, tmp_path: Path
+    ) -> None:
+        import numpy as np
+
+        from gen_dsp.graph.simulate import SimState, simulate
+
+        g = self._fdn_graph(matrix, damping, n)
+        total = 3000
+        driver = compile_graph(g) + "\n".join(
+            [
+                "#include <cstdio>",
+                "int main() {",
+                "    RvState* s = rv_create(48000.0f);",
+                f"    static float in[{total}], out[{total}];",
+                "    in[0] = 1.0f;",
+                "    for (int i = 1; i < 300; i++) in[i] = 0.5f * sinf(0.1f * (float)i);",
+                "    float* ins[1] = {in};",
+                "    float* outs[1] = {out};",
+                f"    rv_perform(s, ins, outs, {total // 2});",
+                "    rv_set_param(s, 0, 0.95f);",
+                f"    ins[0] = in + {total // 2};",
+                f"    outs[0] = out + {total // 2};",
+                f"    rv_perform(s, ins, outs, {total - total // 2});",
+                f'    for (int i = 0; i < {total}; i++) printf("%.9g\\n", out[i]);',
+                "    rv_destroy(s);",
+                "    return 0;",
+                "}",
+                "",
+            ]
+        )
+        src = tmp_path / "rv.cpp"
+        exe = tmp_path / "rv"
+        src.write_text(driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O1", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=False)
+        assert run.returncode == 0, run.stderr
+        compiled = np.array([float(v) for v in run.stdout.split()])
+
+        x = np.zeros(total, dtype=np.float32)
+        x[0] = 1.0
+        x[1:300] = 0.5 * np.sin(np.float32(0.1) * np.arange(1, 300, dtype=np.float32))
+        state = SimState(g)
+        a = simulate(g, inputs={"in1": x[: total // 2]}, state=state).outputs["out1"]
+        state.set_param("fb", 0.95)
+        b = simulate(g, inputs={"in1": x[total // 2 :]}, state=state).outputs["out1"]
+        np.testing.assert_allclose(compiled, np.concatenate([a, b]), atol=1e-6)
+
+
+_bench_enabled = os.environ.get("GEN_DSP_BENCH", "") not in ("", "0")
+
+
+class TestWindowExtrema:
+    """WindowMax/WindowMin keep a monotonic deque in the state struct."""
+
+    def _graph(self, cls: type = WindowMax, window: float | str = "win") -> Graph:
+        return Graph(
+            name="pk",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="m")],
+            params=[Param(name="win", min=1.0, max=64.0, default=17.0)],
+            nodes=[cls(id="m", a="in1", window=window, max_window=64)],
+            sample_rate=48000.0,
+        )
+
+    def test_deque_state(self) -> None:
+        code = compile_graph(self._graph())
+        assert "self->m_m_val = (float*)calloc(64, sizeof(float));" in code
+        assert "self->m_m_at = (uint32_t*)calloc(64, sizeof(uint32_t));" in code
+        assert "free(self->m_m_at);" in code
+        assert "self->m_m_count = m_count;" in code
+        # NaN-safe clamp of the control-rate window
+        assert "(uint32_t)fminf(fmaxf(win, 1.0f), 64.0f);" in code
+
+    def test_min_flips_comparison(self) -> None:
+        assert "if (m_val[m_b] > m_x) break;" in compile_graph(self._graph())
+        code = compile_graph(self._graph(WindowMin))
+        assert "if (m_val[m_b] < m_x) break;" in code
+
+    def test_literal_window_clamped(self) -> None:
+        assert "uint32_t m_w = 64u;" in compile_graph(self._graph(window=1000.0))
+        assert "uint32_t m_w = 1u;" in compile_graph(self._graph(window=0.0))
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    @pytest.mark.parametrize("cls", [WindowMax, WindowMin])
+    def test_matches_simulation(self, cls: type, tmp_path: Path) -> None:
+        import numpy as np
+
+        from gen_dsp.graph.simulate import SimState, simulate
+
+        g = self._graph(cls)
+        windows = (17.0, 5.0, 64.0, 33.5)
+        block = 700
+        total = block * len(windows)
+        driver = compile_graph(g) + "\n".join(
+            [
+                "#include <cstdio>",
+                "int main() {",
+                "    PkState* s = pk_create(48000.0f);",
+                f"    static float in[{total}], out[{total}];",
+                "    unsigned r = 1;",
+                f"    for (int i = 0; i < {total}; i++) {{",
+                "        r = r * 1664525u + 1013904223u;",
+                "        in[i] = (float)(r >> 8) / 16777216.0f - 0.5f;",
+                "    }",
+                # NaN both mid-window and right after a window change
+                "    in[123] = in[700] = in[1800] = in[1801] = NAN;",
+                f"    float wins[{len(windows)}] = {{{', '.join(map(str, windows))}}};",
+                f"    for (int k = 0; k < {len(windows)}; k++) {{",
+                f"        float* ins[1] = {{in + k * {block}}};",
+                f"        float* outs[1] = {{out + k * {block}}};",
+                "        pk_set_param(s, 0, wins[k]);",
+                f"        pk_perform(s, ins, outs, {block});",
+                "    }",
+                f'    for (int i = 0; i < {total}; i++) printf("%.9g\\n", in[i]);',
+                f'    for (int i = 0; i < {total}; i++) printf("%.9g\\n", out[i]);',
+                "    pk_destroy(s);",
+                "    return 0;",
+                "}",
+                "",
+            ]
+        )
+        src = tmp_path / "pk.cpp"
+        exe = tmp_path / "pk"
+        src.write_text(driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O1", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=False)
+        assert run.returncode == 0, run.stderr
+        values = np.array([float(v) for v in run.stdout.split()], dtype=np.float32)
+        x, compiled = values[:total], values[total:]
+
+        state = SimState(g)
+        expected = []
+        for k, win in enumerate(windows):
+            state.set_param("win", win)
+            chunk = x[k * block : (k + 1) * block]
+            expected.append(
+                simulate(g, inputs={"in1": chunk}, state=state).outputs["out1"]
+            )
+        np.testing.assert_array_equal(compiled, np.concatenate(expected))
+
+    @pytest.mark.skipif(not _bench_enabled, reason="opt-in (GEN_DSP_BENCH=1)")
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    @pytest.mark.parametrize("ms", [5, 50])
+    def test_benchmark_vs_tap_chain(
+        self, ms: int, tmp_path: Path, record_property
+    ) -> None:
+        # The pre-deque way to get a sliding max: one DelayRead per tap
+        # folded through a max() chain, O(window) per sample
+        width = 48 * ms
+        taps: list = [DelayLine(id="dl", max_samples=width)]
+        prev = "in1"
+        for k in range(1, width):
+            taps.append(DelayRead(id=f"t{k}", delay="dl", tap=float(k)))
+            taps.append(BinOp(id=f"x{k}", op="max", a=prev, b=f"t{k}"))
+            prev = f"x{k}"
+        taps.append(DelayWrite(id="dw", delay="dl", value="in1"))
+        deque = WindowMax(id="m", a="in1", window=float(width), max_window=width)
+        graphs = {"deque": ([deque], "m"), "taps": (taps, prev)}
+        driver = """
+#include <cstdio>
+#include <ctime>
+int main() {
+    WdState* s = wd_create(48000.0f);
+    static float in[48000], out[48000];
+    unsigned r = 1;
+    for (int i = 0; i < 48000; i++) {
+        r = r * 1664525u + 1013904223u;
+        in[i] = (float)(r >> 8) / 16777216.0f - 0.5f;
+    }
+    double best = 1e30;
+    for (int rep = 0; rep < 5; rep++) {
+        timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int b = 0; b < 48000; b += 64) {
+            float* ins[1] = {in + b};
+            float* outs[1] = {out + b};
+            wd_perform(s, ins, outs, 64);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+        if (ns < best) best = ns;
+    }
+    printf("%.3f %.9g\\n", best / 48000.0, out[47999]);
+    wd_destroy(s);
+    return 0;
+}
+"""
+        report = {}
+        for label, (nodes, source) in graphs.items():
+            g = Graph(
+                name="wd",
+                inputs=[AudioInput(id="in1")],
+                outputs=[AudioOutput(id="out1", source=source)],
+                nodes=nodes,
+            )
+            src = tmp_path / f"{label}.cpp"
+            exe = tmp_path / label
+            src.write_text(compile_graph(g) + driver)
+            subprocess.run(
+                ["g++", "-std=c++17", "-O2", "-o", str(exe), str(src)],
+                check=True,
+                capture_output=True,
+            )
+            run = subprocess.run(
+                [str(exe)], capture_output=True, text=True, timeout=300, check=True
+            )
+            report[label] = run.stdout.split()
+
+        # Same signal out of both, so the timings compare like for like
+        assert report["deque"][1] == report["taps"][1]
+        for label, (ns, _) in report.items():
+            record_property(f"{label}_{ms}ms_ns_per_sample", float(ns))
+        print(
+            f"\nsliding max {ms} ms ({width} samples): deque "
+            f"{float(report['deque'][0]):.1f} ns/sample, tap chain "
+            f"{float(report['taps'][0]):.1f} ns/sample"
+        )
+
+
+class TestMovingAverage:
+    """MovingAverage keeps a ring, a running sum and a restarted sum."""
+
+    def _graph(self, mode: str = "mean", window: int = 100) -> Graph:
+        return Graph(
+            name="ma",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="m")],
+            nodes=[MovingAverage(id="m", a="in1", window=window, mode=mode)],  # type: ignore[arg-type]
+            sample_rate=48000.0,
+        )
+
+    def test_running_sum_codegen(self) -> None:
+        code = compile_graph(self._graph())
+        assert "self->m_m_buf = (float*)calloc(100, sizeof(float));" in code
+        assert "free(self->m_m_buf);" in code
+        assert "m_sum += m_v - m_buf[m_pos];" in code
+        # The restarted sum takes over each time the head wraps
+        assert "if (++m_pos == 100) {" in code
+        assert "m_sum = m_fresh;" in code
+        assert "m = m_sum * 0.01f;" in code
+
+    def test_rms_codegen(self) -> None:
+        code = compile_graph(self._graph("rms"))
+        assert "float m_v = m_x * m_x;" in code
+        assert "m = sqrtf(fmaxf(m_sum * 0.01f, 0.0f));" in code
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    @pytest.mark.parametrize("mode", ["mean", "rms"])
+    def test_matches_simulation(self, mode: str, tmp_path: Path) -> None:
+        import numpy as np
+
+        from gen_dsp.graph.simulate import simulate
+
+        g = self._graph(mode)
+        total = 5000
+        driver = compile_graph(g) + "\n".join(
+            [
+                "#include <cstdio>",
+                "int main() {",
+                "    MaState* s = ma_create(48000.0f);",
+                f"    static float in[{total}], out[{total}];",
+                "    unsigned r = 1;",
+                f"    for (int i = 0; i < {total}; i++) {{",
+                "        r = r * 1664525u + 1013904223u;",
+                "        in[i] = (float)(r >> 8) / 16777216.0f - 0.3f;",
+                "    }",
+                f"    for (int b = 0; b < {total}; b += 50) {{",
+                "        float* ins[1] = {in + b};",
+                "        float* outs[1] = {out + b};",
+                "        ma_perform(s, ins, outs, 50);",
+                "    }",
+                f'    for (int i = 0; i < {total}; i++) printf("%.9g\\n", in[i]);',
+                f'    for (int i = 0; i < {total}; i++) printf("%.9g\\n", out[i]);',
+                "    ma_destroy(s);",
+                "    return 0;",
+                "}",
+                "",
+            ]
+        )
+        src = tmp_path / "ma.cpp"
+        exe = tmp_path / "ma"
+        src.write_text(driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O1", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=False)
+        assert run.returncode == 0, run.stderr
+        values = np.array([float(v) for v in run.stdout.split()], dtype=np.float32)
+        x, compiled = values[:total], values[total:]
+        expected = simulate(g, inputs={"in1": x}).outputs["out1"]
+        np.testing.assert_array_equal(compiled, expected)
+
+
+class TestMultiTapRead:
+    """MultiTapRead shares one base index and spreads taps over partial sums."""
+
+    def _graph(self, taps: list, gains: list, interp: str = "none") -> Graph:
+        return Graph(
+            name="mt",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="m")],
+            params=[
+                Param(name="t", min=0.0, max=90.0, default=37.25),
+                Param(name="g", min=0.0, max=1.0, default=0.5),
+            ],
+            nodes=[
+                DelayLine(id="dl", max_samples=100),
+                Clamp(id="ct", a="t", lo=0.0, hi=90.0),
+                MultiTapRead(id="m", delay="dl", taps=taps, gains=gains, interp=interp),  # type: ignore[arg-type]
+                DelayWrite(id="dw", delay="dl", value="in1"),
+            ],
+            sample_rate=48000.0,
+        )
+
+    def test_constant_taps_table(self) -> None:
+        code = compile_graph(
+            self._graph([0.0, 5.0, 99.0, 100.0, 5.0], [0.5, 0.25, 1.0, -1.0, 0.25])
+        )
+        assert "int m_base = dl_wr + dl_len;" in code
+        assert "float m_acc[4] = {0.0f};" in code
+        # The repeated tap at 5 is merged into one table entry
+        assert "static const int m_off[4] = {0, 5, 99, 100};" in code
+        assert "static const float m_w[4] = {0.5f, 0.5f, 1.0f, -1.0f};" in code
+        assert "if (m_j >= dl_len) m_j -= dl_len;" in code
+        assert "m = ((m_acc[0] + m_acc[1]) + (m_acc[2] + m_acc[3]));" in code
+        assert "% dl_len + dl_len" not in code
+
+    def test_linear_taps_fold_into_table(self) -> None:
+        code = compile_graph(self._graph([0.0, 5.5, 98.75], [], "linear"))
+        assert "static const int m_off[5] = {0, 5, 6, 98, 99};" in code
+        assert "static const float m_w[5] = {1.0f, 0.5f, 0.5f, 0.25f, 0.75f};" in code
+        # Four entries go round the lane loop, the fifth is the remainder
+        assert "for (int m_k = 0; m_k < 4; m_k += 4) {" in code
+        assert "m_acc[m_k - 4] += m_w[m_k] * dl_buf[m_j];" in code
+
+    def test_runtime_taps(self) -> None:
+        code = compile_graph(self._graph(["ct", 7.0, "in1"], ["g", 1.0, 0.3], "linear"))
+        assert "m_off" not in code
+        # The clamped tap is proven inside the line; the audio-rate one is not
+        assert "int m_j0 = m_base - m_i0;" in code
+        assert "int m_j2 = ((dl_wr - m_i2) % dl_len + dl_len) % dl_len;" in code
+        assert "m_acc[0] += g * (dl_buf[m_j0] + " in code
+        assert "m_acc[1] += dl_buf[m_j1];" in code
+        assert "m = ((m_acc[0] + m_acc[1]) + m_acc[2]);" in code
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    @pytest.mark.parametrize(
+        ("taps", "gains", "interp"),
+        [
+            ([0.0, 5.0, 99.0, 100.0, 5.0], [0.5, 0.25, 1.0, -1.0, 0.25], "none"),
+            ([0.0, 5.5, 98.75, 3.0, 41.5, 77.0], [], "linear"),
+            (["ct", 5.5, "in1"], ["g", 1.0, 0.3], "linear"),
+            (["t", 7.0], [], "none"),
+        ],
+    )
+    def test_matches_simulation(
+        self, taps: list, gains: list, interp: str, tmp_path: Path
+    ) -> None:
+        import numpy as np
+
+        from gen_dsp.graph.simulate import simulate
+
+        g = self._graph(taps, gains, interp)
+        total = 3000
+        driver = compile_graph(g) + "\n".join(
+            [
+                "#include <cstdio>",
+                "int main() {",
+                "    MtState* s = mt_create(48000.0f);",
+                f"    static float in[{total}], out[{total}];",
+                "    unsigned r = 1;",
+                f"    for (int i = 0; i < {total}; i++) {{",
+                "        r = r * 1664525u + 1013904223u;",
+                "        in[i] = (float)(r >> 8) / 16777216.0f * 50.0f;",
+                "    }",
+                f"    for (int b = 0; b < {total}; b += 50) {{",
+                "        float* ins[1] = {in + b};",
+                "        float* outs[1] = {out + b};",
+                "        mt_perform(s, ins, outs, 50);",
+                "    }",
+                f'    for (int i = 0; i < {total}; i++) printf("%.9g\\n", in[i]);',
+                f'    for (int i = 0; i < {total}; i++) printf("%.9g\\n", out[i]);',
+                "    mt_destroy(s);",
+                "    return 0;",
+                "}",
+                "",
+            ]
+        )
+        src = tmp_path / "mt.cpp"
+        exe = tmp_path / "mt"
+        src.write_text(driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O1", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=False)
+        assert run.returncode == 0, run.stderr
+        values = np.array([float(v) for v in run.stdout.split()], dtype=np.float32)
+        x, compiled = values[:total], values[total:]
+        expected = simulate(g, inputs={"in1": x}).outputs["out1"]
+        np.testing.assert_array_equal(compiled, expected)
+
+    @pytest.mark.skipif(not _bench_enabled, reason="opt-in (GEN_DSP_BENCH=1)")
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    @pytest.mark.parametrize("interp", ["none", "linear"])
+    def test_benchmark_vs_tap_chain(
+        self, interp: str, tmp_path: Path, record_property
+    ) -> None:
+        # 64 early reflections, against one DelayRead + gain + add per tap
+        import random
+
+        rnd = random.Random(1)
+        taps = sorted(round(rnd.uniform(100.0, 4700.0), 2) for _ in range(64))
+        if interp == "none":
+            taps = [float(int(t)) for t in taps]
+        gains = [round(rnd.uniform(-0.5, 0.5), 3) for _ in range(64)]
+        chain: list = [DelayLine(id="dl", max_samples=4800)]
+        prev = ""
+        for k, (tap, gain) in enumerate(zip(taps, gains)):
+            chain.append(DelayRead(id=f"r{k}", delay="dl", tap=tap, interp=interp))  # type: ignore[arg-type]
+            chain.append(BinOp(id=f"g{k}", op="mul", a=f"r{k}", b=gain))
+            if prev:
+                chain.append(BinOp(id=f"s{k}", op="add", a=prev, b=f"g{k}"))
+                prev = f"s{k}"
+            else:
+                prev = f"g{k}"
+        chain.append(DelayWrite(id="dw", delay="dl", value="in1"))
+        multi = [
+            DelayLine(id="dl", max_samples=4800),
+            MultiTapRead(id="m", delay="dl", taps=taps, gains=gains, interp=interp),  # type: ignore[arg-type]
+            DelayWrite(id="dw", delay="dl", value="in1"),
+        ]
+        graphs = {"multi": (multi, "m"), "taps": (chain, prev)}
+        driver = """
+#include <cstdio>
+#include <ctime>
+int main() {
+    WdState* s = wd_create(48000.0f);
+    static float in[48000], out[48000];
+    unsigned r = 1;
+    for (int i = 0; i < 48000; i++) {
+        r = r * 1664525u + 1013904223u;
+        in[i] = (float)(r >> 8) / 16777216.0f - 0.5f;
+    }
+    double best = 1e30;
+    for (int rep = 0; rep < 5; rep++) {
+        timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int b = 0; b < 48000; b += 64) {
+            float* ins[1] = {in + b};
+            float* outs[1] = {out + b};
+            wd_perform(s, ins, outs, 64);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+        if (ns < best) best = ns;
+    }
+    printf("%.3f %.9g\\n", best / 48000.0, out[47999]);
+    wd_destroy(s);
+    return 0;
+}
+"""
+        report = {}
+        for label, (nodes, source) in graphs.items():
+            g = Graph(
+                name="wd",
+                inputs=[AudioInput(id="in1")],
+                outputs=[AudioOutput(id="out1", source=source)],
+                nodes=nodes,
+            )
+            src = tmp_path / f"{label}.cpp"
+            exe = tmp_path / label
+            src.write_text(compile_graph(g) + driver)
+            subprocess.run(
+                ["g++", "-std=c++17", "-O2", "-o", str(exe), str(src)],
+                check=True,
+                capture_output=True,
+            )
+            run = subprocess.run(
+                [str(exe)], capture_output=True, text=True, timeout=300, check=True
+            )
+            report[label] = run.stdout.split()
+
+        # Same taps, different summation order; the chain also rounds each
+        # tap to float before taking its fraction, the table does not
+        assert float(report["multi"][1]) == pytest.approx(
+            float(report["taps"][1]), abs=1e-3
+        )
+        for label, (ns, _) in report.items():
+            record_property(f"{label}_{interp}_ns_per_sample", float(ns))
+        print(
+            f"\n64 taps ({interp}): multi-tap "
+            f"{float(report['multi'][0]):.1f} ns/sample, tap chain "
+            f"{float(report['taps'][0]):.1f} ns/sample"
+        )
+
+
+class TestFIR:
+    """FIR keeps a doubled history ring and runs one contiguous dot product."""
+
+    def _graph(self, coeffs: list[float] | str, size: int = 0) -> Graph:
+        nodes: list = [FIR(id="f", a="in1", coeffs=coeffs)]
+        if isinstance(coeffs, str):
+            nodes.insert(0, Buffer(id=coeffs, size=size))
+        return Graph(
+            name="fir",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="f")],
+            nodes=nodes,
+            sample_rate=48000.0,
+        )
+
+    @staticmethod
+    def _taps(n: int) -> list[float]:
+        return [round(0.9 ** (k + 1) * (-1.0) ** k, 6) for k in range(n)]
+
+    def test_inline_codegen(self) -> None:
+        code = compile_graph(self._graph([0.25, -0.5, 0.125]))
+        assert "static inline float fir_fir_dot(" in code
+        assert "#define FIR_FIR_SSE2" in code
+        assert "#define FIR_FIR_NEON" in code
+        assert "static const float f_c[3] = {0.25f, -0.5f, 0.125f};" in code
+        assert "if (--f_pos < 0) f_pos = 3 - 1;" in code
+        assert "f_hist[f_pos] = f_hist[f_pos + 3] = in1[i];" in code
+        assert "f = fir_fir_dot(f_c, f_hist + f_pos, 3);" in code
+        assert "self->m_f_hist = (float*)calloc(2 * 3, sizeof(float));" in code
+        assert "free(self->m_f_hist);" in code
+
+    def test_buffer_codegen(self) -> None:
+        code = compile_graph(self._graph("h", 32))
+        assert "f_c" not in code
+        assert "if (--f_pos < 0) f_pos = h_len - 1;" in code
+        assert "f = fir_fir_dot(h_buf, f_hist + f_pos, h_len);" in code
+        assert "calloc(2 * self->m_h_len, sizeof(float))" in code
+
+    def test_no_helper_without_fir(self) -> None:
+        g = Graph(
+            name="nofir",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="ap")],
+            nodes=[Allpass(id="ap", a="in1", coeff=0.5)],
+        )
+        assert "_fir_dot" not in compile_graph(g)
+
+    def _run(self, g: Graph, tmp_path: Path, *flags: str, coeffs: str = "") -> list:
+        total = 2000
+        lines = [
+            "#include <cstdio>",
+            "int main() {",
+            "    FirState* s = fir_create(48000.0f);",
+        ]
+        if coeffs:
+            lines.append(f"    static const float h[] = {{{coeffs}}};")
+            lines.append("    fir_set_buffer(s, 0, h, (int)(sizeof h / sizeof h[0]));")
+        lines += [
+            f"    static float in[{total}], out[{total}];",
+            "    unsigned r = 1;",
+            f"    for (int i = 0; i < {total}; i++) {{",
+            "        r = r * 1664525u + 1013904223u;",
+            "        in[i] = (float)(r >> 8) / 16777216.0f - 0.5f;",
+            "    }",
+            f"    for (int b = 0; b < {total}; b += 50) {{",
+            "        float* ins[1] = {in + b};",
+            "        float* outs[1] = {out + b};",
+            "        fir_perform(s, ins, outs, 50);",
+            "    }",
+            f'    for (int i = 0; i < {total}; i++) printf("%.9g\\n", in[i]);',
+            f'    for (int i = 0; i < {total}; i++) printf("%.9g\\n", out[i]);',
+            "    fir_destroy(s);",
+            "    return 0;",
+            "}",
+            "",
+        ]
+        src = tmp_path / "fir.cpp"
+        exe = tmp_path / "fir"
+        src.write_text(compile_graph(g) + "\n".join(lines))
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O1", *flags, "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=False)
+        assert run.returncode == 0, run.stderr
+        return [float(v) for v in run.stdout.split()]
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    @pytest.mark.parametrize("n", [1, 3, 7, 33])
+    def test_inline_matches_simulation(self, n: int, tmp_path: Path) -> None:
+        import numpy as np
+
+        from gen_dsp.graph.simulate import simulate
+
+        g = self._graph(self._taps(n))
+        values = np.array(self._run(g, tmp_path), dtype=np.float32)
+        x, compiled = np.split(values, 2)
+        expected = simulate(g, inputs={"in1": x}).outputs["out1"]
+        np.testing.assert_array_equal(compiled, expected)
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_buffer_matches_simulation(self, tmp_path: Path) -> None:
+        import numpy as np
+
+        from gen_dsp.graph.simulate import SimState, simulate
+
+        # 19 taps loaded into a 21-sample buffer: the last two stay zero
+        taps = self._taps(19)
+        g = self._graph("h", 21)
+        coeffs = ", ".join(f"{c!r}f" for c in taps)
+        values = np.array(self._run(g, tmp_path, coeffs=coeffs), dtype=np.float32)
+        x, compiled = np.split(values, 2)
+        state = SimState(g)
+        state.set_buffer("h", np.array(taps, dtype=np.float32))
+        expected = simulate(g, inputs={"in1": x}, state=state).outputs["out1"]
+        np.testing.assert_array_equal(compiled, expected)
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_scalar_fallback_matches(self, tmp_path: Path) -> None:
+        g = self._graph(self._taps(13))
+        simd = self._run(g, tmp_path)
+        scalar = self._run(g, tmp_path, "-DGEN_DSP_SIMD_SCALAR")
+        assert simd == scalar
+
+    @pytest.mark.skipif(not _bench_enabled, reason="opt-in (GEN_DSP_BENCH=1)")
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    @pytest.mark.parametrize("n", [16, 64])
+    def test_benchmark_vs_tap_chain(self, n: int, tmp_path: Path, record_property):
+        # The same taps as one DelayRead + gain + add per coefficient. The
+        # write is scheduled before the reads, so tap 1 is the current input.
+        taps = self._taps(n)
+        chain: list = [DelayLine(id="dl", max_samples=n)]
+        prev = ""
+        for k, c in enumerate(taps):
+            chain.append(DelayRead(id=f"r{k}", delay="dl", tap=float(k + 1)))
+            chain.append(BinOp(id=f"g{k}", op="mul", a=f"r{k}", b=c))
+            if prev:
+                chain.append(BinOp(id=f"s{k}", op="add", a=prev, b=f"g{k}"))
+                prev = f"s{k}"
+            else:
+                prev = f"g{k}"
+        chain.append(DelayWrite(id="dw", delay="dl", value="in1"))
+        graphs = {
+            "fir": ([FIR(id="f", a="in1", coeffs=taps)], "f"),
+            "taps": (chain, prev),
+        }
+        driver = """
+#include <cstdio>
+#include <ctime>
+int main() {
+    WdState* s = wd_create(48000.0f);
+    static float in[48000], out[48000];
+    unsigned r = 1;
+    for (int i = 0; i < 48000; i++) {
+        r = r * 1664525u + 1013904223u;
+        in[i] = (float)(r >> 8) / 16777216.0f - 0.5f;
+    }
+    double best = 1e30;
+    for (int rep = 0; rep < 5; rep++) {
+        timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int b = 0; b < 48000; b += 64) {
+            float* ins[1] = {in + b};
+            float* outs[1] = {out + b};
+            wd_perform(s, ins, outs, 64);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+        if (ns < best) best = ns;
+    }
+    printf("%.3f %.9g\\n", best / 48000.0, out[47999]);
+    wd_destroy(s);
+    return 0;
+}
+"""
+        report = {}
+        for label, (nodes, source) in graphs.items():
+            g = Graph(
+                name="wd",
+                inputs=[AudioInput(id="in1")],
+                outputs=[AudioOutput(id="out1", source=source)],
+                nodes=nodes,
+            )
+            src = tmp_path / f"{label}.cpp"
+            exe = tmp_path / label
+            src.write_text(compile_graph(g) + driver)
+            subprocess.run(
+                ["g++", "-std=c++17", "-O2", "-o", str(exe), str(src)],
+                check=True,
+                capture_output=True,
+            )
+            run = subprocess.run(
+                [str(exe)], capture_output=True, text=True, timeout=300, check=True
+            )
+            report[label] = run.stdout.split()
+
+        # Same taps, different summation order
+        assert float(report["fir"][1]) == pytest.approx(
+            float(report["taps"][1]), abs=1e-5
+        )
+        for label, (ns, _) in report.items():
+            record_property(f"{label}_{n}_ns_per_sample", float(ns))
+        print(
+            f"\n{n} taps: fir {float(report['fir'][0]):.1f} ns/sample, "
+            f"tap chain {float(report['taps'][0]):.1f} ns/sample"
+        )
+
+
+class TestResample:
+    """Resample blends two rows of a shared polyphase windowed-sinc table."""
+
+    _SIZE = 1000
+
+    def _graph(self, taps: int = 16) -> Graph:
+        return Graph(
+            name="rs",
+            inputs=[AudioInput(id="in1"), AudioInput(id="in2")],
+            outputs=[AudioOutput(id="out1", source="y")],
+            nodes=[
+                Buffer(id="smp", size=self._SIZE),
+                Resample(id="y", buffer="smp", index="in1", rate="in2", taps=taps),
+            ],
+            sample_rate=48000.0,
+        )
+
+    def test_codegen(self) -> None:
+        code = compile_graph(self._graph())
+        # 7 cutoff levels x 33 phase rows x 16 taps
+        assert "static const float rs_sinc16[3696] = {" in code
+        assert "static inline float rs_fir_dot(" in code
+        assert "int y_j = y_i - 7;" in code
+        assert "(y_r > 1.0f) + (y_r > 1.4142135623730951f)" in code
+        assert "(y_r > 5.656854249492381f);" in code
+        assert "const float* y_k = rs_sinc16 + (y_lvl * 33 + y_ph) * 16;" in code
+        assert "float y_s0 = rs_fir_dot(y_k, y_x, 16);" in code
+        assert "float y_s1 = rs_fir_dot(y_k + 16, y_x, 16);" in code
+
+    def test_table_shared_per_tap_count(self) -> None:
+        g = Graph(
+            name="rs",
+            inputs=[AudioInput(id="in1")],
+            outputs=[
+                AudioOutput(id="out1", source="a"),
+                AudioOutput(id="out2", source="c"),
+            ],
+            nodes=[
+                Buffer(id="smp", size=64),
+                Resample(id="a", buffer="smp", index="in1"),
+                Resample(id="b", buffer="smp", index="in1", rate=2.0),
+                Resample(id="c", buffer="smp", index="b", taps=32),
+            ],
+        )
+        code = compile_graph(g)
+        assert code.count("static const float rs_sinc16[") == 1
+        assert code.count("static const float rs_sinc32[") == 1
+
+    def _run(self, g: Graph, tmp_path: Path, rate: str, *flags: str) -> list:
+        total = 3000
+        driver = f"""
+#include <cstdio>
+int main() {{
+    RsState* s = rs_create(48000.0f);
+    static float data[{self._SIZE}];
+    unsigned r = 7;
+    for (int i = 0; i < {self._SIZE}; i++) {{
+        r = r * 1664525u + 1013904223u;
+        data[i] = (float)(r >> 8) / 16777216.0f - 0.5f;
+    }}
+    rs_set_buffer(s, 0, data, {self._SIZE});
+    static float idx[{total}], rate[{total}], out[{total}];
+    for (int i = 0; i < {total}; i++) {{
+        idx[i] = -20.0f + (float)i * 0.3517f;
+        rate[i] = {rate};
+    }}
+    for (int b = 0; b < {total}; b += 50) {{
+        float* ins[2] = {{idx + b, rate + b}};
+        float* outs[1] = {{out + b}};
+        rs_perform(s, ins, outs, 50);
+    }}
+    for (int i = 0; i < {total}; i++) printf("%.9g %.9g\\n", idx[i], rate[i]);
+    for (int i = 0; i < {total}; i++) printf("%.9g\\n", out[i]);
+    rs_destroy(s);
+    return 0;
+}}
+"""
+        src = tmp_path / "rs.cpp"
+        exe = tmp_path / "rs"
+        src.write_text(compile_graph(g) + driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O1", *flags, "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=False)
+        assert run.returncode == 0, run.stderr
+        return [float(v) for v in run.stdout.split()]
+
+    def _buffer(self) -> list[float]:
+        import numpy as np
+
+        # Same LCG as the C driver
+        r, data = 7, []
+        for _ in range(self._SIZE):
+            r = (r * 1664525 + 1013904223) % 2**32
+            data.append(np.float32((r >> 8) / 16777216.0) - np.float32(0.5))
+        return data
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    @pytest.mark.parametrize(
+        ("taps", "rate"),
+        [
+            (16, "1.0f"),
+            (8, "2.5f"),
+            (32, "-7.0f"),
+            (4, "0.5f"),
+            (64, "100.0f"),
+            # Sweeps through every cutoff level
+            (16, "(float)i * 0.003f"),
+        ],
+    )
+    def test_matches_simulation(self, taps: int, rate: str, tmp_path: Path) -> None:
+        import numpy as np
+
+        from gen_dsp.graph.simulate import SimState, simulate
+
+        g = self._graph(taps)
+        values = np.array(self._run(g, tmp_path, rate), dtype=np.float32)
+        head, compiled = np.split(values, [2 * 3000])
+        idx, rates = head[0::2], head[1::2]
+        state = SimState(g)
+        state.set_buffer("smp", np.array(self._buffer(), dtype=np.float32))
+        expected = simulate(g, inputs={"in1": idx, "in2": rates}, state=state).outputs[
+            "out1"
+        ]
+        np.testing.assert_array_equal(compiled, expected)
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_scalar_fallback_matches(self, tmp_path: Path) -> None:
+        g = self._graph(24)
+        rate = "(float)i * 0.003f"
+        simd = self._run(g, tmp_path, rate)
+        scalar = self._run(g, tmp_path, rate, "-DGEN_DSP_SIMD_SCALAR")
+        assert simd == scalar
+
+    @pytest.mark.skipif(not _bench_enabled, reason="opt-in (GEN_DSP_BENCH=1)")
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_benchmark_vs_cubic(self, tmp_path: Path, record_property):
+        # One voice playing a 1 s sample at a 2.3x ratio
+        readers: dict[str, object] = {
+            "cubic": BufRead(id="y", buffer="smp", index="ph", interp="cubic"),
+            "sinc8": Resample(id="y", buffer="smp", index="ph", rate=2.3, taps=8),
+            "sinc16": Resample(id="y", buffer="smp", index="ph", rate=2.3),
+            "sinc32": Resample(id="y", buffer="smp", index="ph", rate=2.3, taps=32),
+        }
+        driver = """
+#include <cstdio>
+#include <ctime>
+int main() {
+    WdState* s = wd_create(48000.0f);
+    static float data[48000], in[48000], out[48000];
+    unsigned r = 1;
+    for (int i = 0; i < 48000; i++) {
+        r = r * 1664525u + 1013904223u;
+        data[i] = (float)(r >> 8) / 16777216.0f - 0.5f;
+    }
+    wd_set_buffer(s, 0, data, 48000);
+    double best = 1e30;
+    for (int rep = 0; rep < 5; rep++) {
+        timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int b = 0; b < 48000; b += 64) {
+            float* ins[1] = {in + b};
+            float* outs[1] = {out + b};
+            wd_perform(s, ins, outs, 64);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+        if (ns < best) best = ns;
+    }
+    printf("%.3f\\n", best / 48000.0);
+    wd_destroy(s);
+    return 0;
+}
+"""
+        report = {}
+        for label, reader in readers.items():
+            g = Graph(
+                name="wd",
+                inputs=[AudioInput(id="in1")],
+                outputs=[AudioOutput(id="out1", source="y")],
+                nodes=[
+                    Buffer(id="smp", size=48000),
+                    Accum(id="acc", incr=2.3, reset=0.0),
+                    Wrap(id="ph", a="acc", lo=0.0, hi=47000.0),
+                    reader,
+                ],
+            )
+            src = tmp_path / f"{label}.cpp"
+            exe = tmp_path / label
+            src.write_text(compile_graph(g) + driver)
+            subprocess.run(
+                ["g++", "-std=c++17", "-O2", "-o", str(exe), str(src)],
+                check=True,
+                capture_output=True,
+            )
+            run = subprocess.run(
+                [str(exe)], capture_output=True, text=True, timeout=300, check=True
+            )
+            report[label] = float(run.stdout.split()[0])
+            record_property(f"{label}_ns_per_sample", report[label])
+        print("\n" + ", ".join(f"{k} {v:.1f} ns/sample" for k, v in report.items()))
+
+
+class TestInt16Buffers:
+    """int16 buffers convert on read and saturate on write."""
+
+    _N = 2000
+
+    def _graph(self) -> Graph:
+        reads = ["r0", "r1", "r2", "cy", "wv", "lk", "sn", "wr"]
+        return Graph(
+            name="s16",
+            inputs=[AudioInput(id="in1"), AudioInput(id="in2")],
+            outputs=[
+                AudioOutput(id=f"out{k}", source=src) for k, src in enumerate(reads, 1)
+            ],
+            nodes=[
+                Buffer(id="smp", size=300, format="int16"),
+                Buffer(id="tab", size=64, format="int16"),
+                Buffer(id="sn_t", size=100, fill="sine", format="int16"),
+                BinOp(id="ix", op="mul", a="in1", b=300.0),
+                BufRead(id="r0", buffer="smp", index="ix"),
+                BufRead(id="r1", buffer="smp", index="ix", interp="linear"),
+                BufRead(id="r2", buffer="smp", index="ix", interp="cubic"),
+                Cycle(id="cy", buffer="tab", phase="in1"),
+                Wave(id="wv", buffer="tab", phase="in2"),
+                Lookup(id="lk", buffer="tab", index="in1"),
+                Cycle(id="sn", buffer="sn_t", phase="in1"),
+                BinOp(id="wi", op="mul", a="in1", b=64.0),
+                BinOp(id="big", op="mul", a="in2", b=3.0),
+                BufWrite(id="bw", buffer="tab", index="wi", value="big"),
+                Splat(id="sp", buffer="smp", index="ix", value="in2"),
+                BufRead(id="wr", buffer="tab", index="wi"),
+            ],
+            sample_rate=48000.0,
+        )
+
+    def test_storage_and_conversion(self) -> None:
+        code = compile_graph(self._graph())
+        assert "static inline int16_t s16_to_s16(float x) {" in code
+        # Inverse of the 1/32768 read scale
+        assert "    if (!(x == x)) x = 0.0f;" in code
+        assert "    x *= 32768.0f;" in code
+        assert "    return (int16_t)lrintf(x);" in code
+        assert "    int16_t* m_smp_buf;" in code
+        assert "calloc(66, sizeof(int16_t))" in code
+        assert "float r0 = ((float)smp_buf[r0_idx]) * (1.0f / 32768.0f);" in code
+        # Interpolate the raw integers, scale once
+        assert "float r1_s1 = (float)smp_buf[r1_i1];" in code
+        assert (
+            "float r1 = (r1_s0 + r1_frac * (r1_s1 - r1_s0)) * (1.0f / 32768.0f);"
+            in code
+        )
+        assert "float r2_ym1 = (float)smp_buf[r2_im1];" in code
+        assert "(float)tab_buf[cy_i0 + 1] - (float)tab_buf[cy_i0])) * (1.0f" in code
+        assert "self->m_sn_t_buf[_k] = s16_to_s16(sinf(" in code
+        assert "tab_buf[bw_idx] = s16_to_s16(big);" in code
+        assert "smp_buf[sp_idx] = s16_to_s16(" in code
+        assert "dst16[i] = s16_to_s16(data[i]);" in code
+        # No float view of int16 storage
+        assert "return self->m_smp_buf;" not in code
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_store_round_trips_every_value(self, tmp_path: Path) -> None:
+        """to_s16(k / 32768) == k for every int16 k; the rails saturate."""
+        driver = """
+#include <cstdio>
+int main() {
+    int bad = 0;
+    for (int k = -32768; k <= 32767; k++)
+        if (s16_to_s16((float)k * (1.0f / 32768.0f)) != k) bad++;
+    if (s16_to_s16(2.0f) != 32767 || s16_to_s16(-2.0f) != -32768) bad++;
+    if (s16_to_s16(__builtin_nanf("")) != 0) bad++;
+    printf("%d\\n", bad);
+    return 0;
+}
+"""
+        src = tmp_path / "rt.cpp"
+        exe = tmp_path / "rt"
+        src.write_text(compile_graph(self._graph()) + driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O2", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=True)
+        assert run.stdout.split() == ["0"]
+
+    def test_float_buffers_unchanged(self) -> None:
+        g = Graph(
+            name="f",
+            outputs=[AudioOutput(id="out1", source="r")],
+            nodes=[
+                Buffer(id="smp", size=64),
+                BufRead(id="r", buffer="smp", index=3.0),
+            ],
+        )
+        code = compile_graph(g)
+        assert "int16_t" not in code
+        assert "_to_s16" not in code
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_matches_simulation(self, tmp_path: Path) -> None:
+        import numpy as np
+
+        from gen_dsp.graph.simulate import SimState, simulate
+
+        g = self._graph()
+        n = self._N
+        driver = f"""
+#include <cstdio>
+static int buffer_index(const char* id) {{
+    for (int i = 0; i < s16_num_buffers(); i++)
+        if (strcmp(s16_buffer_name(i), id) == 0) return i;
+    return -1;
+}}
+int main() {{
+    S16State* s = s16_create(48000.0f);
+    static float data[300];
+    unsigned r = 7;
+    for (int i = 0; i < 300; i++) {{
+        r = r * 1664525u + 1013904223u;
+        data[i] = ((float)(r >> 8) / 16777216.0f - 0.5f) * 2.5f;
+    }}
+    data[5] = __builtin_nanf("");
+    s16_set_buffer(s, buffer_index("smp"), data, 300);
+    s16_set_buffer(s, buffer_index("tab"), data, 64);
+    static float a[{n}], b[{n}], o[8][{n}];
+    for (int i = 0; i < {n}; i++) {{
+        a[i] = (float)((i * 37) % 1024) / 1024.0f;
+        b[i] = -1.25f + (float)(i % 97) / 32.0f;
+    }}
+    for (int off = 0; off < {n}; off += 64) {{
+        float* ins[2] = {{a + off, b + off}};
+        float* outs[8];
+        for (int k = 0; k < 8; k++) outs[k] = o[k] + off;
+        s16_perform(s, ins, outs, {n} - off < 64 ? {n} - off : 64);
+    }}
+    for (int k = 0; k < 8; k++)
+        for (int i = 0; i < {n}; i++) printf("%.9g\\n", o[k][i]);
+    s16_destroy(s);
+    return 0;
+}}
+"""
+        src = tmp_path / "s16.cpp"
+        exe = tmp_path / "s16"
+        src.write_text(compile_graph(g) + driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O1", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=False)
+        assert run.returncode == 0, run.stderr
+        compiled = np.array(run.stdout.split(), dtype=np.float32).reshape(8, n)
+
+        r, data = 7, []
+        for _ in range(300):
+            r = (r * 1664525 + 1013904223) % 2**32
+            u = np.float32((r >> 8) / 16777216.0) - np.float32(0.5)
+            data.append(u * np.float32(2.5))
+        data[5] = np.float32(np.nan)
+        state = SimState(g)
+        state.set_buffer("smp", np.array(data, dtype=np.float32))
+        state.set_buffer("tab", np.array(data[:64], dtype=np.float32))
+        i = np.arange(n)
+        a = (((i * 37) % 1024) / 1024.0).astype(np.float32)
+        b = (-1.25 + (i % 97) / 32.0).astype(np.float32)
+        out = simulate(g, inputs={"in1": a, "in2": b}, state=state).outputs
+        expected = np.array([out[f"out{k}"] for k in range(1, 9)])
+        # Stored samples (plain reads) agree exactly; interpolation is
+        # float32 in C and float64 in simulate
+        np.testing.assert_array_equal(compiled[0], expected[0])
+        np.testing.assert_array_equal(compiled[7], expected[7])
+        np.testing.assert_allclose(compiled, expected, atol=1e-5)
+        # data spans +-1.25 and BufWrite stores up to +-3.6: both saturate
+        assert compiled[7].min() == np.float32(-1.0)
+        assert compiled[7].max() == np.float32(32767 / 32768)
+        # NaN stores as silence, not a full-scale step
+        assert not np.isnan(compiled).any()
+
+    @pytest.mark.skipif(not _bench_enabled, reason="opt-in (GEN_DSP_BENCH=1)")
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    @pytest.mark.parametrize(
+        ("size", "rate"),
+        [
+            # Near unit rate: reads hit cache, conversion cost shows
+            (1 << 22, 1.0),
+            # 128 MB of float32 read at 16x: every read is a new cache line
+            (1 << 25, 16.0),
+        ],
+    )
+    def test_benchmark_bandwidth(
+        self, size: int, rate: float, tmp_path: Path, record_property
+    ):
+        # Eight linear-interpolated voices playing through one buffer
+        from gen_dsp.graph.cost import graph_cost
+
+        voices = 8
+        driver = f"""
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+int main() {{
+    WdState* s = wd_create(48000.0f);
+    float* data = (float*)malloc({size} * sizeof(float));
+    for (unsigned i = 0; i < {size}u; i++)
+        data[i] = (float)((int)((i * 7919u) % 2001u) - 1000) * 0.001f;
+    wd_set_buffer(s, 0, data, {size});
+    static float in[4096], out[4096];
+    double best = 1e30;
+    for (int rep = 0; rep < 5; rep++) {{
+        timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int b = 0; b < 48000 * 4; b += 4096) {{
+            float* ins[1] = {{in}};
+            float* outs[1] = {{out}};
+            wd_perform(s, ins, outs, 4096);
+        }}
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+        if (ns < best) best = ns;
+    }}
+    printf("%.3f\\n", best / (48000.0 * 4));
+    wd_destroy(s);
+    free(data);
+    return 0;
+}}
+"""
+        report = {}
+        for fmt in ("float32", "int16"):
+            nodes: list = [Buffer(id="smp", size=size, format=fmt)]
+            prev = ""
+            for k in range(voices):
+                nodes += [
+                    Phasor(id=f"ph{k}", freq=rate * 48000.0 / size * (1 + 0.07 * k)),
+                    BinOp(id=f"ix{k}", op="mul", a=f"ph{k}", b=float(size - 2)),
+                    BufRead(id=f"rd{k}", buffer="smp", index=f"ix{k}", interp="linear"),
+                ]
+                if prev:
+                    nodes.append(BinOp(id=f"s{k}", op="add", a=prev, b=f"rd{k}"))
+                    prev = f"s{k}"
+                else:
+                    prev = f"rd{k}"
+            g = Graph(
+                name="wd",
+                inputs=[AudioInput(id="in1")],
+                outputs=[AudioOutput(id="out1", source=prev)],
+                nodes=nodes,
+            )
+            src = tmp_path / f"{fmt}.cpp"
+            exe = tmp_path / fmt
+            src.write_text(compile_graph(g) + driver)
+            subprocess.run(
+                ["g++", "-std=c++17", "-O2", "-o", str(exe), str(src)],
+                check=True,
+                capture_output=True,
+            )
+            run = subprocess.run(
+                [str(exe)], capture_output=True, text=True, timeout=300, check=True
+            )
+            ns = float(run.stdout.split()[0])
+            mem = graph_cost(g).buffer_bytes
+            report[fmt] = (ns, mem)
+            record_property(f"{fmt}_ns_per_sample", ns)
+            record_property(f"{fmt}_memory_bytes", mem)
+        print(
+            f"\n{voices} voices over {size} samples at {rate:g}x: "
+            f"float32 {report['float32'][0]:.1f} ns/sample "
+            f"({report['float32'][1] >> 20} MiB), "
+            f"int16 {report['int16'][0]:.1f} ns/sample "
+            f"({report['int16'][1] >> 20} MiB)"
+        )
+
+
+class TestGranulator:
+    """Granulator renders its live grains span by span between onsets."""
+
+    _SIZE = 1000
+    _TOTAL = 6000
+
+    def _graph(self, grains: int = 16, density: float = 2000.0) -> Graph:
+        return Graph(
+            name="gr",
+            inputs=[AudioInput(id="in1"), AudioInput(id="in2")],
+            outputs=[AudioOutput(id="out1", source="y")],
+            params=[
+                Param(name="dens", min=0.0, max=100000.0, default=density),
+                Param(name="jit", min=0.0, max=1.0, default=0.3),
+            ],
+            nodes=[
+                Buffer(id="smp", size=self._SIZE),
+                Granulator(
+                    id="y",
+                    buffer="smp",
+                    density="dens",
+                    pitch="in1",
+                    position="in2",
+                    jitter="jit",
+                    size=4.0,
+                    grains=grains,
+                ),
+            ],
+            sample_rate=48000.0,
+        )
+
+    def test_codegen(self) -> None:
+        code = compile_graph(self._graph())
+        assert code.count("static void gr_grain_render(") == 1
+        assert "static const float gr_grain_win[513] = {" in code
+        assert "    float m_y_gpos[16];" in code
+        assert "    uint32_t m_y_gstep[16];" in code
+        assert "if (i == y_end) { // Granulator y: up to 16 grains of smp" in code
+        assert "if (y_count < 16) {" in code
+        assert "y_gstep[y_count] = 0xffffffffu / (uint32_t)y_len;" in code
+        assert "float y = y_blk[i - y_base];" in code
+        # The source buffer gets table guards for the unwrapped linear read
+        assert "calloc(1002, sizeof(float))" in code
+
+    def test_pool_state_bytes(self) -> None:
+        from gen_dsp.graph.cost import graph_cost
+
+        small = graph_cost(self._graph(grains=32)).state_bytes
+        large = graph_cost(self._graph(grains=128)).state_bytes
+        # Five 4-byte fields per slot
+        assert large - small == 96 * 5 * 4
+
+    def _run(self, g: Graph, tmp_path: Path, block: int) -> list:
+        total = self._TOTAL
+        driver = f"""
+#include <cstdio>
+int main() {{
+    GrState* s = gr_create(48000.0f);
+    static float data[{self._SIZE}];
+    unsigned r = 7;
+    for (int i = 0; i < {self._SIZE}; i++) {{
+        r = r * 1664525u + 1013904223u;
+        data[i] = (float)(r >> 8) / 16777216.0f - 0.5f;
+    }}
+    gr_set_buffer(s, 0, data, {self._SIZE});
+    static float pitch[{total}], pos[{total}], out[{total}];
+    for (int i = 0; i < {total}; i++) {{
+        pitch[i] = -2.0f + (float)i * 0.0007f;
+        pos[i] = (float)i * 0.0003f;
+    }}
+    for (int b = 0; b < {total}; b += {block}) {{
+        int m = ({total} - b < {block}) ? {total} - b : {block};
+        float* ins[2] = {{pitch + b, pos + b}};
+        float* outs[1] = {{out + b}};
+        gr_perform(s, ins, outs, m);
+    }}
+    for (int i = 0; i < {total}; i++) printf("%.9g %.9g\\n", pitch[i], pos[i]);
+    for (int i = 0; i < {total}; i++) printf("%.9g\\n", out[i]);
+    gr_destroy(s);
+    return 0;
+}}
+"""
+        src = tmp_path / "gr.cpp"
+        exe = tmp_path / "gr"
+        src.write_text(compile_graph(g) + driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O1", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=False)
+        assert run.returncode == 0, run.stderr
+        return [float(v) for v in run.stdout.split()]
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    @pytest.mark.parametrize(
+        ("grains", "density", "block"),
+        [
+            (16, 2000.0, 64),
+            (16, 2000.0, 1),
+            (4, 2000.0, 50),
+            (8, 300.0, 7),
+            # Onsets every sample, most of them dropped by a one-slot pool
+            (1, 100000.0, 1000),
+            # Density zero: nothing starts
+            (16, 0.0, 64),
+        ],
+    )
+    def test_matches_simulation(
+        self, grains: int, density: float, block: int, tmp_path: Path
+    ) -> None:
+        import numpy as np
+
+        from gen_dsp.graph.simulate import SimState, simulate
+
+        g = self._graph(grains, density)
+        values = np.array(self._run(g, tmp_path, block), dtype=np.float32)
+        head, compiled = np.split(values, [2 * self._TOTAL])
+        # Same LCG as the C driver
+        r, data = 7, []
+        for _ in range(self._SIZE):
+            r = (r * 1664525 + 1013904223) % 2**32
+            data.append(np.float32((r >> 8) / 16777216.0) - np.float32(0.5))
+        state = SimState(g)
+        state.set_buffer("smp", np.array(data, dtype=np.float32))
+        expected = simulate(
+            g, inputs={"in1": head[0::2], "in2": head[1::2]}, state=state
+        ).outputs["out1"]
+        np.testing.assert_array_equal(compiled, expected)
+        assert compiled.any() == (density > 0.0)
+
+    @pytest.mark.skipif(not _bench_enabled, reason="opt-in (GEN_DSP_BENCH=1)")
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    @pytest.mark.parametrize("n", [32, 128])
+    def test_benchmark_vs_voices(self, n: int, tmp_path: Path, record_property):
+        # n grains of 100 ms, about n overlapping, against n always-running
+        # Phasor -> BufRead/Lookup voices built from primitives
+        voices: list = [Buffer(id="win", size=512)]
+        prev = ""
+        for k in range(n):
+            voices += [
+                Phasor(id=f"ph{k}", freq=10.0),
+                BinOp(id=f"ix{k}", op="mul", a=f"ph{k}", b=4800.0),
+                BinOp(id=f"at{k}", op="add", a=f"ix{k}", b=float(300 * k)),
+                BufRead(id=f"rd{k}", buffer="smp", index=f"at{k}", interp="linear"),
+                Lookup(id=f"wn{k}", buffer="win", index=f"ph{k}"),
+                BinOp(id=f"g{k}", op="mul", a=f"rd{k}", b=f"wn{k}"),
+            ]
+            if prev:
+                voices.append(BinOp(id=f"s{k}", op="add", a=prev, b=f"g{k}"))
+                prev = f"s{k}"
+            else:
+                prev = f"g{k}"
+        graphs = {
+            "granulator": (
+                [
+                    Granulator(
+                        id="y",
+                        buffer="smp",
+                        density=9.5 * n,
+                        position=0.2,
+                        jitter=0.5,
+                        size=100.0,
+                        grains=n,
+                    )
+                ],
+                "y",
+            ),
+            "voices": (voices, prev),
+        }
+        driver = """
+#include <cstdio>
+#include <ctime>
+int main() {
+    WdState* s = wd_create(48000.0f);
+    static float data[48000], in[48000], out[48000];
+    unsigned r = 1;
+    for (int i = 0; i < 48000; i++) {
+        r = r * 1664525u + 1013904223u;
+        data[i] = (float)(r >> 8) / 16777216.0f - 0.5f;
+    }
+    wd_set_buffer(s, 0, data, 48000);
+    double best = 1e30;
+    for (int rep = 0; rep < 5; rep++) {
+        timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int b = 0; b < 48000; b += 64) {
+            float* ins[1] = {in + b};
+            float* outs[1] = {out + b};
+            wd_perform(s, ins, outs, 64);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+        if (ns < best) best = ns;
+    }
+    printf("%.3f\\n", best / 48000.0);
+    wd_destroy(s);
+    return 0;
+}
+"""
+        report = {}
+        for label, (nodes, source) in graphs.items():
+            g = Graph(
+                name="wd",
+                inputs=[AudioInput(id="in1")],
+                outputs=[AudioOutput(id="out1", source=source)],
+                nodes=[Buffer(id="smp", size=48000), *nodes],
+            )
+            src = tmp_path / f"{label}.cpp"
+            exe = tmp_path / label
+            src.write_text(compile_graph(g) + driver)
+            subprocess.run(
+                ["g++", "-std=c++17", "-O2", "-o", str(exe), str(src)],
+                check=True,
+                capture_output=True,
+            )
+            run = subprocess.run(
+                [str(exe)], capture_output=True, text=True, timeout=300, check=True
+            )
+            report[label] = float(run.stdout.split()[0])
+            record_property(f"{label}_{n}_ns_per_sample", report[label])
+        print(
+            f"\n{n} grains: granulator {report['granulator']:.1f} ns/sample, "
+            f"primitive voices {report['voices']:.1f} ns/sample"
+        )
+
+
 class TestBatch3Compile:
     """Codegen and compilation tests for batch 3 operators."""
 
@@ -2450,3 +4553,433 @@ class TestADSRCompilation:
             )
             Path(f.name).unlink()
         assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+
+    def test_param_gate_uses_segment_renderer(self) -> None:
+        g = Graph(
+            name="adsr_seg",
+            outputs=[AudioOutput(id="out1", source="env")],
+            params=[Param(name="gate")],
+            nodes=[
+                ADSR(
+                    id="env",
+                    gate="gate",
+                    attack=10.0,
+                    decay=100.0,
+                    sustain=0.7,
+                    release=200.0,
+                ),
+            ],
+        )
+        code = compile_graph(g)
+        assert "static void adsr_seg_adsr_render(" in code
+        # Edge detection and segment lengths are hoisted before the loop
+        pre_loop = code.split("for (int i = 0; i < n; i++)")[0]
+        assert "float env_a_samps = fmaxf(" in pre_loop
+        assert "float env_blk[64];" in pre_loop
+        assert "adsr_seg_adsr_render(&env_phase, &env_output" in code
+        assert "float env = env_blk[i & 63];" in code
+
+    def test_audio_gate_stays_per_sample(self) -> None:
+        g = Graph(
+            name="adsr_audio",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="env")],
+            nodes=[
+                ADSR(
+                    id="env",
+                    gate="in1",
+                    attack=10.0,
+                    decay=100.0,
+                    sustain=0.7,
+                    release=200.0,
+                ),
+            ],
+        )
+        code = compile_graph(g)
+        assert "adsr_render(&env_phase" not in code
+        assert "float env = env_output;" in code
+
+    def test_idle_api(self) -> None:
+        g = Graph(
+            name="adsr_idle",
+            outputs=[AudioOutput(id="out1", source="env")],
+            params=[Param(name="gate")],
+            nodes=[
+                ADSR(
+                    id="env",
+                    gate="gate",
+                    attack=10.0,
+                    decay=100.0,
+                    sustain=0.7,
+                    release=200.0,
+                ),
+            ],
+        )
+        code = compile_graph(g)
+        assert "int adsr_idle_adsr_idle(AdsrIdleState* self) {" in code
+        assert "return (self->m_env_phase == 0) ? 1 : 0;" in code
+
+    def test_idle_api_without_envelopes(self, stereo_gain_graph: Graph) -> None:
+        code = compile_graph(stereo_gain_graph)
+        assert "int stereo_gain_adsr_idle(StereoGainState* self) {" in code
+        assert "return 0;" in code
+
+    @pytest.mark.skipif(
+        not shutil.which("g++"),
+        reason="g++ not found",
+    )
+    def test_segment_render_matches_simulation(self, tmp_path: Path) -> None:
+        import numpy as np
+
+        from gen_dsp.graph.simulate import SimState, simulate
+
+        g = Graph(
+            name="adsr_par",
+            outputs=[AudioOutput(id="out1", source="env")],
+            params=[Param(name="gate")],
+            nodes=[
+                ADSR(
+                    id="env",
+                    gate="gate",
+                    attack=1.1,
+                    decay=2.3,
+                    sustain=0.5,
+                    release=3.7,
+                ),
+            ],
+            sample_rate=48000.0,
+        )
+        # gate on for 3 blocks, off for 4 blocks, retrigger mid-release
+        gates = [1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0]
+        block = 100
+        driver = compile_graph(g) + "\n".join(
+            [
+                "#include <cstdio>",
+                "int main() {",
+                "    AdsrParState* s = adsr_par_create(48000.0f);",
+                "    float buf[100];",
+                "    float* outs[1] = {buf};",
+                f"    float gates[] = {{{', '.join(f'{v}f' for v in gates)}}};",
+                f"    for (int b = 0; b < {len(gates)}; b++) {{",
+                "        adsr_par_set_param(s, 0, gates[b]);",
+                f"        adsr_par_perform(s, nullptr, outs, {block});",
+                f'        for (int i = 0; i < {block}; i++) printf("%.9g\\n", buf[i]);',
+                "    }",
+                '    printf("%d\\n", adsr_par_adsr_idle(s));',
+                "    adsr_par_destroy(s);",
+                "    return 0;",
+                "}",
+                "",
+            ]
+        )
+        src = tmp_path / "adsr_par.cpp"
+        exe = tmp_path / "adsr_par"
+        src.write_text(driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O2", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        lines = subprocess.run(
+            [str(exe)], capture_output=True, text=True, check=True
+        ).stdout.split()
+        compiled = np.array([float(v) for v in lines[:-1]], dtype=np.float32)
+
+        state = SimState(g)
+        expected = []
+        for gate in gates:
+            state.set_param("gate", gate)
+            expected.append(simulate(g, n_samples=block, state=state).outputs["out1"])
+        np.testing.assert_allclose(compiled, np.concatenate(expected), atol=1e-5)
+        assert int(lines[-1]) == int(state.adsr_idle())
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_segment_render_under_param_ramp(self, tmp_path: Path) -> None:
+        """A ramping sustain is re-read by every one-sample param segment."""
+        import numpy as np
+
+        from gen_dsp.graph.simulate import SimState, simulate
+
+        g = Graph(
+            name="adsr_ramp",
+            outputs=[AudioOutput(id="out1", source="env")],
+            params=[Param(name="gate", default=1.0), Param(name="sus", default=0.5)],
+            nodes=[
+                ADSR(
+                    id="env",
+                    gate="gate",
+                    attack=0.2,
+                    decay=0.4,
+                    sustain="sus",
+                    release=3.7,
+                ),
+            ],
+            sample_rate=48000.0,
+        )
+        # (sustain target, ramp length) per block; the second ramp ends
+        # mid-chunk so the tail restarts rendering off the chunk grid
+        steps = [(0.5, 0), (0.9, 100), (0.3, 37), (0.3, 0)]
+        block = 100
+        driver = compile_graph(g) + "\n".join(
+            [
+                "#include <cstdio>",
+                "int main() {",
+                "    AdsrRampState* s = adsr_ramp_create(48000.0f);",
+                "    float buf[100];",
+                "    float* outs[1] = {buf};",
+                f"    for (int b = 0; b < {len(steps)}; b++) {{",
+                *[
+                    f"        if (b == {b}) adsr_ramp_set_param_ramp(s, 1, {t}f, {k});"
+                    for b, (t, k) in enumerate(steps)
+                ],
+                f"        adsr_ramp_perform(s, nullptr, outs, {block});",
+                f'        for (int i = 0; i < {block}; i++) printf("%.9g\\n", buf[i]);',
+                "    }",
+                "    adsr_ramp_destroy(s);",
+                "    return 0;",
+                "}",
+                "",
+            ]
+        )
+        src = tmp_path / "adsr_ramp.cpp"
+        exe = tmp_path / "adsr_ramp"
+        src.write_text(driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O2", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        out = subprocess.run(
+            [str(exe)], capture_output=True, text=True, check=True
+        ).stdout.split()
+        compiled = np.array([float(v) for v in out], dtype=np.float32)
+
+        state = SimState(g)
+        expected = []
+        for target, k in steps:
+            state.set_param_ramp("sus", target, k)
+            expected.append(simulate(g, n_samples=block, state=state).outputs["out1"])
+        np.testing.assert_allclose(compiled, np.concatenate(expected), atol=1e-5)
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_long_segment_drift_bound(self, tmp_path: Path) -> None:
+        """Closed-form ramps drift from simulate() by <= 2^-24 per chunk.
+
+        Each 64-sample render chunk restarts the ramp from a rounded float,
+        so the error grows with segment length and resets at its end.
+        """
+        import numpy as np
+
+        from gen_dsp.graph.simulate import SimState, simulate
+
+        sr = 48000
+        g = Graph(
+            name="adsr_long",
+            outputs=[AudioOutput(id="out1", source="env")],
+            params=[Param(name="gate")],
+            nodes=[
+                ADSR(
+                    id="env",
+                    gate="gate",
+                    attack=300.0,
+                    decay=2000.0,
+                    sustain=0.3,
+                    release=1000.0,
+                ),
+            ],
+            sample_rate=float(sr),
+        )
+        block = 256
+        on, off = 2600 * sr // 1000 // block, 1300 * sr // 1000 // block
+        driver = compile_graph(g) + "\n".join(
+            [
+                "#include <cstdio>",
+                "int main() {",
+                "    AdsrLongState* s = adsr_long_create(48000.0f);",
+                f"    float buf[{block}];",
+                "    float* outs[1] = {buf};",
+                f"    for (int b = 0; b < {on + off}; b++) {{",
+                f"        adsr_long_set_param(s, 0, b < {on} ? 1.0f : 0.0f);",
+                f"        adsr_long_perform(s, nullptr, outs, {block});",
+                f"        fwrite(buf, sizeof(float), {block}, stdout);",
+                "    }",
+                "    adsr_long_destroy(s);",
+                "    return 0;",
+                "}",
+                "",
+            ]
+        )
+        src = tmp_path / "adsr_long.cpp"
+        exe = tmp_path / "adsr_long"
+        src.write_text(driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O2", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        raw = subprocess.run([str(exe)], capture_output=True, check=True).stdout
+        compiled = np.frombuffer(raw, dtype=np.float32)
+
+        state = SimState(g)
+        state.set_param("gate", 1.0)
+        held = simulate(g, n_samples=on * block, state=state).outputs["out1"]
+        state.set_param("gate", 0.0)
+        released = simulate(g, n_samples=off * block, state=state).outputs["out1"]
+        expected = np.concatenate([held, released])
+
+        err = np.abs(compiled - expected)
+        longest = 2000 * sr // 1000
+        assert err.max() <= 2.0**-24 * (-(-longest // 64) + 4)
+        # The drift resets once a segment ends: sustain and idle are exact
+        assert compiled[on * block - 1] == expected[on * block - 1] == np.float32(0.3)
+        assert compiled[-1] == expected[-1] == 0.0
+
+
+class TestRangeGuards:
+    """Value-range analysis drops clamps, wraps and index guards."""
+
+    def _delay_graph(self, tap: float | str, interp: str = "linear") -> Graph:
+        return Graph(
+            name="rdelay",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="rd")],
+            params=[Param(name="t", default=10.0)],
+            nodes=[
+                DelayLine(id="dl", max_samples=64),
+                Clamp(id="ct", a="t", lo=0.0, hi=62.0),
+                DelayRead(id="rd", delay="dl", tap=tap, interp=interp),
+                DelayWrite(id="dw", delay="dl", value="in1"),
+            ],
+        )
+
+    def test_bounded_tap_single_wrap(self) -> None:
+        code = compile_graph(self._delay_graph("ct", "cubic"))
+        assert "% dl_len + dl_len" not in code
+        assert "int rd_i0 = dl_wr - rd_itap;" in code
+        assert "if (rd_i2 < 0) rd_i2 += dl_len;" in code
+
+    def test_unbounded_tap_double_modulo(self) -> None:
+        code = compile_graph(self._delay_graph("t"))
+        assert "int rd_i0 = ((dl_wr - rd_itap) % dl_len + dl_len) % dl_len;" in code
+
+    def test_tap_past_line_length_double_modulo(self) -> None:
+        """Cubic reads two samples behind the tap: 63 + 2 exceeds 64."""
+        code = compile_graph(self._delay_graph(63.0, "cubic"))
+        assert "% dl_len + dl_len" in code
+
+    def test_redundant_clamp_and_wrap(self) -> None:
+        g = Graph(
+            name="rclamp",
+            outputs=[AudioOutput(id="out1", source="wr")],
+            inputs=[AudioInput(id="in1")],
+            nodes=[
+                Clamp(id="ph", a="in1", lo=0.0, hi=0.5),
+                Clamp(id="cl", a="ph", lo=0.0, hi=1.0),
+                Wrap(id="wr", a="cl", lo=0.0, hi=1.0),
+            ],
+        )
+        code = compile_graph(g)
+        assert "float cl = ph;" in code
+        assert "float wr = cl;" in code
+        assert "fmodf" not in code
+
+    def test_bounded_table_reads_unclamped(self) -> None:
+        g = Graph(
+            name="rtable",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="sum")],
+            nodes=[
+                Buffer(id="tab", size=256, fill="sine"),
+                Clamp(id="ph", a="in1", lo=0.0, hi=0.99),
+                BinOp(id="pos", op="mul", a="ph", b=254.0),
+                BufRead(id="br", buffer="tab", index="pos", interp="linear"),
+                Lookup(id="lk", buffer="tab", index="ph"),
+                BinOp(id="sum", op="add", a="br", b="lk"),
+            ],
+        )
+        code = compile_graph(g)
+        assert "if (br_i0" not in code
+        assert "if (br_i1" not in code
+        assert "if (lk_ci" not in code
+
+    def test_check_ranges_emits_asserts(self) -> None:
+        g = self._delay_graph("ct")
+        assert "assert(" not in compile_graph(g)
+        code = compile_graph(g, check_ranges=True)
+        assert "#include <cassert>" in code
+        assert "assert(ct >= " in code
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_unguarded_code_matches_simulation(self, tmp_path: Path) -> None:
+        """Range-checked build runs clean and matches the simulator."""
+        import numpy as np
+
+        from gen_dsp.graph.simulate import SimState, simulate
+
+        g = Graph(
+            name="rpar",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="mix")],
+            params=[Param(name="t", default=20.0)],
+            nodes=[
+                Buffer(id="tab", size=128, fill="sine"),
+                Phasor(id="ph", freq=997.0),
+                BinOp(id="pos", op="mul", a="ph", b=125.0),
+                BufRead(id="br", buffer="tab", index="pos", interp="cubic"),
+                DelayLine(id="dl", max_samples=64),
+                Clamp(id="ct", a="t", lo=0.0, hi=61.5),
+                DelayRead(id="rd", delay="dl", tap="ct", interp="cubic"),
+                DelayWrite(id="dw", delay="dl", value="in1"),
+                BinOp(id="mix", op="add", a="br", b="rd"),
+            ],
+            sample_rate=48000.0,
+        )
+        n = 400
+        driver = compile_graph(g, check_ranges=True) + "\n".join(
+            [
+                "#include <cstdio>",
+                "int main() {",
+                "    RparState* s = rpar_create(48000.0f);",
+                f"    float in[{n}], out[{n}];",
+                f"    for (int i = 0; i < {n}; i++) in[i] = sinf(0.03f * (float)i);",
+                "    float* ins[1] = {in};",
+                "    float* outs[1] = {out};",
+                f"    rpar_perform(s, ins, outs, {n // 2});",
+                "    rpar_set_param(s, 0, 80.0f);",
+                f"    ins[0] = in + {n // 2};",
+                f"    outs[0] = out + {n // 2};",
+                f"    rpar_perform(s, ins, outs, {n - n // 2});",
+                f'    for (int i = 0; i < {n}; i++) printf("%.9g\\n", out[i]);',
+                "    rpar_destroy(s);",
+                "    return 0;",
+                "}",
+                "",
+            ]
+        )
+        src = tmp_path / "rpar.cpp"
+        exe = tmp_path / "rpar"
+        src.write_text(driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O1", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=False)
+        assert run.returncode == 0, run.stderr
+        compiled = np.array([float(v) for v in run.stdout.split()], dtype=np.float32)
+
+        x = np.sin(np.float32(0.03) * np.arange(n, dtype=np.float32))
+        x = x.astype(np.float32)
+        state = SimState(g)
+        a = simulate(g, inputs={"in1": x[: n // 2]}, state=state).outputs["out1"]
+        state.set_param("t", 80.0)
+        b = simulate(g, inputs={"in1": x[n // 2 :]}, state=state).outputs["out1"]
+        np.testing.assert_allclose(compiled, np.concatenate([a, b]), atol=1e-4)
@@ -0,0 +1,263 @@
+"""Tests for the static graph cost report."""
+
+from __future__ import annotations
+
+pydantic = __import__("pytest").importorskip("pydantic")
+import json
+from pathlib import Path
+
+import pytest
+
+from gen_dsp.core.cost import CostReport
+from gen_dsp.graph import (
+    FDN,
+    FIR,
+    AudioInput,
+    AudioOutput,
+    BinOp,
+    Buffer,
+    Granulator,
+    Graph,
+    MultiTapRead,
+    Param,
+    Resample,
+    UnaryOp,
+    WavetableOsc,
+    WindowMin,
+)
+from gen_dsp.graph.cli import main
+from gen_dsp.graph.cost import graph_cost, node_ops
+from gen_dsp.graph.models import Undersample
+
+
+class TestNodeOps:
+    def test_binop_classes(self) -> None:
+        assert node_ops(BinOp(id="a", op="add", a=1.0, b=2.0)).add == 1
+        assert node_ops(BinOp(id="m", op="mul", a=1.0, b=2.0)).mul == 1
+        assert node_ops(BinOp(id="d", op="div", a=1.0, b=2.0)).div == 1
+        assert node_ops(BinOp(id="p", op="pow", a=1.0, b=2.0)).math == 1
+
+    def test_unary_math(self) -> None:
+        assert node_ops(UnaryOp(id="s", op="sin", a=0.5)).math == 1
+        assert node_ops(UnaryOp(id="n", op="neg", a=0.5)).math == 0
+
+
+class TestGraphCost:
+    def test_stateless_graph(self, stereo_gain_graph: Graph) -> None:
+        report = graph_cost(stereo_gain_graph)
+        assert report.delay_bytes == 0
+        assert report.buffer_bytes == 0
+        assert report.ops.mul == 2
+
+    def test_delay_line_bytes(self, fbdelay_graph: Graph) -> None:
+        report = graph_cost(fbdelay_graph)
+        assert report.delay_bytes == 48000 * 4
+        assert report.total_bytes == report.state_bytes + 48000 * 4
+
+    def test_invariant_nodes_amortised(self, fbdelay_graph: Graph) -> None:
+        # sr_ms / tap / inv_mix depend only on params and literals
+        per_block = graph_cost(fbdelay_graph, block_size=1)
+        amortised = graph_cost(fbdelay_graph, block_size=64)
+        assert amortised.ops.flops < per_block.ops.flops
+
+    def test_buffer_bytes(self) -> None:
+        g = Graph(
+            name="buf",
+            outputs=[AudioOutput(id="out1", source="one")],
+            nodes=[
+                Buffer(id="table", size=1024),
+                BinOp(id="one", op="add", a=0.0, b=1.0),
+            ],
+        )
+        assert graph_cost(g).buffer_bytes == 1024 * 4
+
+    def test_int16_buffer_bytes(self) -> None:
+        g = Graph(
+            name="buf",
+            outputs=[AudioOutput(id="out1", source="one")],
+            nodes=[
+                Buffer(id="table", size=1024, format="int16"),
+                BinOp(id="one", op="add", a=0.0, b=1.0),
+            ],
+        )
+        assert graph_cost(g).buffer_bytes == 1024 * 2
+
+    def test_fdn_lines_and_ops(self) -> None:
+        def report(matrix: str, n: int) -> CostReport:
+            fdn = FDN(id="f", a=0.0, delays=[1000] * n, matrix=matrix)  # type: ignore[arg-type]
+            g = Graph(
+                name="fdn",
+                outputs=[AudioOutput(id="out1", source="f")],
+                nodes=[fdn],
+            )
+            return graph_cost(g)
+
+        r16 = report("hadamard", 16)
+        assert [(m.name, m.kind, m.bytes) for m in r16.items] == [
+            ("f", "delay", 16 * 1000 * 4)
+        ]
+        # N log2 N mix adds, not N^2 multiplies
+        assert r16.ops.mul == 17
+        assert report("hadamard", 16).ops.add == 2 * 16 + 16 * 4
+        assert report("householder", 16).ops.add == 2 * 16 + 2 * 16
+
+    def test_window_deque_bytes(self) -> None:
+        g = Graph(
+            name="pk",
+            outputs=[AudioOutput(id="out1", source="m")],
+            nodes=[WindowMin(id="m", a=0.0, window=240.0, max_window=2400)],
+        )
+        report = graph_cost(g)
+        # float value + uint32 arrival time per slot, independent of window
+        assert [(m.name, m.kind, m.bytes) for m in report.items] == [
+            ("m", "delay", 2400 * 8)
+        ]
+        assert report.ops.mem == 5
+
+    def test_multitap_ops(self) -> None:
+        def ops(taps: list, interp: str = "none") -> float:
+            return node_ops(
+                MultiTapRead(id="m", delay="dl", taps=taps, interp=interp)  # type: ignore[arg-type]
+            ).mem
+
+        assert ops([10.0, 20.0, 30.0]) == 3
+        # Fractional taps read two samples, repeated offsets are merged
+        assert ops([10.5, 20.0, 10.0], "linear") == 3
+        assert ops(["t", 20.0], "linear") == 4
+
+    def test_fir_ops_and_history(self) -> None:
+        g = Graph(
+            name="fir",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="b")],
+            nodes=[
+                Buffer(id="h", size=64),
+                FIR(id="a", a="in1", coeffs=[0.5] * 9),
+                FIR(id="b", a="a", coeffs="h"),
+            ],
+        )
+        report = graph_cost(g)
+        delays = [(m.name, m.bytes) for m in report.items if m.kind == "delay"]
+        assert delays == [("a", 2 * 9 * 4), ("b", 2 * 64 * 4)]
+        assert report.ops.mul == 9 + 64
+        assert node_ops(FIR(id="f", a=0.0, coeffs="h"), {"h": 32}).mul == 32
+
+    def test_resample_ops_scale_with_taps(self) -> None:
+        ops16 = node_ops(Resample(id="r", buffer="smp", index=0.0))
+        ops32 = node_ops(Resample(id="r", buffer="smp", index=0.0, taps=32))
+        assert ops16.mul == 2 * 16 + 2
+        assert ops32.mem - ops16.mem == 3 * 16
+
+    def test_granulator_ops_scale_with_pool(self) -> None:
+        ops32 = node_ops(Granulator(id="g", buffer="smp"))
+        ops128 = node_ops(Granulator(id="g", buffer="smp", grains=128))
+        assert ops32.mul == 3 * 32
+        assert ops128.mem - ops32.mem == 5 * 96
+
+    def test_wavetable_mip_bytes(self) -> None:
+        g = Graph(
+            name="wt",
+            outputs=[AudioOutput(id="out1", source="o1")],
+            nodes=[
+                Buffer(id="table", size=1024),
+                WavetableOsc(id="o1", buffer="table", freq=440.0),
+                WavetableOsc(id="o2", buffer="table", freq=220.0),
+            ],
+        )
+        # One shared pyramid: 10 levels of 1024 + 2 guard samples
+        mips = [m for m in graph_cost(g).items if m.name == "table_mip"]
+        assert len(mips) == 1
+        assert mips[0].bytes == 10 * 1026 * 4
+
+    def test_sample_rate_override(self, stereo_gain_graph: Graph) -> None:
+        assert graph_cost(stereo_gain_graph).sample_rate == 44100.0
+        assert graph_cost(stereo_gain_graph, sample_rate=96000.0).sample_rate == (
+            96000.0
+        )
+
+    def test_undersample_scales_inner_cost(self) -> None:
+        inner = Graph(
+            name="inner",
+            inputs=[AudioInput(id="x")],
+            outputs=[AudioOutput(id="y", source="s")],
+            nodes=[UnaryOp(id="s", op="tanh", a="x")],
+        )
+        outer = Graph(
+            name="outer",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="us")],
+            params=[Param(name="gain", min=0.0, max=1.0, default=0.5)],
+            nodes=[Undersample(id="us", graph=inner, factor=4, inputs=["in1"])],
+        )
+        report = graph_cost(outer)
+        assert report.ops.math == pytest.approx(0.25)
+        assert report.ops.mul > 0  # resampling filters
+
+
+class TestCostCli:
+    def test_cost_text(
+        self, tmp_path: Path, capsys: pytest.CaptureFixture[str]
+    ) -> None:
+        p = tmp_path / "gain.gdsp"
+        p.write_text(
+            """
+            graph gain {
+                in input
+                out output = scaled
+                param vol 0..2 = 1.0
+                scaled = input * vol
+            }
+            """
+        )
+        rc = main(["cost", str(p), "--target", "daisy"])
+        assert rc == 0
+        out = capsys.readouterr().out
+        assert "Cost estimate: gain" in out
+        assert "daisy" in out
+
+    def test_cost_json_budget(
+        self, tmp_path: Path, capsys: pytest.CaptureFixture[str]
+    ) -> None:
+        p = tmp_path / "delay.gdsp"
+        p.write_text(
+            """
+            graph dl {
+                in input
+                out output = rd
+                delay line 96000
+                rd = delay_read line (1000)
+                delay_write line (input)
+            }
+            """
+        )
+        rc = main(["cost", str(p), "--json", "--max-memory", "64K"])
+        assert rc == 1
+        captured = capsys.readouterr()
+        data = json.loads(captured.out)
+        assert data["memory"]["delay_bytes"] == 96000 * 4
+        assert data["budget_failures"]
+        assert "budget exceeded" in captured.err
+
+    def test_cost_target_capacity_warns(
+        self, tmp_path: Path, capsys: pytest.CaptureFixture[str]
+    ) -> None:
+        """Exceeding a target's memory warns; only given budgets fail."""
+        p = tmp_path / "big.gdsp"
+        p.write_text(
+            """
+            graph big {
+                in input
+                out output = rd
+                delay line 20000000
+                rd = delay_read line (1000)
+                delay_write line (input)
+            }
+            """
+        )
+        rc = main(["cost", str(p), "--json", "--target", "daisy"])
+        assert rc == 0
+        captured = capsys.readouterr()
+        data = json.loads(captured.out)
+        assert data["budget_failures"] == []
+        assert data["capacity_warnings"]
+        assert "warning: daisy: memory" in captured.err
@@ -46,15 +46,24 @@ from gen_dsp.graph.models import (
     DelayLine,
     DelayRead,
     DelayWrite,
+    FDN,
+    FIR,
     GateOut,
     GateRoute,
+    Granulator,
     Graph,
     History,
+    MovingAverage,
+    MultiTapRead,
     NamedConstant,
+    Resample,
     SampleRate,
     SinOsc,
     Subgraph,
     UnaryOp,
+    WavetableOsc,
+    WindowMax,
+    WindowMin,
 )
 
 
@@ -217,6 +226,16 @@ class TestParser:
         assert stmt.size == 512
         assert stmt.fill == "sine"
 
+    def test_buffer_decl_format(self):
+        g = self._parse_graph("graph t { buffer smp 48000 format=int16 fill=sine }")
+        stmt = g.body[0]
+        assert isinstance(stmt, ASTBufferDecl)
+        assert stmt.format == "int16"
+        assert stmt.fill == "sine"
+        graph = parse("graph t { buffer smp 64 format=int16 }")
+        buf = next(n for n in graph.nodes if isinstance(n, Buffer))
+        assert buf.format == "int16"
+
     def test_delay_decl(self):
         g = self._parse_graph("graph t { delay dly 96000 }")
         stmt = g.body[0]
@@ -451,6 +470,110 @@ class TestCompiler:
         dr = [n for n in graph.nodes if isinstance(n, DelayRead)][0]
         assert dr.interp == "linear"
 
+    def test_delay_taps(self):
+        graph = parse("""
+        graph er {
+            in input
+            out output = early
+            param size 0..4000 = 1200
+            delay dl 48000
+            delay_write dl (input)
+            early = delay_taps dl (331, 0.8, size, 0.5, 2210.5, -0.3, interp=linear)
+        }
+        """)
+        mt = next(n for n in graph.nodes if isinstance(n, MultiTapRead))
+        assert mt.delay == "dl"
+        assert mt.taps == [331.0, "size", 2210.5]
+        assert mt.gains == [0.8, 0.5, -0.3]
+        assert mt.interp == "linear"
+
+    def test_delay_taps_odd_args(self):
+        with pytest.raises(GDSPCompileError, match="delay_taps"):
+            parse("""
+            graph er {
+                in input
+                out output = early
+                delay dl 48000
+                delay_write dl (input)
+                early = delay_taps dl (331, 0.8, 500)
+            }
+            """)
+
+    def test_fir(self):
+        graph = parse("""
+        graph xo {
+            in input
+            out lo = smooth
+            out hi = shaped
+            buffer cab 64
+            smooth = fir(input, 0.25, 0.5, 0.25)
+            shaped = fir(input, cab)
+        }
+        """)
+        firs = {n.id: n for n in graph.nodes if isinstance(n, FIR)}
+        assert firs["smooth"].coeffs == [0.25, 0.5, 0.25]
+        assert firs["shaped"].coeffs == "cab"
+
+    def test_fir_negative_taps(self):
+        graph = parse("""
+        graph hp {
+            in input
+            out output = y
+            y = fir(input, -0.5, 1, -0.5)
+        }
+        """)
+        fir = next(n for n in graph.nodes if isinstance(n, FIR))
+        assert fir.coeffs == [-0.5, 1.0, -0.5]
+
+    def test_fir_rejects_runtime_taps(self):
+        with pytest.raises(GDSPCompileError, match="fir taps"):
+            parse("""
+            graph hp {
+                in input
+                out output = y
+                param g 0..1 = 0.5
+                y = fir(input, 0.5, g)
+            }
+            """)
+
+    def test_resample(self):
+        graph = parse("""
+        graph varispeed {
+            in pos
+            out a = hq
+            out b = lq
+            param rate 0.25..8 = 1
+            buffer smp 48000
+            hq = resample(smp, pos, rate, 32)
+            lq = resample(smp, pos, rate=2, taps=8)
+        }
+        """)
+        rs = {n.id: n for n in graph.nodes if isinstance(n, Resample)}
+        assert rs["hq"].rate == "rate"
+        assert rs["hq"].taps == 32
+        assert rs["lq"].rate == 2.0
+        assert rs["lq"].taps == 8
+
+    def test_granulator(self):
+        graph = parse("""
+        graph clouds {
+            in pos
+            out a = dense
+            out b = sparse
+            param dens 0..500 = 40
+            buffer smp 48000
+            dense = granulator(smp, dens, 1, pos, 0.1, 80, grains=128)
+            sparse = granulator(smp, 5)
+        }
+        """)
+        gs = {n.id: n for n in graph.nodes if isinstance(n, Granulator)}
+        assert gs["dense"].density == "dens"
+        assert gs["dense"].position == "pos"
+        assert gs["dense"].size == 80.0
+        assert gs["dense"].grains == 128
+        assert gs["sparse"].pitch == 1.0
+        assert gs["sparse"].grains == 32
+
     def test_buffer_cycle(self):
         graph = parse("""
         graph wt {
@@ -468,6 +591,76 @@ class TestCompiler:
         assert len(cyc) == 1
         assert cyc[0].buffer == "tbl"
 
+    def test_fdn(self):
+        graph = parse("""
+        graph rv {
+            in input
+            out output = wet
+            param fb 0..1 = 0.8
+            wet = fdn(input, 1031, 1327, 1523, feedback=fb, damping=0.3, matrix=householder)
+        }
+        """)
+        fdn = [n for n in graph.nodes if isinstance(n, FDN)]
+        assert len(fdn) == 1
+        assert fdn[0].delays == [1031, 1327, 1523]
+        assert fdn[0].feedback == "fb"
+        assert fdn[0].damping == 0.3
+        assert fdn[0].matrix == "householder"
+
+    def test_fdn_rejects_expression_lengths(self):
+        with pytest.raises(GDSPCompileError, match="literal integers"):
+            parse("""
+            graph rv {
+                in input
+                out output = wet
+                wet = fdn(input, 1031, input)
+            }
+            """)
+
+    def test_window_extrema(self):
+        graph = parse("""
+        graph pk {
+            in input
+            out hi = peak
+            out lo = trough
+            param look 1..480 = 240
+            peak = window_max(abs(input), look, 480)
+            trough = window_min(input, 64)
+        }
+        """)
+        peak = [n for n in graph.nodes if isinstance(n, WindowMax)]
+        trough = [n for n in graph.nodes if isinstance(n, WindowMin)]
+        assert peak[0].window == "look"
+        assert peak[0].max_window == 480
+        assert trough[0].window == 64.0
+        assert trough[0].max_window == 4800
+
+    def test_moving_average(self):
+        graph = parse("""
+        graph meter {
+            in input
+            out output = level
+            level = moving_average(input, 19200, mode=rms)
+        }
+        """)
+        ma = [n for n in graph.nodes if isinstance(n, MovingAverage)]
+        assert ma[0].window == 19200
+        assert ma[0].mode == "rms"
+
+    def test_buffer_wavetable(self):
+        graph = parse("""
+        graph wt {
+            out output = val
+            param freq 20..20000 = 440
+            buffer tbl 2048
+            val = wavetable(tbl, freq)
+        }
+        """)
+        wt = [n for n in graph.nodes if isinstance(n, WavetableOsc)]
+        assert len(wt) == 1
+        assert wt[0].buffer == "tbl"
+        assert wt[0].freq == "freq"
+
     def test_control_rate(self):
         graph = parse("""
         graph synth (control=64) {
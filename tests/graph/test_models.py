@@ -31,15 +31,20 @@ from gen_dsp.graph import (
     DelayWrite,
     Delta,
     Elapsed,
+    FDN,
+    FIR,
     Fold,
     GateOut,
     GateRoute,
+    Granulator,
     Graph,
     History,
     Latch,
     Lookup,
     Mix,
+    MovingAverage,
     MulAccum,
+    MultiTapRead,
     NamedConstant,
     Noise,
     OnePole,
@@ -49,6 +54,7 @@ from gen_dsp.graph import (
     Phasor,
     PulseOsc,
     RateDiv,
+    Resample,
     SampleHold,
     SampleRate,
     SawOsc,
@@ -64,6 +70,9 @@ from gen_dsp.graph import (
     TriOsc,
     UnaryOp,
     Wave,
+    WavetableOsc,
+    WindowMax,
+    WindowMin,
     Wrap,
 )
 
@@ -155,6 +164,50 @@ class TestNodeConstruction:
         n = DelayWrite(id="dw", delay="dl", value="input_node")
         assert n.value == "input_node"
 
+    def test_fdn(self) -> None:
+        n = FDN(id="f", a="in1", delays=[101, 143, 165, 177])
+        assert n.op == "fdn"
+        assert n.feedback == 0.7
+        assert n.damping == 0.0
+        assert n.matrix == "hadamard"
+
+    def test_window_extrema(self) -> None:
+        n = WindowMax(id="m", a="in1", window=240.0)
+        assert n.op == "window_max"
+        assert n.max_window == 4800
+        assert WindowMin(id="m", a="in1", window="w", max_window=64).op == "window_min"
+
+    def test_moving_average(self) -> None:
+        n = MovingAverage(id="m", a="in1")
+        assert n.op == "moving_average"
+        assert n.window == 4800
+        assert n.mode == "mean"
+
+    def test_multi_tap_read(self) -> None:
+        n = MultiTapRead(id="m", delay="dl", taps=[10.0, "t"])
+        assert n.op == "multi_tap_read"
+        assert n.gains == []
+        assert n.interp == "none"
+
+    def test_fir(self) -> None:
+        n = FIR(id="f", a="in1", coeffs=[0.5, 0.25])
+        assert n.op == "fir"
+        assert n.coeffs == [0.5, 0.25]
+        assert FIR(id="f", a="in1", coeffs="h").coeffs == "h"
+
+    def test_resample(self) -> None:
+        n = Resample(id="r", buffer="smp", index="pos")
+        assert n.op == "resample"
+        assert n.rate == 1.0
+        assert n.taps == 16
+
+    def test_granulator(self) -> None:
+        n = Granulator(id="g", buffer="smp", position="pos")
+        assert n.op == "granulator"
+        assert n.density == 10.0
+        assert n.size == 50.0
+        assert n.grains == 32
+
     def test_phasor(self) -> None:
         n = Phasor(id="p", freq=440.0)
         assert n.freq == 440.0
@@ -303,6 +356,11 @@ class TestNodeConstruction:
         restored = Buffer.model_validate(d)
         assert restored.fill == "sine"
 
+    def test_buffer_format(self) -> None:
+        assert Buffer(id="buf").format == "float32"
+        n = Buffer(id="buf", size=512, format="int16")
+        assert Buffer.model_validate(n.model_dump()).format == "int16"
+
     def test_bufread(self) -> None:
         n = BufRead(id="br", buffer="buf", index=0.0)
         assert n.op == "buf_read"
@@ -549,6 +607,23 @@ class TestJsonRoundTrip:
         assert isinstance(rd, DelayRead)
         assert rd.interp == "cubic"
 
+    def test_fdn_roundtrip(self) -> None:
+        g = Graph(
+            name="fdn_test",
+            outputs=[AudioOutput(id="out1", source="f")],
+            nodes=[
+                FDN(
+                    id="f",
+                    a=0.0,
+                    delays=[101, 143, 165],
+                    damping=0.2,
+                    matrix="householder",
+                )
+            ],
+        )
+        restored = Graph.model_validate_json(g.model_dump_json())
+        assert restored == g
+
 
 # ---------------------------------------------------------------------------
 # Discriminated union deserialization
@@ -1052,6 +1127,12 @@ class TestBatch2Ops:
         assert n.buffer == "buf"
         assert n.index == 0.5
 
+    def test_wavetable_construction(self) -> None:
+        n = WavetableOsc(id="wt", buffer="buf", freq="freq")
+        assert n.op == "wavetable"
+        assert n.buffer == "buf"
+        assert n.freq == "freq"
+
     def test_batch2_json_roundtrip(self) -> None:
         g = Graph(
             name="batch2_types",
@@ -189,7 +189,7 @@ class TestCompileNoControlRate:
         """control_interval=0 produces identical code to the default path."""
         g = _simple_graph(control_interval=0)
         code = compile_graph(g)
-        assert "for (int i = 0; i < n; i++)" in code
+        assert "for (int i = _s; i < _e; i++)" in code
         assert "_cb" not in code
         assert "_block_end" not in code
 
@@ -197,7 +197,7 @@ class TestCompileNoControlRate:
         """control_interval>0 but empty control_nodes -> single loop."""
         g = _simple_graph(control_interval=64, control_nodes=[])
         code = compile_graph(g)
-        assert "for (int i = 0; i < n; i++)" in code
+        assert "for (int i = _s; i < _e; i++)" in code
         assert "_cb" not in code
 
 
@@ -221,11 +221,11 @@ class TestCompileTwoTier:
 
     def test_outer_loop_present(self, two_tier_graph):
         code = compile_graph(two_tier_graph)
-        assert "for (int _cb = 0; _cb < n; _cb += 64)" in code
+        assert "for (int _cb = _s; _cb < _e; _cb += 64)" in code
 
     def test_block_end_calculation(self, two_tier_graph):
         code = compile_graph(two_tier_graph)
-        assert "int _block_end = (_cb + 64 < n) ? _cb + 64 : n;" in code
+        assert "int _block_end = (_cb + 64 < _e) ? _cb + 64 : _e;" in code
 
     def test_inner_loop_present(self, two_tier_graph):
         code = compile_graph(two_tier_graph)
@@ -234,7 +234,7 @@ class TestCompileTwoTier:
     def test_control_node_between_loops(self, two_tier_graph):
         """Control-rate SmoothParam should appear between outer and inner loops."""
         code = compile_graph(two_tier_graph)
-        outer_pos = code.index("for (int _cb = 0;")
+        outer_pos = code.index("for (int _cb = _s;")
         inner_pos = code.index("for (int i = _cb;")
         # smoother computation should be between outer and inner
         smoother_pos = code.index("float smoother =")
@@ -264,7 +264,7 @@ class TestCompileTwoTier:
             ],
         )
         code = compile_graph(g)
-        outer_pos = code.index("for (int _cb = 0;")
+        outer_pos = code.index("for (int _cb = _s;")
         # inv should be hoisted before the outer loop
         inv_pos = code.index("float inv = a + b;")
         assert inv_pos < outer_pos
@@ -317,7 +317,7 @@ class TestCompileTwoTier:
         )
         code = compile_graph(g)
         # Should compile without error and have two-tier structure
-        assert "for (int _cb = 0;" in code
+        assert "for (int _cb = _s;" in code
         assert "for (int i = _cb;" in code
 
 
@@ -705,7 +705,7 @@ class TestEdgeCases:
         # loop is generated (since ctrl_rate_ids would be empty after removing
         # invariant nodes).
         # This is correct behavior: invariant nodes override control-rate classification.
-        assert "for (int i = 0; i < n; i++)" in code
+        assert "for (int i = _s; i < _e; i++)" in code
 
     def test_control_interval_greater_than_n(self):
         """When control_interval > n, single control block processes all samples."""
@@ -741,7 +741,7 @@ class TestEdgeCases:
             ],
         )
         code = compile_graph(g)
-        assert "for (int _cb = 0; _cb < n; _cb += 1)" in code
+        assert "for (int _cb = _s; _cb < _e; _cb += 1)" in code
 
     def test_generator_no_inputs_with_control_rate(self):
         """Generator (no audio inputs) with control-rate nodes should work."""
@@ -858,7 +858,7 @@ class TestControlRatePromotion:
         assert "inv_vol" in opt_graph.control_nodes
 
         code = compile_graph(opt_graph)
-        outer_pos = code.index("for (int _cb = 0;")
+        outer_pos = code.index("for (int _cb = _s;")
         inner_pos = code.index("for (int i = _cb;")
         inv_vol_pos = code.index("float inv_vol =")
         # inv_vol should be emitted between outer and inner loops (control-rate)
@@ -3,9 +3,13 @@
 from __future__ import annotations
 
 pydantic = __import__("pytest").importorskip("pydantic")
+import math
+from typing import Any
+
 import pytest
 
 from gen_dsp.graph import (
+    FIR,
     SVF,
     ADSR,
     Accum,
@@ -29,6 +33,7 @@ from gen_dsp.graph import (
     DelayWrite,
     Delta,
     Fold,
+    Granulator,
     Graph,
     History,
     Latch,
@@ -41,6 +46,7 @@ from gen_dsp.graph import (
     Phasor,
     PulseOsc,
     RateDiv,
+    Resample,
     SampleHold,
     SawOsc,
     Scale,
@@ -53,6 +59,7 @@ from gen_dsp.graph import (
     constant_fold,
     eliminate_cse,
     eliminate_dead_nodes,
+    infer_ranges,
     optimize_graph,
     promote_control_rate,
 )
@@ -553,6 +560,51 @@ class TestOptimizeGraph:
         assert "bw" not in ids
         assert "buf" not in ids
 
+    def test_fir_coeffs_keep_writers_alive(self) -> None:
+        """An FIR reading its taps from a buffer keeps that buffer's writers."""
+        g = Graph(
+            name="test",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="f")],
+            nodes=[
+                Buffer(id="h", size=16),
+                BufWrite(id="bw", buffer="h", index=0.0, value=0.5),
+                FIR(id="f", a="in1", coeffs="h"),
+            ],
+        )
+        ids = {n.id for n in eliminate_dead_nodes(g).nodes}
+        assert {"h", "bw", "f"} <= ids
+
+    def test_resample_keeps_writers_alive(self) -> None:
+        """Resample reads its buffer like BufRead does."""
+        g = Graph(
+            name="test",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="r")],
+            nodes=[
+                Buffer(id="smp", size=64),
+                BufWrite(id="bw", buffer="smp", index="in1", value=0.5),
+                Resample(id="r", buffer="smp", index="in1", rate=2.0),
+            ],
+        )
+        ids = {n.id for n in eliminate_dead_nodes(g).nodes}
+        assert {"smp", "bw", "r"} <= ids
+
+    def test_granulator_keeps_writers_alive(self) -> None:
+        """Granulator reads its buffer like BufRead does."""
+        g = Graph(
+            name="test",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="g")],
+            nodes=[
+                Buffer(id="smp", size=64),
+                BufWrite(id="bw", buffer="smp", index="in1", value=0.5),
+                Granulator(id="g", buffer="smp"),
+            ],
+        )
+        ids = {n.id for n in eliminate_dead_nodes(g).nodes}
+        assert {"smp", "bw", "g"} <= ids
+
     def test_bufsize_keeps_writers_alive(self) -> None:
         """BufSize also keeps BufWrite alive on the same buffer."""
         g = Graph(
@@ -1219,6 +1271,10 @@ class TestBatch3Folding:
             ("fixdenorm", 1.0, 1.0),
             ("fastsin", 0.0, 0.0),
             ("fastcos", 0.0, 1.0),
+            # roundf rounds halves away from zero
+            ("round", 0.5, 1.0),
+            ("round", 2.5, 3.0),
+            ("round", -2.5, -3.0),
         ],
     )
     def test_foldable_unary_folds(self, op: str, a: float, expected: float) -> None:
@@ -1270,3 +1326,120 @@ class TestADSROptimization:
         folded = constant_fold(g)
         env = {n.id: n for n in folded.nodes}["env"]
         assert isinstance(env, ADSR), "ADSR should NOT be constant-folded"
+
+
+# ---------------------------------------------------------------------------
+# Value-range analysis
+# ---------------------------------------------------------------------------
+
+
+class TestInferRanges:
+    def _ranges(
+        self,
+        *nodes: Any,
+        params: list[Param] | None = None,
+        inputs: list[AudioInput] | None = None,
+    ) -> dict[str, tuple[float, float]]:
+        g = Graph(
+            name="rng",
+            inputs=inputs or [],
+            outputs=[AudioOutput(id="out1", source=nodes[-1].id)],
+            params=params or [],
+            nodes=list(nodes),
+        )
+        return infer_ranges(g)
+
+    def test_constant_arithmetic(self) -> None:
+        r = self._ranges(
+            Constant(id="c", value=3.0),
+            BinOp(id="m", op="mul", a="c", b=-2.0),
+            BinOp(id="s", op="add", a="m", b=1.0),
+        )
+        assert r["m"] == (-6.0, -6.0)
+        assert r["s"] == (-5.0, -5.0)
+
+    def test_params_and_inputs_unbounded(self) -> None:
+        """set_param does not clamp, so declared param ranges are not trusted."""
+        r = self._ranges(
+            BinOp(id="m", op="mul", a="in1", b="p"),
+            params=[Param(name="p", min=0.0, max=1.0)],
+            inputs=[AudioInput(id="in1")],
+        )
+        assert r["m"] == (-math.inf, math.inf)
+
+    def test_phasor_in_unit_interval(self) -> None:
+        r = self._ranges(
+            Phasor(id="ph", freq=440.0),
+            BinOp(id="idx", op="mul", a="ph", b=512.0),
+        )
+        assert r["ph"][0] == 0.0
+        assert r["ph"][1] < 1.0
+        assert r["idx"][0] == 0.0 and r["idx"][1] < 512.0
+
+    def test_oscillators_bounded_for_any_freq(self) -> None:
+        """The phase wrap does not depend on the frequency or sample rate."""
+        r = self._ranges(
+            Phasor(id="ph", freq="in1"),
+            SawOsc(id="sw", freq=-6000.0),
+            TriOsc(id="tr", freq="in1"),
+            inputs=[AudioInput(id="in1")],
+        )
+        assert r["ph"] == (0.0, 1.0 - 2.0**-24)
+        assert r["sw"] == (-1.0, 1.0)
+        assert r["tr"] == (-1.0, 1.0)
+
+    def test_round_halves_away_from_zero(self) -> None:
+        r = self._ranges(
+            Clamp(id="c", a="in1", lo=0.5, hi=2.5),
+            UnaryOp(id="r", op="round", a="c"),
+            inputs=[AudioInput(id="in1")],
+        )
+        assert r["r"] == (1.0, 3.0)
+
+    def test_clamp_bounds_unknown_input(self) -> None:
+        r = self._ranges(
+            Clamp(id="c", a="in1", lo=-0.5, hi=0.5),
+            inputs=[AudioInput(id="in1")],
+        )
+        assert r["c"] == (-0.5, 0.5)
+
+    def test_wrap_and_compare(self) -> None:
+        r = self._ranges(
+            SinOsc(id="s", freq=2.0),
+            Wrap(id="w", a="s", lo=0.0, hi=0.25),
+            Compare(id="cmp", op="gt", a="in1", b="w"),
+            inputs=[AudioInput(id="in1")],
+        )
+        assert r["s"] == (-1.0, 1.0)
+        assert r["w"] == (0.0, 0.25)
+        assert r["cmp"] == (0.0, 1.0)
+
+    def test_division_by_interval_containing_zero(self) -> None:
+        r = self._ranges(
+            SinOsc(id="s", freq=2.0),
+            BinOp(id="d", op="div", a=1.0, b="s"),
+        )
+        assert r["d"] == (-math.inf, math.inf)
+
+    def test_fir_sums_scaled_input(self) -> None:
+        r = self._ranges(
+            Clamp(id="x", a="in1", lo=-1.0, hi=0.5),
+            FIR(id="f", a="x", coeffs=[0.5, -0.25, 1.0]),
+            inputs=[AudioInput(id="in1")],
+        )
+        # Each slot is a past input in [-1, 0.5] or its initial zero
+        assert r["f"] == (-1.625, 1.0)
+
+    def test_fir_buffer_coeffs_unbounded(self) -> None:
+        r = self._ranges(
+            Buffer(id="h", size=8),
+            FIR(id="f", a=0.5, coeffs="h"),
+        )
+        assert r["f"] == (-math.inf, math.inf)
+
+    def test_feedback_unbounded(self) -> None:
+        r = self._ranges(
+            History(id="h", input="acc"),
+            BinOp(id="acc", op="add", a="h", b=1.0),
+        )
+        assert r["acc"] == (-math.inf, math.inf)
@@ -199,3 +199,157 @@ class TestGraphToGdsp:
         assert "interp=linear" in source
         g2 = parse(source)
         assert g2.name == "buf_test"
+
+    def test_fdn_roundtrip(self):
+        source = graph_to_gdsp(
+            parse("""
+            graph rv {
+                in input
+                out output = wet
+                param fb 0..1 = 0.8
+                wet = fdn(input, 1031, 1327, 1523, 1871, feedback=fb, damping=0.25)
+            }
+            """)
+        )
+        assert "fdn(input, 1031, 1327, 1523, 1871, feedback=fb, damping=0.25)" in source
+        g2 = parse(source)
+        fdn = [n for n in g2.nodes if n.op == "fdn"]
+        assert len(fdn) == 1
+        assert fdn[0].delays == [1031, 1327, 1523, 1871]
+
+    def test_window_extrema_roundtrip(self):
+        source = graph_to_gdsp(
+            parse("""
+            graph pk {
+                in input
+                out output = peak
+                param look 1..480 = 240
+                peak = window_max(input, look, 480)
+            }
+            """)
+        )
+        assert "window_max(input, look, 480)" in source
+        peak = [n for n in parse(source).nodes if n.op == "window_max"]
+        assert peak[0].max_window == 480
+
+    def test_moving_average_roundtrip(self):
+        source = graph_to_gdsp(
+            parse("""
+            graph meter {
+                in input
+                out output = level
+                level = moving_average(input, 19200, mode=rms)
+            }
+            """)
+        )
+        assert "moving_average(input, 19200, mode=rms)" in source
+        ma = [n for n in parse(source).nodes if n.op == "moving_average"]
+        assert ma[0].mode == "rms"
+
+    def test_delay_taps_roundtrip(self):
+        source = graph_to_gdsp(
+            parse("""
+            graph er {
+                in input
+                out output = early
+                param size 0..4000 = 1200
+                delay dl 48000
+                delay_write dl (input)
+                early = delay_taps dl (331, 0.8, size, 0.5, interp=linear)
+            }
+            """)
+        )
+        assert "delay_taps dl (331, 0.8, size, 0.5, interp=linear)" in source
+        mt = [n for n in parse(source).nodes if n.op == "multi_tap_read"]
+        assert mt[0].taps == [331.0, "size"]
+        assert mt[0].interp == "linear"
+
+    def test_fir_roundtrip(self):
+        source = graph_to_gdsp(
+            parse("""
+            graph xo {
+                in input
+                out lo = smooth
+                out hi = shaped
+                buffer cab 64
+                smooth = fir(input, 0.25, -0.5, 0.125)
+                shaped = fir(input, cab)
+            }
+            """)
+        )
+        assert "fir(input, 0.25, -0.5, 0.125)" in source
+        assert "fir(input, cab)" in source
+        firs = {n.id: n for n in parse(source).nodes if n.op == "fir"}
+        assert firs["smooth"].coeffs == [0.25, -0.5, 0.125]
+        assert firs["shaped"].coeffs == "cab"
+
+    def test_resample_roundtrip(self):
+        source = graph_to_gdsp(
+            parse("""
+            graph vs {
+                in pos
+                out a = hq
+                out b = lq
+                param rate 0.25..8 = 1
+                buffer smp 4800
+                hq = resample(smp, pos, rate, taps=32)
+                lq = resample(smp, pos)
+            }
+            """)
+        )
+        assert "resample(smp, pos, rate, taps=32)" in source
+        assert "resample(smp, pos, 1)" in source
+        rs = {n.id: n for n in parse(source).nodes if n.op == "resample"}
+        assert rs["hq"].taps == 32
+        assert rs["lq"].taps == 16
+
+    def test_buffer_format_roundtrip(self):
+        source = graph_to_gdsp(
+            parse("""
+            graph s16 {
+                out output = val
+                buffer smp 4800 fill=sine format=int16
+                buffer plain 16
+                val = buf_read(smp, 3) + buf_read(plain, 1)
+            }
+            """)
+        )
+        assert "buffer smp 4800 fill=sine format=int16" in source
+        assert "buffer plain 16\n" in source
+        bufs = {n.id: n for n in parse(source).nodes if n.op == "buffer"}
+        assert bufs["smp"].format == "int16"
+        assert bufs["plain"].format == "float32"
+
+    def test_granulator_roundtrip(self):
+        source = graph_to_gdsp(
+            parse("""
+            graph clouds {
+                out a = dense
+                out b = plain
+                param dens 0..500 = 40
+                buffer smp 4800
+                dense = granulator(smp, dens, 1.5, 0.25, 0.1, 80, grains=128)
+                plain = granulator(smp)
+            }
+            """)
+        )
+        assert "granulator(smp, dens, 1.5, 0.25, 0.1, 80, grains=128)" in source
+        assert "granulator(smp, 10, 1, 0, 0, 50)" in source
+        gs = {n.id: n for n in parse(source).nodes if n.op == "granulator"}
+        assert gs["dense"].grains == 128
+        assert gs["plain"].grains == 32
+
+    def test_wavetable_roundtrip(self):
+        source = graph_to_gdsp(
+            parse("""
+            graph wt_test {
+                out output = val
+                param freq 1..20000 = 440
+                buffer wt 2048
+                val = wavetable(wt, freq)
+            }
+            """)
+        )
+        assert "wavetable(wt, freq)" in source
+        g2 = parse(source)
+        assert [n.op for n in g2.nodes if n.op == "wavetable"] == ["wavetable"]
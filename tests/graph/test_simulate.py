@@ -34,15 +34,20 @@ from gen_dsp.graph import (
     DelayWrite,
     Delta,
     Elapsed,
+    FDN,
+    FIR,
     Fold,
     GateOut,
     GateRoute,
+    Granulator,
     Graph,
     History,
     Latch,
     Lookup,
     Mix,
+    MovingAverage,
     MulAccum,
+    MultiTapRead,
     NamedConstant,
     Noise,
     OnePole,
@@ -52,6 +57,7 @@ from gen_dsp.graph import (
     Phasor,
     PulseOsc,
     RateDiv,
+    Resample,
     SampleHold,
     SampleRate,
     SawOsc,
@@ -67,6 +73,9 @@ from gen_dsp.graph import (
     TriOsc,
     UnaryOp,
     Wave,
+    WavetableOsc,
+    WindowMax,
+    WindowMin,
     Wrap,
 )
 from gen_dsp.graph.simulate import SimResult, SimState, simulate
@@ -101,6 +110,46 @@ class TestSimStateAPI:
         st.set_param("vol", 0.8)
         assert st.get_param("vol") == 0.8
 
+    def test_param_ramp(self) -> None:
+        g = Graph(
+            name="p",
+            params=[Param(name="vol", default=0.0)],
+            outputs=[AudioOutput(id="out1", source="v")],
+            nodes=[Pass(id="v", a="vol")],
+        )
+        st = SimState(g)
+        st.set_param_ramp("vol", 1.0, 4)
+        # Value is only advanced while samples are processed
+        assert st.get_param("vol") == 0.0
+        out = simulate(g, n_samples=6, state=st).outputs["out1"]
+        # The first sample keeps the starting value
+        np.testing.assert_allclose(out, [0.0, 0.25, 0.5, 0.75, 1.0, 1.0])
+
+    def test_param_ramp_zero_length_jumps(self) -> None:
+        g = Graph(name="p", params=[Param(name="vol", default=0.0)], outputs=[])
+        st = SimState(g)
+        st.set_param_ramp("vol", 0.7, 0)
+        assert st.get_param("vol") == 0.7
+
+    def test_set_param_cancels_ramp(self) -> None:
+        g = Graph(
+            name="p",
+            params=[Param(name="vol", default=0.0)],
+            outputs=[AudioOutput(id="out1", source="v")],
+            nodes=[Pass(id="v", a="vol")],
+        )
+        st = SimState(g)
+        st.set_param_ramp("vol", 1.0, 100)
+        st.set_param("vol", 0.3)
+        out = simulate(g, n_samples=3, state=st).outputs["out1"]
+        np.testing.assert_allclose(out, [0.3, 0.3, 0.3])
+
+    def test_param_ramp_unknown_raises(self) -> None:
+        g = Graph(name="p", outputs=[])
+        st = SimState(g)
+        with pytest.raises(KeyError, match="Unknown param"):
+            st.set_param_ramp("nope", 1.0, 8)
+
     def test_param_unknown_raises(self) -> None:
         g = Graph(name="p", outputs=[])
         st = SimState(g)
@@ -876,6 +925,77 @@ class TestDelayAndBuffer:
         r = simulate(g, n_samples=1, state=st)
         assert r.outputs["out1"][0] == pytest.approx(30.0)
 
+    def test_int16_buffer_quantizes(self) -> None:
+        g = Graph(
+            name="t",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="br")],
+            nodes=[
+                Buffer(id="buf", size=6, format="int16"),
+                BufRead(id="br", buffer="buf", index="in1"),
+            ],
+        )
+        st = SimState(g)
+        data = np.array([0.1, -0.25, 1.0, -1.5, 2.0, np.nan], dtype=np.float32)
+        st.set_buffer("buf", data)
+        stored = st.get_buffer("buf")
+        # x * 32768 rounded to nearest, saturated; NaN -> 0
+        assert stored[0] == np.float32(3277 / 32768)
+        assert stored[1] == np.float32(-8192 / 32768)
+        assert stored[2] == np.float32(32767 / 32768)
+        assert stored[3] == np.float32(-1.0)
+        assert stored[4] == np.float32(32767 / 32768)
+        assert stored[5] == 0.0
+        out = simulate(g, inputs={"in1": np.arange(6, dtype=np.float32)}, state=st)
+        np.testing.assert_array_equal(out.outputs["out1"], stored)
+
+    def test_int16_writes_saturate(self) -> None:
+        g = Graph(
+            name="t",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="br")],
+            nodes=[
+                Buffer(id="buf", size=4, format="int16"),
+                BufWrite(id="bw", buffer="buf", index=0.0, value="in1"),
+                Splat(id="sp", buffer="buf", index=1.0, value="in1"),
+                BufRead(id="br", buffer="buf", index=1.0),
+            ],
+        )
+        st = SimState(g)
+        inp = np.array([0.4, 0.4, 0.4, -3.0], dtype=np.float32)
+        out = simulate(g, inputs={"in1": inp}, state=st).outputs["out1"]
+        # "br" sorts before "sp": each read sees the previous sum
+        np.testing.assert_array_equal(
+            out,
+            np.array([0, 13107, 26214, 32767], dtype=np.float32) / np.float32(32768),
+        )
+        np.testing.assert_array_equal(st.get_buffer("buf")[:2], [-1.0, -1.0])
+
+    def test_int16_read_write_round_trips(self) -> None:
+        """Reading every int16 value and writing it back is the identity."""
+        g = Graph(
+            name="t",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="br")],
+            nodes=[
+                Buffer(id="src", size=65536, format="int16"),
+                Buffer(id="dst", size=65536, format="int16"),
+                BufRead(id="br", buffer="src", index="in1"),
+                BufWrite(id="bw", buffer="dst", index="in1", value="br"),
+                Splat(id="sp", buffer="src", index="in1", value=0.0),
+            ],
+        )
+        st = SimState(g)
+        every = np.arange(-32768, 32768, dtype=np.float32) / np.float32(32768)
+        st.set_buffer("src", every)
+        np.testing.assert_array_equal(st.get_buffer("src"), every)
+        idx = np.arange(65536, dtype=np.float32)
+        out = simulate(g, inputs={"in1": idx}, state=st).outputs["out1"]
+        np.testing.assert_array_equal(out, every)
+        np.testing.assert_array_equal(st.get_buffer("dst"), every)
+        # Splat of 0 rewrites each sample without drift
+        np.testing.assert_array_equal(st.get_buffer("src"), every)
+
     def test_bufread_linear_interp(self) -> None:
         g = Graph(
             name="t",
@@ -942,6 +1062,359 @@ class TestDelayAndBuffer:
         assert r.state.get_buffer("buf")[5] == pytest.approx(42.0)
 
 
+class TestFDNSimulate:
+    def _graph(self, matrix: str = "hadamard", feedback: float = 0.5) -> Graph:
+        delays = [7, 11, 13, 17] if matrix == "hadamard" else [7, 11, 13]
+        return Graph(
+            name="t",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="f")],
+            nodes=[
+                FDN(
+                    id="f",
+                    a="in1",
+                    delays=delays,
+                    feedback=feedback,
+                    matrix=matrix,  # type: ignore[arg-type]
+                )
+            ],
+        )
+
+    def test_first_echoes(self) -> None:
+        # An impulse reaches the output once per line, scaled by 1/N
+        inp = np.zeros(18, dtype=np.float32)
+        inp[0] = 1.0
+        out = simulate(self._graph(), inputs={"in1": inp}).outputs["out1"]
+        np.testing.assert_allclose(out[[7, 11, 13, 17]], 0.25)
+        assert not out[:7].any()
+
+    @pytest.mark.parametrize("matrix", ["hadamard", "householder"])
+    def test_orthogonal_mix_is_lossless(self, matrix: str) -> None:
+        # With unit feedback the energy held in the lines never changes
+        g = self._graph(matrix, feedback=1.0)
+        state = SimState(g)
+        inp = np.zeros(40, dtype=np.float32)
+        inp[0] = 1.0
+        simulate(g, inputs={"in1": inp}, state=state)
+        energy = float(np.sum(state._state["f.buf"].astype(np.float64) ** 2))
+        simulate(g, inputs={"in1": np.zeros(500, dtype=np.float32)}, state=state)
+        after = float(np.sum(state._state["f.buf"].astype(np.float64) ** 2))
+        assert after == pytest.approx(energy, rel=1e-4)
+
+    def test_reset_clears_lines(self) -> None:
+        g = self._graph()
+        state = SimState(g)
+        simulate(g, inputs={"in1": np.ones(30, dtype=np.float32)}, state=state)
+        state.reset()
+        out = simulate(g, inputs={"in1": np.zeros(30, dtype=np.float32)}, state=state)
+        assert not out.outputs["out1"].any()
+
+
+class TestWindowExtremaSimulate:
+    def _graph(self, cls: type = WindowMax, window: float | str = 9.0) -> Graph:
+        return Graph(
+            name="t",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="m")],
+            params=[Param(name="win", min=1.0, max=32.0, default=9.0)],
+            nodes=[cls(id="m", a="in1", window=window, max_window=32)],
+        )
+
+    @pytest.mark.parametrize(("cls", "ref"), [(WindowMax, np.max), (WindowMin, np.min)])
+    def test_matches_brute_force(self, cls: type, ref) -> None:
+        x = np.random.default_rng(7).standard_normal(400).astype(np.float32)
+        out = simulate(self._graph(cls), inputs={"in1": x}).outputs["out1"]
+        expected = [ref(x[max(0, i - 8) : i + 1]) for i in range(len(x))]
+        np.testing.assert_array_equal(out, expected)
+
+    def test_window_shrinks_immediately(self) -> None:
+        g = self._graph(window="win")
+        state = SimState(g)
+        x = np.zeros(20, dtype=np.float32)
+        x[0] = 1.0
+        simulate(g, inputs={"in1": x[:5]}, state=state)
+        state.set_param("win", 3.0)
+        out = simulate(g, inputs={"in1": x[5:]}, state=state).outputs["out1"]
+        assert not out.any()
+
+    def test_window_clamped_to_capacity(self) -> None:
+        x = np.zeros(40, dtype=np.float32)
+        x[0] = 1.0
+        out = simulate(self._graph(window=1000.0), inputs={"in1": x}).outputs["out1"]
+        assert out[31] == 1.0 and out[32] == 0.0
+        # A NaN window falls back to 1 sample, as fmaxf does in the C++
+        out = simulate(
+            self._graph(window="win"), inputs={"in1": x}, params={"win": math.nan}
+        ).outputs["out1"]
+        np.testing.assert_array_equal(out, x)
+
+    def test_reset_empties_deque(self) -> None:
+        g = self._graph()
+        state = SimState(g)
+        simulate(g, inputs={"in1": np.ones(5, dtype=np.float32)}, state=state)
+        state.reset()
+        out = simulate(g, inputs={"in1": -np.ones(5, dtype=np.float32)}, state=state)
+        np.testing.assert_array_equal(out.outputs["out1"], -1.0)
+
+
+class TestMovingAverageSimulate:
+    def _graph(self, mode: str = "mean") -> Graph:
+        return Graph(
+            name="t",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="m")],
+            nodes=[MovingAverage(id="m", a="in1", window=64, mode=mode)],  # type: ignore[arg-type]
+        )
+
+    @pytest.mark.parametrize("mode", ["mean", "rms"])
+    def test_matches_direct_sum(self, mode: str) -> None:
+        x = np.random.default_rng(3).standard_normal(1000).astype(np.float32)
+        out = simulate(self._graph(mode), inputs={"in1": x}).outputs["out1"]
+        terms = x.astype(np.float64) ** (2 if mode == "rms" else 1)
+        expected = np.convolve(terms, np.ones(64) / 64)[: len(x)]
+        if mode == "rms":
+            expected = np.sqrt(expected)
+        np.testing.assert_allclose(out, expected, atol=1e-5)
+
+    def test_restart_clears_residue(self) -> None:
+        # A plain running sum keeps the rounding residue of a loud burst
+        # forever; the restarted sum is exact once a window of silence wraps
+        x = np.zeros(64 * 12, dtype=np.float32)
+        x[: 64 * 8] = 1000.0 * np.random.default_rng(5).standard_normal(64 * 8)
+        out = simulate(self._graph(), inputs={"in1": x}).outputs["out1"]
+        assert not out[64 * 10 :].any()
+
+    def test_reset_clears_ring(self) -> None:
+        g = self._graph()
+        state = SimState(g)
+        simulate(g, inputs={"in1": np.ones(100, dtype=np.float32)}, state=state)
+        state.reset()
+        out = simulate(g, inputs={"in1": np.zeros(10, dtype=np.float32)}, state=state)
+        assert not out.outputs["out1"].any()
+
+
+class TestMultiTapReadSimulate:
+    def _graph(self, nodes: list, source: str) -> Graph:
+        return Graph(
+            name="t",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source=source)],
+            params=[Param(name="t", min=0.0, max=40.0, default=12.5)],
+            nodes=[
+                DelayLine(id="dl", max_samples=64),
+                *nodes,
+                DelayWrite(id="dw", delay="dl", value="in1"),
+            ],
+        )
+
+    @pytest.mark.parametrize(
+        ("taps", "interp"),
+        [
+            ([3.0, 17.0, 40.0], "none"),
+            ([2.5, 17.0, 40.25], "linear"),
+            (["t", 5.0, 62.5], "linear"),
+        ],
+    )
+    def test_matches_delay_reads(self, taps: list, interp: str) -> None:
+        x = np.random.default_rng(3).standard_normal(500).astype(np.float32)
+        gains = [0.5, -0.25, 0.125]
+        multi = self._graph(
+            [MultiTapRead(id="m", delay="dl", taps=taps, gains=gains, interp=interp)],  # type: ignore[arg-type]
+            "m",
+        )
+        reads: list = []
+        for k, (tap, gain) in enumerate(zip(taps, gains)):
+            reads.append(DelayRead(id=f"r{k}", delay="dl", tap=tap, interp=interp))  # type: ignore[arg-type]
+            reads.append(BinOp(id=f"g{k}", op="mul", a=f"r{k}", b=gain))
+        reads.append(BinOp(id="s1", op="add", a="g0", b="g1"))
+        reads.append(BinOp(id="s2", op="add", a="s1", b="g2"))
+        np.testing.assert_allclose(
+            simulate(multi, inputs={"in1": x}).outputs["out1"],
+            simulate(self._graph(reads, "s2"), inputs={"in1": x}).outputs["out1"],
+            atol=1e-6,
+        )
+
+    def test_reset_clears_line(self) -> None:
+        g = self._graph([MultiTapRead(id="m", delay="dl", taps=[1.0, 2.0])], "m")
+        state = SimState(g)
+        simulate(g, inputs={"in1": np.ones(10, dtype=np.float32)}, state=state)
+        state.reset()
+        out = simulate(g, inputs={"in1": np.zeros(5, dtype=np.float32)}, state=state)
+        assert not out.outputs["out1"].any()
+
+
+class TestFIRSimulate:
+    def _graph(self, nodes: list) -> Graph:
+        return Graph(
+            name="t",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="f")],
+            nodes=nodes,
+        )
+
+    @pytest.mark.parametrize("n", [1, 5, 8, 21])
+    def test_matches_convolution(self, n: int) -> None:
+        rng = np.random.default_rng(n)
+        x = rng.standard_normal(300).astype(np.float32)
+        coeffs = rng.uniform(-1.0, 1.0, n).astype(np.float32)
+        g = self._graph([FIR(id="f", a="in1", coeffs=coeffs.tolist())])
+        expected = np.convolve(x.astype(np.float64), coeffs)[: len(x)]
+        out = simulate(g, inputs={"in1": x}).outputs["out1"]
+        np.testing.assert_allclose(out, expected, atol=1e-5)
+
+    def test_buffer_coeffs(self) -> None:
+        g = self._graph([Buffer(id="h", size=3), FIR(id="f", a="in1", coeffs="h")])
+        state = SimState(g)
+        state.set_buffer("h", np.array([1.0, 0.0, -1.0], dtype=np.float32))
+        x = np.arange(1, 7, dtype=np.float32)
+        out = simulate(g, inputs={"in1": x}, state=state).outputs["out1"]
+        np.testing.assert_array_equal(out, [1.0, 2.0, 2.0, 2.0, 2.0, 2.0])
+
+    def test_reset_clears_history(self) -> None:
+        g = self._graph([FIR(id="f", a="in1", coeffs=[0.5, 0.5, 0.5])])
+        state = SimState(g)
+        simulate(g, inputs={"in1": np.ones(10, dtype=np.float32)}, state=state)
+        state.reset()
+        out = simulate(g, inputs={"in1": np.zeros(5, dtype=np.float32)}, state=state)
+        assert not out.outputs["out1"].any()
+
+
+class TestResampleSimulate:
+    def _graph(self, rate: float, taps: int = 16, size: int = 2000) -> Graph:
+        return Graph(
+            name="t",
+            inputs=[AudioInput(id="in1")],
+            outputs=[
+                AudioOutput(id="out1", source="y"),
+                AudioOutput(id="out2", source="c"),
+            ],
+            nodes=[
+                Buffer(id="smp", size=size),
+                Resample(id="y", buffer="smp", index="in1", rate=rate, taps=taps),
+                BufRead(id="c", buffer="smp", index="in1", interp="cubic"),
+            ],
+        )
+
+    @pytest.mark.parametrize("taps", [4, 16, 64])
+    def test_integer_index_passthrough(self, taps: int) -> None:
+        # At rate <= 1 the kernel is a sinc through the sample points
+        g = self._graph(1.0, taps, size=100)
+        data = np.random.default_rng(taps).uniform(-1, 1, 100).astype(np.float32)
+        state = SimState(g)
+        state.set_buffer("smp", data)
+        idx = np.arange(100, dtype=np.float32)
+        out = simulate(g, inputs={"in1": idx}, state=state).outputs["out1"]
+        np.testing.assert_allclose(out, data, atol=1e-6)
+
+    def test_clamped_edges(self) -> None:
+        g = self._graph(1.0, size=50)
+        state = SimState(g)
+        state.set_buffer("smp", np.full(50, 0.25, dtype=np.float32))
+        idx = np.array([-30.0, -0.5, 0.0, 0.3, 48.7, 49.0, 80.0], dtype=np.float32)
+        out = simulate(g, inputs={"in1": idx}, state=state).outputs["out1"]
+        # Unity-gain rows over a constant buffer, edge reads clamped
+        np.testing.assert_allclose(out, 0.25, atol=1e-6)
+
+    def test_attenuates_aliasing(self) -> None:
+        # A tone at 0.35 fs read at 2x folds to 0.3 fs; the cutoff tracks
+        # the ratio so Resample should suppress it, cubic lets it through
+        size = 4000
+        t = np.arange(size)
+        data = np.sin(2 * np.pi * 0.35 * t).astype(np.float32)
+        g = self._graph(2.0, 32, size=size)
+        state = SimState(g)
+        state.set_buffer("smp", data)
+        idx = (100.0 + 2.0 * np.arange(1500) + 0.37).astype(np.float32)
+        out = simulate(g, inputs={"in1": idx}, state=state).outputs
+        rms_sinc = float(np.sqrt(np.mean(out["out1"] ** 2)))
+        rms_cubic = float(np.sqrt(np.mean(out["out2"] ** 2)))
+        assert rms_cubic > 0.3
+        assert rms_sinc < 0.05 * rms_cubic
+
+    def test_passes_band_at_ratio(self) -> None:
+        # A tone at 0.1 fs read at 2x lands at 0.2 fs, inside the passband
+        size = 4000
+        data = np.sin(2 * np.pi * 0.1 * np.arange(size)).astype(np.float32)
+        g = self._graph(2.0, 32, size=size)
+        state = SimState(g)
+        state.set_buffer("smp", data)
+        idx = (100.0 + 2.0 * np.arange(1500) + 0.37).astype(np.float32)
+        out = simulate(g, inputs={"in1": idx}, state=state).outputs["out1"]
+        ref = np.sin(2 * np.pi * 0.1 * idx.astype(np.float64))
+        np.testing.assert_allclose(out, ref, atol=0.02)
+
+
+class TestGranulatorSimulate:
+    def _graph(
+        self, density: float, size: float, grains: int = 32, jitter: float = 0.0
+    ) -> Graph:
+        return Graph(
+            name="t",
+            outputs=[AudioOutput(id="out1", source="y")],
+            nodes=[
+                Buffer(id="smp", size=1000),
+                Granulator(
+                    id="y",
+                    buffer="smp",
+                    density=density,
+                    pitch=0.0,
+                    jitter=jitter,
+                    size=size,
+                    grains=grains,
+                ),
+            ],
+            sample_rate=48000.0,
+        )
+
+    def _run(self, g: Graph, n: int, state: SimState | None = None) -> np.ndarray:
+        if state is None:
+            state = SimState(g)
+            state.set_buffer("smp", np.ones(1000, dtype=np.float32))
+        return simulate(g, n_samples=n, state=state).outputs["out1"]
+
+    def test_hann_grain_on_constant_buffer(self) -> None:
+        # One 1 ms grain (48 samples) with the next onset far away
+        out = self._run(self._graph(1.0, 1.0), 100)
+        ref = 0.5 - 0.5 * np.cos(2 * np.pi * np.arange(48) / 48)
+        np.testing.assert_allclose(out[:48], ref, atol=1e-3)
+        assert not out[48:].any()
+
+    def test_onsets_at_exact_offsets(self) -> None:
+        # sr / 480 = a grain every 100 samples, each 48 samples long
+        out = self._run(self._graph(480.0, 1.0), 1000)
+        frames = out.reshape(10, 100)
+        np.testing.assert_array_equal(frames, np.tile(frames[0], (10, 1)))
+        assert frames[0, 1:48].all()
+        assert not frames[0, 48:].any()
+
+    def test_full_pool_drops_onsets(self) -> None:
+        # Onsets every sample but one slot: a new grain only once the
+        # 10 ms (480 sample) grain finishes
+        out = self._run(self._graph(48000.0, 10.0, grains=1), 1920)
+        frames = out.reshape(4, 480)
+        np.testing.assert_array_equal(frames, np.tile(frames[0], (4, 1)))
+        assert out.max() <= 1.0
+
+    def test_overlap_adds(self) -> None:
+        # Four Hann grains overlapping by 3/4 sum to a constant 2
+        out = self._run(self._graph(400.0, 10.0), 2400)
+        np.testing.assert_allclose(out[480:], 2.0, atol=1e-3)
+
+    def test_zero_density_is_silent(self) -> None:
+        assert not self._run(self._graph(0.0, 50.0), 500).any()
+
+    def test_jitter_is_deterministic(self) -> None:
+        g = self._graph(2000.0, 5.0, jitter=0.5)
+        state = SimState(g)
+        data = np.random.default_rng(3).uniform(-1, 1, 1000).astype(np.float32)
+        state.set_buffer("smp", data)
+        first = self._run(g, 300, state)
+        # Reset restarts the seed; it also clears the buffer
+        state.reset()
+        state.set_buffer("smp", data)
+        np.testing.assert_array_equal(self._run(g, 300, state), first)
+
+
 # ---------------------------------------------------------------------------
 # G. Integration tests using conftest fixtures
 # ---------------------------------------------------------------------------
@@ -1814,6 +2287,63 @@ class TestLookupSimulate:
         assert float(res.outputs["out1"][0]) == pytest.approx(40.0, rel=1e-4)
 
 
+class TestWavetableOscSimulate:
+    def _graph(self, freq: float = 100.0) -> Graph:
+        return Graph(
+            name="wt_test",
+            outputs=[AudioOutput(id="out1", source="wt")],
+            params=[Param(name="freq", min=0.0, max=20000.0, default=freq)],
+            nodes=[
+                Buffer(id="tab", size=256),
+                WavetableOsc(id="wt", buffer="tab", freq="freq"),
+            ],
+            sample_rate=25600.0,
+        )
+
+    def test_mip_levels_band_limited(self) -> None:
+        from gen_dsp.graph.simulate import _build_mips
+
+        table = 2.0 * np.arange(256) / 256.0 - 1.0
+        mips = _build_mips(table)
+        assert mips.shape == (8, 258)
+        np.testing.assert_allclose(mips[0, :256], table, atol=1e-7)
+        for level in range(1, 8):
+            spectrum = np.abs(np.fft.rfft(mips[level, :256]))
+            assert spectrum[(256 >> (level + 1)) + 1 :].max() < 1e-5
+            assert spectrum[256 >> (level + 1)] > 1e-3
+            # Guard samples wrap the level for the interpolation read
+            assert mips[level, 256] == mips[level, 0]
+            assert mips[level, 257] == mips[level, 1]
+
+    def test_low_freq_reads_source_table(self) -> None:
+        # 100 Hz at sr=25600 steps one table sample per output sample and
+        # sits entirely in level 0
+        g = self._graph()
+        state = SimState(g)
+        table = np.sin(2.0 * np.pi * np.arange(256) / 256.0)
+        state.set_buffer("tab", table)
+        res = simulate(g, n_samples=256, state=state)
+        np.testing.assert_allclose(res.outputs["out1"], table, atol=1e-6)
+
+    def test_high_freq_drops_harmonics(self) -> None:
+        # A square table at 3200 Hz (pos = 6.0) reads level 6 alone, which
+        # keeps harmonics 1-2: only the fundamental of the square survives
+        g = self._graph(freq=3200.0)
+        state = SimState(g)
+        state.set_buffer("tab", np.where(np.arange(256) < 128, 1.0, -1.0))
+        out = simulate(g, n_samples=256, state=state).outputs["out1"]
+        spectrum = np.abs(np.fft.rfft(out)) / 128.0
+        assert spectrum[32] == pytest.approx(4.0 / np.pi, rel=1e-2)
+        assert spectrum[33:].max() < 1e-2
+
+    def test_set_buffer_rebuilds_pyramid(self) -> None:
+        g = self._graph()
+        state = SimState(g)
+        state.set_buffer("tab", np.ones(256))
+        res = simulate(g, n_samples=4, state=state)
+        np.testing.assert_allclose(res.outputs["out1"], 1.0, atol=1e-9)
+
+
 # ---------------------------------------------------------------------------
 # P. Batch 3: reverse ops, p-comparisons, angle/sample convert, DSP safety,
 #             fast approx, splat
@@ -2160,3 +2690,25 @@ class TestADSRSimulation:
         retrig_level = float(res2.outputs["out1"][1])
         # Should continue from current output level, not restart from 0
         assert retrig_level > release_level
+
+    def test_adsr_idle(self) -> None:
+        """adsr_idle() reports True only once the release has finished."""
+        sr = 1000.0
+        g = self._make_adsr_graph(
+            attack_ms=10.0, decay_ms=20.0, sustain=0.5, release_ms=10.0
+        )
+        state = SimState(g, sample_rate=sr)
+        assert state.adsr_idle()
+
+        state.set_param("gate", 1.0)
+        simulate(g, n_samples=50, state=state, sample_rate=sr)
+        assert not state.adsr_idle()
+
+        state.set_param("gate", 0.0)
+        simulate(g, n_samples=2, state=state, sample_rate=sr)
+        assert not state.adsr_idle()
+        simulate(g, n_samples=20, state=state, sample_rate=sr)
+        assert state.adsr_idle()
+
+    def test_adsr_idle_without_envelopes(self, stereo_gain_graph: Graph) -> None:
+        assert not SimState(stereo_gain_graph).adsr_idle()
@@ -3,14 +3,22 @@
 from __future__ import annotations
 
 pydantic = __import__("pytest").importorskip("pydantic")
+import shutil
+import subprocess
+from pathlib import Path
+
+import numpy as np
 import pytest
 
 from gen_dsp.graph import (
     AudioInput,
     AudioOutput,
     BinOp,
+    Biquad,
+    Buffer,
     Graph,
     History,
+    Node,
     OnePole,
     Param,
     Subgraph,
@@ -19,6 +27,7 @@ from gen_dsp.graph import (
     optimize_graph,
     validate_graph,
 )
+from gen_dsp.graph.simulate import simulate
 
 
 def _onepole_graph() -> Graph:
@@ -520,3 +529,226 @@ class TestParamNamespaceCollision:
         )
         expanded = expand_subgraphs(graph)
         assert "sub__lpf" in {n.id for n in expanded.nodes}
+
+
+# ---------------------------------------------------------------------------
+# Outlined subgraphs
+# ---------------------------------------------------------------------------
+
+
+def _section_graph() -> Graph:
+    """12-node filter section with feedback, two outputs and two params."""
+    nodes: list[Node] = [History(id="fb", input="m3", init=0.0)]
+    prev = "sig"
+    for k in range(4):
+        nodes.append(
+            Biquad(id=f"bq{k}", a=prev, b0="g", b1=0.1, b2=0.05, a1=-0.3, a2=0.1)
+        )
+        nodes.append(BinOp(id=f"m{k}", op="mul", a=f"bq{k}", b="trim"))
+        prev = f"m{k}"
+    nodes.append(BinOp(id="fbs", op="mul", a="fb", b=0.25))
+    nodes.append(BinOp(id="wet", op="add", a="m3", b="fbs"))
+    nodes.append(BinOp(id="lvl", op="absdiff", a="bq0", b=0.0))
+    return Graph(
+        name="section",
+        inputs=[AudioInput(id="sig")],
+        outputs=[AudioOutput(id="y", source="wet"), AudioOutput(id="z", source="lvl")],
+        params=[Param(name="g", default=0.5), Param(name="trim", default=0.9)],
+        nodes=nodes,
+    )
+
+
+def _section_chain(count: int = 6) -> Graph:
+    nodes: list[Node] = []
+    prev = "in1"
+    for k in range(count):
+        nodes.append(
+            Subgraph(
+                id=f"s{k}",
+                graph=_section_graph(),
+                inputs={"sig": prev},
+                params={"g": "gain"},
+            )
+        )
+        prev = f"s{k}"
+    tap = f"s{min(2, count - 1)}__z"
+    nodes.append(BinOp(id="mix", op="add", a=prev, b=tap))
+    return Graph(
+        name="chain",
+        inputs=[AudioInput(id="in1")],
+        outputs=[AudioOutput(id="out1", source="mix")],
+        params=[Param(name="gain", default=0.7)],
+        nodes=nodes,
+    )
+
+
+class TestOutlinedSubgraphs:
+    def test_off_by_default(self) -> None:
+        code = compile_graph(_section_chain())
+        assert "Outlined subgraph" not in code
+        assert "s5__bq3" in code
+
+    def test_repeated_section_outlined_once(self) -> None:
+        code = compile_graph(_section_chain(), outline_subgraphs=True)
+        assert code.count("// -- Outlined subgraph") == 1
+        assert "struct ChainS0State {" in code
+        assert "s5__bq3" not in code
+        for k in range(6):
+            assert f"self->m_s{k}_inner = chain_s0_create(sr);" in code
+            assert (
+                f"chain_s0_perform(self->m_s{k}_inner, s{k}_ins, s{k}_outs, _cn);"
+                in code
+            )
+            assert f"chain_s0_set_param(self->m_s{k}_inner, 0, gain);" in code
+        # Unmapped params keep the inner default, so they are never written
+        assert "_inner, 1, " not in code
+        assert "float s2__z = s2_y[1][_j];" in code
+        assert len(code) < len(compile_graph(_section_chain()))
+
+    def test_small_or_rare_subgraphs_inlined(self) -> None:
+        # One instance saves nothing; a one-node graph is below the size floor
+        code = compile_graph(_section_chain(count=1), outline_subgraphs=True)
+        assert "Outlined subgraph" not in code
+        inner = _onepole_graph()
+        nodes: list[Node] = [
+            Subgraph(id=f"f{k}", graph=inner, inputs={"sig": "in1"}) for k in range(40)
+        ]
+        g = Graph(
+            name="many",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="f39")],
+            nodes=nodes,
+        )
+        assert "Outlined subgraph" not in compile_graph(g, outline_subgraphs=True)
+
+    def test_buffers_keep_subgraph_inlined(self) -> None:
+        """Inner buffers are exposed through the outer buffer API."""
+        inner = _section_graph()
+        inner = inner.model_copy(
+            update={"nodes": [*inner.nodes, Buffer(id="tab", size=8)]}
+        )
+        g = _section_chain()
+        nodes = [
+            n.model_copy(update={"graph": inner}) if isinstance(n, Subgraph) else n
+            for n in g.nodes
+        ]
+        code = compile_graph(
+            g.model_copy(update={"nodes": nodes}), outline_subgraphs=True
+        )
+        assert "Outlined subgraph" not in code
+
+    def test_expand_keeps_requested_nodes(self) -> None:
+        g = _section_chain(count=2)
+        flat = expand_subgraphs(g, keep={"s1"})
+        kept = [n for n in flat.nodes if isinstance(n, Subgraph)]
+        assert [n.id for n in kept] == ["s1"]
+        # The kept instance now reads the expanded output of s0
+        assert kept[0].inputs["sig"] == "s0__wet"
+
+    def test_chain_called_per_chunk(self) -> None:
+        """Without feedback, instances run over a whole chunk per call."""
+        code = compile_graph(_section_chain(), outline_subgraphs=True)
+        assert "for (int _c0 = _s; _c0 < _e; _c0 += 64) {" in code
+        assert "float* s0_ins[1] = {in1 + _c0};" in code
+        assert "float* s3_ins[1] = {s2_y[0]};" in code
+        assert "float s2__z = s2_y[1][_j];" in code
+        assert ", 1);" not in code.split("void chain_perform(")[1]
+
+    def test_feedback_into_call_stays_per_sample(self) -> None:
+        g = _section_chain(count=4)
+        fb = History(id="back", input="s3", init=0.0)
+        pre = BinOp(id="pre", op="add", a="in1", b="back")
+        nodes = [fb, pre, *g.nodes]
+        nodes[2] = nodes[2].model_copy(update={"inputs": {"sig": "pre"}})
+        code = compile_graph(
+            g.model_copy(update={"nodes": nodes}), outline_subgraphs=True
+        )
+        assert "chain_s0_perform(self->m_s0_inner, s0_ins, s0_outs, 1);" in code
+        assert "_c0" not in code
+
+    def test_varying_mapped_param_stays_per_sample(self) -> None:
+        g = _section_chain(count=4)
+        nodes = [
+            n.model_copy(update={"params": {"g": "in1"}})
+            if isinstance(n, Subgraph)
+            else n
+            for n in g.nodes
+        ]
+        code = compile_graph(
+            g.model_copy(update={"nodes": nodes}), outline_subgraphs=True
+        )
+        assert "_c0" not in code
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_matches_flattened_simulation(self, tmp_path: Path) -> None:
+        _assert_outlined_matches_simulation(_section_chain(), tmp_path)
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_staged_glue_matches_flattened_simulation(self, tmp_path: Path) -> None:
+        """Outer nodes, state and History around the calls cross chunk levels."""
+        section = _section_graph()
+        nodes: list[Node] = [
+            BinOp(id="pre", op="mul", a="in1", b="gain"),
+            OnePole(id="lp", a="pre", coeff=0.3),
+            History(id="h", input="post", init=0.0),
+            Subgraph(id="s0", graph=section, inputs={"sig": "lp"}, params={"g": 0.4}),
+            BinOp(id="post", op="add", a="s0", b="pre"),
+            BinOp(id="echo", op="mul", a="h", b=0.5),
+            Subgraph(id="s1", graph=section, inputs={"sig": "post"}),
+            Subgraph(id="s2", graph=section, inputs={"sig": "echo"}),
+            Subgraph(id="s3", graph=section, inputs={"sig": 0.25}),
+            BinOp(id="sum", op="add", a="s1__z", b="s2"),
+            BinOp(id="tail", op="add", a="sum", b="s3"),
+            BinOp(id="mix", op="add", a="tail", b="lp"),
+        ]
+        g = Graph(
+            name="chain",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="mix")],
+            params=[Param(name="gain", default=0.7)],
+            nodes=nodes,
+        )
+        code = compile_graph(g, outline_subgraphs=True)
+        assert "float lp_blk[64];" in code
+        _assert_outlined_matches_simulation(g, tmp_path)
+
+
+def _assert_outlined_matches_simulation(g: Graph, tmp_path: Path) -> None:
+    """Run the outlined build over several chunks and a partial one."""
+    n = 300
+    driver = compile_graph(g, outline_subgraphs=True) + "\n".join(
+        [
+            "#include <cstdio>",
+            "int main() {",
+            "    ChainState* s = chain_create(44100.0f);",
+            f"    float in[{n}], out[{n}];",
+            f"    for (int i = 0; i < {n}; i++) in[i] = (i % 23) * 0.05f - 0.5f;",
+            "    float* ins[1] = {in};",
+            "    float* outs[1] = {out};",
+            "    chain_set_param(s, 0, 0.6f);",
+            f"    chain_perform(s, ins, outs, {n});",
+            f'    for (int i = 0; i < {n}; i++) printf("%.9g\\n", out[i]);',
+            "    chain_destroy(s);",
+            "    return 0;",
+            "}",
+            "",
+        ]
+    )
+    src = tmp_path / "chain.cpp"
+    exe = tmp_path / "chain"
+    src.write_text(driver)
+    result = subprocess.run(
+        ["g++", "-std=c++17", "-O2", "-o", str(exe), str(src)],
+        capture_output=True,
+        text=True,
+        check=False,
+    )
+    assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+    out = subprocess.run(
+        [str(exe)], capture_output=True, text=True, check=True
+    ).stdout.split()
+    compiled = np.array([float(v) for v in out], dtype=np.float32)
+
+    x = ((np.arange(n) % 23) * 0.05 - 0.5).astype(np.float32)
+    expected = simulate(g, inputs={"in1": x}, params={"gain": 0.6}).outputs["out1"]
+    np.testing.assert_allclose(compiled, expected, atol=1e-5)
@@ -6,12 +6,51 @@ pydantic = __import__("pytest").importorskip("pydantic")
 import pytest
 
 from gen_dsp.graph import (
+    AudioInput,
     AudioOutput,
     BinOp,
+    Buffer,
+    BufRead,
+    BufWrite,
     Constant,
     Graph,
+    Node,
+    max_live,
+    schedule,
     toposort,
 )
+from gen_dsp.graph._deps import build_forward_deps
+
+
+def _wide_graph(n: int = 8) -> Graph:
+    """n independent three-stage chains summed into one output.
+
+    Stage prefixes sort so that alphabetical tie-breaking computes each
+    stage for every chain before starting the next one.
+    """
+    nodes: list[Node] = []
+    for k in range(n):
+        nodes.append(BinOp(id=f"a{k}", op="mul", a="x", b=float(k + 1)))
+        nodes.append(BinOp(id=f"b{k}", op="add", a=f"a{k}", b=0.5))
+        nodes.append(BinOp(id=f"c{k}", op="mul", a=f"b{k}", b=f"b{k}"))
+    acc = "c0"
+    for k in range(1, n):
+        nodes.append(BinOp(id=f"s{k}", op="add", a=acc, b=f"c{k}"))
+        acc = f"s{k}"
+    return Graph(
+        name="wide",
+        inputs=[AudioInput(id="x")],
+        outputs=[AudioOutput(id="out1", source=acc)],
+        nodes=nodes,
+    )
+
+
+def _assert_topological(graph: Graph, order: list[Node]) -> None:
+    at = {n.id: i for i, n in enumerate(order)}
+    assert sorted(at) == sorted(n.id for n in graph.nodes)
+    for nid, deps in build_forward_deps(graph).items():
+        for dep in deps:
+            assert at[dep] < at[nid], f"{dep} scheduled after {nid}"
 
 
 class TestToposortOrdering:
@@ -98,3 +137,68 @@ class TestToposortEdgeCases:
         order1 = [n.id for n in toposort(stereo_gain_graph)]
         order2 = [n.id for n in toposort(stereo_gain_graph)]
         assert order1 == order2
+
+
+class TestSchedule:
+    """Locality-aware emission order."""
+
+    def test_valid_order(
+        self, onepole_graph: Graph, fbdelay_graph: Graph, gen_dsp_graph: Graph
+    ) -> None:
+        for g in (onepole_graph, fbdelay_graph, gen_dsp_graph, _wide_graph()):
+            _assert_topological(g, schedule(g))
+
+    def test_empty_graph(self) -> None:
+        assert schedule(Graph(name="empty")) == []
+
+    def test_cycle_raises(self) -> None:
+        g = Graph(
+            name="bad",
+            nodes=[
+                BinOp(id="a", op="add", a="b", b=0.0),
+                BinOp(id="b", op="add", a="a", b=0.0),
+            ],
+            outputs=[AudioOutput(id="out1", source="a")],
+        )
+        with pytest.raises(ValueError, match="cycle"):
+            schedule(g)
+
+    def test_deterministic(self) -> None:
+        """Order depends only on graph structure, not node list order."""
+        g = _wide_graph()
+        shuffled = g.model_copy(update={"nodes": list(reversed(g.nodes))})
+        order = [n.id for n in schedule(g)]
+        assert order == [n.id for n in schedule(g)]
+        assert order == [n.id for n in schedule(shuffled)]
+
+    def test_consumers_follow_producers(self) -> None:
+        order = [n.id for n in schedule(_wide_graph())]
+        assert order[:4] == ["a0", "b0", "c0", "a1"]
+
+    def test_reduces_live_values(self) -> None:
+        g = _wide_graph(16)
+        assert max_live(g, toposort(g)) > 16
+        assert max_live(g, schedule(g)) <= 3
+
+    def test_delay_access_order_preserved(self, fbdelay_graph: Graph) -> None:
+        ref = [n.id for n in toposort(fbdelay_graph)]
+        order = [n.id for n in schedule(fbdelay_graph)]
+        assert (ref.index("delayed") < ref.index("dwrite")) == (
+            order.index("delayed") < order.index("dwrite")
+        )
+
+    def test_buffer_access_order_preserved(self) -> None:
+        """A write sorting before an unrelated read stays before it."""
+        g = Graph(
+            name="bufs",
+            inputs=[AudioInput(id="x")],
+            outputs=[AudioOutput(id="out1", source="y")],
+            nodes=[
+                Buffer(id="tab", size=16),
+                BufWrite(id="a_wr", buffer="tab", index=0.0, value="x"),
+                BufRead(id="rd", buffer="tab", index=0.0),
+                BinOp(id="y", op="mul", a="rd", b=2.0),
+            ],
+        )
+        order = [n.id for n in schedule(g)]
+        assert order.index("a_wr") < order.index("rd")
@@ -0,0 +1,360 @@
+"""Tests for the Undersample container node."""
+
+from __future__ import annotations
+
+pydantic = __import__("pytest").importorskip("pydantic")
+import shutil
+import subprocess
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+from gen_dsp.graph import (
+    AudioInput,
+    AudioOutput,
+    BinOp,
+    Buffer,
+    BufRead,
+    Graph,
+    OnePole,
+    Param,
+    Phasor,
+    SinOsc,
+    Subgraph,
+    UnaryOp,
+    Undersample,
+    compile_graph,
+    optimize_graph,
+    validate_graph,
+)
+from gen_dsp.graph.simulate import SimState, simulate
+from gen_dsp.graph.tables import undersample_filter, undersample_poly
+
+
+def _follower_graph() -> Graph:
+    """Envelope follower: rectifier into a one-pole lowpass."""
+    return Graph(
+        name="follower",
+        inputs=[AudioInput(id="x")],
+        outputs=[AudioOutput(id="env", source="lp")],
+        params=[Param(name="coeff", default=0.9)],
+        nodes=[
+            UnaryOp(id="rect", op="abs", a="x"),
+            OnePole(id="lp", a="rect", coeff="coeff"),
+        ],
+    )
+
+
+def _ducker_graph(factor: int = 4) -> Graph:
+    """Outer graph scaling its input by an undersampled envelope."""
+    return Graph(
+        name="ducker",
+        inputs=[AudioInput(id="in1")],
+        outputs=[AudioOutput(id="out1", source="ducked")],
+        params=[Param(name="speed", default=0.95)],
+        nodes=[
+            Undersample(
+                id="det",
+                graph=_follower_graph(),
+                factor=factor,
+                inputs=["in1"],
+                params=["speed"],
+            ),
+            BinOp(id="ducked", op="mul", a="in1", b="det"),
+        ],
+        sample_rate=48000.0,
+    )
+
+
+def _test_signal(n: int) -> np.ndarray:
+    t = np.arange(n, dtype=np.float32)
+    amp = np.where(t < n // 2, 1.0, 0.25).astype(np.float32)
+    return (np.sin(0.05 * t) * amp).astype(np.float32)
+
+
+# ---------------------------------------------------------------------------
+# Filter design
+# ---------------------------------------------------------------------------
+
+
+class TestFilterDesign:
+    def test_unity_dc_gain(self) -> None:
+        h = undersample_filter(4, 65)
+        assert sum(h) == pytest.approx(1.0)
+
+    def test_symmetric(self) -> None:
+        h = undersample_filter(3, 49)
+        assert h == pytest.approx(h[::-1])
+
+    def test_polyphase_phases_sum_to_unity(self) -> None:
+        """Each interpolation phase passes DC with unity gain."""
+        node = Undersample(id="u", graph=_follower_graph(), factor=4, inputs=["x"])
+        poly = np.array(undersample_poly(node)).reshape(4, -1)
+        np.testing.assert_allclose(poly.sum(axis=1), 1.0, atol=0.02)
+
+
+# ---------------------------------------------------------------------------
+# Validation
+# ---------------------------------------------------------------------------
+
+
+class TestUndersampleValidation:
+    def test_valid(self) -> None:
+        assert validate_graph(_ducker_graph()) == []
+
+    def test_factor_too_small(self) -> None:
+        errors = validate_graph(_ducker_graph(factor=1))
+        assert any(e.kind == "undersample_error" and "factor" in e for e in errors)
+
+    def test_input_count_mismatch(self) -> None:
+        g = _ducker_graph()
+        node = g.nodes[0].model_copy(update={"inputs": []})
+        g = g.model_copy(update={"nodes": [node, g.nodes[1]]})
+        errors = validate_graph(g)
+        assert any("expects 1 input(s), got 0" in e for e in errors)
+
+    def test_unknown_output(self) -> None:
+        g = _ducker_graph()
+        node = g.nodes[0].model_copy(update={"output": "nope"})
+        g = g.model_copy(update={"nodes": [node, g.nodes[1]]})
+        errors = validate_graph(g)
+        assert any("output 'nope' not found" in e for e in errors)
+
+    def test_invalid_inner_graph(self) -> None:
+        inner = _follower_graph().model_copy(
+            update={"outputs": [AudioOutput(id="env", source="missing")]}
+        )
+        g = _ducker_graph()
+        node = g.nodes[0].model_copy(update={"graph": inner})
+        g = g.model_copy(update={"nodes": [node, g.nodes[1]]})
+        errors = validate_graph(g)
+        assert any(e.kind == "undersample_error" and "inner graph" in e for e in errors)
+
+    def test_dangling_input_ref(self) -> None:
+        g = _ducker_graph()
+        node = g.nodes[0].model_copy(update={"inputs": ["nowhere"]})
+        g = g.model_copy(update={"nodes": [node, g.nodes[1]]})
+        errors = validate_graph(g)
+        assert any(e.kind == "dangling_ref" for e in errors)
+
+
+# ---------------------------------------------------------------------------
+# Compilation
+# ---------------------------------------------------------------------------
+
+
+class TestUndersampleCompile:
+    def test_inner_graph_emitted(self) -> None:
+        code = compile_graph(_ducker_graph())
+        assert "struct DuckerDetState {" in code
+        assert "void ducker_det_perform(DuckerDetState* self" in code
+        assert "static const float ducker_det_aa[65]" in code
+        assert "static const float ducker_det_poly[" in code
+        # Includes are emitted once, at the top
+        assert code.count("#include <cmath>") == 1
+
+    def test_lifecycle(self) -> None:
+        code = compile_graph(_ducker_graph())
+        assert "self->m_det_inner = ducker_det_create(sr / 4.0f);" in code
+        assert "ducker_det_destroy(self->m_det_inner);" in code
+        assert "ducker_det_reset(self->m_det_inner);" in code
+
+    def test_inner_step_every_factor_samples(self) -> None:
+        code = compile_graph(_ducker_graph(factor=8))
+        assert "if (++det_phase == 8) {" in code
+        # Wired through the setter, so a stale inner ramp cannot override it
+        assert "ducker_det_set_param(self->m_det_inner, 0, speed);" in code
+        assert "ducker_det_perform(self->m_det_inner, det_ins, det_outs, 1);" in code
+
+    def test_generator_inner_graph(self) -> None:
+        """Inner graphs without inputs skip the decimation filter."""
+        lfo = Graph(
+            name="lfo",
+            outputs=[AudioOutput(id="o", source="osc")],
+            nodes=[SinOsc(id="osc", freq=2.0)],
+        )
+        g = Graph(
+            name="trem",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="y")],
+            nodes=[
+                Undersample(id="mod", graph=lfo, factor=16),
+                BinOp(id="y", op="mul", a="in1", b="mod"),
+            ],
+        )
+        code = compile_graph(g)
+        assert "m_mod_dec" not in code
+        assert "trem_mod_perform(self->m_mod_inner, nullptr, mod_outs, 1);" in code
+
+    def test_inside_subgraph(self) -> None:
+        inner = _ducker_graph().model_copy(update={"name": "duck_inner"})
+        g = Graph(
+            name="outer",
+            inputs=[AudioInput(id="src")],
+            outputs=[AudioOutput(id="out1", source="d")],
+            params=[Param(name="s", default=0.9)],
+            nodes=[
+                Subgraph(
+                    id="d", graph=inner, inputs={"in1": "src"}, params={"speed": "s"}
+                ),
+            ],
+        )
+        code = compile_graph(g)
+        assert "outer_d__det_perform" in code
+        assert "outer_d__det_set_param(self->m_d__det_inner, 0, s);" in code
+
+    def test_survives_optimization(self) -> None:
+        result = optimize_graph(_ducker_graph())
+        assert any(isinstance(n, Undersample) for n in result.graph.nodes)
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_matches_simulation(self, tmp_path: Path) -> None:
+        g = _ducker_graph()
+        n = 600
+        x = _test_signal(n)
+        # Two perform calls with an odd split exercise state save/restore
+        split = 157
+        driver = compile_graph(g) + "\n".join(
+            [
+                "#include <cstdio>",
+                "#include <cmath>",
+                "int main() {",
+                "    DuckerState* s = ducker_create(48000.0f);",
+                f"    float in[{n}], out[{n}];",
+                f"    for (int i = 0; i < {n}; i++)",
+                f"        in[i] = sinf(0.05f * (float)i) * (i < {n // 2} ? 1.0f : 0.25f);",
+                "    float* ins[1] = {in};",
+                "    float* outs[1] = {out};",
+                f"    ducker_perform(s, ins, outs, {split});",
+                f"    ins[0] = in + {split};",
+                f"    outs[0] = out + {split};",
+                f"    ducker_perform(s, ins, outs, {n - split});",
+                f'    for (int i = 0; i < {n}; i++) printf("%.9g\\n", out[i]);',
+                "    ducker_destroy(s);",
+                "    return 0;",
+                "}",
+                "",
+            ]
+        )
+        src = tmp_path / "ducker.cpp"
+        exe = tmp_path / "ducker"
+        src.write_text(driver)
+        result = subprocess.run(
+            ["g++", "-std=c++17", "-O2", "-o", str(exe), str(src)],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        out = subprocess.run(
+            [str(exe)], capture_output=True, text=True, check=True
+        ).stdout.split()
+        compiled = np.array([float(v) for v in out], dtype=np.float32)
+
+        expected = simulate(g, inputs={"in1": x}).outputs["out1"]
+        np.testing.assert_allclose(compiled, expected, atol=1e-5)
+
+    @pytest.mark.skipif(not shutil.which("g++"), reason="g++ not found")
+    def test_inner_phasor_index_stays_in_bounds(self, tmp_path: Path) -> None:
+        """A 6 kHz Phasor at 44.1k/8 still wraps into [0, 1): no clamp needed."""
+        scan = Graph(
+            name="scan",
+            outputs=[AudioOutput(id="o", source="br")],
+            nodes=[
+                Buffer(id="tab", size=256, fill="sine"),
+                Phasor(id="ph", freq=6000.0),
+                BinOp(id="pos", op="mul", a="ph", b=255.0),
+                BufRead(id="br", buffer="tab", index="pos", interp="linear"),
+            ],
+        )
+        g = Graph(
+            name="lowscan",
+            outputs=[AudioOutput(id="out1", source="us")],
+            nodes=[Undersample(id="us", graph=scan, factor=8)],
+        )
+        code = compile_graph(g)
+        assert "if (br_i1 >= tab_len) br_i1 = tab_len - 1;" not in code
+
+        n = 4096
+        driver = code + "\n".join(
+            [
+                "#include <cstdio>",
+                "int main() {",
+                "    LowscanState* s = lowscan_create(44100.0f);",
+                f"    static float out[{n}];",
+                "    float* outs[1] = {out};",
+                f"    lowscan_perform(s, nullptr, outs, {n});",
+                "    lowscan_destroy(s);",
+                "    return 0;",
+                "}",
+                "",
+            ]
+        )
+        src = tmp_path / "lowscan.cpp"
+        exe = tmp_path / "lowscan"
+        src.write_text(driver)
+        result = subprocess.run(
+            [
+                "g++",
+                "-std=c++17",
+                "-O1",
+                "-fsanitize=address",
+                "-o",
+                str(exe),
+                str(src),
+            ],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"g++ failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=False)
+        assert run.returncode == 0, run.stderr
+
+
+# ---------------------------------------------------------------------------
+# Simulation
+# ---------------------------------------------------------------------------
+
+
+class TestUndersampleSimulate:
+    def test_inner_runs_at_reduced_rate(self) -> None:
+        g = _ducker_graph(factor=4)
+        state = SimState(g)
+        inner = state._state["det.inner"]
+        assert inner.sr == pytest.approx(12000.0)
+
+    def test_tracks_envelope(self) -> None:
+        """A sustained sine settles to its mean absolute value (2/pi)."""
+        g = Graph(
+            name="env_only",
+            inputs=[AudioInput(id="in1")],
+            outputs=[AudioOutput(id="out1", source="det")],
+            nodes=[
+                Undersample(
+                    id="det", graph=_follower_graph(), factor=4, inputs=["in1"]
+                ),
+            ],
+        )
+        x = np.sin(0.05 * np.arange(4000)).astype(np.float32)
+        env = simulate(g, inputs={"in1": x}).outputs["out1"]
+        assert float(np.mean(env[-1000:])) == pytest.approx(2.0 / np.pi, abs=0.02)
+
+    def test_block_split_invariance(self) -> None:
+        g = _ducker_graph()
+        x = _test_signal(400)
+        whole = simulate(g, inputs={"in1": x}).outputs["out1"]
+        state = SimState(g)
+        a = simulate(g, inputs={"in1": x[:123]}, state=state).outputs["out1"]
+        b = simulate(g, inputs={"in1": x[123:]}, state=state).outputs["out1"]
+        np.testing.assert_array_equal(np.concatenate([a, b]), whole)
+
+    def test_reset(self) -> None:
+        g = _ducker_graph()
+        x = _test_signal(200)
+        state = SimState(g)
+        first = simulate(g, inputs={"in1": x}, state=state).outputs["out1"]
+        state.reset()
+        second = simulate(g, inputs={"in1": x}, state=state).outputs["out1"]
+        np.testing.assert_array_equal(first, second)
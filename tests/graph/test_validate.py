@@ -15,21 +15,29 @@ from gen_dsp.graph import (
     DelayRead,
     DelayWrite,
     Elapsed,
+    FDN,
+    FIR,
     GateOut,
     GateRoute,
+    Granulator,
     Graph,
     GraphValidationError,
     History,
     Lookup,
+    MovingAverage,
     MulAccum,
+    MultiTapRead,
     Splat,
     OnePole,
     Param,
+    Resample,
     SampleRate,
     Selector,
     Slide,
     Subgraph,
     Wave,
+    WavetableOsc,
+    WindowMax,
     validate_graph,
 )
 
@@ -155,11 +163,234 @@ class TestDelayConsistency:
         assert validate_graph(g) == []
 
 
+class TestWindowValidation:
+    def test_capacity_must_be_positive(self) -> None:
+        g = Graph(
+            name="test",
+            outputs=[AudioOutput(id="out1", source="m")],
+            nodes=[WindowMax(id="m", a=0.0, window=10.0, max_window=0)],
+        )
+        errors = validate_graph(g)
+        assert [e.kind for e in errors] == ["window_capacity"]
+        assert errors[0].field_name == "max_window"
+
+    def test_moving_average_window(self) -> None:
+        g = Graph(name="test", nodes=[MovingAverage(id="m", a=0.0, window=0)])
+        errors = validate_graph(g)
+        assert [e.kind for e in errors] == ["window_capacity"]
+        assert errors[0].field_name == "window"
+
+
+class TestMultiTapValidation:
+    def _graph(self, node: MultiTapRead) -> Graph:
+        return Graph(
+            name="test",
+            outputs=[AudioOutput(id="out1", source="m")],
+            params=[Param(name="x")],
+            nodes=[
+                DelayLine(id="dl", max_samples=100),
+                node,
+                DelayWrite(id="dw", delay="dl", value=1.0),
+            ],
+        )
+
+    def test_valid(self) -> None:
+        node = MultiTapRead(id="m", delay="dl", taps=[0.0, 100.0, "x"])
+        assert validate_graph(self._graph(node)) == []
+
+    def test_missing_delay_line(self) -> None:
+        g = Graph(
+            name="test",
+            outputs=[AudioOutput(id="out1", source="m")],
+            nodes=[MultiTapRead(id="m", delay="nope", taps=[1.0])],
+        )
+        err = next(e for e in validate_graph(g) if "delay line" in e)
+        assert err.kind == "missing_delay_line"
+
+    def test_gain_count(self) -> None:
+        node = MultiTapRead(id="m", delay="dl", taps=[1.0, 2.0], gains=[0.5])
+        errors = validate_graph(self._graph(node))
+        assert [e.kind for e in errors] == ["multitap_error"]
+        assert errors[0].field_name == "gains"
+
+    def test_no_taps(self) -> None:
+        errors = validate_graph(self._graph(MultiTapRead(id="m", delay="dl", taps=[])))
+        assert [e.kind for e in errors] == ["multitap_error"]
+
+    def test_literal_tap_past_line(self) -> None:
+        # Linear interpolation reads one sample behind the tap
+        node = MultiTapRead(id="m", delay="dl", taps=[100.0], interp="linear")
+        errors = validate_graph(self._graph(node))
+        assert [e.kind for e in errors] == ["multitap_error"]
+        assert "outside [0, 99]" in errors[0]
+
+
+class TestFDNValidation:
+    def test_valid(self) -> None:
+        g = Graph(
+            name="test",
+            outputs=[AudioOutput(id="out1", source="f")],
+            nodes=[FDN(id="f", a=0.0, delays=[101, 143, 165, 177])],
+        )
+        assert validate_graph(g) == []
+
+    def test_hadamard_needs_power_of_two(self) -> None:
+        g = Graph(name="test", nodes=[FDN(id="f", a=0.0, delays=[101, 143, 165])])
+        errors = validate_graph(g)
+        assert [e.kind for e in errors] == ["fdn_error"]
+        assert errors[0].field_name == "matrix"
+        householder = FDN(id="f", a=0.0, delays=[101, 143, 165], matrix="householder")
+        assert validate_graph(Graph(name="test", nodes=[householder])) == []
+
+    def test_line_count_and_lengths(self) -> None:
+        for delays in ([101], list(range(1, 130)), [101, 0]):
+            g = Graph(
+                name="test",
+                nodes=[FDN(id="f", a=0.0, delays=delays, matrix="householder")],
+            )
+            errors = validate_graph(g)
+            assert [e.kind for e in errors] == ["fdn_error"]
+            assert errors[0].field_name == "delays"
+
+    def test_matrix_is_not_a_reference(self) -> None:
+        g = Graph(
+            name="test",
+            nodes=[FDN(id="f", a=0.0, delays=[3, 5], matrix="householder")],
+        )
+        assert validate_graph(g) == []
+
+
+class TestFIRValidation:
+    def _graph(self, *nodes: object) -> Graph:
+        return Graph(
+            name="test",
+            outputs=[AudioOutput(id="out1", source="f")],
+            nodes=list(nodes),  # type: ignore[arg-type]
+        )
+
+    def test_valid(self) -> None:
+        assert validate_graph(self._graph(FIR(id="f", a=0.0, coeffs=[0.5, 0.5]))) == []
+        g = self._graph(Buffer(id="h", size=64), FIR(id="f", a=0.0, coeffs="h"))
+        assert validate_graph(g) == []
+
+    def test_tap_count(self) -> None:
+        for coeffs in ([], [0.0] * 4097):
+            errors = validate_graph(self._graph(FIR(id="f", a=0.0, coeffs=coeffs)))
+            assert [e.kind for e in errors] == ["fir_taps"]
+            assert errors[0].field_name == "coeffs"
+
+    def test_missing_buffer(self) -> None:
+        errors = validate_graph(self._graph(FIR(id="f", a=0.0, coeffs="nope")))
+        err = next(e for e in errors if e.kind == "missing_buffer")
+        assert err.field_name == "coeffs"
+        assert not any(e.kind == "fir_taps" for e in errors)
+
+
+class TestResampleValidation:
+    def _graph(self, *nodes: object) -> Graph:
+        return Graph(
+            name="test",
+            outputs=[AudioOutput(id="out1", source="r")],
+            nodes=list(nodes),  # type: ignore[arg-type]
+        )
+
+    def test_valid(self) -> None:
+        for taps in (4, 16, 64):
+            g = self._graph(
+                Buffer(id="smp", size=64),
+                Resample(id="r", buffer="smp", index=0.0, taps=taps),
+            )
+            assert validate_graph(g) == []
+
+    def test_taps(self) -> None:
+        for taps in (0, 6, 68):
+            g = self._graph(
+                Buffer(id="smp", size=64),
+                Resample(id="r", buffer="smp", index=0.0, taps=taps),
+            )
+            errors = validate_graph(g)
+            assert [e.kind for e in errors] == ["resample_taps"]
+            assert errors[0].field_name == "taps"
+
+    def test_missing_buffer(self) -> None:
+        errors = validate_graph(self._graph(Resample(id="r", buffer="nope", index=0.0)))
+        err = next(e for e in errors if e.kind == "missing_buffer")
+        assert err.field_name == "buffer"
+
+
+class TestGranulatorValidation:
+    def _graph(self, *nodes: object) -> Graph:
+        return Graph(
+            name="test",
+            outputs=[AudioOutput(id="out1", source="g")],
+            nodes=list(nodes),  # type: ignore[arg-type]
+        )
+
+    def test_valid(self) -> None:
+        for grains in (1, 32, 1024):
+            g = self._graph(
+                Buffer(id="smp", size=64),
+                Granulator(id="g", buffer="smp", grains=grains),
+            )
+            assert validate_graph(g) == []
+
+    def test_grains(self) -> None:
+        for grains in (0, -4, 1025):
+            g = self._graph(
+                Buffer(id="smp", size=64),
+                Granulator(id="g", buffer="smp", grains=grains),
+            )
+            errors = validate_graph(g)
+            assert [e.kind for e in errors] == ["granulator_grains"]
+            assert errors[0].field_name == "grains"
+
+    def test_missing_buffer(self) -> None:
+        errors = validate_graph(self._graph(Granulator(id="g", buffer="nope")))
+        err = next(e for e in errors if e.kind == "missing_buffer")
+        assert err.field_name == "buffer"
+
+
 # ---------------------------------------------------------------------------
 # Buffer consistency
 # ---------------------------------------------------------------------------
 
 
+class TestBufferFormatValidation:
+    def _graph(self, *nodes: object) -> Graph:
+        return Graph(
+            name="test",
+            outputs=[AudioOutput(id="out1", source="r")],
+            nodes=[Buffer(id="smp", size=64, format="int16"), *nodes],  # type: ignore[list-item]
+        )
+
+    def test_converting_readers_accept_int16(self) -> None:
+        g = self._graph(
+            BufRead(id="r", buffer="smp", index=0.0, interp="cubic"),
+            Cycle(id="c", buffer="smp", phase=0.5),
+            Wave(id="w", buffer="smp", phase=0.0),
+            Lookup(id="l", buffer="smp", index=0.5),
+            BufWrite(id="bw", buffer="smp", index=0.0, value=2.0),
+            Splat(id="sp", buffer="smp", index=1.0, value=1.0),
+        )
+        assert validate_graph(g) == []
+
+    def test_float_only_readers_rejected(self) -> None:
+        g = self._graph(
+            Resample(id="r", buffer="smp", index=0.0),
+            Granulator(id="g", buffer="smp"),
+            WavetableOsc(id="o", buffer="smp", freq=110.0),
+            FIR(id="f", a=0.0, coeffs="smp"),
+        )
+        errors = validate_graph(g)
+        assert sorted((e.node_id, e.field_name) for e in errors) == [
+            ("f", "coeffs"),
+            ("g", "buffer"),
+            ("o", "buffer"),
+            ("r", "buffer"),
+        ]
+        assert {e.kind for e in errors} == {"buffer_format"}
+
+
 class TestBufferConsistency:
     def test_bufread_references_nonexistent_buffer(self) -> None:
         g = Graph(
@@ -684,3 +915,34 @@ class TestCycleWaveLookupValidation:
         )
         errors = validate_graph(g)
         assert any("non-existent buffer 'missing'" in e for e in errors)
+
+    def test_wavetable_valid(self) -> None:
+        g = Graph(
+            name="test",
+            outputs=[AudioOutput(id="out1", source="wt")],
+            nodes=[
+                Buffer(id="buf", size=2048),
+                WavetableOsc(id="wt", buffer="buf", freq=440.0),
+            ],
+        )
+        assert validate_graph(g) == []
+
+    def test_wavetable_missing_buffer(self) -> None:
+        g = Graph(
+            name="test",
+            nodes=[WavetableOsc(id="wt", buffer="missing", freq=440.0)],
+        )
+        errors = validate_graph(g)
+        assert any("non-existent buffer 'missing'" in e for e in errors)
+
+    def test_wavetable_size_bounds(self) -> None:
+        for size in (2, 32768):
+            g = Graph(
+                name="test",
+                nodes=[
+                    Buffer(id="buf", size=size),
+                    WavetableOsc(id="wt", buffer="buf", freq=440.0),
+                ],
+            )
+            errors = validate_graph(g)
+            assert [e.kind for e in errors] == ["wavetable_size"]
@@ -0,0 +1,193 @@
+// bench.h - Shared driver for the headless wrapper-overhead hosts
+//
+// Every host (direct_host, clap_host, lv2_host, vst3_host) parses the same
+// arguments, runs the same scripted block/event schedule through
+// bench_run(), and prints the same report, so their ns/block figures are
+// directly comparable:
+//
+//   <host> [options] <plugin-path>
+//     --blocks N         timed blocks per repeat (default 20000)
+//     --block-size N     frames per block (default 64)
+//     --repeats N        timed repeats; the fastest is reported (default 5)
+//     --sr HZ            sample rate (default 48000)
+//     --io IN OUT        audio channel counts (default 2 2)
+//     --param I          parameter index to automate (default 0, -1 = none)
+//     --values LO HI     values alternated on each change (default 0 1)
+//     --every N          change the parameter every N blocks (default 4)
+//     --controls a,b,..  initial control values (LV2 control ports)
+//
+// Output (one "key value" pair per line, parsed by test_wrapper_overhead.py):
+//   ns_per_block <float>
+//   output_rms   <float>
+
+#ifndef GEN_DSP_BENCH_H
+#define GEN_DSP_BENCH_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_MAX_CHANNELS 64
+#define BENCH_MAX_CONTROLS 256
+#define BENCH_WARMUP_BLOCKS 200
+
+typedef struct {
+    const char* path;
+    int blocks;
+    int block_size;
+    int repeats;
+    double sample_rate;
+    int num_inputs;
+    int num_outputs;
+    int param_index;
+    float value_lo;
+    float value_hi;
+    int every;
+    int num_controls;
+    float controls[BENCH_MAX_CONTROLS];
+} bench_args;
+
+// Called once per block. `change` is non-zero when the schedule sets
+// `args->param_index` to `value` at the start of this block.
+typedef void (*bench_block_fn)(void* ctx, int change, float value);
+
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static inline int bench_parse(int argc, char** argv, bench_args* a)
+{
+    memset(a, 0, sizeof(*a));
+    a->blocks = 20000;
+    a->block_size = 64;
+    a->repeats = 5;
+    a->sample_rate = 48000.0;
+    a->num_inputs = 2;
+    a->num_outputs = 2;
+    a->param_index = 0;
+    a->value_lo = 0.0f;
+    a->value_hi = 1.0f;
+    a->every = 4;
+
+    for (int i = 1; i < argc; i++) {
+        const char* opt = argv[i];
+        int left = argc - i - 1;
+        if (!strcmp(opt, "--blocks") && left >= 1) {
+            a->blocks = atoi(argv[++i]);
+        } else if (!strcmp(opt, "--block-size") && left >= 1) {
+            a->block_size = atoi(argv[++i]);
+        } else if (!strcmp(opt, "--repeats") && left >= 1) {
+            a->repeats = atoi(argv[++i]);
+        } else if (!strcmp(opt, "--sr") && left >= 1) {
+            a->sample_rate = atof(argv[++i]);
+        } else if (!strcmp(opt, "--io") && left >= 2) {
+            a->num_inputs = atoi(argv[++i]);
+            a->num_outputs = atoi(argv[++i]);
+        } else if (!strcmp(opt, "--param") && left >= 1) {
+            a->param_index = atoi(argv[++i]);
+        } else if (!strcmp(opt, "--values") && left >= 2) {
+            a->value_lo = (float)atof(argv[++i]);
+            a->value_hi = (float)atof(argv[++i]);
+        } else if (!strcmp(opt, "--every") && left >= 1) {
+            a->every = atoi(argv[++i]);
+        } else if (!strcmp(opt, "--controls") && left >= 1) {
+            const char* p = argv[++i];
+            while (*p && a->num_controls < BENCH_MAX_CONTROLS) {
+                char* end = NULL;
+                a->controls[a->num_controls++] = strtof(p, &end);
+                if (end == p) break;
+                p = (*end == ',') ? end + 1 : end;
+            }
+        } else if (opt[0] == '-' && opt[1] == '-') {
+            fprintf(stderr, "unknown or incomplete option: %s\n", opt);
+            return -1;
+        } else {
+            a->path = opt;
+        }
+    }
+
+    if (a->blocks <= 0 || a->block_size <= 0 || a->repeats <= 0
+        || a->num_inputs < 0 || a->num_inputs > BENCH_MAX_CHANNELS
+        || a->num_outputs <= 0 || a->num_outputs > BENCH_MAX_CHANNELS) {
+        fprintf(stderr, "invalid block or channel configuration\n");
+        return -1;
+    }
+    return 0;
+}
+
+// Allocate `n` zeroed channels of `frames` samples (one contiguous block).
+static inline float** bench_alloc_channels(int n, int frames)
+{
+    float** chans = (float**)calloc((size_t)(n > 0 ? n : 1), sizeof(float*));
+    float* data = (float*)calloc((size_t)(n > 0 ? n : 1) * (size_t)frames,
+                                 sizeof(float));
+    for (int c = 0; c < n; c++) chans[c] = data + (size_t)c * (size_t)frames;
+    return chans;
+}
+
+static inline void bench_free_channels(float** chans)
+{
+    if (!chans) return;
+    free(chans[0]);
+    free(chans);
+}
+
+// Deterministic white noise in [-0.5, 0.5), filled once before timing so
+// input generation is not part of the measured cost.
+static inline void bench_fill_noise(float** chans, int n, int frames)
+{
+    uint32_t seed = 0x12345678u;
+    for (int c = 0; c < n; c++) {
+        for (int i = 0; i < frames; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            chans[c][i] = (float)(seed >> 8) / 16777216.0f - 0.5f;
+        }
+    }
+}
+
+static inline void bench_block(const bench_args* a, bench_block_fn fn,
+                               void* ctx, int block)
+{
+    if (a->param_index >= 0 && a->every > 0 && block % a->every == 0) {
+        float v = ((block / a->every) & 1) ? a->value_hi : a->value_lo;
+        fn(ctx, 1, v);
+    } else {
+        fn(ctx, 0, 0.0f);
+    }
+}
+
+// Warm up, then run `repeats` timed passes of `blocks` blocks. Returns the
+// fastest pass in nanoseconds per block.
+static inline double bench_run(const bench_args* a, bench_block_fn fn, void* ctx)
+{
+    for (int b = 0; b < BENCH_WARMUP_BLOCKS; b++) bench_block(a, fn, ctx, b);
+
+    uint64_t best = 0;
+    for (int r = 0; r < a->repeats; r++) {
+        uint64_t t0 = bench_now_ns();
+        for (int b = 0; b < a->blocks; b++) bench_block(a, fn, ctx, b);
+        uint64_t dt = bench_now_ns() - t0;
+        if (r == 0 || dt < best) best = dt;
+    }
+    return (double)best / (double)a->blocks;
+}
+
+static inline void bench_report(double ns_per_block, float** outs, int n,
+                                int frames)
+{
+    double sum = 0.0;
+    for (int c = 0; c < n; c++) {
+        for (int i = 0; i < frames; i++) sum += (double)outs[c][i] * outs[c][i];
+    }
+    double rms = (n > 0 && frames > 0) ? sqrt(sum / ((double)n * frames)) : 0.0;
+    printf("ns_per_block %.3f\n", ns_per_block);
+    printf("output_rms %.9g\n", rms);
+}
+
+#endif // GEN_DSP_BENCH_H
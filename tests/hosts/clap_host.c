@@ -0,0 +1,173 @@
+// clap_host.c - Minimal headless CLAP host for wrapper-overhead benchmarks
+//
+// Loads a built .clap with dlopen, instantiates its first plugin and drives
+// process() with the shared bench.h schedule. Parameter changes arrive as a
+// single CLAP_EVENT_PARAM_VALUE in the block's input event list, as a DAW
+// would send automation. Host extensions are not offered; gen-dsp plugins
+// do not require any.
+
+#include <dlfcn.h>
+
+#include <clap/clap.h>
+
+#include "bench.h"
+
+// ---------------------------------------------------------------------------
+// Host
+// ---------------------------------------------------------------------------
+
+static const void* host_get_extension(const clap_host_t* host, const char* id)
+{
+    (void)host;
+    (void)id;
+    return NULL;
+}
+
+static void host_request(const clap_host_t* host) { (void)host; }
+
+static const clap_host_t s_host = {
+    CLAP_VERSION_INIT,
+    NULL,
+    "gen-dsp bench host",
+    "gen-dsp",
+    "https://github.com/shakfu/gen-dsp",
+    "1.0",
+    host_get_extension,
+    host_request,
+    host_request,
+    host_request,
+};
+
+// ---------------------------------------------------------------------------
+// Event lists: at most one parameter event per block, nothing is collected
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    clap_event_param_value_t event;
+    uint32_t count;
+} event_list;
+
+static uint32_t in_events_size(const clap_input_events_t* list)
+{
+    return ((const event_list*)list->ctx)->count;
+}
+
+static const clap_event_header_t* in_events_get(const clap_input_events_t* list,
+                                                uint32_t index)
+{
+    const event_list* ev = (const event_list*)list->ctx;
+    return index < ev->count ? &ev->event.header : NULL;
+}
+
+static bool out_events_try_push(const clap_output_events_t* list,
+                                const clap_event_header_t* event)
+{
+    (void)list;
+    (void)event;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    const clap_plugin_t* plugin;
+    clap_process_t process;
+    event_list events;
+} clap_ctx;
+
+static void clap_block(void* p, int change, float value)
+{
+    clap_ctx* c = (clap_ctx*)p;
+    c->events.count = change ? 1 : 0;
+    c->events.event.value = value;
+    c->plugin->process(c->plugin, &c->process);
+    c->process.steady_time += c->process.frames_count;
+}
+
+int main(int argc, char** argv)
+{
+    bench_args args;
+    if (bench_parse(argc, argv, &args) != 0 || !args.path) {
+        fprintf(stderr, "usage: clap_host [options] <plugin.clap>\n");
+        return 2;
+    }
+
+    void* lib = dlopen(args.path, RTLD_NOW | RTLD_LOCAL);
+    if (!lib) {
+        fprintf(stderr, "dlopen failed: %s\n", dlerror());
+        return 1;
+    }
+    const clap_plugin_entry_t* entry =
+        (const clap_plugin_entry_t*)dlsym(lib, "clap_entry");
+    if (!entry || !entry->init(args.path)) {
+        fprintf(stderr, "clap_entry missing or init failed\n");
+        return 1;
+    }
+    const clap_plugin_factory_t* factory =
+        (const clap_plugin_factory_t*)entry->get_factory(CLAP_PLUGIN_FACTORY_ID);
+    if (!factory || factory->get_plugin_count(factory) < 1) {
+        fprintf(stderr, "no plugin factory\n");
+        return 1;
+    }
+    const clap_plugin_descriptor_t* desc =
+        factory->get_plugin_descriptor(factory, 0);
+    const clap_plugin_t* plugin = factory->create_plugin(factory, &s_host, desc->id);
+    if (!plugin || !plugin->init(plugin)) {
+        fprintf(stderr, "create_plugin/init failed\n");
+        return 1;
+    }
+    if (!plugin->activate(plugin, args.sample_rate, 1, (uint32_t)args.block_size)
+        || !plugin->start_processing(plugin)) {
+        fprintf(stderr, "activate/start_processing failed\n");
+        return 1;
+    }
+
+    float** ins = bench_alloc_channels(args.num_inputs, args.block_size);
+    float** outs = bench_alloc_channels(args.num_outputs, args.block_size);
+    bench_fill_noise(ins, args.num_inputs, args.block_size);
+
+    clap_audio_buffer_t in_buf;
+    clap_audio_buffer_t out_buf;
+    memset(&in_buf, 0, sizeof(in_buf));
+    memset(&out_buf, 0, sizeof(out_buf));
+    in_buf.data32 = ins;
+    in_buf.channel_count = (uint32_t)args.num_inputs;
+    out_buf.data32 = outs;
+    out_buf.channel_count = (uint32_t)args.num_outputs;
+
+    clap_ctx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.plugin = plugin;
+    ctx.events.event.header.size = sizeof(clap_event_param_value_t);
+    ctx.events.event.header.space_id = CLAP_CORE_EVENT_SPACE_ID;
+    ctx.events.event.header.type = CLAP_EVENT_PARAM_VALUE;
+    ctx.events.event.param_id = (clap_id)(args.param_index >= 0 ? args.param_index : 0);
+    ctx.events.event.note_id = -1;
+    ctx.events.event.port_index = -1;
+    ctx.events.event.channel = -1;
+    ctx.events.event.key = -1;
+
+    clap_input_events_t in_events = { &ctx.events, in_events_size, in_events_get };
+    clap_output_events_t out_events = { NULL, out_events_try_push };
+
+    ctx.process.frames_count = (uint32_t)args.block_size;
+    ctx.process.audio_inputs = &in_buf;
+    ctx.process.audio_inputs_count = args.num_inputs > 0 ? 1 : 0;
+    ctx.process.audio_outputs = &out_buf;
+    ctx.process.audio_outputs_count = 1;
+    ctx.process.in_events = &in_events;
+    ctx.process.out_events = &out_events;
+
+    double ns = bench_run(&args, clap_block, &ctx);
+    bench_report(ns, outs, args.num_outputs, args.block_size);
+
+    plugin->stop_processing(plugin);
+    plugin->deactivate(plugin);
+    plugin->destroy(plugin);
+    entry->deinit();
+    bench_free_channels(ins);
+    bench_free_channels(outs);
+    return 0;
+}
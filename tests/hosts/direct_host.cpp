@@ -0,0 +1,62 @@
+// direct_host.cpp - Baseline: drive the wrapper_* API with no plugin format
+//
+// Compiled against a generated project's own _ext_<platform>.cpp, so the
+// DSP code is bit-identical to the plugin under test. The parameter
+// schedule mirrors what the CLAP/VST3 wrappers do on an automation event
+// (a ramp across the block), which leaves only the plugin-format glue in
+// the difference between a host's figure and this one.
+
+#include BENCH_EXT_HEADER
+#include "bench.h"
+
+using namespace WRAPPER_NAMESPACE;
+
+struct DirectCtx {
+    GenState* state;
+    float** ins;
+    float** outs;
+    int numInputs;
+    int numOutputs;
+    int blockSize;
+    int paramIndex;
+};
+
+static void direct_block(void* p, int change, float value)
+{
+    DirectCtx* c = (DirectCtx*)p;
+    if (change) {
+        wrapper_set_param_ramp(c->state, c->paramIndex, value, c->blockSize);
+    }
+    wrapper_perform(c->state, c->numInputs > 0 ? c->ins : nullptr, c->numInputs,
+                    c->outs, c->numOutputs, c->blockSize);
+}
+
+int main(int argc, char** argv)
+{
+    bench_args args;
+    if (bench_parse(argc, argv, &args) != 0) return 2;
+
+    DirectCtx ctx;
+    ctx.numInputs = wrapper_num_inputs();
+    ctx.numOutputs = wrapper_num_outputs();
+    ctx.blockSize = args.block_size;
+    ctx.paramIndex = args.param_index;
+    if (ctx.paramIndex >= wrapper_num_params()) args.param_index = -1;
+
+    ctx.state = wrapper_create((float)args.sample_rate, args.block_size);
+    if (!ctx.state) {
+        fprintf(stderr, "wrapper_create failed\n");
+        return 1;
+    }
+    ctx.ins = bench_alloc_channels(ctx.numInputs, args.block_size);
+    ctx.outs = bench_alloc_channels(ctx.numOutputs, args.block_size);
+    bench_fill_noise(ctx.ins, ctx.numInputs, args.block_size);
+
+    double ns = bench_run(&args, direct_block, &ctx);
+    bench_report(ns, ctx.outs, ctx.numOutputs, args.block_size);
+
+    wrapper_destroy(ctx.state);
+    bench_free_channels(ctx.ins);
+    bench_free_channels(ctx.outs);
+    return 0;
+}
@@ -0,0 +1,135 @@
+// lv2_host.c - Minimal headless LV2 host for wrapper-overhead benchmarks
+//
+// Loads the plugin binary inside a built .lv2 bundle with dlopen and takes
+// its first descriptor, without lilv or any Turtle parsing. Ports are
+// connected using the fixed gen-dsp layout (see gen_ext_lv2.cpp):
+//
+//   0 .. P-1        control inputs (initial values from --controls)
+//   P .. P+I-1      audio inputs
+//   P+I .. P+I+O-1  audio outputs
+//
+// Parameter changes are made the way an LV2 host makes them: by writing the
+// control port value before run(). Only the URID map feature is provided.
+
+#include <dlfcn.h>
+#include <libgen.h>
+
+#include <lv2/core/lv2.h>
+#include <lv2/urid/urid.h>
+
+#include "bench.h"
+
+// ---------------------------------------------------------------------------
+// URID map (linear table; only a handful of URIs are mapped at instantiate)
+// ---------------------------------------------------------------------------
+
+#define MAX_URIDS 64
+
+typedef struct {
+    char* uris[MAX_URIDS];
+    uint32_t count;
+} urid_table;
+
+static LV2_URID urid_map(LV2_URID_Map_Handle handle, const char* uri)
+{
+    urid_table* t = (urid_table*)handle;
+    for (uint32_t i = 0; i < t->count; i++) {
+        if (!strcmp(t->uris[i], uri)) return i + 1;
+    }
+    if (t->count >= MAX_URIDS) return 0;
+    t->uris[t->count] = strdup(uri);
+    return ++t->count;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    const LV2_Descriptor* desc;
+    LV2_Handle handle;
+    float* control;
+    uint32_t block_size;
+} lv2_ctx;
+
+static void lv2_block(void* p, int change, float value)
+{
+    lv2_ctx* c = (lv2_ctx*)p;
+    if (change) *c->control = value;
+    c->desc->run(c->handle, c->block_size);
+}
+
+int main(int argc, char** argv)
+{
+    bench_args args;
+    if (bench_parse(argc, argv, &args) != 0 || !args.path) {
+        fprintf(stderr, "usage: lv2_host [options] --controls a,b,.. <bundle>/<name>.so\n");
+        return 2;
+    }
+
+    void* lib = dlopen(args.path, RTLD_NOW | RTLD_LOCAL);
+    if (!lib) {
+        fprintf(stderr, "dlopen failed: %s\n", dlerror());
+        return 1;
+    }
+    LV2_Descriptor_Function descriptor_fn =
+        (LV2_Descriptor_Function)dlsym(lib, "lv2_descriptor");
+    const LV2_Descriptor* desc = descriptor_fn ? descriptor_fn(0) : NULL;
+    if (!desc) {
+        fprintf(stderr, "lv2_descriptor missing\n");
+        return 1;
+    }
+
+    // Bundle path with trailing slash, as a host passes it
+    char path_copy[4096];
+    char bundle[4096];
+    snprintf(path_copy, sizeof(path_copy), "%s", args.path);
+    snprintf(bundle, sizeof(bundle), "%s/", dirname(path_copy));
+
+    urid_table urids;
+    memset(&urids, 0, sizeof(urids));
+    LV2_URID_Map map = { &urids, urid_map };
+    LV2_Feature map_feature = { LV2_URID__map, &map };
+    const LV2_Feature* features[] = { &map_feature, NULL };
+
+    LV2_Handle handle = desc->instantiate(desc, args.sample_rate, bundle, features);
+    if (!handle) {
+        fprintf(stderr, "instantiate failed\n");
+        return 1;
+    }
+
+    int num_params = args.num_controls;
+    float controls[BENCH_MAX_CONTROLS];
+    memcpy(controls, args.controls, sizeof(controls));
+    float dummy = 0.0f;
+
+    float** ins = bench_alloc_channels(args.num_inputs, args.block_size);
+    float** outs = bench_alloc_channels(args.num_outputs, args.block_size);
+    bench_fill_noise(ins, args.num_inputs, args.block_size);
+
+    uint32_t port = 0;
+    for (int i = 0; i < num_params; i++) desc->connect_port(handle, port++, &controls[i]);
+    for (int c = 0; c < args.num_inputs; c++) desc->connect_port(handle, port++, ins[c]);
+    for (int c = 0; c < args.num_outputs; c++) desc->connect_port(handle, port++, outs[c]);
+
+    lv2_ctx ctx;
+    ctx.desc = desc;
+    ctx.handle = handle;
+    ctx.block_size = (uint32_t)args.block_size;
+    if (args.param_index >= 0 && args.param_index < num_params) {
+        ctx.control = &controls[args.param_index];
+    } else {
+        ctx.control = &dummy;
+    }
+
+    if (desc->activate) desc->activate(handle);
+    double ns = bench_run(&args, lv2_block, &ctx);
+    bench_report(ns, outs, args.num_outputs, args.block_size);
+    if (desc->deactivate) desc->deactivate(handle);
+
+    desc->cleanup(handle);
+    for (uint32_t i = 0; i < urids.count; i++) free(urids.uris[i]);
+    bench_free_channels(ins);
+    bench_free_channels(outs);
+    return 0;
+}
@@ -0,0 +1,310 @@
+// simd_kernels.cpp - Bit-exactness check and microbenchmark for gen_dsp_simd.h
+//
+// Every kernel is run against the plain C loop it replaced in the platform
+// wrappers (standalone, ChucK, Circle, Csound) over odd lengths, values
+// outside [-1, 1], NaN and infinities, and the outputs compared bit for bit.
+// test_simd.py builds this twice -- once with the SSE2/NEON paths and once
+// with -DGEN_DSP_SIMD_SCALAR -- and also compares the two checksums.
+//
+//   simd_kernels            run the checks
+//   simd_kernels --bench    also time reference vs kernel
+//
+// Output (one "key value" pair per line, parsed by test_simd.py):
+//   path      sse2|neon|scalar
+//   checksum  <hex>          FNV-1a over every kernel output
+//   mismatch  <kernel>       (only on failure)
+//   bench     <kernel> <reference ns/sample> <kernel ns/sample>
+//   ok
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../src/gen_dsp/templates/shared/gen_dsp_simd.h"
+
+#define MAX_FRAMES 1031
+#define MAX_CH 8
+
+static uint64_t g_checksum = 1469598103934665603ULL;
+static int g_failures = 0;
+
+static void hash_bytes(const void* p, size_t n)
+{
+    const unsigned char* b = (const unsigned char*)p;
+    for (size_t i = 0; i < n; i++) {
+        g_checksum ^= b[i];
+        g_checksum *= 1099511628211ULL;
+    }
+}
+
+static void check(const char* kernel, const void* expected, const void* actual, size_t bytes)
+{
+    hash_bytes(actual, bytes);
+    if (memcmp(expected, actual, bytes) != 0) {
+        printf("mismatch %s\n", kernel);
+        g_failures++;
+    }
+}
+
+// Deterministic test signal: mostly [-1.5, 1.5] with NaN, +/-inf, exact
+// range edges and denormals sprinkled in
+static uint32_t g_rng = 12345;
+
+static float next_sample(void)
+{
+    g_rng = g_rng * 1664525u + 1013904223u;
+    uint32_t r = g_rng >> 8;
+    switch (r % 61) {
+    case 0: return NAN;
+    case 1: return INFINITY;
+    case 2: return -INFINITY;
+    case 3: return 1.0f;
+    case 4: return -1.0f;
+    case 5: return 1e-40f;
+    default: return ((float)(r & 0xffff) / 65535.0f) * 3.0f - 1.5f;
+    }
+}
+
+static void fill(float* buf, long n)
+{
+    for (long i = 0; i < n; i++) buf[i] = next_sample();
+}
+
+// -- Reference loops (as they stood in the wrappers) ---------------------------
+
+static void ref_deinterleave(const float* src, float** dst, int channels, long frames)
+{
+    for (long i = 0; i < frames; i++)
+        for (int ch = 0; ch < channels; ch++)
+            dst[ch][i] = src[i * channels + ch];
+}
+
+static void ref_interleave(float** src, float* dst, int channels, long frames)
+{
+    for (long i = 0; i < frames; i++)
+        for (int ch = 0; ch < channels; ch++)
+            dst[i * channels + ch] = src[ch][i];
+}
+
+static void ref_float_to_range(float** src, int num_src, unsigned int* dst, int channels, long frames,
+                               int range_min, int range_max)
+{
+    for (long i = 0; i < frames; i++) {
+        for (int ch = 0; ch < channels; ch++) {
+            float sample = 0.0f;
+            if (ch < num_src) sample = src[ch][i];
+            if (sample != sample) sample = 0.0f;  // NaN was undefined; now silence
+            if (sample > 1.0f) sample = 1.0f;
+            if (sample < -1.0f) sample = -1.0f;
+            int n = (int)((sample + 1.0f) / 2.0f * (range_max - range_min) + range_min);
+            dst[i * channels + ch] = (unsigned int)n;
+        }
+    }
+}
+
+static void ref_float_to_s16(const float* src, short* dst, long n)
+{
+    for (long i = 0; i < n; i++) {
+        float x = src[i];
+        if (x != x) x = 0.0f;
+        if (x > 1.0f) x = 1.0f;
+        if (x < -1.0f) x = -1.0f;
+        dst[i] = (short)(x * 32767.0f);
+    }
+}
+
+// -- Checks ----------------------------------------------------------------------
+
+static float g_in[MAX_CH * MAX_FRAMES];
+static float g_planar[MAX_CH][MAX_FRAMES];
+static float g_ref[MAX_CH * MAX_FRAMES];
+static float g_out[MAX_CH * MAX_FRAMES];
+
+static void check_lengths(long n)
+{
+    char name[64];
+
+    // zero / copy_gain
+    fill(g_in, n);
+    for (long i = 0; i < n; i++) g_ref[i] = 0.0f;
+    memset(g_out, 0xff, sizeof(float) * n);
+    gen_dsp_zero(g_out, n);
+    check("zero", g_ref, g_out, sizeof(float) * n);
+
+    for (long i = 0; i < n; i++) g_ref[i] = g_in[i] * 0.7071f;
+    gen_dsp_copy_gain(g_in, g_out, 0.7071f, n);
+    check("copy_gain", g_ref, g_out, sizeof(float) * n);
+
+    // deinterleave / interleave for 1..MAX_CH channels
+    for (int channels = 1; channels <= MAX_CH; channels++) {
+        float* ref_ptrs[MAX_CH];
+        float* out_ptrs[MAX_CH];
+        static float ref_planar[MAX_CH][MAX_FRAMES];
+        for (int ch = 0; ch < channels; ch++) {
+            ref_ptrs[ch] = ref_planar[ch];
+            out_ptrs[ch] = g_planar[ch];
+        }
+        fill(g_in, n * channels);
+        ref_deinterleave(g_in, ref_ptrs, channels, n);
+        gen_dsp_deinterleave(g_in, out_ptrs, channels, n);
+        snprintf(name, sizeof(name), "deinterleave/%d", channels);
+        for (int ch = 0; ch < channels; ch++) check(name, ref_planar[ch], g_planar[ch], sizeof(float) * n);
+
+        ref_interleave(ref_ptrs, g_ref, channels, n);
+        gen_dsp_interleave((const float* const*)ref_ptrs, g_out, channels, n);
+        snprintf(name, sizeof(name), "interleave/%d", channels);
+        check(name, g_ref, g_out, sizeof(float) * n * channels);
+
+        // double host buffers (ChucK with a double SAMPLE)
+        static double dbl[MAX_CH * MAX_FRAMES];
+        static double dbl_ref[MAX_CH * MAX_FRAMES];
+        for (long i = 0; i < n * channels; i++) dbl[i] = (double)g_in[i] * 1.000001;
+        for (long i = 0; i < n; i++)
+            for (int ch = 0; ch < channels; ch++) ref_planar[ch][i] = (float)dbl[i * channels + ch];
+        gen_dsp_deinterleave(dbl, out_ptrs, channels, n);
+        snprintf(name, sizeof(name), "deinterleave_f64/%d", channels);
+        for (int ch = 0; ch < channels; ch++) check(name, ref_planar[ch], g_planar[ch], sizeof(float) * n);
+
+        for (long i = 0; i < n; i++)
+            for (int ch = 0; ch < channels; ch++) dbl_ref[i * channels + ch] = (double)ref_planar[ch][i];
+        gen_dsp_interleave((const float* const*)ref_ptrs, dbl, channels, n);
+        snprintf(name, sizeof(name), "interleave_f64/%d", channels);
+        check(name, dbl_ref, dbl, sizeof(double) * n * channels);
+    }
+
+    // float <-> double (Csound with a double MYFLT)
+    static double d[MAX_FRAMES];
+    static double d_ref[MAX_FRAMES];
+    fill(g_in, n);
+    for (long i = 0; i < n; i++) d_ref[i] = (double)g_in[i];
+    gen_dsp_convert(g_in, d, n);
+    check("convert_f32_f64", d_ref, d, sizeof(double) * n);
+    for (long i = 0; i < n; i++) d[i] = d_ref[i] * 3.3;
+    for (long i = 0; i < n; i++) g_ref[i] = (float)d[i];
+    gen_dsp_convert(d, g_out, n);
+    check("convert_f64_f32", g_ref, g_out, sizeof(float) * n);
+    gen_dsp_convert(g_in, g_out, n);
+    check("convert_f32_f32", g_in, g_out, sizeof(float) * n);
+
+    // float -> device range (Circle); includes a silent channel past the outputs
+    static unsigned int u_ref[MAX_CH * MAX_FRAMES];
+    static unsigned int u_out[MAX_CH * MAX_FRAMES];
+    const int ranges[][2] = {{0, 4095}, {-32767, 32767}, {-8388607, 8388607}, {100, 1123}};
+    for (int channels = 1; channels <= 4; channels++) {
+        for (int num_src = 0; num_src <= channels; num_src++) {
+            for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++) {
+                float* src[MAX_CH];
+                const float* ksrc[MAX_CH];
+                for (int ch = 0; ch < channels; ch++) {
+                    src[ch] = g_planar[ch];
+                    fill(g_planar[ch], n);
+                    ksrc[ch] = ch < num_src ? g_planar[ch] : NULL;
+                }
+                ref_float_to_range(src, num_src, u_ref, channels, n, ranges[r][0], ranges[r][1]);
+                gen_dsp_float_to_range(ksrc, u_out, channels, n, ranges[r][0], ranges[r][1]);
+                snprintf(name, sizeof(name), "float_to_range/%d/%d/%d", channels, num_src, ranges[r][1]);
+                check(name, u_ref, u_out, sizeof(unsigned int) * n * channels);
+            }
+        }
+    }
+
+    // float <-> int16
+    static short s_ref[MAX_FRAMES];
+    static short s_out[MAX_FRAMES];
+    fill(g_in, n);
+    ref_float_to_s16(g_in, s_ref, n);
+    gen_dsp_float_to_s16(g_in, s_out, n);
+    check("float_to_s16", s_ref, s_out, sizeof(short) * n);
+
+    for (long i = 0; i < n; i++) s_out[i] = (short)(i * 977 - 32768);
+    if (n > 1) {
+        s_out[0] = -32768;
+        s_out[1] = 32767;
+    }
+    for (long i = 0; i < n; i++) g_ref[i] = (float)s_out[i] / 32768.0f;
+    gen_dsp_s16_to_float(s_out, g_out, n);
+    check("s16_to_float", g_ref, g_out, sizeof(float) * n);
+}
+
+// -- Benchmark -------------------------------------------------------------------
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+#define BENCH_FRAMES 256
+#define BENCH_ITERS 20000
+
+// Fastest of five repeats, in ns per frame
+#define TIME_NS(expr)                                                    \
+    ({                                                                   \
+        uint64_t best = UINT64_MAX;                                      \
+        for (int rep = 0; rep < 5; rep++) {                              \
+            uint64_t t0 = now_ns();                                      \
+            for (int it = 0; it < BENCH_ITERS; it++) {                   \
+                expr;                                                    \
+                __asm__ __volatile__("" ::: "memory");                   \
+            }                                                            \
+            uint64_t dt = now_ns() - t0;                                 \
+            if (dt < best) best = dt;                                    \
+        }                                                                \
+        (double)best / ((double)BENCH_ITERS * BENCH_FRAMES);             \
+    })
+
+// Opaque to the optimiser so the kernels are not specialised for one length
+static volatile long g_bench_frames = BENCH_FRAMES;
+
+static void bench(void)
+{
+    const long n = g_bench_frames;
+    float* planar[2] = {g_planar[0], g_planar[1]};
+    const float* cplanar[2] = {g_planar[0], g_planar[1]};
+    static unsigned int u[2 * BENCH_FRAMES];
+    static short s[BENCH_FRAMES];
+    static double d[BENCH_FRAMES];
+
+    fill(g_in, 2 * n);
+    fill(g_planar[0], n);
+    fill(g_planar[1], n);
+
+    printf("bench deinterleave/2 %.4f %.4f\n", TIME_NS(ref_deinterleave(g_in, planar, 2, n)),
+           TIME_NS(gen_dsp_deinterleave(g_in, planar, 2, n)));
+    printf("bench interleave/2 %.4f %.4f\n", TIME_NS(ref_interleave(planar, g_out, 2, n)),
+           TIME_NS(gen_dsp_interleave(cplanar, g_out, 2, n)));
+    printf("bench float_to_range/2 %.4f %.4f\n",
+           TIME_NS(ref_float_to_range(planar, 2, u, 2, n, -8388607, 8388607)),
+           TIME_NS(gen_dsp_float_to_range(cplanar, u, 2, n, -8388607, 8388607)));
+    printf("bench float_to_s16 %.4f %.4f\n", TIME_NS(ref_float_to_s16(g_in, s, n)),
+           TIME_NS(gen_dsp_float_to_s16(g_in, s, n)));
+    printf("bench convert_f32_f64 %.4f %.4f\n",
+           TIME_NS(for (long i = 0; i < n; i++) d[i] = (double)g_in[i]),
+           TIME_NS(gen_dsp_convert(g_in, d, n)));
+}
+
+int main(int argc, char** argv)
+{
+#if defined(GEN_DSP_SIMD_SSE2)
+    printf("path sse2\n");
+#elif defined(GEN_DSP_SIMD_NEON)
+    printf("path neon\n");
+#else
+    printf("path scalar\n");
+#endif
+
+    const long lengths[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 63, 64, 65, 255, 1031};
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) check_lengths(lengths[i]);
+
+    printf("checksum %016llx\n", (unsigned long long)g_checksum);
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) bench();
+
+    if (g_failures) return 1;
+    printf("ok\n");
+    return 0;
+}
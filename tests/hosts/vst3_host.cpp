@@ -0,0 +1,138 @@
+// vst3_host.cpp - Minimal headless VST3 host for wrapper-overhead benchmarks
+//
+// Loads a built .vst3 bundle through the SDK's hosting classes
+// (VST3::Hosting::Module, HostProcessData, ParameterChanges), instantiates
+// the first audio effect class and drives IAudioProcessor::process() with
+// the shared bench.h schedule. Parameter changes are delivered as one
+// queue point in inputParameterChanges, normalized through the plugin's
+// own IEditController as a DAW would.
+
+#include "public.sdk/source/vst/hosting/hostclasses.h"
+#include "public.sdk/source/vst/hosting/module.h"
+#include "public.sdk/source/vst/hosting/parameterchanges.h"
+#include "public.sdk/source/vst/hosting/processdata.h"
+#include "pluginterfaces/vst/ivstaudioprocessor.h"
+#include "pluginterfaces/vst/ivstcomponent.h"
+#include "pluginterfaces/vst/ivsteditcontroller.h"
+
+#include <string>
+
+#include "bench.h"
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+struct Vst3Ctx {
+    IAudioProcessor* processor;
+    IEditController* controller;
+    HostProcessData* data;
+    ParameterChanges* changes;
+    ParamID paramId;
+};
+
+static void vst3_block(void* p, int change, float value)
+{
+    Vst3Ctx* c = (Vst3Ctx*)p;
+    c->changes->clearQueue();
+    if (change) {
+        int32 queueIndex = 0;
+        int32 pointIndex = 0;
+        IParamValueQueue* queue = c->changes->addParameterData(c->paramId, queueIndex);
+        if (queue) {
+            ParamValue norm = c->controller
+                ? c->controller->plainParamToNormalized(c->paramId, value)
+                : value;
+            queue->addPoint(0, norm, pointIndex);
+        }
+    }
+    c->processor->process(*c->data);
+}
+
+static SpeakerArrangement arrangement_for(int channels)
+{
+    if (channels == 1) return SpeakerArr::kMono;
+    if (channels == 2) return SpeakerArr::kStereo;
+    SpeakerArrangement arr = 0;
+    for (int i = 0; i < channels; i++) arr |= (SpeakerArrangement)1 << i;
+    return arr;
+}
+
+int main(int argc, char** argv)
+{
+    bench_args args;
+    if (bench_parse(argc, argv, &args) != 0 || !args.path) {
+        fprintf(stderr, "usage: vst3_host [options] <plugin.vst3>\n");
+        return 2;
+    }
+
+    std::string error;
+    VST3::Hosting::Module::Ptr module = VST3::Hosting::Module::create(args.path, error);
+    if (!module) {
+        fprintf(stderr, "module load failed: %s\n", error.c_str());
+        return 1;
+    }
+
+    HostApplication hostApp;
+    VST3::Hosting::PluginFactory factory = module->getFactory();
+    IPtr<IComponent> component;
+    for (const auto& info : factory.classInfos()) {
+        if (info.category() == kVstAudioEffectClass) {
+            component = factory.createInstance<IComponent>(info.ID());
+            if (component) break;
+        }
+    }
+    if (!component || component->initialize(&hostApp) != kResultOk) {
+        fprintf(stderr, "no audio effect component\n");
+        return 1;
+    }
+
+    FUnknownPtr<IAudioProcessor> processor(component);
+    FUnknownPtr<IEditController> controller(component);
+    if (!processor) {
+        fprintf(stderr, "component is not an IAudioProcessor\n");
+        return 1;
+    }
+
+    SpeakerArrangement inArr = arrangement_for(args.num_inputs);
+    SpeakerArrangement outArr = arrangement_for(args.num_outputs);
+    processor->setBusArrangements(args.num_inputs > 0 ? &inArr : nullptr,
+                                  args.num_inputs > 0 ? 1 : 0, &outArr, 1);
+    if (args.num_inputs > 0) component->activateBus(kAudio, kInput, 0, true);
+    component->activateBus(kAudio, kOutput, 0, true);
+
+    ProcessSetup setup{kRealtime, kSample32, args.block_size, args.sample_rate};
+    if (processor->setupProcessing(setup) != kResultOk
+        || component->setActive(true) != kResultOk) {
+        fprintf(stderr, "setupProcessing/setActive failed\n");
+        return 1;
+    }
+    processor->setProcessing(true);
+
+    HostProcessData data;
+    data.prepare(*component, args.block_size, kSample32);
+    data.numSamples = args.block_size;
+    if (data.numInputs > 0) {
+        bench_fill_noise(data.inputs[0].channelBuffers32,
+                         data.inputs[0].numChannels, args.block_size);
+    }
+
+    ParameterChanges changes(1);
+    data.inputParameterChanges = &changes;
+
+    Vst3Ctx ctx;
+    ctx.processor = processor;
+    ctx.controller = controller;
+    ctx.data = &data;
+    ctx.changes = &changes;
+    ctx.paramId = (ParamID)(args.param_index >= 0 ? args.param_index : 0);
+
+    double ns = bench_run(&args, vst3_block, &ctx);
+    bench_report(ns, data.outputs[0].channelBuffers32,
+                 data.outputs[0].numChannels, args.block_size);
+
+    processor->setProcessing(false);
+    component->setActive(false);
+    data.unprepare();
+    component->terminate();
+    return 0;
+}
@@ -97,6 +97,19 @@ class TestClapProjectGeneration:
         buffer_h = (project_dir / "gen_buffer.h").read_text()
         assert "WRAPPER_BUFFER_COUNT 0" in buffer_h
 
+    def test_param_ramp_in_process_only(self, gigaverb_export: Path, tmp_project: Path):
+        """Test automation ramps across the process block; flush applies it."""
+        export_info = GenExportParser(gigaverb_export).parse()
+        config = ProjectConfig(name="testverb", platform="clap")
+        project_dir = ProjectGenerator(export_info, config).generate(tmp_project)
+
+        wrapper = (project_dir / "gen_ext_clap.cpp").read_text()
+        flush, _, process = wrapper.partition("clap_gen_process(")
+        flush = flush[flush.index("static void params_flush(") :]
+        assert "_ramp(" not in flush
+        assert "wrapper_set_param(plug->genState, idx" in flush
+        assert "wrapper_set_param_ramp(plug->genState, idx" in process
+
     def test_generate_clap_project_with_buffers(
         self, rampleplayer_export: Path, tmp_project: Path
     ):
@@ -0,0 +1,157 @@
+"""Tests for gen_dsp.core.cost module."""
+
+import json
+from pathlib import Path
+
+import pytest
+
+from gen_dsp.cli import main
+from gen_dsp.core.cost import (
+    TARGETS,
+    CostReport,
+    MemoryItem,
+    OpCounts,
+    check_budget,
+    check_capacity,
+    count_code_ops,
+    export_cost,
+    parse_size,
+)
+from gen_dsp.core.parser import GenExportParser
+
+
+class TestParseSize:
+    """Tests for budget size parsing."""
+
+    @pytest.mark.parametrize(
+        "text,expected",
+        [("512", 512), ("64K", 65536), ("64kb", 65536), ("1.5M", 1572864)],
+    )
+    def test_parse_size(self, text: str, expected: int):
+        assert parse_size(text) == expected
+
+    def test_parse_size_invalid(self):
+        with pytest.raises(ValueError):
+            parse_size("lots")
+
+
+class TestCountCodeOps:
+    """Tests for per-statement operation counting."""
+
+    def test_arithmetic(self):
+        ops = count_code_ops("t_sample x = ((a * b) + (c / d));")
+        assert ops.mul == 1
+        assert ops.add == 1
+        assert ops.div == 1
+
+    def test_math_calls(self):
+        ops = count_code_ops("t_sample y = sin(x); t_sample z = exp(y);")
+        assert ops.math == 2
+
+    def test_pointer_declarations_not_counted(self):
+        ops = count_code_ops("t_sample * out1 = __outs[0];")
+        assert ops.mul == 0
+
+
+class TestExportCost:
+    """Tests for the gen~ export cost report."""
+
+    def test_gigaverb_delays(self, gigaverb_export: Path):
+        report = export_cost(GenExportParser(gigaverb_export).parse())
+
+        delays = [i for i in report.items if i.kind == "delay"]
+        assert delays
+        for item in delays:
+            # genlib Delay rounds its allocation up to a power of two
+            assert item.bytes is not None
+            assert item.bytes & (item.bytes - 1) == 0
+        assert report.delay_bytes == sum(i.bytes or 0 for i in delays)
+        assert report.state_bytes > 0
+        assert report.ops.flops > 0
+
+    def test_slicer_storage(self, slicer_export: Path):
+        report = export_cost(GenExportParser(slicer_export).parse())
+
+        storage = next(i for i in report.items if i.name == "storage")
+        assert storage.bytes == 100000 * 4
+
+    def test_host_sized_buffer(self, rampleplayer_export: Path):
+        report = export_cost(GenExportParser(rampleplayer_export).parse())
+
+        sample = next(i for i in report.items if i.name == "sample")
+        assert sample.kind == "buffer"
+        assert sample.bytes is None
+        assert report.total_bytes == report.state_bytes
+
+    def test_sample_rate_scales_delays(self, gigaverb_export: Path):
+        info = GenExportParser(gigaverb_export).parse()
+        low = export_cost(info, sample_rate=44100.0)
+        high = export_cost(info, sample_rate=96000.0)
+        assert high.delay_bytes >= low.delay_bytes
+
+
+class TestCheckBudget:
+    """Tests for budget checks."""
+
+    def _report(self) -> CostReport:
+        report = CostReport("t", 48000.0, 64, state_bytes=100)
+        report.items.append(MemoryItem("d", "delay", 1 << 20))
+        report.ops = OpCounts(add=1000.0, mul=1000.0)
+        return report
+
+    def test_within_budget(self):
+        assert check_budget(self._report(), ["desktop"], 2 << 20, 50.0) == []
+
+    def test_memory_exceeded(self):
+        failures = check_budget(self._report(), [], 64 * 1024, None)
+        assert len(failures) == 1
+        assert "memory" in failures[0]
+
+    def test_cpu_exceeded_per_target(self):
+        failures = check_budget(self._report(), ["desktop", "daisy"], None, 1.0)
+        assert any("daisy" in f for f in failures)
+
+    def test_capacity_is_a_warning(self):
+        """Target memory is reported, not enforced, without --max-memory."""
+        report = self._report()
+        report.items.append(MemoryItem("big", "data", 100 << 20))
+        assert check_budget(report, ["daisy"]) == []
+        warnings = check_capacity(report, ["desktop", "daisy"])
+        assert len(warnings) == 1
+        assert warnings[0].startswith("daisy: memory")
+
+    def test_slower_target_costs_more(self):
+        ops = self._report().ops
+        assert TARGETS["daisy"].cpu_percent(ops, 48000) > TARGETS[
+            "desktop"
+        ].cpu_percent(ops, 48000)
+
+
+class TestDetectCost:
+    """Tests for detect --cost."""
+
+    def test_text_output(self, gigaverb_export: Path, capsys):
+        result = main(["detect", str(gigaverb_export), "--cost"])
+
+        assert result == 0
+        out = capsys.readouterr().out
+        assert "Cost estimate:" in out
+        assert "Delays:" in out
+        assert "daisy" in out
+
+    def test_json_output(self, gigaverb_export: Path, capsys):
+        result = main(
+            ["detect", str(gigaverb_export), "--cost", "--json", "--target", "circle"]
+        )
+
+        assert result == 0
+        data = json.loads(capsys.readouterr().out)
+        assert data["memory"]["delay_bytes"] > 0
+        assert list(data["targets"]) == ["circle"]
+        assert data["budget_failures"] == []
+
+    def test_budget_failure_exits_1(self, gigaverb_export: Path, capsys):
+        result = main(["detect", str(gigaverb_export), "--cost", "--max-memory", "64K"])
+
+        assert result == 1
+        assert "Budget exceeded" in capsys.readouterr().err
@@ -0,0 +1,309 @@
+"""Tests for the shared library (C ABI) platform implementation."""
+
+import os
+import shutil
+import subprocess
+from pathlib import Path
+
+import pytest
+
+from gen_dsp.core.parser import GenExportParser
+from gen_dsp.core.project import ProjectConfig, ProjectGenerator
+from gen_dsp.platforms import (
+    PLATFORM_REGISTRY,
+    LibPlatform,
+    get_platform,
+)
+from gen_dsp.platforms.lib import LIB_API_VERSION
+
+# Skip integration tests if the toolchain is not available
+_has_cmake = shutil.which("cmake") is not None
+_has_cc = shutil.which("cc") is not None
+_has_pkg_config = shutil.which("pkg-config") is not None
+_skip_no_build = pytest.mark.skipif(
+    not (_has_cmake and _has_cc), reason="cmake or cc not found"
+)
+_skip_no_pkg_config = pytest.mark.skipif(
+    not (_has_cmake and _has_cc and _has_pkg_config),
+    reason="cmake, cc, or pkg-config not found",
+)
+
+# C client exercising the whole API against gigaverb (2in/2out).
+# Prints one "key value" line per check so failures are easy to read.
+_GIGAVERB_CLIENT = r"""
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gendsp_gigaverb.h"
+
+#define N 1000
+#define STREAMS 3
+
+int main(void) {
+    static float in[2][N], ref[2][N], batch[STREAMS][2][N];
+    const float* ins[2] = {in[0], in[1]};
+    float* refs[2] = {ref[0], ref[1]};
+    const float* const* batch_ins[STREAMS];
+    float* batch_ch[STREAMS][2];
+    float* const* batch_outs[STREAMS];
+    gendsp_gigaverb* single;
+    gendsp_gigaverb_pool* pool;
+    void* state;
+    size_t size;
+    int i, s, idx, same = 1, nonzero = 0;
+
+    printf("api %d %d\n", gendsp_gigaverb_api_version(),
+           GENDSP_GIGAVERB_API_VERSION);
+    printf("io %d %d\n", gendsp_gigaverb_num_inputs(),
+           gendsp_gigaverb_num_outputs());
+
+    for (i = 0; i < N; i++)
+        in[0][i] = in[1][i] = (float)((i * 7919) % 200 - 100) / 100.0f;
+
+    /* Reference: one instance, block size smaller than N (chunked) */
+    single = gendsp_gigaverb_create(48000.0f, 64);
+    printf("process %d\n", gendsp_gigaverb_process(single, ins, refs, N));
+    printf("process_null %d\n", gendsp_gigaverb_process(NULL, ins, refs, N));
+
+    /* Pool of independent streams in one call must match the reference */
+    pool = gendsp_gigaverb_pool_create(STREAMS, 48000.0f, 256);
+    printf("pool %d\n", gendsp_gigaverb_pool_size(pool));
+    for (s = 0; s < STREAMS; s++) {
+        batch_ins[s] = ins;
+        batch_ch[s][0] = batch[s][0];
+        batch_ch[s][1] = batch[s][1];
+        batch_outs[s] = batch_ch[s];
+    }
+    printf("pool_process %d\n",
+           gendsp_gigaverb_pool_process(pool, batch_ins, batch_outs, N));
+    for (s = 0; s < STREAMS; s++)
+        same &= memcmp(batch[s], ref, sizeof(ref)) == 0;
+    printf("batch_matches %d\n", same);
+    for (i = 0; i < N; i++)
+        nonzero += ref[0][i] != 0.0f;
+    printf("output_nonzero %d\n", nonzero > N / 2);
+
+    /* Parameters and state round-trip between instances */
+    idx = gendsp_gigaverb_param_index(single, "revtime");
+    printf("param_index %d %d\n", idx, gendsp_gigaverb_param_index(single, "nope"));
+    gendsp_gigaverb_set_param(single, idx, 0.25f);
+    size = gendsp_gigaverb_state_size();
+    state = malloc(size);
+    printf("save_short %d\n", (int)gendsp_gigaverb_save_state(single, state, size - 1));
+    printf("save %d\n", gendsp_gigaverb_save_state(single, state, size) == size);
+    printf("load %d\n",
+           gendsp_gigaverb_load_state(gendsp_gigaverb_pool_get(pool, 1), state, size));
+    printf("loaded %g\n",
+           gendsp_gigaverb_get_param(gendsp_gigaverb_pool_get(pool, 1), idx));
+    memset(state, 0, size);
+    printf("load_bad %d\n", gendsp_gigaverb_load_state(single, state, size));
+    printf("pool_get_oob %d\n", gendsp_gigaverb_pool_get(pool, STREAMS) == NULL);
+
+    free(state);
+    gendsp_gigaverb_pool_destroy(pool);
+    gendsp_gigaverb_destroy(single);
+    return 0;
+}
+"""
+
+
+def _generate_gigaverb(gigaverb_export: Path, project_dir: Path) -> Path:
+    parser = GenExportParser(gigaverb_export)
+    export_info = parser.parse()
+    config = ProjectConfig(name="gigaverb", platform="lib")
+    return ProjectGenerator(export_info, config).generate(project_dir)
+
+
+def _run(cmd: list[str], cwd: Path, **kwargs: object) -> str:
+    result = subprocess.run(
+        cmd, cwd=cwd, capture_output=True, text=True, timeout=300, check=False, **kwargs
+    )
+    assert result.returncode == 0, (
+        f"{cmd[0]} failed:\nstdout: {result.stdout}\nstderr: {result.stderr}"
+    )
+    return result.stdout
+
+
+def _parse_report(stdout: str) -> dict[str, str]:
+    report = {}
+    for line in stdout.splitlines():
+        key, _, value = line.partition(" ")
+        report[key] = value
+    return report
+
+
+class TestLibPlatform:
+    """Test lib platform registry and basic properties."""
+
+    def test_registry_contains_lib(self):
+        """Test that lib is in the registry."""
+        assert "lib" in PLATFORM_REGISTRY
+        assert PLATFORM_REGISTRY["lib"] == LibPlatform
+
+    def test_get_platform_lib(self):
+        """Test getting lib platform instance."""
+        platform = get_platform("lib")
+        assert isinstance(platform, LibPlatform)
+        assert platform.name == "lib"
+
+    def test_lib_extension(self):
+        """Test shared library extension."""
+        assert LibPlatform().extension in (".so", ".dylib", ".dll")
+
+    def test_lib_build_instructions(self):
+        """Test lib build instructions mention install."""
+        instructions = LibPlatform().get_build_instructions()
+        assert any("cmake --build" in i for i in instructions)
+        assert any("cmake --install" in i for i in instructions)
+
+
+class TestLibProjectGeneration:
+    """Test lib project generation."""
+
+    def test_generate_project_gigaverb(self, gigaverb_export: Path, tmp_project: Path):
+        """Test generating lib project from gigaverb (no buffers)."""
+        project_dir = _generate_gigaverb(gigaverb_export, tmp_project)
+
+        assert (project_dir / "CMakeLists.txt").is_file()
+        assert (project_dir / "gen_ext_lib.cpp").is_file()
+        assert (project_dir / "_ext_lib.cpp").is_file()
+        assert (project_dir / "_ext_lib.h").is_file()
+        assert (project_dir / "gen_ext_common_lib.h").is_file()
+        assert (project_dir / "lib_buffer.h").is_file()
+        assert (project_dir / "gendsp.pc.in").is_file()
+        assert (project_dir / "include" / "gendsp_gigaverb.h").is_file()
+        assert (project_dir / "gen").is_dir()
+
+    def test_public_header_content(self, gigaverb_export: Path, tmp_project: Path):
+        """The public header is plain C with prefixed, exported symbols."""
+        project_dir = _generate_gigaverb(gigaverb_export, tmp_project)
+
+        header = (project_dir / "include" / "gendsp_gigaverb.h").read_text()
+        assert f"#define GENDSP_GIGAVERB_API_VERSION {LIB_API_VERSION}" in header
+        assert 'extern "C"' in header
+        assert "typedef struct gendsp_gigaverb gendsp_gigaverb;" in header
+        assert "gendsp_gigaverb_process_batch(" in header
+        assert "gendsp_gigaverb_pool_create(" in header
+        assert "gendsp_gigaverb_save_state(" in header
+        assert "GENDSP_GIGAVERB_API gendsp_gigaverb* gendsp_gigaverb_create(" in header
+        # No unexpanded template variables
+        assert "$lib" not in header
+
+    def test_cmakelists_content(self, gigaverb_export: Path, tmp_project: Path):
+        """Test that CMakeLists.txt builds a versioned, installable library."""
+        project_dir = _generate_gigaverb(gigaverb_export, tmp_project)
+
+        cmake = (project_dir / "CMakeLists.txt").read_text()
+        assert "set(GENDSP_LIB_TARGET gendsp_gigaverb)" in cmake
+        assert "SHARED" in cmake
+        assert "LIB_EXT_NAME=gigaverb" in cmake
+        assert "GENDSP_GIGAVERB_BUILDING" in cmake
+        assert f"SOVERSION {LIB_API_VERSION}" in cmake
+        assert "CXX_VISIBILITY_PRESET hidden" in cmake
+        assert "pkgconfig" in cmake
+        assert "genlib.cpp" in cmake
+
+
+class TestLibBuildIntegration:
+    """Integration tests that build the library and link C clients against it.
+
+    Skipped when cmake or cc is not available.
+    """
+
+    @_skip_no_build
+    def test_build_and_link_from_c(self, gigaverb_export: Path, tmp_path: Path):
+        """Build gigaverb, link a C program, and exercise the full API."""
+        project_dir = _generate_gigaverb(gigaverb_export, tmp_path / "gigaverb")
+        _run(["cmake", ".."], project_dir / "build")
+        _run(["cmake", "--build", "."], project_dir / "build")
+
+        lib = LibPlatform().find_output(project_dir)
+        assert lib is not None
+
+        src = tmp_path / "client.c"
+        src.write_text(_GIGAVERB_CLIENT)
+        exe = tmp_path / "client"
+        _run(
+            [
+                "cc",
+                "-std=c99",
+                "-Wall",
+                "-Werror",
+                f"-I{project_dir / 'include'}",
+                str(src),
+                f"-L{lib.parent}",
+                "-lgendsp_gigaverb",
+                "-o",
+                str(exe),
+            ],
+            tmp_path,
+        )
+        env = dict(os.environ, LD_LIBRARY_PATH=str(lib.parent))
+        report = _parse_report(_run([str(exe)], tmp_path, env=env))
+
+        assert report["api"] == f"{LIB_API_VERSION} {LIB_API_VERSION}"
+        assert report["io"] == "2 2"
+        assert report["process"] == "0"
+        assert report["process_null"] == "-1"
+        assert report["pool"] == "3"
+        assert report["pool_process"] == "0"
+        assert report["batch_matches"] == "1"
+        assert report["output_nonzero"] == "1"
+        assert report["param_index"].split()[1] == "-1"
+        assert report["save_short"] == "0"
+        assert report["save"] == "1"
+        assert report["load"] == "0"
+        assert float(report["loaded"]) == pytest.approx(0.25)
+        assert report["load_bad"] == "-1"
+        assert report["pool_get_oob"] == "1"
+
+    @_skip_no_build
+    def test_only_c_api_exported(self, gigaverb_export: Path, tmp_path: Path):
+        """genlib internals (including its operator new) stay hidden."""
+        if shutil.which("nm") is None:
+            pytest.skip("nm not found")
+        project_dir = _generate_gigaverb(gigaverb_export, tmp_path / "gigaverb")
+        _run(["cmake", ".."], project_dir / "build")
+        _run(["cmake", "--build", "."], project_dir / "build")
+
+        lib = LibPlatform().find_output(project_dir)
+        assert lib is not None
+        nm_args = ["nm", "-g", "--defined-only"]
+        if lib.suffix == ".so":
+            nm_args.insert(1, "-D")
+        symbols = [
+            line.split()[-1].lstrip("_")
+            for line in _run([*nm_args, str(lib)], tmp_path).splitlines()
+            if line.strip()
+        ]
+        assert "gendsp_gigaverb_process_batch" in symbols
+        assert all(s.startswith("gendsp_gigaverb_") for s in symbols), symbols
+
+    @_skip_no_pkg_config
+    def test_install_and_pkg_config(self, gigaverb_export: Path, tmp_path: Path):
+        """Installed library is found through pkg-config from any prefix."""
+        project_dir = _generate_gigaverb(gigaverb_export, tmp_path / "gigaverb")
+        prefix = tmp_path / "prefix"
+        _run(["cmake", ".."], project_dir / "build")
+        _run(["cmake", "--build", "."], project_dir / "build")
+        _run(
+            ["cmake", "--install", ".", "--prefix", str(prefix)], project_dir / "build"
+        )
+
+        pc_files = list(prefix.glob("**/pkgconfig/gendsp_gigaverb.pc"))
+        assert len(pc_files) == 1
+        env = dict(os.environ, PKG_CONFIG_PATH=str(pc_files[0].parent))
+        flags = _run(
+            ["pkg-config", "--cflags", "--libs", "gendsp_gigaverb"], tmp_path, env=env
+        ).split()
+        assert "-lgendsp_gigaverb" in flags
+
+        src = tmp_path / "client.c"
+        src.write_text(_GIGAVERB_CLIENT)
+        exe = tmp_path / "client"
+        _run(["cc", "-std=c99", str(src), *flags, "-o", str(exe)], tmp_path)
+
+        libdir = next(f[2:] for f in flags if f.startswith("-L"))
+        env["LD_LIBRARY_PATH"] = libdir
+        report = _parse_report(_run([str(exe)], tmp_path, env=env))
+        assert report["batch_matches"] == "1"
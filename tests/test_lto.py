@@ -0,0 +1,159 @@
+"""Tests for link-time optimised builds (GEN_DSP_LTO / gen-dsp build --lto)."""
+
+import os
+import shutil
+import subprocess
+from pathlib import Path
+
+import pytest
+
+from gen_dsp.cli import main
+from gen_dsp.core.builder import Builder, BuildResult
+from gen_dsp.core.parser import GenExportParser
+from gen_dsp.core.project import ProjectConfig, ProjectGenerator
+from gen_dsp.errors import BuildError
+from gen_dsp.platforms import get_platform
+
+# Skip integration tests if the toolchain is not available
+_has_cmake = shutil.which("cmake") is not None
+_has_make = shutil.which("make") is not None
+_has_nm = shutil.which("nm") is not None
+_has_cxx = shutil.which("g++") is not None or shutil.which("clang++") is not None
+_skip_no_cmake = pytest.mark.skipif(
+    not (_has_cmake and _has_cxx and _has_nm),
+    reason="cmake, nm or C++ compiler not found",
+)
+_skip_no_make = pytest.mark.skipif(
+    not (_has_make and _has_cxx), reason="make or C++ compiler not found"
+)
+
+_CMAKE_PLATFORMS = ["au", "auv3", "clap", "lib", "lv2", "max", "sc", "vst3"]
+_MAKE_FILES = {
+    "standalone": "Makefile",
+    "csound": "Makefile",
+    "pd": "Makefile",
+    "webaudio": "Makefile",
+    "vcvrack": "Makefile",
+    "daisy": "Makefile",
+    "chuck": "makefile",
+}
+
+
+def _generate(export: Path, platform: str, project_dir: Path) -> Path:
+    export_info = GenExportParser(export).parse()
+    config = ProjectConfig(name="gigaverb", platform=platform)
+    return ProjectGenerator(export_info, config).generate(project_dir)
+
+
+class TestLtoProjectFiles:
+    """Generated build files honour GEN_DSP_LTO."""
+
+    @pytest.mark.parametrize("platform", _CMAKE_PLATFORMS)
+    def test_cmake_includes_module(
+        self, platform: str, gigaverb_export: Path, tmp_path: Path
+    ):
+        project_dir = _generate(gigaverb_export, platform, tmp_path / platform)
+        assert (project_dir / "gen_dsp_lto.cmake").exists()
+        cmakelists = (project_dir / "CMakeLists.txt").read_text()
+        assert "gen_dsp_lto.cmake" in cmakelists
+        assert "gen_dsp_enable_lto(" in cmakelists
+        # LTO must come after PGO so it covers the shared kernel objects
+        if "gen_dsp_enable_pgo(" in cmakelists:
+            assert cmakelists.index("gen_dsp_enable_pgo(") < cmakelists.index(
+                "gen_dsp_enable_lto("
+            )
+
+    @pytest.mark.parametrize("platform", sorted(_MAKE_FILES))
+    def test_makefile_honours_variable(
+        self, platform: str, gigaverb_export: Path, tmp_path: Path
+    ):
+        project_dir = _generate(gigaverb_export, platform, tmp_path / platform)
+        makefile = (project_dir / _MAKE_FILES[platform]).read_text()
+        assert "GEN_DSP_LTO" in makefile
+        assert "-flto" in makefile
+
+    def test_chuck_static_uses_lto_archiver(
+        self, gigaverb_export: Path, tmp_path: Path
+    ):
+        project_dir = _generate(gigaverb_export, "chuck", tmp_path / "chuck")
+        makefile = (project_dir / "makefile").read_text()
+        assert "gcc-ar" in makefile
+        assert "$(AR) rv" in makefile
+        assert "\tar rv" not in makefile
+
+    def test_circle_not_supported(self, tmp_path: Path):
+        assert not get_platform("circle").supports_lto
+        project_dir = tmp_path / "circle"
+        project_dir.mkdir()
+        with pytest.raises(BuildError, match="not supported"):
+            Builder(project_dir).build(target_platform="circle", lto=True)
+
+
+class TestBuilderLto:
+    """Builder passes GEN_DSP_LTO to the build tools."""
+
+    def test_environment_set_and_restored(
+        self, tmp_path: Path, monkeypatch: pytest.MonkeyPatch
+    ):
+        monkeypatch.delenv("GEN_DSP_LTO", raising=False)
+        seen = []
+
+        def fake_build(self, project_dir, clean=False, verbose=False):
+            seen.append(os.environ.get("GEN_DSP_LTO"))
+            return BuildResult(True, self.name, None, "", "", 0)
+
+        monkeypatch.setattr(type(get_platform("lib")), "build", fake_build)
+
+        Builder(tmp_path).build(target_platform="lib", lto=True)
+        Builder(tmp_path).build(target_platform="lib")
+
+        assert seen == ["1", None]
+        assert "GEN_DSP_LTO" not in os.environ
+
+    def test_cli_dry_run_mentions_lto(
+        self, gigaverb_export: Path, tmp_path: Path, capsys
+    ):
+        result = main(
+            [
+                str(gigaverb_export),
+                "-p",
+                "lib",
+                "-o",
+                str(tmp_path / "out"),
+                "--lto",
+                "--dry-run",
+            ]
+        )
+        assert result == 0
+        assert "(LTO)" in capsys.readouterr().out
+
+
+class TestLtoBuildIntegration:
+    """Full builds with link-time optimisation."""
+
+    @_skip_no_cmake
+    def test_lib_wrapper_calls_inlined(self, gigaverb_export: Path, tmp_path: Path):
+        project_dir = _generate(gigaverb_export, "lib", tmp_path / "lib")
+
+        result = Builder(project_dir).build(target_platform="lib", lto=True)
+        assert result.success, result.stderr
+        assert result.output_file is not None
+
+        # wrapper_* live in _ext_lib.cpp and are called from gen_ext_lib.cpp;
+        # with LTO they are inlined into the C API and no symbol survives
+        symbols = subprocess.run(
+            ["nm", "-C", str(result.output_file)],
+            capture_output=True,
+            text=True,
+            check=True,
+        ).stdout
+        assert "wrapper_perform" not in symbols
+        assert "wrapper_set_param" not in symbols
+
+    @_skip_no_make
+    def test_pd_lto_build(self, gigaverb_export: Path, tmp_path: Path):
+        project_dir = _generate(gigaverb_export, "pd", tmp_path / "pd")
+
+        result = Builder(project_dir).build(target_platform="pd", lto=True)
+        assert result.success, result.stderr
+        assert result.output_file is not None
@@ -84,6 +84,23 @@ class TestLv2Platform:
 class TestLv2ProjectGeneration:
     """Test LV2 project generation."""
 
+    def test_first_run_does_not_ramp_from_defaults(
+        self, gigaverb_export: Path, tmp_project: Path
+    ):
+        """Control ports ramp per run, except on the first run after activate."""
+        parser = GenExportParser(gigaverb_export)
+        config = ProjectConfig(name="testverb", platform="lv2")
+        project_dir = ProjectGenerator(parser.parse(), config).generate(tmp_project)
+
+        src = (project_dir / "gen_ext_lv2.cpp").read_text()
+        activate = src.split("lv2_gen_activate(LV2_Handle instance)")[1]
+        assert "plug->paramsPrimed = false;" in activate.split("\n}")[0]
+        assert "int rampLen = plug->paramsPrimed ? (int)sample_count : 0;" in src
+        assert (
+            "*(plug->control_in[i]),\n                                   rampLen);"
+            in src
+        )
+
     def test_generate_lv2_project_no_buffers(
         self, gigaverb_export: Path, tmp_project: Path
     ):
@@ -71,6 +71,18 @@ class TestGenExportParser:
         assert "storage" in info.buffers
         assert len(info.buffers) == 1
 
+    def test_parse_state_layout(self, slicer_export: Path):
+        """Test State members, reset() allocations and the per-sample loop."""
+        info = GenExportParser(slicer_export).parse()
+
+        assert info.state is not None
+        assert ("Data", "m_storage_3") in info.state.members
+        alloc = next(a for a in info.state.allocations if a[1] == "storage")
+        assert alloc[0] == "m_storage_3"
+        assert alloc[2] == ["((int)100000)", "((int)1)"]
+        assert info.state.perform_loop is not None
+        assert "__n--" not in info.state.perform_loop
+
     def test_parse_invalid_path_raises_error(self, tmp_path: Path):
         """Test that parsing non-existent path raises ParseError."""
         with pytest.raises(ParseError, match="not a directory"):
@@ -1,10 +1,28 @@
 """Tests for gen_dsp.core.patcher module."""
 
+import ctypes
+import os
+import random
 import shutil
+import statistics
+import time
 from pathlib import Path
 
+import pytest
 
-from gen_dsp.core.patcher import Patcher, PatchResult
+from gen_dsp.cli import main
+from gen_dsp.core.builder import Builder
+from gen_dsp.core.parser import GenExportParser
+from gen_dsp.core.patcher import PERF_PATCH_MARKER, PERF_PATCHES, Patcher, PatchResult
+from gen_dsp.core.project import ProjectConfig, ProjectGenerator
+from gen_dsp.errors import PatchError
+
+# Skip integration tests if the toolchain is not available
+_has_cmake = shutil.which("cmake") is not None
+_has_cxx = shutil.which("g++") is not None or shutil.which("clang++") is not None
+_skip_no_cmake = pytest.mark.skipif(
+    not (_has_cmake and _has_cxx), reason="cmake or C++ compiler not found"
+)
 
 
 class TestPatcher:
@@ -122,3 +140,374 @@ class TestPatchResult:
         repr_str = repr(result)
         assert "test_patch" in repr_str
         assert "skipped" in repr_str
+
+
+def _copy_export(export: Path, tmp_path: Path) -> Path:
+    test_export = tmp_path / "test_export"
+    shutil.copytree(export, test_export)
+    return test_export
+
+
+def _patch(export: Path, tmp_path: Path, name: str) -> str:
+    test_export = _copy_export(export, tmp_path)
+    Patcher(test_export).apply_perf_patches([name])
+    return (test_export / "gen_exported.cpp").read_text()
+
+
+class TestPerfPatches:
+    """Tests for the opt-in performance patch set."""
+
+    def test_ftz_denormals(self, gigaverb_export: Path, tmp_path: Path):
+        content = _patch(gigaverb_export, tmp_path, "ftz_denormals")
+        assert "fixdenorm(" not in content.split("inline int perform(")[1]
+        assert content.count("GEN_DSP_FIXDENORM(mix_") == 5
+        assert "GenDspFtzScope gen_dsp_ftz_scope;" in content
+        # Scope type is defined before State, with a fixdenorm fallback
+        assert content.index("struct GenDspFtzScope") < content.index(
+            "typedef struct State"
+        )
+        assert "#define GEN_DSP_FIXDENORM(x) fixdenorm(x)" in content
+
+    def test_safediv_nonzero(self, fm_bells_export: Path, tmp_path: Path):
+        content = _patch(fm_bells_export, tmp_path, "safediv_nonzero")
+        # Divisor is samplerate: plain division
+        assert "/ (t_sample)(samplerate))" in content
+        # Divisor is a variable: left alone
+        assert "safediv(-6.9077552789821, mul_11)" in content
+
+    def test_safediv_zero_literal_kept(self, tmp_path: Path):
+        export = tmp_path / "export"
+        (export / "gen_dsp").mkdir(parents=True)
+        (export / "gen_exported.cpp").write_text(
+            "typedef struct State {\n"
+            "\tinline int perform(t_sample ** __ins, t_sample ** __outs, int __n) {\n"
+            "\t\tt_sample a = safediv(x, ((t_sample)0));\n"
+            "\t\tt_sample b = safediv(x, ((int)4));\n"
+            "\t\tt_sample c = safediv(x, vectorsize);\n"
+            "\t\treturn 0;\n"
+            "\t}\n"
+            "} State;\n"
+        )
+        Patcher(export).apply_perf_patches(["safediv_nonzero"])
+        content = (export / "gen_exported.cpp").read_text()
+        assert "safediv(x, ((t_sample)0))" in content
+        assert "((t_sample)(x) / (t_sample)(((int)4)))" in content
+        assert "safediv(x, vectorsize)" in content
+
+    def test_safepow_literal(self, gigaverb_export: Path, tmp_path: Path):
+        content = _patch(gigaverb_export, tmp_path, "safepow_literal")
+        assert "safepow(((t_sample)0.001)" not in content
+        assert "fixnan(exp((t_sample)(safediv(" in content
+        # Non-literal base stays a safepow
+        assert "safepow(expr_234, add_139)" in content
+
+    def test_float_literals(self, gigaverb_export: Path, tmp_path: Path):
+        content = _patch(gigaverb_export, tmp_path, "float_literals")
+        assert "(m_spread_22 * (-((t_sample)0.380445)))" in content
+        # Already-cast literals and code outside perform() are untouched
+        assert "((t_sample)((t_sample)" not in content
+        assert "pi->outputmin = 0.1;" in content
+
+    def test_large_pages(self, gigaverb_export: Path, tmp_path: Path):
+        test_export = _copy_export(gigaverb_export, tmp_path)
+        results = Patcher(test_export).apply_perf_patches(["large_pages"])
+
+        assert [(r.file_path.name, r.applied) for r in results] == [
+            ("genlib.cpp", True)
+        ]
+        genlib = (test_export / "gen_dsp" / "genlib.cpp").read_text()
+        assert genlib.startswith(f"{PERF_PATCH_MARKER}large_pages\n")
+        newptr = genlib.split("t_ptr sysmem_newptr(t_ptr_size size)")[1]
+        assert newptr.index("gen_dsp_large_alloc(size)") < newptr.index("malloc(size)")
+        clear = genlib.split("t_ptr sysmem_newptrclear(t_ptr_size size)")[1]
+        assert clear.split("}")[0].count("sysmem_newptr(size)") == 1
+        assert "MADV_HUGEPAGE" in genlib
+        # The kernel itself is untouched
+        assert (test_export / "gen_exported.cpp").read_text() == (
+            gigaverb_export / "gen_exported.cpp"
+        ).read_text()
+
+    def test_patches_individually_toggleable(
+        self, gigaverb_export: Path, tmp_path: Path
+    ):
+        test_export = _copy_export(gigaverb_export, tmp_path)
+        results = Patcher(test_export).apply_perf_patches(["float_literals"])
+        assert [r.patch_name for r in results] == ["float_literals"]
+
+        content = (test_export / "gen_exported.cpp").read_text()
+        assert "// gen-dsp perf patch: float_literals" in content
+        assert "fixdenorm(mix_223)" in content
+        assert "safepow(((t_sample)0.001)" in content
+
+    def test_apply_all_idempotent(self, gigaverb_export: Path, tmp_path: Path):
+        test_export = _copy_export(gigaverb_export, tmp_path)
+        patcher = Patcher(test_export)
+
+        first = patcher.apply_perf_patches()
+        assert [r.patch_name for r in first] == list(PERF_PATCHES)
+        assert any(r.applied for r in first)
+        content = (test_export / "gen_exported.cpp").read_text()
+
+        second = patcher.apply_perf_patches()
+        assert not any(r.applied for r in second)
+        assert (test_export / "gen_exported.cpp").read_text() == content
+
+    def test_dry_run(self, gigaverb_export: Path, tmp_path: Path):
+        test_export = _copy_export(gigaverb_export, tmp_path)
+        original = (test_export / "gen_exported.cpp").read_text()
+
+        results = Patcher(test_export).apply_perf_patches(dry_run=True)
+
+        assert not any(r.applied for r in results)
+        assert any(r.new_content for r in results)
+        assert (test_export / "gen_exported.cpp").read_text() == original
+
+    def test_unknown_patch(self, gigaverb_export: Path, tmp_path: Path):
+        test_export = _copy_export(gigaverb_export, tmp_path)
+        with pytest.raises(PatchError, match="no_such_patch"):
+            Patcher(test_export).apply_perf_patches(["no_such_patch"])
+
+    def test_project_generation(self, gigaverb_export: Path, tmp_path: Path):
+        export_info = GenExportParser(gigaverb_export).parse()
+        config = ProjectConfig(
+            name="gigaverb", platform="lib", perf_patches=["ftz_denormals"]
+        )
+        project_dir = ProjectGenerator(export_info, config).generate(tmp_path / "p")
+
+        content = (project_dir / "gen" / "gen_exported.cpp").read_text()
+        assert "// gen-dsp perf patch: ftz_denormals" in content
+        # The source export is never modified
+        assert (
+            "gen-dsp perf patch"
+            not in (gigaverb_export / "gen_exported.cpp").read_text()
+        )
+
+    def test_project_config_rejects_unknown(self):
+        config = ProjectConfig(name="x", platform="lib", perf_patches=["nope"])
+        assert any("nope" in e for e in config.validate())
+
+    def test_cli_patch_command(self, fm_bells_export: Path, tmp_path: Path, capsys):
+        test_export = _copy_export(fm_bells_export, tmp_path)
+        result = main(["patch", str(test_export), "--perf-patches", "safediv_nonzero"])
+        assert result == 0
+        assert "Applied: safediv_nonzero" in capsys.readouterr().out
+
+
+# Input scale per export: fm_bells reads its inputs as frequency (Hz) and
+# modulation index
+_INPUT_SCALE = {"gigaverb_export": 1.0, "fm_bells_export": 1000.0}
+
+# Exports and the patches that rewrite something in them
+_EQUIVALENCE_CASES = [
+    ("gigaverb_export", "ftz_denormals"),
+    ("gigaverb_export", "safepow_literal"),
+    ("gigaverb_export", "float_literals"),
+    ("gigaverb_export", None),
+    ("fm_bells_export", "ftz_denormals"),
+    ("fm_bells_export", "safediv_nonzero"),
+    ("fm_bells_export", "float_literals"),
+    ("fm_bells_export", None),
+]
+
+
+def _build_lib(export: Path, project_dir: Path, perf_patches: list[str] | None):
+    name = project_dir.name
+    export_info = GenExportParser(export).parse()
+    config = ProjectConfig(name=name, platform="lib", perf_patches=perf_patches)
+    ProjectGenerator(export_info, config).generate(project_dir)
+    result = Builder(project_dir).build(target_platform="lib")
+    assert result.success, result.stderr
+    assert result.output_file is not None
+    return result.output_file
+
+
+def _render(
+    lib_path: Path, name: str, scale: float, blocks: int = 400, n: int = 64
+) -> list[float]:
+    """Process seeded noise (then silence) with random parameter jumps."""
+    lib = ctypes.CDLL(str(lib_path))
+
+    def fn(suffix: str, restype, *argtypes):
+        f = getattr(lib, f"gendsp_{name}_{suffix}")
+        f.restype = restype
+        f.argtypes = argtypes
+        return f
+
+    create = fn("create", ctypes.c_void_p, ctypes.c_float, ctypes.c_int)
+    destroy = fn("destroy", None, ctypes.c_void_p)
+    num_inputs = fn("num_inputs", ctypes.c_int)
+    num_outputs = fn("num_outputs", ctypes.c_int)
+    num_params = fn("num_params", ctypes.c_int)
+    param_min = fn("param_min", ctypes.c_float, ctypes.c_void_p, ctypes.c_int)
+    param_max = fn("param_max", ctypes.c_float, ctypes.c_void_p, ctypes.c_int)
+    set_param = fn("set_param", None, ctypes.c_void_p, ctypes.c_int, ctypes.c_float)
+    process = fn(
+        "process",
+        None,
+        ctypes.c_void_p,
+        ctypes.POINTER(ctypes.POINTER(ctypes.c_float)),
+        ctypes.POINTER(ctypes.POINTER(ctypes.c_float)),
+        ctypes.c_int,
+    )
+
+    inst = create(48000.0, n)
+    ins = [(ctypes.c_float * n)() for _ in range(num_inputs())]
+    outs = [(ctypes.c_float * n)() for _ in range(num_outputs())]
+    in_ptrs = (ctypes.POINTER(ctypes.c_float) * max(1, len(ins)))(*ins)
+    out_ptrs = (ctypes.POINTER(ctypes.c_float) * len(outs))(*outs)
+
+    rng = random.Random(1)
+    rendered = []
+    for block in range(blocks):
+        if block % 50 == 0:
+            for i in range(num_params()):
+                lo, hi = param_min(inst, i), param_max(inst, i)
+                set_param(inst, i, lo + (hi - lo) * rng.random())
+        loud = block < blocks // 2
+        for buf in ins:
+            for j in range(n):
+                buf[j] = scale * rng.uniform(-0.5, 0.5) if loud else 0.0
+        process(inst, in_ptrs, out_ptrs, n)
+        for buf in outs:
+            rendered.extend(buf)
+    destroy(inst)
+    return rendered
+
+
+class TestPerfPatchEquivalence:
+    """Patched exports produce the same output as the unpatched export."""
+
+    @pytest.fixture(scope="class")
+    @classmethod
+    def reference(cls, tmp_path_factory: pytest.TempPathFactory):
+        """Unpatched renders, built once per export."""
+        cache: dict[str, list[float]] = {}
+
+        def render(export: Path, export_fixture: str) -> list[float]:
+            if export_fixture not in cache:
+                project_dir = tmp_path_factory.mktemp("ref") / "reference"
+                lib_path = _build_lib(export, project_dir, None)
+                cache[export_fixture] = _render(
+                    lib_path, "reference", _INPUT_SCALE[export_fixture]
+                )
+            return cache[export_fixture]
+
+        return render
+
+    @staticmethod
+    def _prepare(export: Path, export_fixture: str, tmp_path: Path) -> Path:
+        if export_fixture != "fm_bells_export":
+            return export
+        # fm_bells has no trigger input: strike the bell at reset instead
+        struck = _copy_export(export, tmp_path)
+        cpp = struck / "gen_exported.cpp"
+        cpp.write_text(
+            cpp.read_text().replace("m_amp_5 = ((int)0);", "m_amp_5 = ((int)1);")
+        )
+        return struck
+
+    @_skip_no_cmake
+    @pytest.mark.parametrize("export_fixture,patch", _EQUIVALENCE_CASES)
+    def test_output_matches_unpatched(
+        self,
+        export_fixture: str,
+        patch: str | None,
+        reference,
+        request: pytest.FixtureRequest,
+        tmp_path: Path,
+    ):
+        export = self._prepare(
+            request.getfixturevalue(export_fixture), export_fixture, tmp_path
+        )
+        expected = reference(export, export_fixture)
+
+        names = [patch] if patch else []  # [] = all patches
+        lib_path = _build_lib(export, tmp_path / "patched", names)
+        actual = _render(lib_path, "patched", _INPUT_SCALE[export_fixture])
+
+        peak = max(abs(x) for x in expected)
+        assert peak > 1e-3
+        worst = max(abs(a - e) for a, e in zip(actual, expected))
+        assert worst <= 1e-4 * peak, f"max abs difference {worst} (peak {peak})"
+
+
+_bench_enabled = os.environ.get("GEN_DSP_BENCH", "") not in ("", "0")
+_skip_no_bench = pytest.mark.skipif(
+    not _bench_enabled, reason="first-block benchmark is opt-in (GEN_DSP_BENCH=1)"
+)
+
+
+def _scaled_gigaverb(export: Path, tmp_path: Path, frames: int) -> Path:
+    """gigaverb with its five 48000-frame delay lines grown to `frames`."""
+    scaled = _copy_export(export, tmp_path)
+    cpp = scaled / "gen_exported.cpp"
+    cpp.write_text(cpp.read_text().replace("((int)48000)", f"((int){frames})"))
+    return scaled
+
+
+def _first_block_ns(lib_path: Path, name: str, runs: int, n: int = 64):
+    """Median create() and first process() times over fresh instances."""
+    lib = ctypes.CDLL(str(lib_path))
+    create = getattr(lib, f"gendsp_{name}_create")
+    create.restype = ctypes.c_void_p
+    create.argtypes = [ctypes.c_float, ctypes.c_int]
+    destroy = getattr(lib, f"gendsp_{name}_destroy")
+    destroy.argtypes = [ctypes.c_void_p]
+    process = getattr(lib, f"gendsp_{name}_process")
+    process.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_int]
+    num_outputs = getattr(lib, f"gendsp_{name}_num_outputs")()
+
+    bufs = [(ctypes.c_float * n)() for _ in range(max(2, num_outputs))]
+    ptrs = (ctypes.POINTER(ctypes.c_float) * len(bufs))(*bufs)
+    create_ns, block_ns = [], []
+    for _ in range(runs):
+        t0 = time.perf_counter_ns()
+        inst = create(48000.0, n)
+        t1 = time.perf_counter_ns()
+        process(inst, ptrs, ptrs, n)
+        t2 = time.perf_counter_ns()
+        destroy(inst)
+        create_ns.append(t1 - t0)
+        block_ns.append(t2 - t1)
+    return statistics.median(create_ns), statistics.median(block_ns)
+
+
+class TestLargePages:
+    """The large-allocation path in genlib.cpp."""
+
+    @_skip_no_cmake
+    def test_output_identical(self, gigaverb_export: Path, tmp_path: Path):
+        # 480000 frames rounds up to 2 MB of float32: the huge-page threshold
+        export = _scaled_gigaverb(gigaverb_export, tmp_path, 480000)
+        expected = _render(
+            _build_lib(export, tmp_path / "plain", None), "plain", 1.0, blocks=100
+        )
+        actual = _render(
+            _build_lib(export, tmp_path / "large", ["large_pages"]),
+            "large",
+            1.0,
+            blocks=100,
+        )
+        assert max(abs(x) for x in expected) > 1e-3
+        assert actual == expected
+
+    @_skip_no_bench
+    @_skip_no_cmake
+    def test_first_block_latency(
+        self, gigaverb_export: Path, tmp_path: Path, record_property
+    ):
+        # 4.8M frames -> 32 MB per delay line, 160 MB in all
+        export = _scaled_gigaverb(gigaverb_export, tmp_path, 4800000)
+        plain = _build_lib(export, tmp_path / "plain", None)
+        large = _build_lib(export, tmp_path / "large", ["large_pages"])
+
+        plain_create, plain_block = _first_block_ns(plain, "plain", runs=15)
+        large_create, large_block = _first_block_ns(large, "large", runs=15)
+        record_property("plain_first_block_ns", plain_block)
+        record_property("large_pages_first_block_ns", large_block)
+        print(
+            f"\nfirst block: malloc {plain_block / 1e3:.1f} us, "
+            f"large_pages {large_block / 1e3:.1f} us; "
+            f"create: malloc {plain_create / 1e6:.1f} ms, "
+            f"large_pages {large_create / 1e6:.1f} ms"
+        )
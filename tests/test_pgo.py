@@ -0,0 +1,173 @@
+"""Tests for profile-guided builds (gen_dsp.core.pgo)."""
+
+import shutil
+from pathlib import Path
+
+import pytest
+
+from gen_dsp.cli import main
+from gen_dsp.core.builder import Builder
+from gen_dsp.core.parser import GenExportParser
+from gen_dsp.core.pgo import (
+    PgoBuilder,
+    PgoWorkload,
+    make_pgo_flags,
+    profile_cache_key,
+)
+from gen_dsp.core.project import ProjectConfig, ProjectGenerator
+from gen_dsp.errors import BuildError
+from gen_dsp.platforms import get_platform
+
+# Skip integration tests if the toolchain is not available
+_has_cmake = shutil.which("cmake") is not None
+_has_make = shutil.which("make") is not None
+_has_cxx = shutil.which("g++") is not None or shutil.which("clang++") is not None
+_skip_no_cmake = pytest.mark.skipif(
+    not (_has_cmake and _has_cxx), reason="cmake or C++ compiler not found"
+)
+_skip_no_make = pytest.mark.skipif(
+    not (_has_make and _has_cxx), reason="make or C++ compiler not found"
+)
+
+_PGO_PLATFORMS = ["clap", "vst3", "lv2", "sc", "lib", "standalone", "pd"]
+_CMAKE_PGO_PLATFORMS = ["clap", "vst3", "lv2", "sc", "lib"]
+
+
+def _generate(export: Path, platform: str, project_dir: Path) -> Path:
+    export_info = GenExportParser(export).parse()
+    config = ProjectConfig(name="gigaverb", platform=platform)
+    return ProjectGenerator(export_info, config).generate(project_dir)
+
+
+@pytest.fixture
+def pgo_cache(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> Path:
+    """Isolate the PGO profile cache from the user's cache directory."""
+    cache = tmp_path / "pgo_cache"
+    monkeypatch.setattr("gen_dsp.core.pgo.get_pgo_cache_dir", lambda: cache)
+    return cache
+
+
+class TestPgoProjectFiles:
+    """Generated projects carry the --pgo hooks."""
+
+    @pytest.mark.parametrize("platform", _PGO_PLATFORMS)
+    def test_trainer_copied(self, platform: str, gigaverb_export: Path, tmp_path: Path):
+        project_dir = _generate(gigaverb_export, platform, tmp_path / platform)
+        assert (project_dir / "gen_dsp_pgo_train.cpp").exists()
+        assert get_platform(platform).supports_pgo
+
+    @pytest.mark.parametrize("platform", _CMAKE_PGO_PLATFORMS)
+    def test_cmake_includes_helper(
+        self, platform: str, gigaverb_export: Path, tmp_path: Path
+    ):
+        project_dir = _generate(gigaverb_export, platform, tmp_path / platform)
+        assert (project_dir / "gen_dsp_pgo.cmake").exists()
+        cmakelists = (project_dir / "CMakeLists.txt").read_text()
+        assert "gen_dsp_pgo.cmake" in cmakelists
+        assert f" {platform})" in cmakelists  # gen_dsp_enable_pgo(<target> <key>)
+
+    @pytest.mark.parametrize("platform", ["standalone", "pd"])
+    def test_makefile_hooks(self, platform: str, gigaverb_export: Path, tmp_path: Path):
+        project_dir = _generate(gigaverb_export, platform, tmp_path / platform)
+        makefile = (project_dir / "Makefile").read_text()
+        assert "PGO_FLAGS ?=" in makefile
+        assert "pgo-train:" in makefile
+
+    def test_unsupported_platform_has_no_trainer(
+        self, gigaverb_export: Path, tmp_path: Path
+    ):
+        project_dir = _generate(gigaverb_export, "chuck", tmp_path / "chuck")
+        assert not (project_dir / "gen_dsp_pgo_train.cpp").exists()
+        assert not get_platform("chuck").supports_pgo
+
+
+class TestPgoConfig:
+    """Flags, cache keys and argument checks."""
+
+    def test_make_flags_generate(self, tmp_path: Path):
+        assert make_pgo_flags("generate", tmp_path, clang=False) == (
+            f"-fprofile-generate={tmp_path}"
+        )
+
+    def test_make_flags_use(self, tmp_path: Path):
+        gcc = make_pgo_flags("use", tmp_path, clang=False)
+        clang = make_pgo_flags("use", tmp_path, clang=True)
+        assert f"-fprofile-use={tmp_path}" in gcc
+        assert "default.profdata" in clang
+
+    def test_cache_key_tracks_export_and_workload(
+        self, gigaverb_export: Path, tmp_path: Path
+    ):
+        project_dir = _generate(gigaverb_export, "lib", tmp_path / "lib")
+        workload = PgoWorkload()
+        key = profile_cache_key(project_dir, "lib", workload, "clang 17")
+
+        assert key == profile_cache_key(project_dir, "lib", workload, "clang 17")
+        assert key != profile_cache_key(project_dir, "clap", workload, "clang 17")
+        assert key != profile_cache_key(
+            project_dir, "lib", PgoWorkload(seed=2), "clang 17"
+        )
+        assert key != profile_cache_key(project_dir, "lib", workload, "clang 18")
+
+        cpp = project_dir / "gen" / "gen_exported.cpp"
+        cpp.write_text(cpp.read_text() + "\n// edited\n")
+        assert key != profile_cache_key(project_dir, "lib", workload, "clang 17")
+
+    def test_unsupported_platform(self, gigaverb_export: Path, tmp_path: Path):
+        project_dir = _generate(gigaverb_export, "chuck", tmp_path / "chuck")
+        with pytest.raises(BuildError, match="not supported"):
+            PgoBuilder(get_platform("chuck"), project_dir)
+
+    def test_missing_trainer(self, gigaverb_export: Path, tmp_path: Path):
+        project_dir = _generate(gigaverb_export, "lib", tmp_path / "lib")
+        (project_dir / "gen_dsp_pgo_train.cpp").unlink()
+        with pytest.raises(BuildError, match="regenerate"):
+            PgoBuilder(get_platform("lib"), project_dir)
+
+    def test_cli_build_rejects_unsupported(
+        self, gigaverb_export: Path, tmp_path: Path, capsys
+    ):
+        project_dir = _generate(gigaverb_export, "chuck", tmp_path / "chuck")
+        result = main(["build", str(project_dir), "-p", "chuck", "--pgo"])
+        assert result == 1
+        assert "not supported" in capsys.readouterr().err
+
+
+class TestPgoBuildIntegration:
+    """Full generate / train / use cycles."""
+
+    @_skip_no_cmake
+    def test_lib_pgo_build(
+        self, gigaverb_export: Path, tmp_path: Path, pgo_cache: Path
+    ):
+        project_dir = _generate(gigaverb_export, "lib", tmp_path / "lib")
+
+        result = Builder(project_dir).build(target_platform="lib", pgo=True)
+        assert result.success, result.stderr
+        assert result.output_file is not None
+
+        profile_dir = project_dir / "build" / "pgo"
+        assert any(profile_dir.iterdir())
+        cached = list(pgo_cache.iterdir())
+        assert len(cached) == 1
+
+        # Second build reuses the cached profile without retraining
+        (project_dir / "build" / "gen_dsp_pgo_train").unlink()
+        result = Builder(project_dir).build(target_platform="lib", pgo=True)
+        assert result.success, result.stderr
+        assert "Using cached profile" in result.stdout
+        assert not (project_dir / "build" / "gen_dsp_pgo_train").exists()
+
+    @_skip_no_make
+    def test_pd_pgo_build(
+        self, rampleplayer_export: Path, tmp_path: Path, pgo_cache: Path
+    ):
+        export_info = GenExportParser(rampleplayer_export).parse()
+        config = ProjectConfig(name="rampleplayer", platform="pd", buffers=["sample"])
+        project_dir = ProjectGenerator(export_info, config).generate(tmp_path / "pd")
+
+        result = Builder(project_dir).build(target_platform="pd", pgo=True)
+        assert result.success, result.stderr
+        assert result.output_file is not None
+        assert (project_dir / "gen_dsp_pgo_train").exists()
+        assert any((project_dir / "build" / "pgo").iterdir())
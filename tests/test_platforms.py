@@ -161,6 +161,7 @@ _BUILD_SYSTEM_FILES = {
     "standalone": "Makefile",
     "csound": "Makefile",
     "auv3": "CMakeLists.txt",
+    "lib": "CMakeLists.txt",
 }
 
 
@@ -0,0 +1,123 @@
+"""Tests for the shared SIMD sample kernels (templates/shared/gen_dsp_simd.h).
+
+tests/hosts/simd_kernels.cpp checks every kernel bit for bit against the
+plain loops it replaced in the standalone, ChucK, Circle and Csound
+wrappers. It is built with the SSE2/NEON paths and again with
+GEN_DSP_SIMD_SCALAR; both must pass and agree on the output checksum.
+
+The microbenchmark (reference loop vs kernel, ns/sample) is opt-in::
+
+    GEN_DSP_BENCH=1 pytest tests/test_simd.py -s
+"""
+
+import os
+import shutil
+import subprocess
+from pathlib import Path
+
+import pytest
+
+from gen_dsp.core.parser import GenExportParser
+from gen_dsp.core.project import ProjectConfig, ProjectGenerator
+from gen_dsp.platforms import get_platform
+
+_CXX = shutil.which("g++") or shutil.which("clang++")
+_bench_enabled = os.environ.get("GEN_DSP_BENCH", "") not in ("", "0")
+
+_skip_no_cxx = pytest.mark.skipif(_CXX is None, reason="C++ compiler not found")
+_skip_no_bench = pytest.mark.skipif(
+    not _bench_enabled, reason="SIMD benchmark is opt-in (GEN_DSP_BENCH=1)"
+)
+
+_SOURCE = Path(__file__).resolve().parent / "hosts" / "simd_kernels.cpp"
+
+_SIMD_PLATFORMS = ["standalone", "chuck", "csound", "circle"]
+
+
+def _build(tmp_path: Path, name: str, *flags: str) -> Path:
+    assert _CXX is not None
+    exe = tmp_path / name
+    # No FP contraction: the kernels are only bit-exact against unfused loops
+    subprocess.run(
+        [_CXX, "-O2", "-ffp-contract=off", *flags, "-o", str(exe), str(_SOURCE)],
+        check=True,
+        capture_output=True,
+        text=True,
+    )
+    return exe
+
+
+def _run(exe: Path, *args: str) -> tuple[int, dict[str, str], list[str]]:
+    result = subprocess.run(
+        [str(exe), *args], capture_output=True, text=True, timeout=300, check=False
+    )
+    report: dict[str, str] = {}
+    lines = result.stdout.splitlines()
+    for line in lines:
+        key, _, value = line.partition(" ")
+        report.setdefault(key, value)
+    return result.returncode, report, lines
+
+
+class TestSimdKernels:
+    """The SIMD paths are bit-exact with the scalar loops."""
+
+    @_skip_no_cxx
+    def test_kernels_bit_exact(self, tmp_path: Path):
+        simd = _build(tmp_path, "simd_kernels")
+        scalar = _build(tmp_path, "simd_kernels_scalar", "-DGEN_DSP_SIMD_SCALAR")
+
+        rc_simd, simd_report, simd_lines = _run(simd)
+        rc_scalar, scalar_report, scalar_lines = _run(scalar)
+
+        assert rc_simd == 0, "\n".join(simd_lines)
+        assert rc_scalar == 0, "\n".join(scalar_lines)
+        assert "ok" in simd_lines
+        assert "ok" in scalar_lines
+        assert scalar_report["path"] == "scalar"
+        assert simd_report["checksum"] == scalar_report["checksum"]
+
+    @_skip_no_bench
+    @_skip_no_cxx
+    def test_kernel_benchmark(self, tmp_path: Path, record_property):
+        exe = _build(tmp_path, "simd_kernels")
+        rc, report, lines = _run(exe, "--bench")
+        assert rc == 0, "\n".join(lines)
+
+        print(f"\nSIMD path: {report['path']}")
+        for line in lines:
+            if not line.startswith("bench "):
+                continue
+            _, kernel, ref_ns, simd_ns = line.split()
+            record_property(f"{kernel}_ref_ns_per_sample", float(ref_ns))
+            record_property(f"{kernel}_ns_per_sample", float(simd_ns))
+            print(
+                f"{kernel}: reference {float(ref_ns):.3f} ns/sample, "
+                f"kernel {float(simd_ns):.3f} ns/sample"
+            )
+
+
+class TestSimdHeaderCopied:
+    """Only the wrappers that use the kernels get the header."""
+
+    @pytest.mark.parametrize("platform", _SIMD_PLATFORMS)
+    def test_header_copied(self, platform: str, gigaverb_export: Path, tmp_path: Path):
+        assert get_platform(platform).uses_simd_kernels
+        export_info = GenExportParser(gigaverb_export).parse()
+        config = ProjectConfig(name="gigaverb", platform=platform)
+        project_dir = ProjectGenerator(export_info, config).generate(tmp_path / "p")
+
+        assert (project_dir / "gen_dsp_simd.h").exists()
+        wrapper = next(project_dir.glob("gen_ext_*.cpp"))
+        assert '#include "gen_dsp_simd.h"' in wrapper.read_text()
+
+    @pytest.mark.parametrize("platform", ["clap", "lib", "pd"])
+    def test_header_not_copied(
+        self, platform: str, gigaverb_export: Path, tmp_path: Path
+    ):
+        assert not get_platform(platform).uses_simd_kernels
+        export_info = GenExportParser(gigaverb_export).parse()
+        config = ProjectConfig(name="gigaverb", platform=platform)
+        project_dir = ProjectGenerator(export_info, config).generate(tmp_path / "p")
+
+        assert not (project_dir / "gen_dsp_simd.h").exists()
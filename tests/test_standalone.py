@@ -136,6 +136,67 @@ class TestStandaloneProjectGeneration:
         assert "ma_device" in content
         assert "STANDALONE_EXT_NAME" in content
 
+    def test_gen_ext_standalone_rt_options(
+        self, gigaverb_export: Path, tmp_project: Path
+    ):
+        """Test that the real-time options and xrun report are present."""
+        export_info = GenExportParser(gigaverb_export).parse()
+        config = ProjectConfig(name="testverb", platform="standalone")
+        project_dir = ProjectGenerator(export_info, config).generate(tmp_project)
+
+        content = (project_dir / "gen_ext_standalone.cpp").read_text()
+        for flag in ("--rt-priority", "--cpu", "--mlockall", "--prefault"):
+            assert f'"{flag}"' in content
+        assert "pthread_setschedparam" in content
+        assert "pthread_setaffinity_np" in content
+        assert "mlockall(MCL_CURRENT | MCL_FUTURE)" in content
+        assert "Xruns:" in content
+        # Prefault resets the state, so it must run before -p values apply
+        assert content.index("if (g_prefault) {\n        long bs") < content.index(
+            "// Apply parameter settings"
+        )
+
+    @pytest.mark.skipif(not _has_cxx, reason="c++ not found")
+    def test_audio_callback_keeps_device_stride(
+        self, gigaverb_export: Path, tmp_path: Path
+    ):
+        """Devices wider than MAX_CHANNELS keep their interleave stride."""
+        export_info = GenExportParser(gigaverb_export).parse()
+        config = ProjectConfig(name="testverb", platform="standalone")
+        project_dir = ProjectGenerator(export_info, config).generate(tmp_path / "proj")
+
+        content = (project_dir / "gen_ext_standalone.cpp").read_text()
+        start = content.index("static void audio_callback(")
+        end = content.index("\n}\n", start) + 3
+        stubs = tmp_path / "stubs"
+        stubs.mkdir()
+        for name, text in _CALLBACK_STUBS.items():
+            (stubs / name).write_text(text)
+        src = tmp_path / "callback.cpp"
+        src.write_text(content[:end] + _CALLBACK_DRIVER)
+        exe = tmp_path / "callback"
+        cxx = shutil.which("c++") or "g++"
+        result = subprocess.run(
+            [
+                cxx,
+                "-std=c++17",
+                f"-I{stubs}",
+                f"-I{project_dir}",
+                str(src),
+                "-o",
+                str(exe),
+                "-lpthread",
+            ],
+            capture_output=True,
+            text=True,
+            check=False,
+        )
+        assert result.returncode == 0, f"compile failed:\n{result.stderr}"
+        run = subprocess.run([str(exe)], capture_output=True, text=True, check=False)
+        assert run.returncode == 0, run.stderr
+        # ins, mismatches, and the channel counts wrapper_perform saw
+        assert run.stdout.splitlines() == ["2 0 2 2", "3 0 3 1", "70 0 64 64"]
+
     def test_generate_copies_gen_export(self, gigaverb_export: Path, tmp_project: Path):
         """Test that gen~ export is copied to project."""
         parser = GenExportParser(gigaverb_export)
@@ -170,6 +231,63 @@ class TestStandaloneProjectGeneration:
         assert "STANDALONE" in header
 
 
+# Stand-ins for miniaudio and the wrapper so audio_callback can be compiled
+# and driven on its own, without an audio device.
+_CALLBACK_STUBS = {
+    "miniaudio.h": "typedef unsigned int ma_uint32;\n"
+    "struct ma_device { ma_uint32 sampleRate; };\n",
+    "_ext_standalone.h": "#define WRAPPER_NAMESPACE stub\n"
+    "namespace stub {\n"
+    "typedef void GenState;\n"
+    "void wrapper_perform(GenState*, float**, long, float**, long, long);\n"
+    "}\n",
+}
+
+_CALLBACK_DRIVER = r"""
+static long s_seen_in = -1, s_seen_out = -1;
+static int s_in_errors = 0;
+
+void stub::wrapper_perform(GenState*, float** ins, long numins, float** outs,
+                           long numouts, long n) {
+    s_seen_in = numins;
+    s_seen_out = numouts;
+    for (long ch = 0; ch < numins; ch++)
+        for (long i = 0; i < n; i++)
+            s_in_errors += ins[ch][i] != (float)(ch * 10 + i);
+    for (long ch = 0; ch < numouts; ch++)
+        for (long i = 0; i < n; i++) outs[ch][i] = (float)(ch + 1);
+}
+
+static int run(int ins, int outs, int dev_out) {
+    static float in[4 * 80], out[4 * 80];
+    ma_device dev = {48000};
+    g_num_inputs = ins;
+    g_num_outputs = outs;
+    g_device_out_channels = dev_out;
+    for (int i = 0; i < 4; i++)
+        for (int ch = 0; ch < ins; ch++) in[i * ins + ch] = (float)(ch * 10 + i);
+    audio_callback(&dev, out, ins ? in : nullptr, 4);
+    int errors = s_in_errors;
+    for (int i = 0; i < 4; i++) {
+        for (int ch = 0; ch < dev_out; ch++) {
+            int src = ch < outs ? ch : outs - 1;
+            float want = src < MAX_CHANNELS ? (float)(src + 1) : 0.0f;
+            errors += out[i * dev_out + ch] != want;
+        }
+    }
+    printf("%d %d %ld %ld\n", ins, errors, s_seen_in, s_seen_out);
+    return errors;
+}
+
+int main() {
+    run(2, 2, 2);
+    run(3, 1, 2);
+    run(70, 70, 70);
+    return 0;
+}
+"""
+
+
 class TestStandaloneBuildIntegration:
     """Integration tests that generate and compile standalone executables.
 
@@ -268,3 +386,44 @@ class TestStandaloneBuildIntegration:
         assert "roomsize" in output
         assert "revtime" in output
         assert "Audio I/O" in output
+
+    @_skip_no_build
+    def test_rt_options(self, gigaverb_export: Path, tmp_path: Path):
+        """Build gigaverb and check the real-time option parsing."""
+        project_dir = tmp_path / "gigaverb_rt"
+        export_info = GenExportParser(gigaverb_export).parse()
+        config = ProjectConfig(name="gigaverb", platform="standalone")
+        ProjectGenerator(export_info, config).generate(project_dir)
+
+        build_result = subprocess.run(
+            ["make", "all"],
+            cwd=project_dir,
+            capture_output=True,
+            text=True,
+            check=False,
+            timeout=120,
+        )
+        assert build_result.returncode == 0, build_result.stderr
+
+        # -l exits before the device opens; the options must still parse
+        result = subprocess.run(
+            ["./gigaverb", "--rt-priority", "10", "--cpu", "0", "--prefault", "-l"],
+            cwd=project_dir,
+            capture_output=True,
+            text=True,
+            check=False,
+            timeout=10,
+        )
+        assert result.returncode == 0, result.stderr
+        assert "roomsize" in result.stdout
+
+        result = subprocess.run(
+            ["./gigaverb", "--rt-priority", "0"],
+            cwd=project_dir,
+            capture_output=True,
+            text=True,
+            check=False,
+            timeout=10,
+        )
+        assert result.returncode == 1
+        assert "--rt-priority" in result.stderr
@@ -0,0 +1,259 @@
+"""Per-block overhead benchmarks for the CLAP, VST3 and LV2 wrappers.
+
+Each plugin wrapper (gen_ext_clap.cpp, gen_ext_vst3.cpp, gen_ext_lv2.cpp)
+is loaded by a minimal headless host from tests/hosts/ and driven with a
+scripted block/parameter schedule. The same schedule is run through the
+project's own _ext_<platform>.cpp via direct wrapper_* calls, and the
+difference in ns/block is the cost of the wrapper itself: event walking,
+parameter conversion and buffer plumbing.
+
+test_lto_saving builds each plugin twice, with and without GEN_DSP_LTO,
+and reports how much of that per-block cost link-time inlining of the
+wrapper_* calls removes.
+
+These are benchmarks, not correctness tests, so they are opt-in::
+
+    GEN_DSP_BENCH=1 pytest tests/test_wrapper_overhead.py -s
+
+(or ``make bench``). Linux only; SDKs are fetched into the shared
+FetchContent cache on first use.
+"""
+
+import json
+import os
+import shutil
+import subprocess
+import sys
+from pathlib import Path
+
+import pytest
+
+from gen_dsp.core.parser import GenExportParser
+from gen_dsp.core.project import ProjectConfig, ProjectGenerator
+
+
+def _build_env():
+    """Environment for cmake subprocesses that prevents git credential prompts."""
+    env = os.environ.copy()
+    env["GIT_TERMINAL_PROMPT"] = "0"
+    return env
+
+
+# Skip conditions
+_has_cmake = shutil.which("cmake") is not None
+_has_cxx = shutil.which("clang++") is not None or shutil.which("g++") is not None
+_bench_enabled = os.environ.get("GEN_DSP_BENCH", "") not in ("", "0")
+
+_skip_no_bench = pytest.mark.skipif(
+    not (_bench_enabled and sys.platform.startswith("linux")),
+    reason="wrapper benchmarks are opt-in (GEN_DSP_BENCH=1) and Linux only",
+)
+_skip_no_toolchain = pytest.mark.skipif(
+    not (_has_cmake and _has_cxx), reason="cmake and C++ compiler required"
+)
+
+_HOSTS_DIR = Path(__file__).resolve().parent / "hosts"
+
+# Scripted schedule shared by the direct baseline and the plugin host:
+# 64-frame blocks, parameter 0 toggled every 4 blocks.
+_BENCH_ARGS = [
+    "--blocks",
+    "20000",
+    "--block-size",
+    "64",
+    "--repeats",
+    "5",
+    "--sr",
+    "48000",
+    "--param",
+    "0",
+    "--every",
+    "4",
+]
+
+
+def _run(cmd: list[str], cwd: Path, timeout: int) -> subprocess.CompletedProcess:
+    result = subprocess.run(
+        cmd,
+        cwd=cwd,
+        capture_output=True,
+        text=True,
+        timeout=timeout,
+        env=_build_env(),
+        check=False,
+    )
+    assert result.returncode == 0, (
+        f"{' '.join(cmd)} failed:\nstdout: {result.stdout}\nstderr: {result.stderr}"
+    )
+    return result
+
+
+def _build_plugin(
+    export: Path,
+    platform: str,
+    tmp_path: Path,
+    fetchcontent_cache: Path,
+    lto: bool = False,
+) -> tuple[Path, Path]:
+    """Generate and build an optimized plugin; return (project_dir, plugin_path)."""
+    project_dir = tmp_path / f"gigaverb_{platform}{'_lto' if lto else ''}"
+    export_info = GenExportParser(export).parse()
+    config = ProjectConfig(name="gigaverb", platform=platform)
+    ProjectGenerator(export_info, config).generate(project_dir)
+
+    build_dir = project_dir / "build"
+    _run(
+        [
+            "cmake",
+            "..",
+            "-DCMAKE_BUILD_TYPE=Release",
+            f"-DFETCHCONTENT_BASE_DIR={fetchcontent_cache}",
+            f"-DGEN_DSP_LTO={'ON' if lto else 'OFF'}",
+        ],
+        build_dir,
+        300,
+    )
+    _run(["cmake", "--build", ".", "-j"], build_dir, 600)
+
+    if platform == "clap":
+        plugin = next(build_dir.glob("**/*.clap"))
+    elif platform == "vst3":
+        plugin = next(d for d in build_dir.glob("**/*.vst3") if d.is_dir())
+    else:
+        bundle = next(d for d in build_dir.glob("**/*.lv2") if d.is_dir())
+        plugin = next(f for f in bundle.glob("gigaverb.*") if f.suffix != ".ttl")
+    return project_dir, plugin
+
+
+def _build_hosts(
+    project_dir: Path, platform: str, tmp_path: Path, fetchcontent_cache: Path
+) -> Path:
+    """Build direct_host and <platform>_host for a generated project."""
+    build_dir = tmp_path / f"hosts_{platform}"
+    build_dir.mkdir()
+    _run(
+        [
+            "cmake",
+            str(_HOSTS_DIR),
+            "-DCMAKE_BUILD_TYPE=Release",
+            f"-DGEN_PROJECT_DIR={project_dir}",
+            f"-DGEN_PLATFORM={platform}",
+            "-DGEN_LIB_NAME=gigaverb",
+            f"-DFETCHCONTENT_BASE_DIR={fetchcontent_cache}",
+        ],
+        build_dir,
+        300,
+    )
+    _run(["cmake", "--build", ".", "-j"], build_dir, 600)
+    return build_dir
+
+
+def _bench_args(project_dir: Path) -> list[str]:
+    """Schedule arguments with the project's I/O counts and parameter range."""
+    manifest = json.loads((project_dir / "manifest.json").read_text())
+    param = manifest["params"][0]
+    return [
+        *_BENCH_ARGS,
+        "--io",
+        str(manifest["num_inputs"]),
+        str(manifest["num_outputs"]),
+        "--values",
+        str(param["min"]),
+        str(param["max"]),
+        "--controls",
+        ",".join(str(p["default"]) for p in manifest["params"]),
+    ]
+
+
+def _parse_report(stdout: str) -> dict[str, float]:
+    report = {}
+    for line in stdout.splitlines():
+        key, _, value = line.partition(" ")
+        if value:
+            report[key] = float(value)
+    return report
+
+
+class TestWrapperOverhead:
+    """Measure ns/block of each plugin wrapper against direct wrapper_perform."""
+
+    @_skip_no_bench
+    @_skip_no_toolchain
+    @pytest.mark.parametrize("platform", ["clap", "vst3", "lv2"])
+    def test_wrapper_overhead(
+        self,
+        platform: str,
+        gigaverb_export: Path,
+        tmp_path: Path,
+        fetchcontent_cache: Path,
+        record_property,
+    ):
+        project_dir, plugin = _build_plugin(
+            gigaverb_export, platform, tmp_path, fetchcontent_cache
+        )
+        hosts = _build_hosts(project_dir, platform, tmp_path, fetchcontent_cache)
+
+        args = _bench_args(project_dir)
+
+        direct = _parse_report(
+            _run([str(hosts / "direct_host"), *args], hosts, 300).stdout
+        )
+        hosted = _parse_report(
+            _run(
+                [str(hosts / f"{platform}_host"), *args, str(plugin)], hosts, 300
+            ).stdout
+        )
+
+        assert direct["ns_per_block"] > 0
+        assert hosted["ns_per_block"] > 0
+        assert direct["output_rms"] > 0
+        assert hosted["output_rms"] > 0
+
+        overhead = hosted["ns_per_block"] - direct["ns_per_block"]
+        record_property("direct_ns_per_block", direct["ns_per_block"])
+        record_property(f"{platform}_ns_per_block", hosted["ns_per_block"])
+        record_property(f"{platform}_overhead_ns_per_block", overhead)
+        print(
+            f"\n{platform}: direct {direct['ns_per_block']:.1f} ns/block, "
+            f"hosted {hosted['ns_per_block']:.1f} ns/block, "
+            f"overhead {overhead:+.1f} ns/block"
+        )
+
+    @_skip_no_bench
+    @_skip_no_toolchain
+    @pytest.mark.parametrize("platform", ["clap", "vst3", "lv2"])
+    def test_lto_saving(
+        self,
+        platform: str,
+        gigaverb_export: Path,
+        tmp_path: Path,
+        fetchcontent_cache: Path,
+        record_property,
+    ):
+        """ns/block with and without GEN_DSP_LTO, through the same host."""
+        project_dir, plugin = _build_plugin(
+            gigaverb_export, platform, tmp_path, fetchcontent_cache
+        )
+        _, plugin_lto = _build_plugin(
+            gigaverb_export, platform, tmp_path, fetchcontent_cache, lto=True
+        )
+        hosts = _build_hosts(project_dir, platform, tmp_path, fetchcontent_cache)
+        host = str(hosts / f"{platform}_host")
+        args = _bench_args(project_dir)
+
+        plain = _parse_report(_run([host, *args, str(plugin)], hosts, 300).stdout)
+        lto = _parse_report(_run([host, *args, str(plugin_lto)], hosts, 300).stdout)
+
+        assert plain["ns_per_block"] > 0
+        assert lto["ns_per_block"] > 0
+        assert lto["output_rms"] > 0
+
+        saving = plain["ns_per_block"] - lto["ns_per_block"]
+        record_property(f"{platform}_ns_per_block", plain["ns_per_block"])
+        record_property(f"{platform}_lto_ns_per_block", lto["ns_per_block"])
+        record_property(f"{platform}_lto_saving_ns_per_block", saving)
+        print(
+            f"\n{platform}: {plain['ns_per_block']:.1f} ns/block, "
+            f"LTO {lto['ns_per_block']:.1f} ns/block, "
+            f"saving {saving:+.1f} ns/block"
+        )